@@ -123,6 +123,9 @@ void OffscreenWidget::drawEvent(const Box2I& drawRect, const DrawEvent& event)
             const TransformState transformState(event.render);
             const RenderSizeState renderSizeState(event.render);
 
+            // Flush the renderer before issuing OpenGL commands directly.
+            event.render->flush();
+
             gl::OffscreenBufferBinding binding(_buffer);
             event.render->setRenderSize(size);
             event.render->setViewport(Box2I(0, 0, g.w(), g.h()));
@@ -169,6 +172,9 @@ void OffscreenWidget::drawEvent(const Box2I& drawRect, const DrawEvent& event)
             auto vao = gl::VAO::create(vbo->getType(), vbo->getID());
             vao->bind();
             vao->draw(GL_TRIANGLES, 0, vbo->getSize());
+
+            // Reset the renderer state since it was changed above.
+            event.render->resetState();
         }
     }
     catch (const std::exception& e)
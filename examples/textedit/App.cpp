@@ -36,7 +36,7 @@ namespace feather_tk
                     { _cmdLine.path });
 
                 _font = ObservableValue<FontRole>::create(FontRole::Mono);
-                _text = ObservableValue<std::string>::create();
+                _text = ObservableValue<std::shared_ptr<LineIndex> >::create();
 
                 context->getSystem<FileBrowserSystem>()->setNativeFileDialog(false);
 
@@ -73,7 +73,7 @@ namespace feather_tk
                 _font->setIfChanged(value);
             }
 
-            std::shared_ptr<IObservableValue<std::string> > App::observeText() const
+            std::shared_ptr<IObservableValue<std::shared_ptr<LineIndex> > > App::observeText() const
             {
                 return _text;
             }
@@ -82,15 +82,21 @@ namespace feather_tk
             {
                 try
                 {
+                    // The file is memory-mapped and indexed, so that only
+                    // the visible lines are read.
                     auto fileIO = FileIO::create(path, FileMode::Read);
-                    const std::string text = read(fileIO);
-                    _text->setIfChanged(text);
+                    _text->setIfChanged(LineIndex::create(fileIO));
                 }
                 catch (const std::exception& e)
                 {
                     _context->getSystem<DialogSystem>()->message("ERROR", e.what(), _window);
                 }
             }
+
+            void App::close()
+            {
+                _text->setIfChanged(nullptr);
+            }
         }
     }
 }
@@ -8,6 +8,7 @@
 #include <feather-tk/ui/Style.h>
 
 #include <feather-tk/core/CmdLine.h>
+#include <feather-tk/core/LineIndex.h>
 #include <feather-tk/core/ObservableValue.h>
 
 #include <filesystem>
@@ -40,10 +41,12 @@ namespace feather_tk
 
                 void setFont(FontRole);
 
-                std::shared_ptr<IObservableValue<std::string> > observeText() const;
+                std::shared_ptr<IObservableValue<std::shared_ptr<LineIndex> > > observeText() const;
 
                 void open(const std::filesystem::path&);
 
+                void close();
+
             private:
                 struct CmdLine
                 {
@@ -51,7 +54,7 @@ namespace feather_tk
                 };
                 CmdLine _cmdLine;
                 std::shared_ptr<ObservableValue<FontRole> > _font;
-                std::shared_ptr<ObservableValue<std::string> > _text;
+                std::shared_ptr<ObservableValue<std::shared_ptr<LineIndex> > > _text;
                 std::shared_ptr<Window> _window;
             };
         }
@@ -4,6 +4,12 @@
 
 #include "TextWidget.h"
 
+#include <feather-tk/ui/LayoutUtil.h>
+
+#include <feather-tk/core/LRUCache.h>
+
+#include <optional>
+
 using namespace feather_tk;
 
 namespace feather_tk
@@ -12,14 +18,63 @@ namespace feather_tk
     {
         namespace textedit
         {
+            namespace
+            {
+                const size_t maxLineLength = 8192;
+                const size_t lineCacheMax = 1000;
+
+                std::string getLine(const std::shared_ptr<LineIndex>& lineIndex, size_t line)
+                {
+                    std::string out = lineIndex->getLine(line, maxLineLength);
+                    if (lineIndex->getLineLength(line) > maxLineLength)
+                    {
+                        // Don't leave a partial UTF-8 sequence at the end.
+                        size_t i = out.size();
+                        while (i > 0 && 0x80 == (static_cast<uint8_t>(out[i - 1]) & 0xc0))
+                        {
+                            --i;
+                        }
+                        if (i > 0 && static_cast<uint8_t>(out[i - 1]) >= 0xc0)
+                        {
+                            out.resize(i - 1);
+                        }
+                    }
+                    return out;
+                }
+            }
+
             struct TextWidget::Private
-            {};
+            {
+                std::shared_ptr<LineIndex> lineIndex;
+                FontRole fontRole = FontRole::Mono;
+                LRUCache<size_t, std::vector<std::shared_ptr<Glyph> > > lineCache;
+
+                struct SizeData
+                {
+                    std::optional<float> displayScale;
+                    int margin = 0;
+                    FontInfo fontInfo;
+                    FontMetrics fontMetrics;
+                    int maxLineWidth = 0;
+                };
+                SizeData size;
+
+                Box2I clipRect;
+
+                struct DrawData
+                {
+                    Box2I g;
+                };
+                std::optional<DrawData> draw;
+            };
 
             void TextWidget::_init(
                 const std::shared_ptr<Context>& context,
                 const std::shared_ptr<IWidget>& parent)
             {
                 IWidget::_init(context, "feather_tk::examples::textedit::TextWidget", parent);
+                FEATHER_TK_P();
+                p.lineCache.setMax(lineCacheMax);
             }
 
             TextWidget::TextWidget() :
@@ -37,6 +92,158 @@ namespace feather_tk
                 out->_init(context, parent);
                 return out;
             }
+
+            void TextWidget::setLineIndex(const std::shared_ptr<LineIndex>& value)
+            {
+                FEATHER_TK_P();
+                if (value == p.lineIndex)
+                    return;
+                p.lineIndex = value;
+                p.lineCache.clear();
+                p.size.displayScale.reset();
+                _setSizeUpdate();
+                _setDrawUpdate();
+            }
+
+            void TextWidget::setFontRole(FontRole value)
+            {
+                FEATHER_TK_P();
+                if (value == p.fontRole)
+                    return;
+                p.fontRole = value;
+                p.lineCache.clear();
+                p.size.displayScale.reset();
+                _setSizeUpdate();
+                _setDrawUpdate();
+            }
+
+            void TextWidget::setGeometry(const Box2I& value)
+            {
+                const bool changed = value != getGeometry();
+                IWidget::setGeometry(value);
+                FEATHER_TK_P();
+                if (changed)
+                {
+                    p.draw.reset();
+                }
+            }
+
+            void TextWidget::sizeHintEvent(const SizeHintEvent& event)
+            {
+                IWidget::sizeHintEvent(event);
+                FEATHER_TK_P();
+
+                if (!p.size.displayScale.has_value() ||
+                    (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+                {
+                    p.size.displayScale = event.displayScale;
+                    p.size.margin = event.style->getSizeRole(SizeRole::MarginInside, event.displayScale);
+                    p.size.fontInfo = event.style->getFontRole(p.fontRole, event.displayScale);
+                    p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
+                    p.size.maxLineWidth = 0;
+                    if (p.lineIndex && p.lineIndex->getLineCount() > 0)
+                    {
+                        // Only the longest line is measured, so that the
+                        // whole text does not need to be shaped.
+                        p.size.maxLineWidth = event.fontSystem->getSize(
+                            getLine(p.lineIndex, p.lineIndex->getMaxLine()),
+                            p.size.fontInfo).w;
+                    }
+                    p.lineCache.clear();
+                    p.draw.reset();
+                }
+
+                Size2I sizeHint;
+                if (p.lineIndex)
+                {
+                    // The height is limited to the range of an int. The
+                    // draw event scales the scroll position for text that
+                    // is taller.
+                    const int64_t lineCount = p.lineIndex->getLineCount();
+                    sizeHint.w = p.size.maxLineWidth;
+                    sizeHint.h = static_cast<int>(std::min(
+                        lineCount * p.size.fontMetrics.lineHeight,
+                        static_cast<int64_t>(std::numeric_limits<int>::max() / 2)));
+                }
+                sizeHint = margin(sizeHint, p.size.margin);
+                _setSizeHint(sizeHint);
+            }
+
+            void TextWidget::clipEvent(const Box2I& clipRect, bool clipped)
+            {
+                IWidget::clipEvent(clipRect, clipped);
+                FEATHER_TK_P();
+                p.clipRect = clipRect;
+                if (clipped)
+                {
+                    p.draw.reset();
+                }
+            }
+
+            void TextWidget::drawEvent(const Box2I& drawRect, const DrawEvent& event)
+            {
+                IWidget::drawEvent(drawRect, event);
+                FEATHER_TK_P();
+
+                if (!p.draw.has_value())
+                {
+                    p.draw = Private::DrawData();
+                    p.draw->g = margin(getGeometry(), -p.size.margin);
+                }
+
+                const int lineHeight = p.size.fontMetrics.lineHeight;
+                if (p.lineIndex && lineHeight > 0)
+                {
+                    // Find the position of the viewport in the text. The
+                    // positions are computed in 64-bit integers relative to
+                    // the top of the viewport, so they do not overflow for
+                    // large files.
+                    const Box2I& g = p.draw->g;
+                    const Box2I viewport = intersect(g, p.clipRect);
+                    const int64_t lineCount = p.lineIndex->getLineCount();
+                    const int64_t textHeight = lineCount * lineHeight;
+                    const int64_t scrollMax = std::max(
+                        static_cast<int64_t>(0),
+                        static_cast<int64_t>(g.h() - viewport.h()));
+                    const int64_t textScrollMax = std::max(
+                        static_cast<int64_t>(0),
+                        textHeight - viewport.h());
+                    int64_t textPos = viewport.min.y - g.min.y;
+                    if (scrollMax > 0 && textScrollMax > scrollMax)
+                    {
+                        textPos = static_cast<int64_t>(
+                            textPos * (textScrollMax / static_cast<double>(scrollMax)));
+                    }
+
+                    // Find the lines that intersect the draw rectangle.
+                    const Box2I rect = intersect(viewport, drawRect);
+                    const int64_t first = std::max(
+                        static_cast<int64_t>(0),
+                        (textPos + rect.min.y - viewport.min.y) / lineHeight);
+                    const int64_t last = std::min(
+                        lineCount - 1,
+                        (textPos + rect.max.y - viewport.min.y) / lineHeight);
+                    const Color4F color = event.style->getColorRole(isEnabled() ?
+                        ColorRole::Text :
+                        ColorRole::TextDisabled);
+                    for (int64_t line = first; line <= last; ++line)
+                    {
+                        std::vector<std::shared_ptr<Glyph> > glyphs;
+                        if (!p.lineCache.get(line, glyphs))
+                        {
+                            glyphs = event.fontSystem->getGlyphs(
+                                getLine(p.lineIndex, line),
+                                p.size.fontInfo);
+                            p.lineCache.add(line, glyphs);
+                        }
+                        event.render->drawText(
+                            glyphs,
+                            p.size.fontMetrics,
+                            V2I(g.min.x, viewport.min.y + static_cast<int>(line * lineHeight - textPos)),
+                            color);
+                    }
+                }
+            }
         }
     }
-}
+}
\ No newline at end of file
@@ -6,12 +6,19 @@
 
 #include <feather-tk/ui/IWidget.h>
 
+#include <feather-tk/core/LineIndex.h>
+
 namespace feather_tk
 {
     namespace examples
     {
         namespace textedit
         {
+            //! Text widget.
+            //!
+            //! Only the lines that intersect the viewport are shaped, and
+            //! the glyphs are cached per line. Long lines are truncated for
+            //! display.
             class TextWidget : public IWidget
             {
             protected:
@@ -28,9 +35,18 @@ namespace feather_tk
                     const std::shared_ptr<Context>&,
                     const std::shared_ptr<IWidget>& parent = nullptr);
 
+                void setLineIndex(const std::shared_ptr<LineIndex>&);
+
+                void setFontRole(FontRole);
+
+                void setGeometry(const Box2I&) override;
+                void sizeHintEvent(const SizeHintEvent&) override;
+                void clipEvent(const Box2I&, bool) override;
+                void drawEvent(const Box2I&, const DrawEvent&) override;
+
             private:
                 FEATHER_TK_PRIVATE();
             };
         }
     }
-}
+}
\ No newline at end of file
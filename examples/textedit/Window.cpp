@@ -59,9 +59,12 @@ namespace feather_tk
                     "FileClose",
                     Key::E,
                     static_cast<int>(KeyModifier::Control),
-                    [this]
+                    [appWeak]
                     {
-                        _textWidget->setText(std::string());
+                        if (auto app = appWeak.lock())
+                        {
+                            app->close();
+                        }
                     });
                 _menus["File"]->addAction(_actions["File/Close"]);
                 _menus["File"]->addDivider();
@@ -106,9 +109,7 @@ namespace feather_tk
                 menuBar->addMenu("File", _menus["File"]);
                 menuBar->addMenu("Edit", _menus["Edit"]);
 
-                _textWidget = Label::create(context);
-                _textWidget->setMarginRole(SizeRole::MarginInside);
-                _textWidget->setVAlign(VAlign::Top);
+                _textWidget = TextWidget::create(context);
                 auto scrollWidget = ScrollWidget::create(context, ScrollType::Both);
                 scrollWidget->setBorder(false);
                 scrollWidget->setVStretch(Stretch::Expanding);
@@ -128,11 +129,11 @@ namespace feather_tk
                         _textWidget->setFontRole(value);
                     });
 
-                _textObserver = ValueObserver<std::string>::create(
+                _textObserver = ValueObserver<std::shared_ptr<LineIndex> >::create(
                     app->observeText(),
-                    [this](const std::string& value)
+                    [this](const std::shared_ptr<LineIndex>& value)
                     {
-                        _textWidget->setText(value);
+                        _textWidget->setLineIndex(value);
                     });
             }
 
@@ -4,7 +4,8 @@
 
 #pragma once
 
-#include <feather-tk/ui/Label.h>
+#include "TextWidget.h"
+
 #include <feather-tk/ui/MainWindow.h>
 #include <feather-tk/ui/Menu.h>
 
@@ -39,9 +40,9 @@ namespace feather_tk
             private:
                 std::map<std::string, std::shared_ptr<Action> > _actions;
                 std::map<std::string, std::shared_ptr<Menu> > _menus;
-                std::shared_ptr<Label> _textWidget;
+                std::shared_ptr<TextWidget> _textWidget;
                 std::shared_ptr<ValueObserver<FontRole> > _fontObserver;
-                std::shared_ptr<ValueObserver<std::string> > _textObserver;
+                std::shared_ptr<ValueObserver<std::shared_ptr<LineIndex> > > _textObserver;
             };
         }
     }
@@ -4,16 +4,39 @@
 
 #include <feather-tk/core/Context.h>
 
+#include <feather-tk/core/DirSystem.h>
 #include <feather-tk/core/FontSystem.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/ImageIO.h>
 #include <feather-tk/core/OS.h>
+#include <feather-tk/core/ProfileSystem.h>
 #include <feather-tk/core/Timer.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace feather_tk
 {
+    struct Context::Wake
+    {
+        std::atomic<bool> woken = false;
+        std::mutex mutex;
+        std::function<void()> callback;
+
+        void wake()
+        {
+            woken = true;
+            std::unique_lock<std::mutex> lock(mutex);
+            if (callback)
+            {
+                callback();
+            }
+        }
+    };
+
     void Context::_init()
     {
+        _wake = std::make_shared<Wake>();
         _logSystem = LogSystem::create(shared_from_this());
         addSystem(_logSystem);
         const auto systemInfo = getSystemInfo();
@@ -31,6 +54,8 @@ namespace feather_tk
         addSystem(FontSystem::create(shared_from_this()));
         addSystem(ImageIO::create(shared_from_this()));
         addSystem(TimerSystem::create(shared_from_this()));
+        addSystem(DirSystem::create(shared_from_this()));
+        addSystem(ProfileSystem::create(shared_from_this()));
     }
 
     Context::~Context()
@@ -73,14 +98,35 @@ namespace feather_tk
         _logSystem->print(prefix, value, type);
     }
 
+    void Context::setWakeCallback(const std::function<void()>& value)
+    {
+        std::unique_lock<std::mutex> lock(_wake->mutex);
+        _wake->callback = value;
+    }
+
+    void Context::wake()
+    {
+        _wake->wake();
+    }
+
+    std::function<void()> Context::getWakeFunc() const
+    {
+        auto wake = _wake;
+        return [wake]
+        {
+            wake->wake();
+        };
+    }
+
     void Context::tick()
     {
+        const bool woken = _wake->woken.exchange(false);
         const auto now = std::chrono::steady_clock::now();
         for (auto& i : _systemTimes)
         {
             const auto tickTime = i.first->getTickTime();
             if (tickTime > std::chrono::milliseconds(0) &&
-                (i.second + i.first->getTickTime()) <= now)
+                (woken || (i.second + tickTime) <= now))
             {
                 i.first->tick();
                 i.second = now;
@@ -7,6 +7,7 @@
 #include <feather-tk/core/LogSystem.h>
 
 #include <chrono>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -54,6 +55,21 @@ namespace feather_tk
             const std::string&,
             LogType = LogType::Message);
 
+        //! Set the callback used to wake the application when it is
+        //! waiting for events. The callback may be called from any thread.
+        void setWakeCallback(const std::function<void()>&);
+
+        //! Wake the application, for example when a background thread has
+        //! results for a system. The systems are ticked on the next call to
+        //! tick() regardless of their tick times. This function is thread
+        //! safe.
+        void wake();
+
+        //! Get a function that wakes the application. The function is
+        //! thread safe and may outlive the context, so background threads
+        //! can use it without locking a reference to the context.
+        std::function<void()> getWakeFunc() const;
+
         //! Tick the context.
         void tick();
 
@@ -61,6 +77,8 @@ namespace feather_tk
         std::shared_ptr<LogSystem> _logSystem;
         std::list<std::shared_ptr<ISystem> > _systems;
         std::map<std::shared_ptr<ISystem>, std::chrono::steady_clock::time_point> _systemTimes;
+        struct Wake;
+        std::shared_ptr<Wake> _wake;
     };
 }
 
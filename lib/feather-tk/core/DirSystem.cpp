@@ -0,0 +1,567 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/DirSystem.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/LRUCache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace feather_tk
+{
+    bool DirEntry::operator == (const DirEntry& other) const
+    {
+        return
+            path == other.path &&
+            isDir == other.isDir &&
+            size == other.size &&
+            time == other.time;
+    }
+
+    bool DirEntry::operator != (const DirEntry& other) const
+    {
+        return !(*this == other);
+    }
+
+    namespace
+    {
+        const size_t batchSize = 1000;
+        const std::chrono::milliseconds batchTime(50);
+
+        std::string getKey(const std::filesystem::path& path)
+        {
+            return path.lexically_normal().u8string();
+        }
+    }
+
+    struct DirSystem::Private
+    {
+        std::function<void()> wake;
+        uint64_t id = 0;
+        std::map<uint64_t, DirScanCallback> callbacks;
+        std::shared_ptr<ObservableValue<std::filesystem::path> > changed;
+
+        struct Request
+        {
+            uint64_t id = 0;
+            std::filesystem::path path;
+        };
+
+        struct Result
+        {
+            uint64_t id = 0;
+            std::vector<DirEntry> entries;
+            bool complete = false;
+        };
+
+        struct Mutex
+        {
+            std::list<Request> requests;
+            uint64_t scanning = 0;
+            bool scanningCanceled = false;
+            std::list<Result> results;
+            std::list<std::filesystem::path> changed;
+            LRUCache<std::string, std::shared_ptr<std::vector<DirEntry> > > cache;
+            std::map<int, std::string> watches;
+            std::map<std::string, int> watchIds;
+            std::mutex mutex;
+        };
+        Mutex mutex;
+
+        struct Thread
+        {
+            int inotify = -1;
+            int wake = -1;
+            std::condition_variable cv;
+            std::thread thread;
+            std::atomic<bool> running;
+        };
+        Thread thread;
+
+        void notify();
+        void run();
+        void wait();
+        void scan(const Request&);
+        bool watch(const std::string&);
+        void unwatch(const std::string&);
+        void readWatcher();
+    };
+
+    DirSystem::DirSystem(const std::shared_ptr<Context>& context) :
+        ISystem(context, "feather_tk::DirSystem"),
+        _p(new Private)
+    {
+        FEATHER_TK_P();
+
+        p.wake = context->getWakeFunc();
+        p.changed = ObservableValue<std::filesystem::path>::create();
+
+        p.mutex.cache.setMax(100);
+        p.mutex.cache.setEvictCallback(
+            [this](const std::string& key, const std::shared_ptr<std::vector<DirEntry> >&)
+            {
+                // The mutex is already locked by the caller.
+                _p->unwatch(key);
+            });
+
+#if defined(__linux__)
+        // The thread blocks on the inotify file descriptor, and the event
+        // file descriptor wakes it up for new requests.
+        p.thread.inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (p.thread.inotify != -1)
+        {
+            p.thread.wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (-1 == p.thread.wake)
+            {
+                close(p.thread.inotify);
+                p.thread.inotify = -1;
+            }
+        }
+#endif // __linux__
+
+        p.thread.running = true;
+        p.thread.thread = std::thread(
+            [this]
+            {
+                _p->run();
+            });
+    }
+
+    DirSystem::~DirSystem()
+    {
+        FEATHER_TK_P();
+        p.thread.running = false;
+        p.notify();
+        if (p.thread.thread.joinable())
+        {
+            p.thread.thread.join();
+        }
+#if defined(__linux__)
+        if (p.thread.inotify != -1)
+        {
+            close(p.thread.inotify);
+            close(p.thread.wake);
+        }
+#endif // __linux__
+    }
+
+    std::shared_ptr<DirSystem> DirSystem::create(const std::shared_ptr<Context>& context)
+    {
+        return std::shared_ptr<DirSystem>(new DirSystem(context));
+    }
+
+    uint64_t DirSystem::scan(
+        const std::filesystem::path& path,
+        const DirScanCallback& callback)
+    {
+        FEATHER_TK_P();
+        const uint64_t id = ++p.id;
+        std::shared_ptr<std::vector<DirEntry> > entries;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            if (!p.mutex.cache.get(getKey(path), entries))
+            {
+                p.mutex.requests.push_back({ id, path });
+            }
+        }
+        if (entries)
+        {
+            if (callback)
+            {
+                callback(*entries, true);
+            }
+        }
+        else
+        {
+            p.callbacks[id] = callback;
+            p.notify();
+        }
+        return id;
+    }
+
+    void DirSystem::cancel(uint64_t id)
+    {
+        FEATHER_TK_P();
+        p.callbacks.erase(id);
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        auto i = std::find_if(
+            p.mutex.requests.begin(),
+            p.mutex.requests.end(),
+            [id](const Private::Request& value)
+            {
+                return id == value.id;
+            });
+        if (i != p.mutex.requests.end())
+        {
+            p.mutex.requests.erase(i);
+        }
+        else if (id == p.mutex.scanning)
+        {
+            p.mutex.scanningCanceled = true;
+        }
+    }
+
+    bool DirSystem::getCache(
+        const std::filesystem::path& path,
+        std::vector<DirEntry>& out)
+    {
+        FEATHER_TK_P();
+        std::shared_ptr<std::vector<DirEntry> > entries;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cache.get(getKey(path), entries);
+        }
+        if (entries)
+        {
+            out = *entries;
+        }
+        return entries != nullptr;
+    }
+
+    void DirSystem::invalidate(const std::filesystem::path& path)
+    {
+        FEATHER_TK_P();
+        const std::string key = getKey(path);
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        p.mutex.cache.remove(key);
+        p.unwatch(key);
+    }
+
+    void DirSystem::clearCache()
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        p.mutex.cache.clear();
+        while (!p.mutex.watchIds.empty())
+        {
+            p.unwatch(p.mutex.watchIds.begin()->first);
+        }
+    }
+
+    size_t DirSystem::getCacheMax() const
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        return p.mutex.cache.getMax();
+    }
+
+    void DirSystem::setCacheMax(size_t value)
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        p.mutex.cache.setMax(value);
+    }
+
+    bool DirSystem::hasWatcher() const
+    {
+        return _p->thread.inotify != -1;
+    }
+
+    std::shared_ptr<IObservableValue<std::filesystem::path> > DirSystem::observeChanged() const
+    {
+        return _p->changed;
+    }
+
+    void DirSystem::tick()
+    {
+        FEATHER_TK_P();
+        std::list<Private::Result> results;
+        std::list<std::filesystem::path> changed;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            std::swap(results, p.mutex.results);
+            std::swap(changed, p.mutex.changed);
+        }
+        for (const auto& result : results)
+        {
+            // Copy the callback since it may start or cancel scans.
+            const auto i = p.callbacks.find(result.id);
+            if (i != p.callbacks.end())
+            {
+                const DirScanCallback callback = i->second;
+                if (result.complete)
+                {
+                    p.callbacks.erase(i);
+                }
+                if (callback)
+                {
+                    callback(result.entries, result.complete);
+                }
+            }
+        }
+        for (const auto& path : changed)
+        {
+            p.changed->setAlways(path);
+        }
+    }
+
+    std::chrono::milliseconds DirSystem::getTickTime() const
+    {
+        return std::chrono::milliseconds(16);
+    }
+
+    void DirSystem::Private::notify()
+    {
+#if defined(__linux__)
+        if (thread.wake != -1)
+        {
+            const uint64_t value = 1;
+            const ssize_t size = write(thread.wake, &value, sizeof(value));
+            (void)size;
+            return;
+        }
+#endif // __linux__
+        {
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+        }
+        thread.cv.notify_one();
+    }
+
+    void DirSystem::Private::run()
+    {
+        while (thread.running)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                if (!mutex.requests.empty())
+                {
+                    request = mutex.requests.front();
+                    mutex.requests.pop_front();
+                    mutex.scanning = request.id;
+                    mutex.scanningCanceled = false;
+                }
+            }
+            if (request.id != 0)
+            {
+                scan(request);
+            }
+            else
+            {
+                wait();
+            }
+            readWatcher();
+        }
+    }
+
+    void DirSystem::Private::wait()
+    {
+#if defined(__linux__)
+        if (thread.inotify != -1)
+        {
+            // Block until there are changes on disk or the thread is
+            // woken up.
+            struct pollfd fds[2];
+            fds[0].fd = thread.inotify;
+            fds[0].events = POLLIN;
+            fds[1].fd = thread.wake;
+            fds[1].events = POLLIN;
+            if (poll(fds, 2, -1) > 0 && (fds[1].revents & POLLIN))
+            {
+                uint64_t value = 0;
+                const ssize_t size = read(thread.wake, &value, sizeof(value));
+                (void)size;
+            }
+            return;
+        }
+#endif // __linux__
+        std::unique_lock<std::mutex> lock(mutex.mutex);
+        thread.cv.wait(
+            lock,
+            [this]
+            {
+                return !mutex.requests.empty() || !thread.running;
+            });
+    }
+
+    void DirSystem::Private::scan(const Request& request)
+    {
+        // Watch the directory before it is read, so the files that are
+        // created or deleted during the scan are not missed.
+        const std::string key = getKey(request.path);
+        bool watched = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            watched = watch(key);
+        }
+
+        std::vector<DirEntry> entries;
+        std::vector<DirEntry> batch;
+        auto batchStart = std::chrono::steady_clock::now();
+        bool canceled = false;
+        std::error_code ec;
+        std::filesystem::directory_iterator i(request.path, ec);
+        for (; !ec && i != std::filesystem::directory_iterator() && !canceled; i.increment(ec))
+        {
+            // The directory iterator caches the file type from the
+            // directory listing where the platform provides it, so only
+            // the size and time require a stat.
+            const std::filesystem::directory_entry& entry = *i;
+            DirEntry dirEntry;
+            dirEntry.path = entry.path();
+            std::error_code entryEC;
+            dirEntry.isDir = entry.is_directory(entryEC);
+            if (!dirEntry.isDir)
+            {
+                const auto size = entry.file_size(entryEC);
+                dirEntry.size = !entryEC ? size : 0;
+            }
+            const auto time = entry.last_write_time(entryEC);
+            if (!entryEC)
+            {
+                dirEntry.time = time;
+            }
+            batch.push_back(dirEntry);
+
+            const auto now = std::chrono::steady_clock::now();
+            if (batch.size() >= batchSize || now - batchStart > batchTime)
+            {
+                entries.insert(entries.end(), batch.begin(), batch.end());
+                {
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    canceled = mutex.scanningCanceled || !thread.running;
+                    if (!canceled)
+                    {
+                        mutex.results.push_back({ request.id, batch, false });
+                    }
+                }
+                if (!canceled)
+                {
+                    wake();
+                }
+                batch.clear();
+                batchStart = now;
+
+                // Read the changes to other directories during long scans.
+                readWatcher();
+            }
+        }
+        // Read the changes that happened during the scan. If the directory
+        // changed its watch is removed and the observers are notified, so
+        // the entries are not cached. Directories that cannot be watched
+        // are always cached.
+        readWatcher();
+        if (!canceled)
+        {
+            entries.insert(entries.end(), batch.begin(), batch.end());
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                canceled = mutex.scanningCanceled;
+                if (!canceled)
+                {
+                    mutex.results.push_back({ request.id, batch, true });
+                }
+                if (!ec && (!watched || mutex.watchIds.find(key) != mutex.watchIds.end()))
+                {
+                    mutex.cache.add(
+                        key,
+                        std::make_shared<std::vector<DirEntry> >(std::move(entries)));
+                }
+            }
+            if (!canceled)
+            {
+                wake();
+            }
+        }
+        std::unique_lock<std::mutex> lock(mutex.mutex);
+        if (!mutex.cache.contains(key))
+        {
+            unwatch(key);
+        }
+        mutex.scanning = 0;
+    }
+
+    bool DirSystem::Private::watch(const std::string& key)
+    {
+        bool out = mutex.watchIds.find(key) != mutex.watchIds.end();
+#if defined(__linux__)
+        if (thread.inotify != -1 && !out)
+        {
+            const int wd = inotify_add_watch(
+                thread.inotify,
+                key.c_str(),
+                IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB |
+                IN_MOVED_FROM | IN_MOVED_TO |
+                IN_DELETE_SELF | IN_MOVE_SELF);
+            if (wd != -1)
+            {
+                mutex.watches[wd] = key;
+                mutex.watchIds[key] = wd;
+                out = true;
+            }
+        }
+#endif // __linux__
+        return out;
+    }
+
+    void DirSystem::Private::unwatch(const std::string& key)
+    {
+        const auto i = mutex.watchIds.find(key);
+        if (i != mutex.watchIds.end())
+        {
+#if defined(__linux__)
+            inotify_rm_watch(thread.inotify, i->second);
+#endif // __linux__
+            mutex.watches.erase(i->second);
+            mutex.watchIds.erase(i);
+        }
+    }
+
+    void DirSystem::Private::readWatcher()
+    {
+#if defined(__linux__)
+        if (-1 == thread.inotify)
+            return;
+        std::set<int> wds;
+        alignas(struct inotify_event) char buf[4096];
+        ssize_t size = 0;
+        while ((size = read(thread.inotify, buf, sizeof(buf))) > 0)
+        {
+            for (char* p = buf; p < buf + size;)
+            {
+                const struct inotify_event* event =
+                    reinterpret_cast<const struct inotify_event*>(p);
+                wds.insert(event->wd);
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        bool changed = false;
+        if (!wds.empty())
+        {
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            for (int wd : wds)
+            {
+                const auto i = mutex.watches.find(wd);
+                if (i != mutex.watches.end())
+                {
+                    const std::string key = i->second;
+                    mutex.cache.remove(key);
+                    unwatch(key);
+                    mutex.changed.push_back(std::filesystem::u8path(key));
+                    changed = true;
+                }
+            }
+        }
+        if (changed)
+        {
+            wake();
+        }
+#endif // __linux__
+    }
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/ISystem.h>
+#include <feather-tk/core/ObservableValue.h>
+
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace feather_tk
+{
+    //! \name Files
+    ///@{
+
+    //! Directory entry.
+    struct DirEntry
+    {
+        std::filesystem::path           path;
+        bool                            isDir = false;
+        size_t                          size  = 0;
+        std::filesystem::file_time_type time;
+
+        bool operator == (const DirEntry&) const;
+        bool operator != (const DirEntry&) const;
+    };
+
+    //! Directory scan callback. The entries are passed in batches as they
+    //! are read, the last batch is marked complete.
+    typedef std::function<void(const std::vector<DirEntry>&, bool complete)> DirScanCallback;
+
+    //! Directory system.
+    //!
+    //! Directories are scanned by a background thread and the entries are
+    //! passed to the callbacks in batches from tick(), so that large or
+    //! slow directories do not block the user interface.
+    //!
+    //! The directory listings are cached. On Linux the cached directories
+    //! are watched with inotify, and they are removed from the cache when
+    //! they change on disk.
+    class DirSystem : public ISystem
+    {
+    protected:
+        DirSystem(const std::shared_ptr<Context>&);
+
+    public:
+        virtual ~DirSystem();
+
+        //! Create a new system.
+        static std::shared_ptr<DirSystem> create(const std::shared_ptr<Context>&);
+
+        //! Scan a directory. If the directory is cached the callback is
+        //! called immediately with all of the entries. Returns the
+        //! request ID.
+        uint64_t scan(const std::filesystem::path&, const DirScanCallback&);
+
+        //! Cancel a scan.
+        void cancel(uint64_t);
+
+        //! Get a cached directory listing. Returns false if the directory
+        //! is not cached.
+        bool getCache(const std::filesystem::path&, std::vector<DirEntry>&);
+
+        //! Remove a directory from the cache.
+        void invalidate(const std::filesystem::path&);
+
+        //! Clear the cache.
+        void clearCache();
+
+        //! Get the maximum number of cached directories.
+        size_t getCacheMax() const;
+
+        //! Set the maximum number of cached directories.
+        void setCacheMax(size_t);
+
+        //! Get whether directories are watched for changes.
+        bool hasWatcher() const;
+
+        //! Observe directories that have changed on disk.
+        std::shared_ptr<IObservableValue<std::filesystem::path> > observeChanged() const;
+
+        void tick() override;
+        std::chrono::milliseconds getTickTime() const override;
+
+    private:
+        FEATHER_TK_PRIVATE();
+    };
+
+    ///@}
+}
\ No newline at end of file
@@ -14,10 +14,17 @@
 #include FT_GLYPH_H
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <codecvt>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <locale>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 namespace feather_tk_resource
 {
@@ -36,24 +43,114 @@ namespace feather_tk
 #else // _WINDOWS
         typedef char32_t feather_tk_char_t;
 #endif // _WINDOWS
+
+        std::basic_string<feather_tk_char_t> toUtf32(const std::string& value)
+        {
+            thread_local std::wstring_convert<std::codecvt_utf8<feather_tk_char_t>, feather_tk_char_t> convert;
+            return convert.from_bytes(value);
+        }
+
+        const size_t glyphCacheShardCount = 16;
+        const size_t glyphCacheMax = 10000;
+        const size_t layoutCacheByteCount = 16 * 1024 * 1024;
+        const size_t layoutByteCountMax = layoutCacheByteCount / 64;
+        const size_t prefetchThreadCount = 4;
+        const size_t facePoolMax = 8;
     }
 
     struct FontSystem::Private
     {
+        //! FreeType faces can only be used by one thread at a time, so
+        //! faces are checked out of a pool and returned to it when they
+        //! are released.
+        struct Face
+        {
+            std::shared_ptr<std::vector<uint8_t> > data;
+            FT_Face ftFace = nullptr;
+            int size = 0;
+        };
+        std::shared_ptr<Face> getFace(const std::string& family, int size);
+        void releaseFace(const std::string& family, Face*);
+
         std::shared_ptr<Glyph> getGlyph(uint32_t code, const FontInfo&);
-        void measure(
+        std::shared_ptr<TextLayout> getLayout(
+            const std::string&,
+            const FontInfo&,
+            int maxLineWidth);
+        void layout(
             const std::basic_string<feather_tk_char_t>& utf32,
             const FontInfo&,
             int maxLineWidth,
-            Size2I&,
-            std::vector<Box2I>* = nullptr);
+            TextLayout&);
 
-        std::map<std::string, std::vector<uint8_t> > fontData;
-        FT_Library ftLibrary = nullptr;
-        std::map<std::string, FT_Face> ftFaces;
-        std::wstring_convert<std::codecvt_utf8<feather_tk_char_t>, feather_tk_char_t> utf32Convert;
         ImageType imageType = ImageType::L_U8;
-        LRUCache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
+
+        struct FaceMutex
+        {
+            std::map<std::string, std::shared_ptr<std::vector<uint8_t> > > fontData;
+            FT_Library ftLibrary = nullptr;
+            std::map<std::string, std::vector<std::unique_ptr<Face> > > faces;
+            std::mutex mutex;
+        };
+        FaceMutex faceMutex;
+
+        //! The glyph cache is split into shards by the glyph hash to
+        //! reduce lock contention between threads.
+        struct GlyphCacheShard
+        {
+            LRUCache<GlyphInfo, std::shared_ptr<Glyph> > cache;
+            std::mutex mutex;
+        };
+        std::array<GlyphCacheShard, glyphCacheShardCount> glyphCache;
+        GlyphCacheShard& getGlyphCacheShard(const GlyphInfo&);
+
+        struct LayoutKey
+        {
+            std::string text;
+            FontInfo fontInfo;
+            int maxLineWidth = 0;
+
+            bool operator == (const LayoutKey& other) const
+            {
+                return
+                    text == other.text &&
+                    fontInfo == other.fontInfo &&
+                    maxLineWidth == other.maxLineWidth;
+            }
+        };
+        struct LayoutKeyHash
+        {
+            std::size_t operator() (const LayoutKey& value) const noexcept
+            {
+                std::size_t out = 0;
+                hashCombine(out, value.text);
+                hashCombine(out, value.fontInfo);
+                hashCombine(out, value.maxLineWidth);
+                return out;
+            }
+        };
+        struct LayoutCacheMutex
+        {
+            LRUCache<LayoutKey, std::shared_ptr<TextLayout>, LayoutKeyHash> cache;
+            std::mutex mutex;
+        };
+        LayoutCacheMutex layoutCache;
+
+        struct PrefetchMutex
+        {
+            std::list<GlyphInfo> glyphs;
+            std::unordered_set<GlyphInfo> pending;
+            std::mutex mutex;
+        };
+        PrefetchMutex prefetchMutex;
+
+        struct PrefetchThread
+        {
+            std::condition_variable cv;
+            std::vector<std::thread> threads;
+            std::atomic<bool> running;
+        };
+        PrefetchThread prefetchThread;
     };
 
     FontSystem::FontSystem(const std::shared_ptr<Context>& context) :
@@ -62,35 +159,31 @@ namespace feather_tk
     {
         FEATHER_TK_P();
 
-        p.fontData["NotoSans-Bold"] = feather_tk_resource::NotoSansBold;
-        p.fontData["NotoSansMono-Regular"] = feather_tk_resource::NotoSansMonoRegular;
-        p.fontData["NotoSans-Regular"] = feather_tk_resource::NotoSansRegular;
+        p.faceMutex.fontData["NotoSans-Bold"] =
+            std::make_shared<std::vector<uint8_t> >(feather_tk_resource::NotoSansBold);
+        p.faceMutex.fontData["NotoSansMono-Regular"] =
+            std::make_shared<std::vector<uint8_t> >(feather_tk_resource::NotoSansMonoRegular);
+        p.faceMutex.fontData["NotoSans-Regular"] =
+            std::make_shared<std::vector<uint8_t> >(feather_tk_resource::NotoSansRegular);
 
 #if defined(FEATHER_TK_API_GLES_2)
         //! \bug Some GLES 2 implementations (Pi Zero W) only support RGBA?
         p.imageType = ImageType::RGBA_U8;
 #endif // FEATHER_TK_API_GLES_2
+
+        for (auto& shard : p.glyphCache)
+        {
+            shard.cache.setMax(glyphCacheMax / glyphCacheShardCount);
+        }
+        p.layoutCache.cache.setMax(layoutCacheByteCount);
+
         try
         {
-            FT_Error ftError = FT_Init_FreeType(&p.ftLibrary);
+            FT_Error ftError = FT_Init_FreeType(&p.faceMutex.ftLibrary);
             if (ftError)
             {
                 throw std::runtime_error("FreeType cannot be initialized");
             }
-
-            for (const auto& i : p.fontData)
-            {
-                ftError = FT_New_Memory_Face(
-                    p.ftLibrary,
-                    i.second.data(),
-                    i.second.size(),
-                    0,
-                    &p.ftFaces[i.first]);
-                if (ftError)
-                {
-                    throw std::runtime_error(Format("Cannot create font: \"{0}\"").arg(i.first));
-                }
-            }
         }
         catch (const std::exception& e)
         {
@@ -100,18 +193,34 @@ namespace feather_tk
                 logSystem->print("feather_tk::FontSystem", e.what(), LogType::Error);
             }
         }
+        p.prefetchThread.running = false;
     }
 
     FontSystem::~FontSystem()
     {
         FEATHER_TK_P();
-        if (p.ftLibrary)
         {
-            for (const auto& i : p.ftFaces)
+            std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+            p.prefetchThread.running = false;
+        }
+        p.prefetchThread.cv.notify_all();
+        for (auto& thread : p.prefetchThread.threads)
+        {
+            if (thread.joinable())
             {
-                FT_Done_Face(i.second);
+                thread.join();
             }
-            FT_Done_FreeType(p.ftLibrary);
+        }
+        if (p.faceMutex.ftLibrary)
+        {
+            for (const auto& i : p.faceMutex.faces)
+            {
+                for (const auto& face : i.second)
+                {
+                    FT_Done_Face(face->ftFace);
+                }
+            }
+            FT_Done_FreeType(p.faceMutex.ftLibrary);
         }
     }
 
@@ -123,56 +232,114 @@ namespace feather_tk
     void FontSystem::addFont(const std::string& name, const uint8_t* data, size_t size)
     {
         FEATHER_TK_P();
-        p.fontData[name] = std::vector<uint8_t>(size);
-        memcpy(p.fontData[name].data(), data, size);
+        std::unique_lock<std::mutex> lock(p.faceMutex.mutex);
+        if (!p.faceMutex.ftLibrary)
+        {
+            throw std::runtime_error(Format("Cannot create font: \"{0}\"").arg(name));
+        }
+        FT_Face ftFace = nullptr;
         FT_Error ftError = FT_New_Memory_Face(
-            p.ftLibrary,
-            p.fontData[name].data(),
+            p.faceMutex.ftLibrary,
+            data,
             size,
             0,
-            &p.ftFaces[name]);
+            &ftFace);
         if (ftError)
         {
             throw std::runtime_error(Format("Cannot create font: \"{0}\"").arg(name));
         }
+        FT_Done_Face(ftFace);
+        p.faceMutex.fontData[name] = std::make_shared<std::vector<uint8_t> >(data, data + size);
+        lock.unlock();
+
+        // Remove any glyphs and layouts for the family. They were either
+        // created with the previous font, or are empty because they were
+        // requested before the font was added.
+        for (auto& shard : p.glyphCache)
+        {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            for (const auto& key : shard.cache.getKeys())
+            {
+                if (name == key.fontInfo.family)
+                {
+                    shard.cache.remove(key);
+                }
+            }
+        }
+        std::unique_lock<std::mutex> layoutLock(p.layoutCache.mutex);
+        for (const auto& key : p.layoutCache.cache.getKeys())
+        {
+            if (name == key.fontInfo.family)
+            {
+                p.layoutCache.cache.remove(key);
+            }
+        }
     }
 
     size_t FontSystem::getGlyphCacheSize() const
     {
-        return _p->glyphCache.getSize();
+        FEATHER_TK_P();
+        size_t out = 0;
+        for (auto& shard : p.glyphCache)
+        {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            out += shard.cache.getSize();
+        }
+        return out;
     }
 
     float FontSystem::getGlyphCachePercentage() const
     {
-        return _p->glyphCache.getPercentage();
+        FEATHER_TK_P();
+        size_t size = 0;
+        size_t max = 0;
+        for (auto& shard : p.glyphCache)
+        {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            size += shard.cache.getSize();
+            max += shard.cache.getMax();
+        }
+        return max > 0 ? (size / static_cast<float>(max) * 100.F) : 0.F;
     }
 
-    FontMetrics FontSystem::getMetrics(const FontInfo& info)
+    size_t FontSystem::getLayoutCacheSize() const
     {
         FEATHER_TK_P();
-        FontMetrics out;
-        const auto ftFaceIt = p.ftFaces.find(info.family);
-        if (ftFaceIt != p.ftFaces.end())
+        std::unique_lock<std::mutex> lock(p.layoutCache.mutex);
+        return p.layoutCache.cache.getCount();
+    }
+
+    size_t FontSystem::getLayoutCacheByteCount() const
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.layoutCache.mutex);
+        return p.layoutCache.cache.getSize();
+    }
+
+    size_t FontSystem::getFacePoolSize() const
+    {
+        FEATHER_TK_P();
+        size_t out = 0;
+        std::unique_lock<std::mutex> lock(p.faceMutex.mutex);
+        for (const auto& i : p.faceMutex.faces)
         {
-            FT_Error ftError = FT_Set_Pixel_Sizes(ftFaceIt->second, 0, info.size);
-            out.ascender = ftFaceIt->second->size->metrics.ascender / 64;
-            out.descender = ftFaceIt->second->size->metrics.descender / 64;
-            out.lineHeight = ftFaceIt->second->size->metrics.height / 64;
+            out += i.second.size();
         }
         return out;
     }
 
-    Size2I FontSystem::getSize(
-        const std::string& text,
-        const FontInfo& fontInfo,
-        int maxLineWidth)
+    FontMetrics FontSystem::getMetrics(const FontInfo& info)
     {
         FEATHER_TK_P();
-        Size2I out;
+        FontMetrics out;
         try
         {
-            const auto utf32 = p.utf32Convert.from_bytes(text);
-            p.measure(utf32, fontInfo, maxLineWidth, out);
+            if (auto face = p.getFace(info.family, info.size))
+            {
+                out.ascender = face->ftFace->size->metrics.ascender / 64;
+                out.descender = face->ftFace->size->metrics.descender / 64;
+                out.lineHeight = face->ftFace->size->metrics.height / 64;
+            }
         }
         catch (const std::exception&)
         {
@@ -180,68 +347,240 @@ namespace feather_tk
         return out;
     }
 
+    Size2I FontSystem::getSize(
+        const std::string& text,
+        const FontInfo& fontInfo,
+        int maxLineWidth)
+    {
+        return _p->getLayout(text, fontInfo, maxLineWidth)->size;
+    }
+
     std::vector<Box2I> FontSystem::getBox(
         const std::string& text,
         const FontInfo& fontInfo,
         int maxLineWidth)
+    {
+        return _p->getLayout(text, fontInfo, maxLineWidth)->boxes;
+    }
+
+    std::shared_ptr<TextLayout> FontSystem::getLayout(
+        const std::string& text,
+        const FontInfo& fontInfo,
+        int maxLineWidth)
+    {
+        return _p->getLayout(text, fontInfo, maxLineWidth);
+    }
+
+    std::vector<std::shared_ptr<Glyph> > FontSystem::getGlyphs(
+        const std::string& text,
+        const FontInfo& fontInfo)
+    {
+        return _p->getLayout(text, fontInfo, 0)->glyphs;
+    }
+
+    void FontSystem::prefetchGlyphs(
+        const std::string& text,
+        const FontInfo& fontInfo)
     {
         FEATHER_TK_P();
-        std::vector<Box2I> out;
+        std::basic_string<feather_tk_char_t> utf32;
         try
         {
-            const auto utf32 = p.utf32Convert.from_bytes(text);
-            Size2I size;
-            p.measure(utf32, fontInfo, maxLineWidth, size, &out);
+            utf32 = toUtf32(text);
         }
         catch (const std::exception&)
         {
         }
-        return out;
+        bool notify = false;
+        {
+            std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+            for (const auto& i : utf32)
+            {
+                const GlyphInfo glyphInfo(i, fontInfo);
+                bool cached = false;
+                {
+                    auto& shard = p.getGlyphCacheShard(glyphInfo);
+                    std::unique_lock<std::mutex> lock(shard.mutex);
+                    cached = shard.cache.contains(glyphInfo);
+                }
+                if (!cached && p.prefetchMutex.pending.insert(glyphInfo).second)
+                {
+                    p.prefetchMutex.glyphs.push_back(glyphInfo);
+                    notify = true;
+                }
+            }
+            if (notify && p.prefetchThread.threads.empty())
+            {
+                p.prefetchThread.running = true;
+                const size_t threadCount = std::max(1U, std::min(
+                    static_cast<unsigned>(prefetchThreadCount),
+                    std::thread::hardware_concurrency()));
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.prefetchThread.threads.push_back(std::thread(
+                        [this]
+                        {
+                            FEATHER_TK_P();
+                            while (p.prefetchThread.running)
+                            {
+                                GlyphInfo glyphInfo;
+                                bool valid = false;
+                                {
+                                    std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+                                    p.prefetchThread.cv.wait(
+                                        lock,
+                                        [this]
+                                        {
+                                            return
+                                                !_p->prefetchMutex.glyphs.empty() ||
+                                                !_p->prefetchThread.running;
+                                        });
+                                    if (!p.prefetchMutex.glyphs.empty())
+                                    {
+                                        glyphInfo = p.prefetchMutex.glyphs.front();
+                                        p.prefetchMutex.glyphs.pop_front();
+                                        valid = true;
+                                    }
+                                }
+                                if (valid)
+                                {
+                                    try
+                                    {
+                                        p.getGlyph(glyphInfo.code, glyphInfo.fontInfo);
+                                    }
+                                    catch (const std::exception&)
+                                    {
+                                    }
+                                    std::unique_lock<std::mutex> lock(p.prefetchMutex.mutex);
+                                    p.prefetchMutex.pending.erase(glyphInfo);
+                                }
+                            }
+                        }));
+                }
+            }
+        }
+        if (notify)
+        {
+            p.prefetchThread.cv.notify_all();
+        }
     }
 
-    std::vector<std::shared_ptr<Glyph> > FontSystem::getGlyphs(
-        const std::string& text,
-        const FontInfo& fontInfo)
+    std::shared_ptr<FontSystem::Private::Face> FontSystem::Private::getFace(const std::string& family, int size)
     {
-        FEATHER_TK_P();
-        std::vector<std::shared_ptr<Glyph> > out;
-        try
+        std::unique_ptr<Face> face;
         {
-            const auto utf32 = p.utf32Convert.from_bytes(text);
-            for (const auto& i : utf32)
+            std::unique_lock<std::mutex> lock(faceMutex.mutex);
+            const auto dataIt = faceMutex.fontData.find(family);
+            if (!faceMutex.ftLibrary || dataIt == faceMutex.fontData.end())
             {
-                out.push_back(p.getGlyph(i, fontInfo));
+                return nullptr;
+            }
+
+            // Check out an idle face, preferring one that already has the
+            // requested size. Faces for replaced font data are released.
+            auto& pool = faceMutex.faces[family];
+            auto i = std::find_if(
+                pool.begin(),
+                pool.end(),
+                [size](const std::unique_ptr<Face>& value)
+                {
+                    return size == value->size;
+                });
+            if (i == pool.end() && !pool.empty())
+            {
+                i = pool.end() - 1;
+            }
+            if (i != pool.end())
+            {
+                face = std::move(*i);
+                pool.erase(i);
+                if (face->data != dataIt->second)
+                {
+                    FT_Done_Face(face->ftFace);
+                    face.reset();
+                }
+            }
+
+            if (!face)
+            {
+                face.reset(new Face);
+                FT_Error ftError = FT_New_Memory_Face(
+                    faceMutex.ftLibrary,
+                    dataIt->second->data(),
+                    dataIt->second->size(),
+                    0,
+                    &face->ftFace);
+                if (ftError)
+                {
+                    throw std::runtime_error(Format("Cannot create font: \"{0}\"").arg(family));
+                }
+                face->data = dataIt->second;
             }
         }
-        catch (const std::exception&)
+        std::shared_ptr<Face> out(
+            face.release(),
+            [this, family](Face* value)
+            {
+                releaseFace(family, value);
+            });
+        if (size != out->size)
         {
+            out->size = 0;
+            FT_Error ftError = FT_Set_Pixel_Sizes(out->ftFace, 0, size);
+            if (ftError)
+            {
+                throw std::runtime_error(
+                    Format("Cannot set pixel sizes: \"{0}\"").arg(family));
+            }
+            out->size = size;
         }
         return out;
     }
 
+    void FontSystem::Private::releaseFace(const std::string& family, Face* value)
+    {
+        std::unique_ptr<Face> face(value);
+        std::unique_lock<std::mutex> lock(faceMutex.mutex);
+        const auto dataIt = faceMutex.fontData.find(family);
+        auto& pool = faceMutex.faces[family];
+        if (dataIt != faceMutex.fontData.end() &&
+            face->data == dataIt->second &&
+            pool.size() < facePoolMax)
+        {
+            pool.push_back(std::move(face));
+        }
+        else
+        {
+            FT_Done_Face(face->ftFace);
+        }
+    }
+
+    FontSystem::Private::GlyphCacheShard& FontSystem::Private::getGlyphCacheShard(const GlyphInfo& info)
+    {
+        return glyphCache[std::hash<GlyphInfo>()(info) % glyphCacheShardCount];
+    }
+
     std::shared_ptr<Glyph> FontSystem::Private::getGlyph(uint32_t code, const FontInfo& fontInfo)
     {
+        const GlyphInfo glyphInfo(code, fontInfo);
+        auto& shard = getGlyphCacheShard(glyphInfo);
         std::shared_ptr<Glyph> out;
-        if (!glyphCache.get(GlyphInfo(code, fontInfo), out))
+        bool cached = false;
+        {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            cached = shard.cache.get(glyphInfo, out);
+        }
+        if (!cached)
         {
             out = std::make_shared<Glyph>();
-            out->info = GlyphInfo(code, fontInfo);
+            out->info = glyphInfo;
 
-            const auto ftFaceIt = ftFaces.find(fontInfo.family);
-            if (ftFaceIt != ftFaces.end())
+            if (auto face = getFace(fontInfo.family, fontInfo.size))
             {
-                FT_Error ftError = FT_Set_Pixel_Sizes(
-                    ftFaceIt->second,
-                    0,
-                    static_cast<int>(fontInfo.size));
-                if (ftError)
+                const FT_Face ftFace = face->ftFace;
+                if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, code))
                 {
-                    throw std::runtime_error(
-                        Format("Cannot set pixel sizes: \"{0}\"").arg(fontInfo.family));
-                }
-                if (auto ftGlyphIndex = FT_Get_Char_Index(ftFaceIt->second, code))
-                {
-                    ftError = FT_Load_Glyph(ftFaceIt->second, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
+                    FT_Error ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
                     if (ftError)
                     {
                         throw std::runtime_error(
@@ -249,14 +588,14 @@ namespace feather_tk
                     }
                     FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
                     uint8_t renderModeChannels = 1;
-                    ftError = FT_Render_Glyph(ftFaceIt->second->glyph, renderMode);
+                    ftError = FT_Render_Glyph(ftFace->glyph, renderMode);
                     if (ftError)
                     {
                         throw std::runtime_error(
                             Format("Cannot render glyph: \"{0}\"").arg(fontInfo.family));
                     }
 
-                    auto ftBitmap = ftFaceIt->second->glyph->bitmap;
+                    auto ftBitmap = ftFace->glyph->bitmap;
                     const ImageInfo imageInfo(ftBitmap.width, ftBitmap.rows, imageType);
                     out->image = Image::create(imageInfo);
                     for (size_t y = 0; y < ftBitmap.rows; ++y)
@@ -296,14 +635,15 @@ namespace feather_tk
                         default: break;
                         }
                     }
-                    out->offset = V2I(ftFaceIt->second->glyph->bitmap_left, ftFaceIt->second->glyph->bitmap_top);
-                    out->advance = ftFaceIt->second->glyph->advance.x / 64;
-                    out->lsbDelta = ftFaceIt->second->glyph->lsb_delta;
-                    out->rsbDelta = ftFaceIt->second->glyph->rsb_delta;
+                    out->offset = V2I(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
+                    out->advance = ftFace->glyph->advance.x / 64;
+                    out->lsbDelta = ftFace->glyph->lsb_delta;
+                    out->rsbDelta = ftFace->glyph->rsb_delta;
                 }
             }
 
-            glyphCache.add(out->info, out);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            shard.cache.add(out->info, out);
         }
         return out;
     }
@@ -316,52 +656,73 @@ namespace feather_tk
         }
     }
 
-    void FontSystem::Private::measure(
-        const std::basic_string<feather_tk_char_t>& utf32,
+    std::shared_ptr<TextLayout> FontSystem::Private::getLayout(
+        const std::string& text,
         const FontInfo& fontInfo,
-        int maxLineWidth,
-        Size2I& size,
-        std::vector<Box2I>* glyphGeom)
+        int maxLineWidth)
     {
-        const auto ftFaceIt = ftFaces.find(fontInfo.family);
-        if (ftFaceIt != ftFaces.end())
+        LayoutKey key;
+        key.text = text;
+        key.fontInfo = fontInfo;
+        key.maxLineWidth = maxLineWidth;
+        std::shared_ptr<TextLayout> out;
         {
-            V2I pos;
-            FT_Error ftError = FT_Set_Pixel_Sizes(
-                ftFaceIt->second,
-                0,
-                static_cast<int>(fontInfo.size));
-            if (ftError)
+            std::unique_lock<std::mutex> lock(layoutCache.mutex);
+            if (layoutCache.cache.get(key, out))
             {
-                throw std::runtime_error(
-                    Format("Cannot set pixel sizes: \"{0}\"").arg(fontInfo.family));
+                return out;
             }
+        }
+        out = std::make_shared<TextLayout>();
+        try
+        {
+            layout(toUtf32(text), fontInfo, maxLineWidth, *out);
+        }
+        catch (const std::exception&)
+        {
+            // Don't cache failed layouts.
+            return std::make_shared<TextLayout>();
+        }
+
+        // The cache is charged by the memory used by the text and the
+        // layout. Very large layouts are not cached so they do not evict
+        // everything else.
+        const size_t byteCount =
+            sizeof(LayoutKey) + text.size() +
+            sizeof(TextLayout) +
+            out->glyphs.size() * sizeof(std::shared_ptr<Glyph>) +
+            out->boxes.size() * sizeof(Box2I) +
+            out->lines.size() * sizeof(size_t);
+        if (byteCount <= layoutByteCountMax)
+        {
+            std::unique_lock<std::mutex> lock(layoutCache.mutex);
+            layoutCache.cache.add(key, out, byteCount);
+        }
+        return out;
+    }
 
-            const int h = ftFaceIt->second->size->metrics.height / 64;
+    void FontSystem::Private::layout(
+        const std::basic_string<feather_tk_char_t>& utf32,
+        const FontInfo& fontInfo,
+        int maxLineWidth,
+        TextLayout& out)
+    {
+        if (auto face = getFace(fontInfo.family, fontInfo.size))
+        {
+            out.glyphs.reserve(utf32.size());
+            out.boxes.reserve(utf32.size());
+            out.lines.push_back(0);
+            V2I pos;
+            const int h = face->ftFace->size->metrics.height / 64;
             pos.y = h;
-            auto textLine = utf32.end();
+            size_t textLine = utf32.size();
             int textLineX = 0;
             int32_t rsbDeltaPrev = 0;
-            for (auto utf32It = utf32.begin(); utf32It != utf32.end(); ++utf32It)
+            for (size_t i = 0; i < utf32.size(); ++i)
             {
-                const auto glyph = getGlyph(*utf32It, fontInfo);
-
-                if (glyphGeom)
-                {
-                    Box2I box;
-                    if (glyph)
-                    {
-                        box = Box2I(
-                            pos.x,
-                            pos.y - h,
-                            glyph->advance,
-                            h);
-                    }
-                    glyphGeom->push_back(box);
-                }
+                const auto glyph = getGlyph(utf32[i], fontInfo);
 
                 int32_t x = 0;
-                V2I posAndSize;
                 if (glyph)
                 {
                     x = glyph->advance;
@@ -380,51 +741,65 @@ namespace feather_tk
                     rsbDeltaPrev = 0;
                 }
 
-                if ('\n' == *utf32It)
+                if ('\n' == utf32[i])
                 {
-                    size.w = std::max(size.w, pos.x);
+                    out.glyphs.push_back(glyph);
+                    out.boxes.push_back(Box2I(pos.x, pos.y - h, glyph ? glyph->advance : 0, h));
+                    out.size.w = std::max(out.size.w, pos.x);
                     pos.x = 0;
                     pos.y += h;
                     rsbDeltaPrev = 0;
-                    auto crIt = utf32It + 1;
-                    if (crIt != utf32.end() && '\r' == *crIt)
+                    if (i + 1 < utf32.size() && '\r' == utf32[i + 1])
                     {
-                        ++utf32It;
+                        ++i;
+                        out.glyphs.push_back(getGlyph(utf32[i], fontInfo));
+                        out.boxes.push_back(Box2I(pos.x, pos.y - h, 0, h));
                     }
+                    textLine = utf32.size();
+                    out.lines.push_back(out.glyphs.size());
                 }
                 else if (
                     maxLineWidth > 0 &&
                     pos.x > 0 &&
-                    pos.x + (!isSpace(*utf32It) ? x : 0) >= maxLineWidth)
+                    pos.x + (!isSpace(utf32[i]) ? x : 0) >= maxLineWidth)
                 {
-                    if (textLine != utf32.end())
+                    if (textLine != utf32.size())
                     {
-                        utf32It = textLine;
-                        textLine = utf32.end();
-                        size.w = std::max(size.w, textLineX);
+                        // Wrap the line at the last space, and lay out the
+                        // characters following it again on the next line.
+                        i = textLine;
+                        textLine = utf32.size();
+                        out.glyphs.resize(i + 1);
+                        out.boxes.resize(i + 1);
+                        out.lines.push_back(i + 1);
+                        out.size.w = std::max(out.size.w, textLineX);
                         pos.x = 0;
-                        pos.y += h;
                     }
                     else
                     {
-                        size.w = std::max(size.w, pos.x);
+                        out.size.w = std::max(out.size.w, pos.x);
+                        out.lines.push_back(out.glyphs.size());
+                        out.glyphs.push_back(glyph);
+                        out.boxes.push_back(Box2I(0, pos.y, glyph ? glyph->advance : 0, h));
                         pos.x = x;
-                        pos.y += h;
                     }
+                    pos.y += h;
                     rsbDeltaPrev = 0;
                 }
                 else
                 {
-                    if (isSpace(*utf32It) && utf32It != utf32.begin())
+                    if (isSpace(utf32[i]) && i > 0)
                     {
-                        textLine = utf32It;
+                        textLine = i;
                         textLineX = pos.x;
                     }
+                    out.glyphs.push_back(glyph);
+                    out.boxes.push_back(Box2I(pos.x, pos.y - h, glyph ? glyph->advance : 0, h));
                     pos.x += x;
                 }
             }
-            size.w = std::max(size.w, pos.x);
-            size.h = pos.y;
+            out.size.w = std::max(out.size.w, pos.x);
+            out.size.h = pos.y;
         }
     }
 }
\ No newline at end of file
@@ -62,8 +62,30 @@ namespace feather_tk
         int32_t                rsbDelta = 0;
     };
 
+    //! Text layout.
+    //!
+    //! Text layouts are computed once by the font system and cached, so
+    //! they can be used repeatedly for measuring and drawing.
+    struct TextLayout
+    {
+        //! The glyph for each character.
+        std::vector<std::shared_ptr<Glyph> > glyphs;
+
+        //! The box for each character.
+        std::vector<Box2I> boxes;
+
+        //! The index of the first character of each line.
+        std::vector<size_t> lines;
+
+        //! The total size.
+        Size2I size;
+    };
+
     //! Font system.
     //!
+    //! The font system is thread safe, glyphs may be rendered and text
+    //! measured from any thread.
+    //!
     //! \todo Add text elide functionality.
     //! \todo Add support for gamma correction?
     //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
@@ -92,6 +114,16 @@ namespace feather_tk
         //! Get the percentage of the glyph cache in use.
         float getGlyphCachePercentage() const;
 
+        //! Get the number of text layouts in the cache.
+        size_t getLayoutCacheSize() const;
+
+        //! Get the memory used by the text layout cache in bytes. The cache
+        //! is limited by memory instead of the number of layouts.
+        size_t getLayoutCacheByteCount() const;
+
+        //! Get the number of idle FreeType faces in the face pool.
+        size_t getFacePoolSize() const;
+
         ///@}
 
         //! \name Measure
@@ -112,6 +144,12 @@ namespace feather_tk
             const FontInfo&,
             int maxLineWidth = 0);
 
+        //! Get the layout for the given string.
+        std::shared_ptr<TextLayout> getLayout(
+            const std::string&,
+            const FontInfo&,
+            int maxLineWidth = 0);
+
         ///@}
 
         //! \name Glyphs
@@ -122,6 +160,13 @@ namespace feather_tk
             const std::string&,
             const FontInfo&);
 
+        //! Render the glyphs for the given string in the background and
+        //! add them to the glyph cache. Use this to avoid stalls when
+        //! large amounts of text are first displayed.
+        void prefetchGlyphs(
+            const std::string&,
+            const FontInfo&);
+
         ///@}
 
     private:
@@ -131,5 +176,20 @@ namespace feather_tk
     ///@}
 }
 
+namespace std
+{
+    template<>
+    struct hash<feather_tk::FontInfo>
+    {
+        std::size_t operator() (const feather_tk::FontInfo&) const noexcept;
+    };
+
+    template<>
+    struct hash<feather_tk::GlyphInfo>
+    {
+        std::size_t operator() (const feather_tk::GlyphInfo&) const noexcept;
+    };
+}
+
 #include <feather-tk/core/FontSystemInline.h>
 
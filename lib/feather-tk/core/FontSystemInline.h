@@ -44,3 +44,24 @@ namespace feather_tk
         return std::tie(code, fontInfo) < std::tie(other.code, other.fontInfo);
     }
 }
+
+namespace std
+{
+    inline std::size_t hash<feather_tk::FontInfo>::operator() (
+        const feather_tk::FontInfo& value) const noexcept
+    {
+        std::size_t out = 0;
+        feather_tk::hashCombine(out, value.family);
+        feather_tk::hashCombine(out, value.size);
+        return out;
+    }
+
+    inline std::size_t hash<feather_tk::GlyphInfo>::operator() (
+        const feather_tk::GlyphInfo& value) const noexcept
+    {
+        std::size_t out = 0;
+        feather_tk::hashCombine(out, value.code);
+        feather_tk::hashCombine(out, value.fontInfo);
+        return out;
+    }
+}
\ No newline at end of file
@@ -41,6 +41,7 @@ namespace feather_tk
         std::string summary;
         std::vector<std::shared_ptr<ICmdLineArg> > cmdLineArgs;
         std::shared_ptr<CmdLineFlagOption> logFlag;
+        std::shared_ptr<CmdLineValueOption<std::string> > logFileOption;
         std::shared_ptr<CmdLineFlagOption> helpFlag;
         std::vector<std::shared_ptr<ICmdLineOption> > cmdLineOptions;
         std::shared_ptr<ListObserver<LogItem> > logObserver;
@@ -73,6 +74,10 @@ namespace feather_tk
             { "-log" },
             "Print the log to the console.");
         p.cmdLineOptions.push_back(p.logFlag);
+        p.logFileOption = CmdLineValueOption<std::string>::create(
+            { "-logFile" },
+            "Write the log to a file.");
+        p.cmdLineOptions.push_back(p.logFileOption);
         p.helpFlag = CmdLineFlagOption::create(
             { "-help", "-h", "--help", "--h" },
             "Show this message.");
@@ -86,6 +91,21 @@ namespace feather_tk
             {
                 _print(value);
             });
+        if (p.logFileOption->hasValue())
+        {
+            const std::string& path = p.logFileOption->getValue();
+            try
+            {
+                logSystem->addSink(FileLogSink::create(std::filesystem::u8path(path)));
+            }
+            catch (const std::exception& e)
+            {
+                logSystem->print(
+                    name,
+                    Format("Cannot open log file: {0}: {1}").arg(path).arg(e.what()),
+                    LogType::Error);
+            }
+        }
         logSystem->print(name, "Starting...");
     }
 
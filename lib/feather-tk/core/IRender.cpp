@@ -6,6 +6,33 @@
 
 namespace feather_tk
 {
+    RenderMesh::RenderMesh(
+        const std::shared_ptr<IRender>& render,
+        const CompactMesh2F& mesh) :
+        _render(render),
+        _mesh(mesh)
+    {}
+
+    RenderMesh::~RenderMesh()
+    {}
+
+    std::shared_ptr<RenderMesh> RenderMesh::create(
+        const std::shared_ptr<IRender>& render,
+        const CompactMesh2F& mesh)
+    {
+        return std::shared_ptr<RenderMesh>(new RenderMesh(render, mesh));
+    }
+
+    std::shared_ptr<IRender> RenderMesh::getRender() const
+    {
+        return _render.lock();
+    }
+
+    const CompactMesh2F& RenderMesh::getMesh() const
+    {
+        return _mesh;
+    }
+
     void IRender::_init(const std::shared_ptr<Context>& context)
     {
         _context = context;
@@ -14,6 +41,12 @@ namespace feather_tk
     IRender::~IRender()
     {}
 
+    void IRender::flush()
+    {}
+
+    void IRender::resetState()
+    {}
+
     void IRender::drawRect(
         const Box2I& rect,
         const Color4F& color)
@@ -57,6 +90,43 @@ namespace feather_tk
         drawLines(linesF, color, options);
     }
 
+    void IRender::drawMesh(
+        const CompactMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        drawMesh(triMesh(mesh), color, pos);
+    }
+
+    std::shared_ptr<RenderMesh> IRender::createMesh(const TriMesh2F& mesh)
+    {
+        return createMesh(compactMesh(mesh));
+    }
+
+    std::shared_ptr<RenderMesh> IRender::createMesh(const CompactMesh2F& mesh)
+    {
+        return RenderMesh::create(shared_from_this(), mesh);
+    }
+
+    void IRender::drawMesh(
+        const std::shared_ptr<RenderMesh>& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        if (mesh)
+        {
+            drawMesh(mesh->getMesh(), color, pos);
+        }
+    }
+
+    void IRender::drawColorMesh(
+        const CompactMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        drawColorMesh(triMesh(mesh), color, pos);
+    }
+
     void IRender::drawText(
         const std::vector<std::shared_ptr<Glyph> >& glyphs,
         const FontMetrics& fontMetics,
@@ -66,6 +136,42 @@ namespace feather_tk
         drawText(glyphs, fontMetics, V2F(position.x, position.y), color);
     }
 
+    void IRender::drawText(
+        const TextLayout& layout,
+        const FontMetrics& fontMetics,
+        const V2I& position,
+        const Color4F& color)
+    {
+        if (layout.lines.size() <= 1)
+        {
+            drawText(layout.glyphs, fontMetics, V2F(position.x, position.y), color);
+        }
+        else
+        {
+            // Draw each line separately, since the glyphs do not include
+            // the line breaks from word wrapping.
+            std::vector<std::shared_ptr<Glyph> > glyphs;
+            for (size_t i = 0; i < layout.lines.size(); ++i)
+            {
+                const size_t first = layout.lines[i];
+                const size_t last = i + 1 < layout.lines.size() ?
+                    layout.lines[i + 1] :
+                    layout.glyphs.size();
+                if (first < last)
+                {
+                    glyphs.assign(
+                        layout.glyphs.begin() + first,
+                        layout.glyphs.begin() + last);
+                    drawText(
+                        glyphs,
+                        fontMetics,
+                        V2F(position.x, position.y + i * fontMetics.lineHeight),
+                        color);
+                }
+            }
+        }
+    }
+
     void IRender::drawImage(
         const std::shared_ptr<Image>& image,
         const Box2I& rect,
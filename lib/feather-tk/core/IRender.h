@@ -16,9 +16,43 @@
 namespace feather_tk
 {
     class Context;
+    class IRender;
 
     //! \name Rendering
     ///@{
+
+    //! Retained mesh.
+    //!
+    //! Retained meshes are uploaded by the renderer once and then drawn
+    //! by handle, so static geometry is not converted and uploaded every
+    //! frame. Create a new mesh when the geometry changes.
+    class RenderMesh
+    {
+        FEATHER_TK_NON_COPYABLE(RenderMesh);
+
+    protected:
+        RenderMesh(
+            const std::shared_ptr<IRender>&,
+            const CompactMesh2F&);
+
+    public:
+        virtual ~RenderMesh();
+
+        //! Create a new retained mesh.
+        static std::shared_ptr<RenderMesh> create(
+            const std::shared_ptr<IRender>&,
+            const CompactMesh2F&);
+
+        //! Get the renderer that created the mesh.
+        std::shared_ptr<IRender> getRender() const;
+
+        //! Get the mesh.
+        const CompactMesh2F& getMesh() const;
+
+    private:
+        std::weak_ptr<IRender> _render;
+        CompactMesh2F _mesh;
+    };
         
     //! Base class for renderers.
     class IRender : public std::enable_shared_from_this<IRender>
@@ -77,6 +111,16 @@ namespace feather_tk
         //! Set the transformation matrix.
         virtual void setTransform(const M44F&) = 0;
 
+        //! Flush pending draw calls. Renderers may record primitives and
+        //! draw them later, so this must be called before issuing
+        //! graphics API commands directly.
+        virtual void flush();
+
+        //! Reset the tracked graphics API state. Renderers may skip
+        //! redundant state changes, so this must be called after issuing
+        //! graphics API commands directly.
+        virtual void resetState();
+
         //! Draw a filled rectangle.
         virtual void drawRect(
             const Box2F&,
@@ -129,12 +173,37 @@ namespace feather_tk
             const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
             const V2F& pos = V2F()) = 0;
 
+        //! Draw a compact triangle mesh.
+        virtual void drawMesh(
+            const CompactMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F());
+
+        //! Create a retained mesh.
+        virtual std::shared_ptr<RenderMesh> createMesh(const TriMesh2F&);
+
+        //! Create a retained mesh.
+        virtual std::shared_ptr<RenderMesh> createMesh(const CompactMesh2F&);
+
+        //! Draw a retained mesh. Meshes created by a different renderer
+        //! are drawn like regular meshes.
+        virtual void drawMesh(
+            const std::shared_ptr<RenderMesh>&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F());
+
         //! Draw a triangle mesh with vertex color information.
         virtual void drawColorMesh(
             const TriMesh2F&,
             const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
             const V2F& pos = V2F()) = 0;
 
+        //! Draw a compact triangle mesh with vertex color information.
+        virtual void drawColorMesh(
+            const CompactMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F());
+
         //! Draw a texture.
         virtual void drawTexture(
             unsigned int,
@@ -156,6 +225,13 @@ namespace feather_tk
             const V2I& position,
             const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F));
 
+        //! Draw a text layout.
+        virtual void drawText(
+            const TextLayout&,
+            const FontMetrics&,
+            const V2I& position,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F));
+
         //! Draw an image.
         virtual void drawImage(
             const std::shared_ptr<Image>&,
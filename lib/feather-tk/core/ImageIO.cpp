@@ -4,9 +4,17 @@
 
 #include <feather-tk/core/ImageIO.h>
 
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
 #include <feather-tk/core/PNG.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace feather_tk
 {
@@ -30,6 +38,31 @@ namespace feather_tk
     IImageReader::~IImageReader()
     {}
 
+    bool IImageReader::read(
+        const std::shared_ptr<Image>& image,
+        const ImageReadCallback& callback)
+    {
+        const ImageInfo& info = getInfo();
+        bool out =
+            image &&
+            image->getSize() == info.size &&
+            image->getType() == info.type;
+        if (out)
+        {
+            auto tmp = read();
+            out = tmp && tmp->getByteCount() == image->getByteCount();
+            if (out)
+            {
+                memcpy(image->getData(), tmp->getData(), image->getByteCount());
+                if (callback)
+                {
+                    callback(image, 0, info.size.h);
+                }
+            }
+        }
+        return out;
+    }
+
     IImageWriter::IImageWriter(
         const std::filesystem::path& path,
         const ImageIOOptions&) :
@@ -89,27 +122,110 @@ namespace feather_tk
         return nullptr;
     }
 
-    ImageIO::ImageIO(const std::shared_ptr<Context>& context) :
-        ISystem(context, "feather_tk::ImageIO")
+    namespace
     {
+        const size_t threadCountMax = 4;
+    }
+
+    struct ImageIO::Private
+    {
+        size_t threadCount = 0;
+        uint64_t id = 0;
+        std::function<void()> contextWake;
+
+        struct Request
+        {
+            uint64_t id = 0;
+            std::filesystem::path path;
+            ImageIOOptions options;
+            ImageReadCallback callback;
+            std::promise<std::shared_ptr<Image> > promise;
+        };
+
+        struct Mutex
+        {
+            std::list<std::shared_ptr<Request> > priorityRequests;
+            std::list<std::shared_ptr<Request> > requests;
+            bool stopped = false;
+            std::mutex mutex;
+        };
+        Mutex mutex;
+
+        struct Thread
+        {
+            std::condition_variable cv;
+            std::vector<std::thread> threads;
+            std::atomic<bool> running;
+        };
+        Thread thread;
+
+        std::mutex pluginsMutex;
+
+        void run(ImageIO&);
+        void cancelRequests();
+    };
+
+    ImageIO::ImageIO(
+        const std::shared_ptr<Context>& context,
+        size_t threadCount) :
+        ISystem(context, "feather_tk::ImageIO"),
+        _p(new Private)
+    {
+        FEATHER_TK_P();
         _plugins.push_front(std::shared_ptr<IImagePlugin>(new png::ImagePlugin));
+        if (0 == threadCount)
+        {
+            threadCount = std::max(
+                static_cast<size_t>(1),
+                std::min(
+                    static_cast<size_t>(std::thread::hardware_concurrency()),
+                    threadCountMax));
+        }
+        p.threadCount = threadCount;
+        p.thread.running = false;
+        p.contextWake = context->getWakeFunc();
     }
 
     ImageIO::~ImageIO()
-    {}
+    {
+        FEATHER_TK_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.thread.running = false;
+            p.mutex.stopped = true;
+        }
+        p.thread.cv.notify_all();
+        for (auto& thread : p.thread.threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        p.cancelRequests();
+    }
 
-    std::shared_ptr<ImageIO> ImageIO::create(const std::shared_ptr<Context>& context)
+    std::shared_ptr<ImageIO> ImageIO::create(
+        const std::shared_ptr<Context>& context,
+        size_t threadCount)
     {
-        return std::shared_ptr<ImageIO>(new ImageIO(context));
+        return std::shared_ptr<ImageIO>(new ImageIO(context, threadCount));
     }
 
-    const std::list<std::shared_ptr<IImagePlugin> >& ImageIO::getPlugins() const
+    size_t ImageIO::getThreadCount() const
     {
+        return _p->threadCount;
+    }
+
+    std::list<std::shared_ptr<IImagePlugin> > ImageIO::getPlugins() const
+    {
+        std::unique_lock<std::mutex> lock(_p->pluginsMutex);
         return _plugins;
     }
 
     void ImageIO::addPlugin(const std::shared_ptr<IImagePlugin>& plugin)
     {
+        std::unique_lock<std::mutex> lock(_p->pluginsMutex);
         _plugins.push_front(plugin);
     }
 
@@ -117,6 +233,7 @@ namespace feather_tk
         const std::filesystem::path& path,
         const ImageIOOptions& options)
     {
+        std::unique_lock<std::mutex> lock(_p->pluginsMutex);
         std::shared_ptr<IImageReader> out;
         for (const auto& plugin : _plugins)
         {
@@ -134,6 +251,7 @@ namespace feather_tk
         const InMemoryFile& memory,
         const ImageIOOptions& options)
     {
+        std::unique_lock<std::mutex> lock(_p->pluginsMutex);
         std::shared_ptr<IImageReader> out;
         for (const auto& plugin : _plugins)
         {
@@ -151,6 +269,7 @@ namespace feather_tk
         const ImageInfo& info,
         const ImageIOOptions& options)
     {
+        std::unique_lock<std::mutex> lock(_p->pluginsMutex);
         std::shared_ptr<IImageWriter> out;
         for (const auto& plugin : _plugins)
         {
@@ -162,4 +281,154 @@ namespace feather_tk
         }
         return out;
     }
+
+    ImageRequest ImageIO::request(
+        const std::filesystem::path& path,
+        const ImageIOOptions& options,
+        const ImageReadCallback& callback,
+        bool priority)
+    {
+        FEATHER_TK_P();
+        ImageRequest out;
+        auto request = std::make_shared<Private::Request>();
+        request->path = path;
+        request->options = options;
+        request->callback = callback;
+        out.future = request->promise.get_future();
+        bool valid = false;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            out.id = p.id++;
+            request->id = out.id;
+            if (!p.mutex.stopped)
+            {
+                valid = true;
+                if (priority)
+                {
+                    p.mutex.priorityRequests.push_back(request);
+                }
+                else
+                {
+                    p.mutex.requests.push_back(request);
+                }
+                if (p.thread.threads.empty())
+                {
+                    p.thread.running = true;
+                    for (size_t i = 0; i < p.threadCount; ++i)
+                    {
+                        p.thread.threads.push_back(std::thread(
+                            [this]
+                            {
+                                _p->run(*this);
+                            }));
+                    }
+                }
+            }
+        }
+        if (valid)
+        {
+            p.thread.cv.notify_one();
+        }
+        else
+        {
+            request->promise.set_value(nullptr);
+        }
+        return out;
+    }
+
+    void ImageIO::cancelRequests(const std::vector<uint64_t>& ids)
+    {
+        FEATHER_TK_P();
+        std::list<std::shared_ptr<Private::Request> > cancelled;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            for (auto requests : { &p.mutex.priorityRequests, &p.mutex.requests })
+            {
+                auto i = requests->begin();
+                while (i != requests->end())
+                {
+                    const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
+                    if (j != ids.end())
+                    {
+                        cancelled.push_back(*i);
+                        i = requests->erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+        }
+        for (auto& request : cancelled)
+        {
+            request->promise.set_value(nullptr);
+        }
+    }
+
+    void ImageIO::Private::run(ImageIO& io)
+    {
+        while (thread.running)
+        {
+            std::shared_ptr<Request> request;
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                thread.cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            !mutex.priorityRequests.empty() ||
+                            !mutex.requests.empty() ||
+                            !thread.running;
+                    });
+                auto& requests = !mutex.priorityRequests.empty() ?
+                    mutex.priorityRequests :
+                    mutex.requests;
+                if (!requests.empty())
+                {
+                    request = requests.front();
+                    requests.pop_front();
+                }
+            }
+            if (request)
+            {
+                try
+                {
+                    std::shared_ptr<Image> image;
+                    if (auto reader = io.read(request->path, request->options))
+                    {
+                        image = Image::create(reader->getInfo());
+                        if (!reader->read(image, request->callback))
+                        {
+                            throw std::runtime_error(
+                                Format("Cannot read: \"{0}\"").arg(request->path.u8string()));
+                        }
+                    }
+                    request->promise.set_value(image);
+                }
+                catch (const std::exception&)
+                {
+                    request->promise.set_exception(std::current_exception());
+                }
+
+                // Wake the application so the result is picked up.
+                contextWake();
+            }
+        }
+    }
+
+    void ImageIO::Private::cancelRequests()
+    {
+        std::list<std::shared_ptr<Request> > requests;
+        {
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            requests = std::move(mutex.priorityRequests);
+            requests.splice(requests.end(), mutex.requests);
+        }
+        for (auto& request : requests)
+        {
+            request->promise.set_value(nullptr);
+        }
+    }
 }
\ No newline at end of file
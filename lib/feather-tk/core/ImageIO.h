@@ -8,6 +8,8 @@
 #include <feather-tk/core/ISystem.h>
 #include <feather-tk/core/Image.h>
 
+#include <functional>
+#include <future>
 #include <list>
 
 namespace feather_tk
@@ -20,6 +22,11 @@ namespace feather_tk
 
         //! Merge image I/O options.
         ImageIOOptions merge(const ImageIOOptions&, const ImageIOOptions&);
+
+        //! Image read callback. The callback is given the image, and the
+        //! first row and number of rows that were read. Each pass of an
+        //! interlaced image updates all of the rows.
+        typedef std::function<void(const std::shared_ptr<Image>&, int, int)> ImageReadCallback;
         
         //! Base class for image readers.
         class IImageReader
@@ -38,6 +45,14 @@ namespace feather_tk
             //! Read the image.
             virtual std::shared_ptr<Image> read() = 0;
 
+            //! Read the image into an existing image with the same size and
+            //! type. The callback is called as the rows are read, so that
+            //! the image can be displayed incrementally. Returns false if
+            //! the image is not compatible or cannot be read.
+            virtual bool read(
+                const std::shared_ptr<Image>&,
+                const ImageReadCallback& = nullptr);
+
         protected:
             std::filesystem::path _path;
         };
@@ -99,20 +114,36 @@ namespace feather_tk
             std::string _name;
         };
         
+        //! Image request.
+        struct ImageRequest
+        {
+            uint64_t id = 0;
+            std::future<std::shared_ptr<Image> > future;
+        };
+
         //! Image I/O system.
+        //!
+        //! Async requests are read by a pool of worker threads, which are
+        //! started with the first request.
         class ImageIO : public ISystem
         {
         protected:
-            ImageIO(const std::shared_ptr<Context>&);
+            ImageIO(const std::shared_ptr<Context>&, size_t threadCount);
 
         public:
             virtual ~ImageIO();
 
-            //! Create a new system.
-            static std::shared_ptr<ImageIO> create(const std::shared_ptr<Context>&);
+            //! Create a new system. If the thread count is zero it is chosen
+            //! automatically.
+            static std::shared_ptr<ImageIO> create(
+                const std::shared_ptr<Context>&,
+                size_t threadCount = 0);
 
-            //! Get the plugins.
-            const std::list<std::shared_ptr<IImagePlugin> >& getPlugins() const;
+            //! Get the number of worker threads.
+            size_t getThreadCount() const;
+
+            //! Get a copy of the plugins.
+            std::list<std::shared_ptr<IImagePlugin> > getPlugins() const;
             
             //! Add a plugin.
             void addPlugin(const std::shared_ptr<IImagePlugin>&);
@@ -134,8 +165,23 @@ namespace feather_tk
                 const ImageInfo&,
                 const ImageIOOptions& = ImageIOOptions());
 
+            //! Request an async image. Priority requests are handled before
+            //! other requests, use them for images that are currently
+            //! visible. The callback is called from a worker thread. Read
+            //! errors are passed to the future as exceptions.
+            ImageRequest request(
+                const std::filesystem::path&,
+                const ImageIOOptions& = ImageIOOptions(),
+                const ImageReadCallback& = nullptr,
+                bool priority = false);
+
+            //! Cancel async requests.
+            void cancelRequests(const std::vector<uint64_t>&);
+
         private:
             std::list<std::shared_ptr<IImagePlugin> > _plugins;
+
+            FEATHER_TK_PRIVATE();
         };
         
         ///@}
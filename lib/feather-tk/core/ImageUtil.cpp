@@ -0,0 +1,1204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/ImageUtil.h>
+
+#include <feather-tk/core/ImageUtilPrivate.h>
+
+#include <feather-tk/core/Math.h>
+#include <feather-tk/core/Memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace feather_tk
+{
+    namespace image
+    {
+        float halfToFloat(uint16_t value)
+        {
+            const uint32_t s = static_cast<uint32_t>(value & 0x8000) << 16;
+            uint32_t e = (value >> 10) & 0x1f;
+            uint32_t m = value & 0x3ff;
+            uint32_t f = s;
+            if (0 == e)
+            {
+                if (m != 0)
+                {
+                    e = 127 - 14;
+                    while (!(m & 0x400))
+                    {
+                        m <<= 1;
+                        --e;
+                    }
+                    m &= 0x3ff;
+                    f = s | (e << 23) | (m << 13);
+                }
+            }
+            else if (31 == e)
+            {
+                f = s | 0x7f800000 | (m << 13);
+            }
+            else
+            {
+                f = s | ((e + 127 - 15) << 23) | (m << 13);
+            }
+            float out = 0.F;
+            std::memcpy(&out, &f, 4);
+            return out;
+        }
+
+        uint16_t floatToHalf(float value)
+        {
+            uint32_t f = 0;
+            std::memcpy(&f, &value, 4);
+            const uint16_t s = static_cast<uint16_t>((f >> 16) & 0x8000);
+            const int fe = (f >> 23) & 0xff;
+            const int e = fe - 127 + 15;
+            uint32_t m = f & 0x7fffff;
+            if (0xff == fe)
+            {
+                return s | 0x7c00 | (m ? 0x200 : 0);
+            }
+            if (e >= 31)
+            {
+                return s | 0x7c00;
+            }
+            if (e <= 0)
+            {
+                if (e < -10)
+                {
+                    return s;
+                }
+                m |= 0x800000;
+                const int shift = 14 - e;
+                uint32_t h = m >> shift;
+                if ((m >> (shift - 1)) & 1)
+                {
+                    ++h;
+                }
+                return static_cast<uint16_t>(s | h);
+            }
+            uint32_t h = s | (e << 10) | (m >> 13);
+            if (m & 0x1000)
+            {
+                // Rounding may carry into the exponent, which is correct.
+                ++h;
+            }
+            return static_cast<uint16_t>(h);
+        }
+    }
+
+    namespace
+    {
+        //! The approximate number of pixels in a band of rows.
+        const int bandPixels = 65536;
+
+        //! Call a function for bands of rows in parallel. The bands start
+        //! on even rows so that the rows of 4:2:0 chroma are not split.
+        void parallelRows(
+            int w,
+            int h,
+            size_t threadCount,
+            const std::function<void(int, int)>& fn)
+        {
+            const int band = std::max(2, (bandPixels / std::max(w, 1)) & ~1);
+            const int bandCount = (h + band - 1) / band;
+            std::atomic<int> next(0);
+            auto work = [&fn, &next, h, band, bandCount]
+            {
+                int i = 0;
+                while ((i = next++) < bandCount)
+                {
+                    fn(i * band, std::min(h, (i + 1) * band));
+                }
+            };
+            if (0 == threadCount)
+            {
+                threadCount = std::max(
+                    static_cast<size_t>(1),
+                    static_cast<size_t>(std::thread::hardware_concurrency()));
+            }
+            threadCount = std::min(threadCount, static_cast<size_t>(bandCount));
+            std::vector<std::future<void> > futures;
+            for (size_t i = 1; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(std::launch::async, work));
+            }
+            work();
+            for (auto& future : futures)
+            {
+                future.get();
+            }
+        }
+
+        inline float saturate(float value)
+        {
+            return value < 0.F ? 0.F : (value > 1.F ? 1.F : value);
+        }
+
+        //! Read values with the given bit depth.
+        void readValues(
+            const uint8_t* p,
+            size_t count,
+            int bitDepth,
+            bool isFloat,
+            bool swap,
+            float* out)
+        {
+            switch (bitDepth)
+            {
+            case 8:
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out[i] = p[i] * (1.F / 255.F);
+                }
+                break;
+            case 16:
+                if (isFloat)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = image::halfToFloat(image::readWord<uint16_t>(p + i * 2, swap));
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = image::readWord<uint16_t>(p + i * 2, swap) * (1.F / 65535.F);
+                    }
+                }
+                break;
+            case 32:
+                if (isFloat)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = image::readWord<float>(p + i * 4, swap);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = static_cast<float>(image::readWord<uint32_t>(p + i * 4, swap) / 4294967295.0);
+                    }
+                }
+                break;
+            default: break;
+            }
+        }
+
+        //! Write values with the given bit depth. Integer values are
+        //! clamped to the zero to one range.
+        void writeValues(
+            const float* in,
+            size_t count,
+            int bitDepth,
+            bool isFloat,
+            bool swap,
+            uint8_t* p)
+        {
+            switch (bitDepth)
+            {
+            case 8:
+                for (size_t i = 0; i < count; ++i)
+                {
+                    p[i] = static_cast<uint8_t>(saturate(in[i]) * 255.F + .5F);
+                }
+                break;
+            case 16:
+                if (isFloat)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        image::writeWord<uint16_t>(p + i * 2, image::floatToHalf(in[i]), swap);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        image::writeWord<uint16_t>(
+                            p + i * 2,
+                            static_cast<uint16_t>(saturate(in[i]) * 65535.F + .5F),
+                            swap);
+                    }
+                }
+                break;
+            case 32:
+                if (isFloat)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        image::writeWord<float>(p + i * 4, in[i], swap);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        image::writeWord<uint32_t>(
+                            p + i * 4,
+                            static_cast<uint32_t>(saturate(in[i]) * 4294967295.0 + .5),
+                            swap);
+                    }
+                }
+                break;
+            default: break;
+            }
+        }
+
+        //! REC709 luminance weights.
+        const float lumaR = .2126F;
+        const float lumaG = .7152F;
+        const float lumaB = .0722F;
+
+        enum class Encoding
+        {
+            Interleaved,
+            RGB_U10,
+            ARGB_4444_Premult,
+            YUV
+        };
+
+        //! Image data layout used to read and write rows of pixels.
+        struct Format
+        {
+            Format(const ImageInfo&);
+
+            ImageInfo info;
+            Encoding encoding = Encoding::Interleaved;
+            int channelCount = 0;
+            int bitDepth = 0;
+            bool isFloat = false;
+            bool swap = false;
+            size_t pixelByteCount = 0;
+            size_t rowByteCount = 0;
+
+            // YUV planes.
+            int cw = 0;
+            int ch = 0;
+            size_t uOffset = 0;
+            size_t vOffset = 0;
+            std::vector<int> chromaX;
+        };
+
+        Format::Format(const ImageInfo& info) :
+            info(info)
+        {
+            const size_t w = info.size.w;
+            const size_t h = info.size.h;
+            channelCount = getChannelCount(info.type);
+            bitDepth = getBitDepth(info.type);
+            swap = info.layout.endian != getEndian();
+            switch (info.type)
+            {
+            case ImageType::L_F16:
+            case ImageType::L_F32:
+            case ImageType::LA_F16:
+            case ImageType::LA_F32:
+            case ImageType::RGB_F16:
+            case ImageType::RGB_F32:
+            case ImageType::RGBA_F16:
+            case ImageType::RGBA_F32:
+                isFloat = true;
+                break;
+            default: break;
+            }
+            switch (info.type)
+            {
+            case ImageType::RGB_U10:
+                encoding = Encoding::RGB_U10;
+                pixelByteCount = 4;
+                rowByteCount = getAlignedByteCount(w * 4, info.layout.alignment);
+                break;
+            case ImageType::ARGB_4444_Premult:
+                encoding = Encoding::ARGB_4444_Premult;
+                pixelByteCount = 2;
+                rowByteCount = w * 2;
+                break;
+            case ImageType::YUV_420P_U8:
+            case ImageType::YUV_422P_U8:
+            case ImageType::YUV_444P_U8:
+            case ImageType::YUV_420P_U16:
+            case ImageType::YUV_422P_U16:
+            case ImageType::YUV_444P_U16:
+            {
+                encoding = Encoding::YUV;
+                cw = info.size.w;
+                ch = info.size.h;
+                switch (info.type)
+                {
+                case ImageType::YUV_420P_U8:
+                case ImageType::YUV_420P_U16:
+                    cw = info.size.w / 2;
+                    ch = info.size.h / 2;
+                    break;
+                case ImageType::YUV_422P_U8:
+                case ImageType::YUV_422P_U16:
+                    cw = info.size.w / 2;
+                    break;
+                default: break;
+                }
+                pixelByteCount = bitDepth / 8;
+                rowByteCount = w * pixelByteCount;
+                uOffset = w * h * pixelByteCount;
+                vOffset = uOffset + static_cast<size_t>(cw) * ch * pixelByteCount;
+                chromaX.resize(w);
+                for (int x = 0; x < info.size.w; ++x)
+                {
+                    chromaX[x] = cw > 0 ? std::min(x * cw / info.size.w, cw - 1) : 0;
+                }
+                break;
+            }
+            default:
+                pixelByteCount = channelCount * bitDepth / 8;
+                rowByteCount = getAlignedByteCount(w * pixelByteCount, info.layout.alignment);
+                break;
+            }
+        }
+
+        //! Get whether the image type has a straight alpha channel.
+        bool hasAlpha(const Format& format)
+        {
+            return
+                Encoding::Interleaved == format.encoding &&
+                (2 == format.channelCount || 4 == format.channelCount);
+        }
+
+        //! Read a row of pixels as floating point RGBA. The scratch buffer
+        //! must hold four values for each pixel.
+        void readRow(
+            const Format& format,
+            const uint8_t* data,
+            int y,
+            float* out,
+            float* scratch)
+        {
+            const int w = format.info.size.w;
+            switch (format.encoding)
+            {
+            case Encoding::Interleaved:
+            {
+                const uint8_t* p = data + y * format.rowByteCount;
+                switch (format.channelCount)
+                {
+                case 1:
+                    readValues(p, w, format.bitDepth, format.isFloat, format.swap, scratch);
+                    for (int x = 0; x < w; ++x)
+                    {
+                        out[x * 4 + 0] = scratch[x];
+                        out[x * 4 + 1] = scratch[x];
+                        out[x * 4 + 2] = scratch[x];
+                        out[x * 4 + 3] = 1.F;
+                    }
+                    break;
+                case 2:
+                    readValues(p, w * 2, format.bitDepth, format.isFloat, format.swap, scratch);
+                    for (int x = 0; x < w; ++x)
+                    {
+                        out[x * 4 + 0] = scratch[x * 2];
+                        out[x * 4 + 1] = scratch[x * 2];
+                        out[x * 4 + 2] = scratch[x * 2];
+                        out[x * 4 + 3] = scratch[x * 2 + 1];
+                    }
+                    break;
+                case 3:
+                    readValues(p, w * 3, format.bitDepth, format.isFloat, format.swap, scratch);
+                    for (int x = 0; x < w; ++x)
+                    {
+                        out[x * 4 + 0] = scratch[x * 3 + 0];
+                        out[x * 4 + 1] = scratch[x * 3 + 1];
+                        out[x * 4 + 2] = scratch[x * 3 + 2];
+                        out[x * 4 + 3] = 1.F;
+                    }
+                    break;
+                case 4:
+                    readValues(p, w * 4, format.bitDepth, format.isFloat, format.swap, out);
+                    break;
+                default: break;
+                }
+                break;
+            }
+            case Encoding::RGB_U10:
+            {
+                const uint8_t* p = data + y * format.rowByteCount;
+                for (int x = 0; x < w; ++x, p += 4)
+                {
+                    const uint32_t v = image::readWord<uint32_t>(p, format.swap);
+                    out[x * 4 + 0] = ((v >> 22) & 0x3ff) / 1023.F;
+                    out[x * 4 + 1] = ((v >> 12) & 0x3ff) / 1023.F;
+                    out[x * 4 + 2] = ((v >> 2) & 0x3ff) / 1023.F;
+                    out[x * 4 + 3] = 1.F;
+                }
+                break;
+            }
+            case Encoding::ARGB_4444_Premult:
+            {
+                const uint8_t* p = data + y * format.rowByteCount;
+                for (int x = 0; x < w; ++x, p += 2)
+                {
+                    const uint16_t v = image::readWord<uint16_t>(p, format.swap);
+                    const float a = ((v >> 12) & 0xf) / 15.F;
+                    const float s = a > 0.F ? 1.F / a : 0.F;
+                    out[x * 4 + 0] = saturate(((v >> 8) & 0xf) / 15.F * s);
+                    out[x * 4 + 1] = saturate(((v >> 4) & 0xf) / 15.F * s);
+                    out[x * 4 + 2] = saturate((v & 0xf) / 15.F * s);
+                    out[x * 4 + 3] = a;
+                }
+                break;
+            }
+            case Encoding::YUV:
+            {
+                const int h = format.info.size.h;
+                const int cw = format.cw;
+                const int cy = format.ch > 0 ? std::min(y * format.ch / h, format.ch - 1) : 0;
+                const size_t bytes = format.pixelByteCount;
+                float* yv = scratch;
+                float* uv = scratch + w;
+                float* vv = uv + cw;
+                readValues(data + y * format.rowByteCount, w, format.bitDepth, false, format.swap, yv);
+                readValues(data + format.uOffset + cy * cw * bytes, cw, format.bitDepth, false, format.swap, uv);
+                readValues(data + format.vOffset + cy * cw * bytes, cw, format.bitDepth, false, format.swap, vv);
+                if (VideoLevels::LegalRange == format.info.videoLevels)
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        yv[x] = image::legalY(yv[x]);
+                    }
+                    for (int x = 0; x < cw; ++x)
+                    {
+                        uv[x] = image::legalC(uv[x]);
+                        vv[x] = image::legalC(vv[x]);
+                    }
+                }
+                const V4F k = getYUVCoefficients(format.info.yuvCoefficients);
+                const int* chromaX = format.chromaX.data();
+                for (int x = 0; x < w; ++x)
+                {
+                    const float cb = uv[chromaX[x]] - .5F;
+                    const float cr = vv[chromaX[x]] - .5F;
+                    out[x * 4 + 0] = yv[x] + k.x * cr;
+                    out[x * 4 + 1] = yv[x] - k.y * cr - k.z * cb;
+                    out[x * 4 + 2] = yv[x] + k.w * cb;
+                    out[x * 4 + 3] = 1.F;
+                }
+                break;
+            }
+            }
+        }
+
+        //! Write a row of floating point RGBA pixels. The previous row is
+        //! used for 4:2:0 chroma, which is written on odd rows. The scratch
+        //! buffer must hold four values for each pixel.
+        void writeRow(
+            const Format& format,
+            const float* in,
+            const float* prev,
+            int y,
+            uint8_t* data,
+            float* scratch)
+        {
+            const int w = format.info.size.w;
+            switch (format.encoding)
+            {
+            case Encoding::Interleaved:
+            {
+                uint8_t* p = data + y * format.rowByteCount;
+                switch (format.channelCount)
+                {
+                case 1:
+                    for (int x = 0; x < w; ++x)
+                    {
+                        scratch[x] =
+                            in[x * 4 + 0] * lumaR +
+                            in[x * 4 + 1] * lumaG +
+                            in[x * 4 + 2] * lumaB;
+                    }
+                    writeValues(scratch, w, format.bitDepth, format.isFloat, format.swap, p);
+                    break;
+                case 2:
+                    for (int x = 0; x < w; ++x)
+                    {
+                        scratch[x * 2] =
+                            in[x * 4 + 0] * lumaR +
+                            in[x * 4 + 1] * lumaG +
+                            in[x * 4 + 2] * lumaB;
+                        scratch[x * 2 + 1] = in[x * 4 + 3];
+                    }
+                    writeValues(scratch, w * 2, format.bitDepth, format.isFloat, format.swap, p);
+                    break;
+                case 3:
+                    for (int x = 0; x < w; ++x)
+                    {
+                        scratch[x * 3 + 0] = in[x * 4 + 0];
+                        scratch[x * 3 + 1] = in[x * 4 + 1];
+                        scratch[x * 3 + 2] = in[x * 4 + 2];
+                    }
+                    writeValues(scratch, w * 3, format.bitDepth, format.isFloat, format.swap, p);
+                    break;
+                case 4:
+                    writeValues(in, w * 4, format.bitDepth, format.isFloat, format.swap, p);
+                    break;
+                default: break;
+                }
+                break;
+            }
+            case Encoding::RGB_U10:
+            {
+                uint8_t* p = data + y * format.rowByteCount;
+                for (int x = 0; x < w; ++x, p += 4)
+                {
+                    const uint32_t r = static_cast<uint32_t>(saturate(in[x * 4 + 0]) * 1023.F + .5F);
+                    const uint32_t g = static_cast<uint32_t>(saturate(in[x * 4 + 1]) * 1023.F + .5F);
+                    const uint32_t b = static_cast<uint32_t>(saturate(in[x * 4 + 2]) * 1023.F + .5F);
+                    image::writeWord<uint32_t>(p, (r << 22) | (g << 12) | (b << 2), format.swap);
+                }
+                break;
+            }
+            case Encoding::ARGB_4444_Premult:
+            {
+                uint8_t* p = data + y * format.rowByteCount;
+                for (int x = 0; x < w; ++x, p += 2)
+                {
+                    const float a = saturate(in[x * 4 + 3]);
+                    const uint16_t r = static_cast<uint16_t>(saturate(in[x * 4 + 0]) * a * 15.F + .5F);
+                    const uint16_t g = static_cast<uint16_t>(saturate(in[x * 4 + 1]) * a * 15.F + .5F);
+                    const uint16_t b = static_cast<uint16_t>(saturate(in[x * 4 + 2]) * a * 15.F + .5F);
+                    const uint16_t av = static_cast<uint16_t>(a * 15.F + .5F);
+                    image::writeWord<uint16_t>(p, (av << 12) | (r << 8) | (g << 4) | b, format.swap);
+                }
+                break;
+            }
+            case Encoding::YUV:
+            {
+                // Y  = a * R + b * G + c * B
+                // Cb = (B - Y) / d
+                // Cr = (R - Y) / e
+                const V4F k = getYUVCoefficients(format.info.yuvCoefficients);
+                const float ke = k.x;
+                const float kd = k.w;
+                const float ka = 1.F - ke / 2.F;
+                const float kc = 1.F - kd / 2.F;
+                const float kb = 1.F - ka - kc;
+                const bool legal = VideoLevels::LegalRange == format.info.videoLevels;
+                const float ys = legal ? (235.F - 16.F) / 255.F : 1.F;
+                const float cs = legal ? (240.F - 16.F) / 255.F : 1.F;
+                const float o = legal ? 16.F / 255.F : 0.F;
+
+                float* yv = scratch;
+                for (int x = 0; x < w; ++x)
+                {
+                    yv[x] = (in[x * 4 + 0] * ka + in[x * 4 + 1] * kb + in[x * 4 + 2] * kc) * ys + o;
+                }
+                writeValues(yv, w, format.bitDepth, false, format.swap, data + y * format.rowByteCount);
+
+                // Get the chroma row, and the source rows that are averaged.
+                const int cw = format.cw;
+                const bool subX = cw < w;
+                const bool subY = format.ch < format.info.size.h;
+                int cy = y;
+                if (subY)
+                {
+                    if (!(y & 1) || !prev)
+                        break;
+                    cy = y / 2;
+                }
+                if (cy >= format.ch)
+                    break;
+                float* uv = scratch + w;
+                float* vv = uv + cw;
+                for (int x = 0; x < cw; ++x)
+                {
+                    const int x0 = subX ? x * 2 : x;
+                    float r = in[x0 * 4 + 0];
+                    float g = in[x0 * 4 + 1];
+                    float b = in[x0 * 4 + 2];
+                    float n = 1.F;
+                    if (subX)
+                    {
+                        r += in[x0 * 4 + 4];
+                        g += in[x0 * 4 + 5];
+                        b += in[x0 * 4 + 6];
+                        n += 1.F;
+                    }
+                    if (subY)
+                    {
+                        r += prev[x0 * 4 + 0];
+                        g += prev[x0 * 4 + 1];
+                        b += prev[x0 * 4 + 2];
+                        n += 1.F;
+                        if (subX)
+                        {
+                            r += prev[x0 * 4 + 4];
+                            g += prev[x0 * 4 + 5];
+                            b += prev[x0 * 4 + 6];
+                            n += 1.F;
+                        }
+                    }
+                    r /= n;
+                    g /= n;
+                    b /= n;
+                    const float l = r * ka + g * kb + b * kc;
+                    uv[x] = ((b - l) / kd + .5F) * cs + o;
+                    vv[x] = ((r - l) / ke + .5F) * cs + o;
+                }
+                const size_t bytes = format.pixelByteCount;
+                writeValues(uv, cw, format.bitDepth, false, format.swap, data + format.uOffset + cy * cw * bytes);
+                writeValues(vv, cw, format.bitDepth, false, format.swap, data + format.vOffset + cy * cw * bytes);
+                break;
+            }
+            }
+        }
+
+        //! Direct conversion of a row of pixels.
+        typedef void (*RowFunc)(const uint8_t*, uint8_t*, int);
+
+        void L_U8ToRGBA_U8(const uint8_t* in, uint8_t* out, int w)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                out[x * 4 + 0] = in[x];
+                out[x * 4 + 1] = in[x];
+                out[x * 4 + 2] = in[x];
+                out[x * 4 + 3] = 255;
+            }
+        }
+
+        void LA_U8ToRGBA_U8(const uint8_t* in, uint8_t* out, int w)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                out[x * 4 + 0] = in[x * 2];
+                out[x * 4 + 1] = in[x * 2];
+                out[x * 4 + 2] = in[x * 2];
+                out[x * 4 + 3] = in[x * 2 + 1];
+            }
+        }
+
+        void RGB_U8ToRGBA_U8(const uint8_t* in, uint8_t* out, int w)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                out[x * 4 + 0] = in[x * 3 + 0];
+                out[x * 4 + 1] = in[x * 3 + 1];
+                out[x * 4 + 2] = in[x * 3 + 2];
+                out[x * 4 + 3] = 255;
+            }
+        }
+
+        void RGBA_U8ToRGB_U8(const uint8_t* in, uint8_t* out, int w)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                out[x * 3 + 0] = in[x * 4 + 0];
+                out[x * 3 + 1] = in[x * 4 + 1];
+                out[x * 3 + 2] = in[x * 4 + 2];
+            }
+        }
+
+        RowFunc getRowFunc(ImageType in, ImageType out)
+        {
+            RowFunc func = nullptr;
+            if (ImageType::RGBA_U8 == out)
+            {
+                switch (in)
+                {
+                case ImageType::L_U8: func = L_U8ToRGBA_U8; break;
+                case ImageType::LA_U8: func = LA_U8ToRGBA_U8; break;
+                case ImageType::RGB_U8: func = RGB_U8ToRGBA_U8; break;
+                default: break;
+                }
+            }
+            else if (ImageType::RGBA_U8 == in && ImageType::RGB_U8 == out)
+            {
+                func = RGBA_U8ToRGB_U8;
+            }
+            return func;
+        }
+
+        //! Get whether the image data can be copied without conversion.
+        bool isCopy(const Format& in, const Format& out)
+        {
+            bool out2 =
+                in.info.type == out.info.type &&
+                (in.swap == out.swap || 8 == in.bitDepth);
+            if (out2 && Encoding::YUV == in.encoding)
+            {
+                out2 =
+                    in.info.videoLevels == out.info.videoLevels &&
+                    in.info.yuvCoefficients == out.info.yuvCoefficients;
+            }
+            return out2;
+        }
+
+        //! Filter weights for resizing one dimension.
+        struct Weights
+        {
+            int taps = 0;
+            std::vector<int> start;
+            std::vector<float> values;
+        };
+
+        Weights getWeights(int in, int out)
+        {
+            Weights weights;
+            const float scale = in / static_cast<float>(out);
+            if (scale > 1.F)
+            {
+                // Area filter.
+                weights.taps = static_cast<int>(std::ceil(scale)) + 1;
+                weights.start.resize(out);
+                weights.values.resize(static_cast<size_t>(out) * weights.taps, 0.F);
+                for (int i = 0; i < out; ++i)
+                {
+                    const float a = i * scale;
+                    const float b = std::min(a + scale, static_cast<float>(in));
+                    const int j0 = static_cast<int>(std::floor(a));
+                    const int j1 = std::min(
+                        std::min(in, static_cast<int>(std::ceil(b))),
+                        j0 + weights.taps);
+                    weights.start[i] = j0;
+                    float sum = 0.F;
+                    for (int j = j0; j < j1; ++j)
+                    {
+                        const float v = std::min(b, j + 1.F) - std::max(a, static_cast<float>(j));
+                        weights.values[i * weights.taps + j - j0] = v;
+                        sum += v;
+                    }
+                    for (int j = j0; j < j1; ++j)
+                    {
+                        weights.values[i * weights.taps + j - j0] /= sum;
+                    }
+                }
+            }
+            else
+            {
+                // Bilinear filter.
+                weights.taps = 2;
+                weights.start.resize(out);
+                weights.values.resize(static_cast<size_t>(out) * 2, 0.F);
+                for (int i = 0; i < out; ++i)
+                {
+                    const float c = (i + .5F) * scale - .5F;
+                    int j0 = static_cast<int>(std::floor(c));
+                    float t = c - j0;
+                    if (j0 < 0)
+                    {
+                        j0 = 0;
+                        t = 0.F;
+                    }
+                    if (j0 >= in - 1)
+                    {
+                        j0 = std::max(in - 2, 0);
+                        t = in > 1 ? 1.F : 0.F;
+                    }
+                    weights.start[i] = j0;
+                    weights.values[i * 2] = 1.F - t;
+                    weights.values[i * 2 + 1] = t;
+                }
+            }
+            return weights;
+        }
+    }
+
+    std::shared_ptr<Image> convert(
+        const std::shared_ptr<Image>& image,
+        ImageType type,
+        size_t threadCount)
+    {
+        ImageInfo info = image->getInfo();
+        info.type = type;
+        switch (type)
+        {
+        case ImageType::YUV_420P_U8:
+        case ImageType::YUV_422P_U8:
+        case ImageType::YUV_444P_U8:
+        case ImageType::YUV_420P_U16:
+        case ImageType::YUV_422P_U16:
+        case ImageType::YUV_444P_U16: break;
+        default:
+            info.videoLevels = VideoLevels::FullRange;
+            break;
+        }
+        info.layout.endian = getEndian();
+        auto out = Image::create(info);
+        out->setTags(image->getTags());
+        convert(image, out, threadCount);
+        return out;
+    }
+
+    void convert(
+        const std::shared_ptr<Image>& in,
+        const std::shared_ptr<Image>& out,
+        size_t threadCount)
+    {
+        if (in->getSize() != out->getSize())
+        {
+            throw std::runtime_error("Incompatible image sizes");
+        }
+        if (!in->isValid())
+            return;
+
+        const Format inFormat(in->getInfo());
+        const Format outFormat(out->getInfo());
+        const int w = in->getWidth();
+        const int h = in->getHeight();
+        const uint8_t* inData = in->getData();
+        uint8_t* outData = out->getData();
+        if (isCopy(inFormat, outFormat))
+        {
+            if (inFormat.rowByteCount == outFormat.rowByteCount)
+            {
+                std::memcpy(outData, inData, std::min(in->getByteCount(), out->getByteCount()));
+            }
+            else
+            {
+                const size_t rowByteCount = w * inFormat.pixelByteCount;
+                for (int y = 0; y < h; ++y)
+                {
+                    std::memcpy(
+                        outData + y * outFormat.rowByteCount,
+                        inData + y * inFormat.rowByteCount,
+                        rowByteCount);
+                }
+            }
+        }
+        else if (RowFunc func = getRowFunc(inFormat.info.type, outFormat.info.type))
+        {
+            parallelRows(
+                w,
+                h,
+                threadCount,
+                [&inFormat, &outFormat, inData, outData, w, func](int y0, int y1)
+                {
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        func(
+                            inData + y * inFormat.rowByteCount,
+                            outData + y * outFormat.rowByteCount,
+                            w);
+                    }
+                });
+        }
+        else
+        {
+            parallelRows(
+                w,
+                h,
+                threadCount,
+                [&inFormat, &outFormat, inData, outData, w](int y0, int y1)
+                {
+                    std::vector<float> rows[2];
+                    rows[0].resize(static_cast<size_t>(w) * 4);
+                    rows[1].resize(static_cast<size_t>(w) * 4);
+                    std::vector<float> scratch(static_cast<size_t>(w) * 4);
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        float* row = rows[y & 1].data();
+                        readRow(inFormat, inData, y, row, scratch.data());
+                        writeRow(
+                            outFormat,
+                            row,
+                            y > y0 ? rows[(y - 1) & 1].data() : nullptr,
+                            y,
+                            outData,
+                            scratch.data());
+                    }
+                });
+        }
+    }
+
+    void premultiply(const std::shared_ptr<Image>& image, size_t threadCount)
+    {
+        const Format format(image->getInfo());
+        if (!image->isValid() || !hasAlpha(format))
+            return;
+        const int w = image->getWidth();
+        uint8_t* data = image->getData();
+        parallelRows(
+            w,
+            image->getHeight(),
+            threadCount,
+            [&format, data, w](int y0, int y1)
+            {
+                if (8 == format.bitDepth)
+                {
+                    const int c = format.channelCount;
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        uint8_t* p = data + y * format.rowByteCount;
+                        for (int x = 0; x < w; ++x, p += c)
+                        {
+                            const int a = p[c - 1];
+                            for (int i = 0; i < c - 1; ++i)
+                            {
+                                p[i] = static_cast<uint8_t>((p[i] * a + 127) / 255);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    std::vector<float> row(static_cast<size_t>(w) * 4);
+                    std::vector<float> scratch(static_cast<size_t>(w) * 4);
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        readRow(format, data, y, row.data(), scratch.data());
+                        for (int x = 0; x < w; ++x)
+                        {
+                            const float a = row[x * 4 + 3];
+                            row[x * 4 + 0] *= a;
+                            row[x * 4 + 1] *= a;
+                            row[x * 4 + 2] *= a;
+                        }
+                        writeRow(format, row.data(), nullptr, y, data, scratch.data());
+                    }
+                }
+            });
+    }
+
+    void unpremultiply(const std::shared_ptr<Image>& image, size_t threadCount)
+    {
+        const Format format(image->getInfo());
+        if (!image->isValid() || !hasAlpha(format))
+            return;
+        const int w = image->getWidth();
+        uint8_t* data = image->getData();
+        parallelRows(
+            w,
+            image->getHeight(),
+            threadCount,
+            [&format, data, w](int y0, int y1)
+            {
+                if (8 == format.bitDepth)
+                {
+                    const int c = format.channelCount;
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        uint8_t* p = data + y * format.rowByteCount;
+                        for (int x = 0; x < w; ++x, p += c)
+                        {
+                            const int a = p[c - 1];
+                            if (a > 0)
+                            {
+                                for (int i = 0; i < c - 1; ++i)
+                                {
+                                    p[i] = static_cast<uint8_t>(std::min((p[i] * 255 + a / 2) / a, 255));
+                                }
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    std::vector<float> row(static_cast<size_t>(w) * 4);
+                    std::vector<float> scratch(static_cast<size_t>(w) * 4);
+                    for (int y = y0; y < y1; ++y)
+                    {
+                        readRow(format, data, y, row.data(), scratch.data());
+                        for (int x = 0; x < w; ++x)
+                        {
+                            const float a = row[x * 4 + 3];
+                            if (a > 0.F)
+                            {
+                                row[x * 4 + 0] /= a;
+                                row[x * 4 + 1] /= a;
+                                row[x * 4 + 2] /= a;
+                            }
+                        }
+                        writeRow(format, row.data(), nullptr, y, data, scratch.data());
+                    }
+                }
+            });
+    }
+
+    void mirror(const std::shared_ptr<Image>& image, const ImageMirror& value)
+    {
+        if (!image->isValid() || (!value.x && !value.y))
+            return;
+
+        // Get the planes of the image.
+        const Format format(image->getInfo());
+        struct Plane
+        {
+            uint8_t* data = nullptr;
+            int w = 0;
+            int h = 0;
+            size_t rowByteCount = 0;
+        };
+        std::vector<Plane> planes;
+        uint8_t* data = image->getData();
+        const size_t bytes = format.pixelByteCount;
+        const int w = image->getWidth();
+        const int h = image->getHeight();
+        planes.push_back({ data, w, h, format.rowByteCount });
+        if (Encoding::YUV == format.encoding)
+        {
+            planes.push_back({ data + format.uOffset, format.cw, format.ch, format.cw * bytes });
+            planes.push_back({ data + format.vOffset, format.cw, format.ch, format.cw * bytes });
+        }
+
+        std::vector<uint8_t> tmp(format.rowByteCount);
+        for (const auto& plane : planes)
+        {
+            if (value.x)
+            {
+                for (int y = 0; y < plane.h; ++y)
+                {
+                    uint8_t* a = plane.data + y * plane.rowByteCount;
+                    uint8_t* b = a + (plane.w - 1) * bytes;
+                    for (; a < b; a += bytes, b -= bytes)
+                    {
+                        std::swap_ranges(a, a + bytes, b);
+                    }
+                }
+            }
+            if (value.y)
+            {
+                const size_t rowByteCount = plane.w * bytes;
+                for (int y = 0; y < plane.h / 2; ++y)
+                {
+                    uint8_t* a = plane.data + y * plane.rowByteCount;
+                    uint8_t* b = plane.data + (plane.h - 1 - y) * plane.rowByteCount;
+                    std::memcpy(tmp.data(), a, rowByteCount);
+                    std::memcpy(a, b, rowByteCount);
+                    std::memcpy(b, tmp.data(), rowByteCount);
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<Image> resize(
+        const std::shared_ptr<Image>& image,
+        const Size2I& size,
+        size_t threadCount)
+    {
+        ImageInfo info = image->getInfo();
+        info.size = size;
+        auto out = Image::create(info);
+        out->setTags(image->getTags());
+        if (!image->isValid() || !out->isValid())
+            return out;
+
+        const Format inFormat(image->getInfo());
+        const Format outFormat(info);
+        const bool alpha = hasAlpha(inFormat) || Encoding::ARGB_4444_Premult == inFormat.encoding;
+        const int iw = image->getWidth();
+        const int ih = image->getHeight();
+        const int ow = size.w;
+        const int oh = size.h;
+        const Weights xWeights = getWeights(iw, ow);
+        const Weights yWeights = getWeights(ih, oh);
+        const uint8_t* inData = image->getData();
+        uint8_t* outData = out->getData();
+
+        // Filter the rows horizontally.
+        std::vector<float> tmp(static_cast<size_t>(ow) * ih * 4);
+        parallelRows(
+            iw,
+            ih,
+            threadCount,
+            [&inFormat, &xWeights, &tmp, inData, iw, ow, alpha](int y0, int y1)
+            {
+                std::vector<float> row(static_cast<size_t>(iw) * 4);
+                std::vector<float> scratch(static_cast<size_t>(iw) * 4);
+                const int taps = xWeights.taps;
+                for (int y = y0; y < y1; ++y)
+                {
+                    readRow(inFormat, inData, y, row.data(), scratch.data());
+                    if (alpha)
+                    {
+                        for (int x = 0; x < iw; ++x)
+                        {
+                            const float a = row[x * 4 + 3];
+                            row[x * 4 + 0] *= a;
+                            row[x * 4 + 1] *= a;
+                            row[x * 4 + 2] *= a;
+                        }
+                    }
+                    float* outP = tmp.data() + static_cast<size_t>(y) * ow * 4;
+                    for (int x = 0; x < ow; ++x)
+                    {
+                        const float* rowP = row.data() + xWeights.start[x] * 4;
+                        const float* w = xWeights.values.data() + x * taps;
+                        const int count = std::min(taps, iw - xWeights.start[x]);
+                        float c[4] = { 0.F, 0.F, 0.F, 0.F };
+                        for (int i = 0; i < count; ++i)
+                        {
+                            c[0] += rowP[i * 4 + 0] * w[i];
+                            c[1] += rowP[i * 4 + 1] * w[i];
+                            c[2] += rowP[i * 4 + 2] * w[i];
+                            c[3] += rowP[i * 4 + 3] * w[i];
+                        }
+                        outP[x * 4 + 0] = c[0];
+                        outP[x * 4 + 1] = c[1];
+                        outP[x * 4 + 2] = c[2];
+                        outP[x * 4 + 3] = c[3];
+                    }
+                }
+            });
+
+        // Filter the columns vertically.
+        parallelRows(
+            ow,
+            oh,
+            threadCount,
+            [&outFormat, &yWeights, &tmp, outData, ih, ow, alpha](int y0, int y1)
+            {
+                std::vector<float> rows[2];
+                rows[0].resize(static_cast<size_t>(ow) * 4);
+                rows[1].resize(static_cast<size_t>(ow) * 4);
+                std::vector<float> scratch(static_cast<size_t>(ow) * 4);
+                const int taps = yWeights.taps;
+                const size_t rowSize = static_cast<size_t>(ow) * 4;
+                for (int y = y0; y < y1; ++y)
+                {
+                    float* row = rows[y & 1].data();
+                    std::fill(row, row + rowSize, 0.F);
+                    const int start = yWeights.start[y];
+                    const int count = std::min(taps, ih - start);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        const float w = yWeights.values[y * taps + i];
+                        const float* tmpP = tmp.data() + (start + i) * rowSize;
+                        for (size_t j = 0; j < rowSize; ++j)
+                        {
+                            row[j] += tmpP[j] * w;
+                        }
+                    }
+                    if (alpha)
+                    {
+                        for (int x = 0; x < ow; ++x)
+                        {
+                            const float a = row[x * 4 + 3];
+                            if (a > 0.F)
+                            {
+                                row[x * 4 + 0] /= a;
+                                row[x * 4 + 1] /= a;
+                                row[x * 4 + 2] /= a;
+                            }
+                        }
+                    }
+                    writeRow(
+                        outFormat,
+                        row,
+                        y > y0 ? rows[(y - 1) & 1].data() : nullptr,
+                        y,
+                        outData,
+                        scratch.data());
+                }
+            });
+
+        return out;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/Image.h>
+
+namespace feather_tk
+{
+    //! \name Image Utilities
+    ///@{
+
+    //! Convert an image to another type.
+    //!
+    //! Images are converted a row at a time through floating point RGBA,
+    //! with direct paths for the common 8-bit conversions. YUV images are
+    //! converted using the image video levels and YUV coefficients, the
+    //! video levels are ignored for other types. Converting RGB to
+    //! luminance uses the REC709 weights.
+    //!
+    //! The rows are split into bands that are converted in parallel. A
+    //! thread count of zero uses the hardware concurrency.
+    std::shared_ptr<Image> convert(
+        const std::shared_ptr<Image>&,
+        ImageType,
+        size_t threadCount = 0);
+
+    //! Convert an image into an existing image with the same size.
+    void convert(
+        const std::shared_ptr<Image>& in,
+        const std::shared_ptr<Image>& out,
+        size_t threadCount = 0);
+
+    //! Multiply the color channels by alpha. Images without an alpha
+    //! channel are not changed.
+    void premultiply(const std::shared_ptr<Image>&, size_t threadCount = 0);
+
+    //! Divide the color channels by alpha. Images without an alpha
+    //! channel are not changed.
+    void unpremultiply(const std::shared_ptr<Image>&, size_t threadCount = 0);
+
+    //! Flip the image data. The image information is not changed.
+    void mirror(const std::shared_ptr<Image>&, const ImageMirror&);
+
+    //! Resize an image. Downscaling uses an area filter so that every
+    //! pixel contributes to the result, which is suitable for thumbnails.
+    //! Upscaling uses bilinear filtering. Alpha is premultiplied while
+    //! filtering.
+    std::shared_ptr<Image> resize(
+        const std::shared_ptr<Image>&,
+        const Size2I&,
+        size_t threadCount = 0);
+
+    ///@}
+}
\ No newline at end of file
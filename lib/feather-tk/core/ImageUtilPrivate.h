@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace feather_tk
+{
+    namespace image
+    {
+        //! Convert a half precision float to a float.
+        float halfToFloat(uint16_t);
+
+        //! Convert a float to a half precision float.
+        uint16_t floatToHalf(float);
+
+        //! Read a word, optionally swapping the byte order.
+        template<typename T>
+        inline T readWord(const uint8_t* p, bool swap)
+        {
+            T out;
+            if (swap)
+            {
+                uint8_t tmp[sizeof(T)];
+                for (size_t i = 0; i < sizeof(T); ++i)
+                {
+                    tmp[i] = p[sizeof(T) - 1 - i];
+                }
+                std::memcpy(&out, tmp, sizeof(T));
+            }
+            else
+            {
+                std::memcpy(&out, p, sizeof(T));
+            }
+            return out;
+        }
+
+        //! Write a word, optionally swapping the byte order.
+        template<typename T>
+        inline void writeWord(uint8_t* p, T value, bool swap)
+        {
+            if (swap)
+            {
+                uint8_t tmp[sizeof(T)];
+                std::memcpy(tmp, &value, sizeof(T));
+                for (size_t i = 0; i < sizeof(T); ++i)
+                {
+                    p[i] = tmp[sizeof(T) - 1 - i];
+                }
+            }
+            else
+            {
+                std::memcpy(p, &value, sizeof(T));
+            }
+        }
+
+        //! Expand a legal range luma value to full range.
+        inline float legalY(float value)
+        {
+            return (value - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+        }
+
+        //! Expand a legal range chroma value to full range.
+        inline float legalC(float value)
+        {
+            return (value - (16.F / 255.F)) * (255.F / (240.F - 16.F));
+        }
+    }
+}
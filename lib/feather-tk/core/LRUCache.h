@@ -5,13 +5,19 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <functional>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace feather_tk
 {
     //! Least recently used (LRU) cache.
-    template<typename T, typename U>
+    //!
+    //! Items are stored in a hash map that points into a list ordered by
+    //! use, so that lookups, additions, and evictions are constant time.
+    //! The key type must be hashable with the hash function H.
+    template<typename T, typename U, typename H = std::hash<T> >
     class LRUCache
     {
     public:
@@ -38,18 +44,47 @@ namespace feather_tk
         void remove(const T& key);
         void clear();
 
+        //! Get the keys, ordered from least to most recently used.
         std::vector<T> getKeys() const;
+
+        //! Get the values, ordered from least to most recently used.
         std::vector<U> getValues() const;
 
+        //! Set a callback that is called when items are evicted.
+        void setEvictCallback(const std::function<void(const T&, const U&)>&);
+
+        ///@}
+
+        //! \name Statistics
+        ///@{
+
+        size_t getHits() const;
+        size_t getMisses() const;
+        size_t getEvictions() const;
+
+        void resetStats();
+
         ///@}
 
     private:
+        struct Item
+        {
+            T key;
+            U value;
+            size_t size = 0;
+        };
+        typedef std::list<Item> List;
+
         void _maxUpdate();
 
         size_t _max = 10000;
-        std::map<T, std::pair<U, size_t> > _map;
-        std::map<T, int64_t> _counts;
-        int64_t _counter = 0;
+        size_t _size = 0;
+        List _list;
+        std::unordered_map<T, typename List::iterator, H> _map;
+        std::function<void(const T&, const U&)> _evictCallback;
+        size_t _hits = 0;
+        size_t _misses = 0;
+        size_t _evictions = 0;
     };
 }
 
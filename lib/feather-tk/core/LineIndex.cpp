@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/LineIndex.h>
+
+#include <feather-tk/core/FileIO.h>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace feather_tk
+{
+    namespace
+    {
+        const size_t blockSize = 1024 * 1024;
+
+        void indexLines(
+            const char* data,
+            size_t start,
+            size_t end,
+            size_t size,
+            std::vector<uint64_t>& out)
+        {
+            const char* p = data + start;
+            const char* pEnd = data + end;
+            while (p < pEnd)
+            {
+                const void* q = memchr(p, '\n', pEnd - p);
+                if (!q)
+                    break;
+                const size_t pos = static_cast<const char*>(q) - data + 1;
+                if (pos < size)
+                {
+                    out.push_back(pos);
+                }
+                p = static_cast<const char*>(q) + 1;
+            }
+        }
+    }
+
+    struct LineIndex::Private
+    {
+        std::string text;
+        std::shared_ptr<FileIO> fileIO;
+        const char* data = nullptr;
+        size_t size = 0;
+        bool newlineAtEnd = false;
+        std::vector<uint64_t> starts;
+        size_t maxLineLength = 0;
+        size_t maxLine = 0;
+    };
+
+    LineIndex::LineIndex() :
+        _p(new Private)
+    {}
+
+    LineIndex::~LineIndex()
+    {}
+
+    std::shared_ptr<LineIndex> LineIndex::create(
+        const std::string& text,
+        size_t threadCount)
+    {
+        auto out = std::shared_ptr<LineIndex>(new LineIndex);
+        out->_p->text = text;
+        out->_p->data = out->_p->text.data();
+        out->_p->size = out->_p->text.size();
+        out->_index(threadCount);
+        return out;
+    }
+
+    std::shared_ptr<LineIndex> LineIndex::create(
+        const std::shared_ptr<FileIO>& fileIO,
+        size_t threadCount)
+    {
+        auto out = std::shared_ptr<LineIndex>(new LineIndex);
+        out->_p->fileIO = fileIO;
+        out->_p->data = reinterpret_cast<const char*>(fileIO->getMemoryStart());
+        out->_p->size = fileIO->getSize();
+        out->_index(threadCount);
+        return out;
+    }
+
+    size_t LineIndex::getSize() const
+    {
+        return _p->size;
+    }
+
+    size_t LineIndex::getLineCount() const
+    {
+        return _p->starts.size();
+    }
+
+    size_t LineIndex::getMaxLineLength() const
+    {
+        return _p->maxLineLength;
+    }
+
+    size_t LineIndex::getMaxLine() const
+    {
+        return _p->maxLine;
+    }
+
+    size_t LineIndex::getLineLength(size_t index) const
+    {
+        FEATHER_TK_P();
+        size_t out = 0;
+        if (index < p.starts.size())
+        {
+            const size_t end = index + 1 < p.starts.size() ?
+                (p.starts[index + 1] - 1) :
+                (p.newlineAtEnd ? p.size - 1 : p.size);
+            out = end - p.starts[index];
+        }
+        return out;
+    }
+
+    std::string LineIndex::getLine(size_t index, size_t maxLength) const
+    {
+        FEATHER_TK_P();
+        std::string out;
+        if (index < p.starts.size())
+        {
+            const size_t start = p.starts[index];
+            const size_t length = std::min(getLineLength(index), maxLength);
+            if (p.data)
+            {
+                out.assign(p.data + start, length);
+            }
+            else if (p.fileIO)
+            {
+                out.resize(length);
+                p.fileIO->setPos(start);
+                p.fileIO->read(out.data(), length);
+            }
+            if (!out.empty() && '\r' == out.back())
+            {
+                out.pop_back();
+            }
+        }
+        return out;
+    }
+
+    void LineIndex::_index(size_t threadCount)
+    {
+        FEATHER_TK_P();
+        p.starts.clear();
+        if (0 == p.size)
+            return;
+        p.starts.push_back(0);
+        if (p.data)
+        {
+            p.newlineAtEnd = '\n' == p.data[p.size - 1];
+
+            // Split the text into blocks that are indexed in parallel.
+            if (0 == threadCount)
+            {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            const size_t blocks = std::max(
+                std::min(threadCount, p.size / blockSize),
+                static_cast<size_t>(1));
+            std::vector<std::vector<uint64_t> > results(blocks);
+            std::vector<std::future<void> > futures;
+            const size_t step = p.size / blocks;
+            for (size_t i = 0; i < blocks; ++i)
+            {
+                const size_t start = i * step;
+                const size_t end = i + 1 < blocks ? (start + step) : p.size;
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [this, start, end, &results, i]
+                    {
+                        indexLines(_p->data, start, end, _p->size, results[i]);
+                    }));
+            }
+            size_t count = 1;
+            for (size_t i = 0; i < blocks; ++i)
+            {
+                futures[i].get();
+                count += results[i].size();
+            }
+            p.starts.reserve(count);
+            for (const auto& result : results)
+            {
+                p.starts.insert(p.starts.end(), result.begin(), result.end());
+            }
+        }
+        else if (p.fileIO)
+        {
+            // Read the file a block at a time.
+            std::vector<char> buf(blockSize);
+            p.fileIO->setPos(0);
+            for (size_t pos = 0; pos < p.size; pos += blockSize)
+            {
+                const size_t size = std::min(blockSize, p.size - pos);
+                p.fileIO->read(buf.data(), size);
+                std::vector<uint64_t> result;
+                indexLines(buf.data(), 0, size, p.size - pos, result);
+                for (auto i : result)
+                {
+                    p.starts.push_back(pos + i);
+                }
+                if (pos + size == p.size)
+                {
+                    p.newlineAtEnd = '\n' == buf[size - 1];
+                }
+            }
+        }
+
+        p.maxLineLength = 0;
+        p.maxLine = 0;
+        for (size_t i = 0; i < p.starts.size(); ++i)
+        {
+            const size_t length = getLineLength(i);
+            if (length > p.maxLineLength)
+            {
+                p.maxLineLength = length;
+                p.maxLine = i;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/Util.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace feather_tk
+{
+    class FileIO;
+
+    //! \name Text
+    ///@{
+
+    //! Line index.
+    //!
+    //! The line index stores the offsets of the lines in a text, so that
+    //! individual lines can be accessed without splitting the whole text.
+    //! Memory-mapped files are indexed in parallel, and only the pages that
+    //! are accessed are loaded, so files larger than the available memory
+    //! can be used.
+    //!
+    //! Lines are separated by "\n", and a trailing "\r" is removed. A
+    //! newline at the end of the text does not start a new line.
+    class LineIndex : public std::enable_shared_from_this<LineIndex>
+    {
+        FEATHER_TK_NON_COPYABLE(LineIndex);
+
+    protected:
+        LineIndex();
+
+    public:
+        ~LineIndex();
+
+        //! Create a new line index from a string. A thread count of zero
+        //! uses the hardware concurrency.
+        static std::shared_ptr<LineIndex> create(
+            const std::string&,
+            size_t threadCount = 0);
+
+        //! Create a new line index from a file. The file should not be
+        //! used by anything else while the line index exists.
+        static std::shared_ptr<LineIndex> create(
+            const std::shared_ptr<FileIO>&,
+            size_t threadCount = 0);
+
+        //! Get the size of the text in bytes.
+        size_t getSize() const;
+
+        //! Get the number of lines.
+        size_t getLineCount() const;
+
+        //! Get the length of the longest line in bytes.
+        size_t getMaxLineLength() const;
+
+        //! Get the index of the longest line.
+        size_t getMaxLine() const;
+
+        //! Get the length of a line in bytes.
+        size_t getLineLength(size_t) const;
+
+        //! Get a line. Lines longer than the maximum length are truncated.
+        std::string getLine(
+            size_t,
+            size_t maxLength = std::numeric_limits<size_t>::max()) const;
+
+    private:
+        void _index(size_t threadCount);
+
+        FEATHER_TK_PRIVATE();
+    };
+
+    ///@}
+}
\ No newline at end of file
@@ -5,9 +5,19 @@
 #include <feather-tk/core/LogSystem.h>
 
 #include <feather-tk/core/Context.h>
+#include <feather-tk/core/FileIO.h>
+#include <feather-tk/core/Format.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
 #include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 
 namespace feather_tk
 {
@@ -46,25 +56,324 @@ namespace feather_tk
         return ss.str();
     }
 
+    ILogSink::~ILogSink()
+    {}
+
+    StdErrLogSink::~StdErrLogSink()
+    {}
+
+    std::shared_ptr<StdErrLogSink> StdErrLogSink::create()
+    {
+        return std::shared_ptr<StdErrLogSink>(new StdErrLogSink);
+    }
+
+    void StdErrLogSink::write(const std::vector<LogItem>& items)
+    {
+        std::string s;
+        for (const auto& item : items)
+        {
+            s += toString(item);
+            s += '\n';
+        }
+        std::cerr << s;
+        std::cerr.flush();
+    }
+
+    struct FileLogSink::Private
+    {
+        std::filesystem::path path;
+        size_t maxSize = 0;
+        size_t maxFiles = 0;
+        std::shared_ptr<FileIO> io;
+        size_t size = 0;
+    };
+
+    FileLogSink::FileLogSink(
+        const std::filesystem::path& path,
+        size_t maxSize,
+        size_t maxFiles) :
+        _p(new Private)
+    {
+        FEATHER_TK_P();
+        p.path = path;
+        p.maxSize = maxSize;
+        p.maxFiles = maxFiles;
+        p.io = FileIO::create(path, FileMode::Append);
+        p.size = p.io->getSize();
+    }
+
+    FileLogSink::~FileLogSink()
+    {}
+
+    std::shared_ptr<FileLogSink> FileLogSink::create(
+        const std::filesystem::path& path,
+        size_t maxSize,
+        size_t maxFiles)
+    {
+        return std::shared_ptr<FileLogSink>(new FileLogSink(path, maxSize, maxFiles));
+    }
+
+    void FileLogSink::write(const std::vector<LogItem>& items)
+    {
+        FEATHER_TK_P();
+        std::string s;
+        for (const auto& item : items)
+        {
+            const std::string line = toString(item) + '\n';
+            if (p.maxSize > 0 && p.size > 0 && p.size + s.size() + line.size() > p.maxSize)
+            {
+                // Rotate the files.
+                if (p.io)
+                {
+                    p.io->write(s);
+                    p.io.reset();
+                }
+                s.clear();
+                std::error_code ec;
+                if (p.maxFiles > 0)
+                {
+                    const std::string path = p.path.u8string();
+                    const auto getPath = [path](size_t index)
+                    {
+                        return std::filesystem::u8path(path + "." + std::to_string(index));
+                    };
+                    std::filesystem::remove(getPath(p.maxFiles), ec);
+                    for (size_t i = p.maxFiles; i > 1; --i)
+                    {
+                        std::filesystem::rename(getPath(i - 1), getPath(i), ec);
+                    }
+                    std::filesystem::rename(p.path, getPath(1), ec);
+                }
+                p.io = FileIO::create(p.path, FileMode::Write);
+                p.size = 0;
+            }
+            s += line;
+            p.size += line.size();
+        }
+        if (p.io && !s.empty())
+        {
+            p.io->write(s);
+        }
+    }
+
+    namespace
+    {
+        const size_t ringSize = 2048;
+        const size_t messageMax = 200;
+        const size_t pendingMax = 10000;
+        const std::chrono::milliseconds fullTimeout(100);
+
+        std::atomic<uint64_t> systemIDs(0);
+
+        struct PrefixCache
+        {
+            uint64_t systemID = 0;
+            std::unordered_map<std::string, uint32_t> ids;
+        };
+    }
+
     struct LogSystem::Private
     {
+        uint64_t id = 0;
         std::chrono::steady_clock::time_point startTime;
+        std::atomic<int> level;
         std::shared_ptr<ObservableList<LogItem> > observableItems;
-        std::vector<LogItem> items;
-        std::mutex mutex;
+
+        std::mutex prefixMutex;
+        std::vector<std::string> prefixes;
+        std::map<std::string, uint32_t> prefixIDs;
+
+        // Bounded multiple producer queue. Each slot has a sequence number
+        // that tells the producers and the consumer whether it is free.
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            float time = 0.F;
+            LogType type = LogType::Message;
+            uint32_t prefix = 0;
+            size_t size = 0;
+            char message[messageMax];
+            std::string longMessage;
+        };
+        std::vector<Slot> slots;
+        std::atomic<size_t> enqueuePos;
+        std::atomic<size_t> dropped;
+
+        // The consumer mutex serializes the log thread and tick().
+        std::mutex consumerMutex;
+        size_t dequeuePos = 0;
+        std::vector<LogItem> batch;
+        std::vector<std::shared_ptr<ILogSink> > sinks;
+        std::vector<LogItem> pending;
+        size_t pendingDropped = 0;
+
+        std::mutex threadMutex;
+        std::condition_variable cv;
+        std::atomic<bool> wake;
+        bool stopped = false;
+        std::thread thread;
+        std::function<void()> contextWake;
+
+        uint32_t getPrefix(const std::string&);
+        bool push(float time, uint32_t prefix, const std::string&, LogType);
+        void notify();
     };
 
+    uint32_t LogSystem::Private::getPrefix(const std::string& prefix)
+    {
+        // Each thread keeps a cache of the prefix IDs so that the lock is
+        // only needed the first time a prefix is used.
+        thread_local PrefixCache cache;
+        if (cache.systemID != id)
+        {
+            cache.systemID = id;
+            cache.ids.clear();
+        }
+        const auto i = cache.ids.find(prefix);
+        if (i != cache.ids.end())
+        {
+            return i->second;
+        }
+        uint32_t out = 0;
+        {
+            std::unique_lock<std::mutex> lock(prefixMutex);
+            const auto j = prefixIDs.find(prefix);
+            if (j != prefixIDs.end())
+            {
+                out = j->second;
+            }
+            else
+            {
+                out = static_cast<uint32_t>(prefixes.size());
+                prefixes.push_back(prefix);
+                prefixIDs[prefix] = out;
+            }
+        }
+        cache.ids[prefix] = out;
+        return out;
+    }
+
+    bool LogSystem::Private::push(
+        float time,
+        uint32_t prefix,
+        const std::string& message,
+        LogType type)
+    {
+        Slot* slot = nullptr;
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (1)
+        {
+            slot = &slots[pos % ringSize];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (0 == diff)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->time = time;
+        slot->type = type;
+        slot->prefix = prefix;
+        slot->size = message.size();
+        if (message.size() <= messageMax)
+        {
+            memcpy(slot->message, message.data(), message.size());
+        }
+        else
+        {
+            slot->longMessage = message;
+        }
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void LogSystem::Private::notify()
+    {
+        // Only the first message after the log thread starts draining
+        // wakes it up, the following messages are drained together.
+        if (!wake.exchange(true))
+        {
+            {
+                std::unique_lock<std::mutex> lock(threadMutex);
+            }
+            cv.notify_one();
+        }
+    }
+
     LogSystem::LogSystem(const std::shared_ptr<Context>& context) :
         ISystem(context, "feather_tk::LogSystem"),
         _p(new Private)
     {
         FEATHER_TK_P();
+        p.id = ++systemIDs;
         p.startTime = std::chrono::steady_clock::now();
+        p.level = static_cast<int>(LogType::Message);
         p.observableItems = ObservableList<LogItem>::create();
+
+        p.slots = std::vector<Private::Slot>(ringSize);
+        for (size_t i = 0; i < ringSize; ++i)
+        {
+            p.slots[i].sequence = i;
+        }
+        p.enqueuePos = 0;
+        p.dropped = 0;
+        p.wake = false;
+        p.contextWake = context->getWakeFunc();
+
+        p.thread = std::thread(
+            [this]
+            {
+                FEATHER_TK_P();
+                while (1)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.threadMutex);
+                        p.cv.wait(
+                            lock,
+                            [this]
+                            {
+                                return _p->stopped || _p->wake;
+                            });
+                        if (p.stopped)
+                        {
+                            break;
+                        }
+                    }
+                    p.wake = false;
+                    if (_drain())
+                    {
+                        // Wake the application to deliver the new items.
+                        p.contextWake();
+                    }
+                }
+            });
     }
 
     LogSystem::~LogSystem()
-    {}
+    {
+        FEATHER_TK_P();
+        {
+            std::unique_lock<std::mutex> lock(p.threadMutex);
+            p.stopped = true;
+        }
+        p.cv.notify_one();
+        if (p.thread.joinable())
+        {
+            p.thread.join();
+        }
+        _drain();
+    }
 
     std::shared_ptr<LogSystem> LogSystem::create(const std::shared_ptr<Context>& context)
     {
@@ -82,10 +391,74 @@ namespace feather_tk
         LogType type)
     {
         FEATHER_TK_P();
+        if (!isLogged(type))
+            return;
         const auto now = std::chrono::steady_clock::now();
         const std::chrono::duration<float> time = now - p.startTime;
-        std::unique_lock<std::mutex> lock(p.mutex);
-        p.items.push_back({ time.count(), prefix, value, type });
+        const uint32_t prefixID = p.getPrefix(prefix);
+        if (p.push(time.count(), prefixID, value, type))
+        {
+            p.notify();
+        }
+        else
+        {
+            // The ring buffer is full, wake up the log thread and wait for
+            // it to make room. The message is dropped if the sinks cannot
+            // keep up.
+            bool pushed = false;
+            while (!pushed && std::chrono::steady_clock::now() - now < fullTimeout)
+            {
+                p.notify();
+                std::this_thread::yield();
+                pushed = p.push(time.count(), prefixID, value, type);
+            }
+            if (pushed)
+            {
+                p.notify();
+            }
+            else
+            {
+                ++p.dropped;
+            }
+        }
+    }
+
+    LogType LogSystem::getLevel() const
+    {
+        return static_cast<LogType>(_p->level.load());
+    }
+
+    void LogSystem::setLevel(LogType value)
+    {
+        _p->level = static_cast<int>(value);
+    }
+
+    bool LogSystem::isLogged(LogType value) const
+    {
+        return static_cast<int>(value) >= _p->level.load(std::memory_order_relaxed);
+    }
+
+    void LogSystem::addSink(const std::shared_ptr<ILogSink>& value)
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.consumerMutex);
+        p.sinks.push_back(value);
+    }
+
+    void LogSystem::removeSink(const std::shared_ptr<ILogSink>& value)
+    {
+        FEATHER_TK_P();
+        std::unique_lock<std::mutex> lock(p.consumerMutex);
+        const auto i = std::find(p.sinks.begin(), p.sinks.end(), value);
+        if (i != p.sinks.end())
+        {
+            p.sinks.erase(i);
+        }
+    }
+
+    void LogSystem::flush()
+    {
+        _drain();
     }
 
     std::shared_ptr<IObservableList<LogItem> > LogSystem::observeLogItems() const
@@ -96,10 +469,22 @@ namespace feather_tk
     void LogSystem::tick()
     {
         FEATHER_TK_P();
+        _drain();
         std::vector<LogItem> items;
         {
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.items.swap(items);
+            std::unique_lock<std::mutex> lock(p.consumerMutex);
+            p.pending.swap(items);
+            if (p.pendingDropped > 0)
+            {
+                LogItem item;
+                item.time = std::chrono::duration<float>(
+                    std::chrono::steady_clock::now() - p.startTime).count();
+                item.prefix = "feather_tk::LogSystem";
+                item.message = Format("{0} log items were not observed").arg(p.pendingDropped);
+                item.type = LogType::Warning;
+                items.push_back(item);
+                p.pendingDropped = 0;
+            }
         }
         p.observableItems->setIfChanged(items);
     }
@@ -108,4 +493,87 @@ namespace feather_tk
     {
         return std::chrono::milliseconds(100);
     }
+
+    bool LogSystem::_drain()
+    {
+        FEATHER_TK_P();
+        bool out = false;
+        std::unique_lock<std::mutex> lock(p.consumerMutex);
+        p.batch.clear();
+        std::unique_lock<std::mutex> prefixLock(p.prefixMutex);
+        while (1)
+        {
+            auto& slot = p.slots[p.dequeuePos % ringSize];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != p.dequeuePos + 1)
+                break;
+            LogItem item;
+            item.time = slot.time;
+            item.type = slot.type;
+            if (slot.size <= messageMax)
+            {
+                item.message.assign(slot.message, slot.size);
+            }
+            else
+            {
+                item.message.swap(slot.longMessage);
+            }
+            item.prefix = p.prefixes[slot.prefix];
+            p.batch.push_back(std::move(item));
+            slot.sequence.store(p.dequeuePos + ringSize, std::memory_order_release);
+            ++p.dequeuePos;
+        }
+        prefixLock.unlock();
+        if (const size_t dropped = p.dropped.exchange(0))
+        {
+            LogItem item;
+            item.time = std::chrono::duration<float>(
+                std::chrono::steady_clock::now() - p.startTime).count();
+            item.prefix = "feather_tk::LogSystem";
+            item.message = Format("{0} log messages were dropped").arg(dropped);
+            item.type = LogType::Warning;
+            p.batch.push_back(item);
+        }
+        if (!p.batch.empty())
+        {
+            // Sinks that throw, for example when the disk is full, are
+            // removed so they do not stop the log thread. The errors are
+            // added to the log items.
+            std::vector<LogItem> errors;
+            auto i = p.sinks.begin();
+            while (i != p.sinks.end())
+            {
+                try
+                {
+                    (*i)->write(p.batch);
+                    ++i;
+                }
+                catch (const std::exception& e)
+                {
+                    LogItem item;
+                    item.time = std::chrono::duration<float>(
+                        std::chrono::steady_clock::now() - p.startTime).count();
+                    item.prefix = "feather_tk::LogSystem";
+                    item.message = Format("The log sink was removed: {0}").arg(e.what());
+                    item.type = LogType::Error;
+                    errors.push_back(item);
+                    i = p.sinks.erase(i);
+                }
+            }
+            p.batch.insert(p.batch.end(), errors.begin(), errors.end());
+            out = p.pending.empty();
+            for (auto& item : p.batch)
+            {
+                if (p.pending.size() < pendingMax)
+                {
+                    p.pending.push_back(std::move(item));
+                }
+                else
+                {
+                    ++p.pendingDropped;
+                }
+            }
+        }
+        return out;
+    }
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <feather-tk/core/ObservableList.h>
 
 #include <chrono>
+#include <filesystem>
 
 namespace feather_tk
 {
@@ -36,8 +37,81 @@ namespace feather_tk
 
     //! Convert a log item to a string.
     std::string toString(const LogItem&);
+
+    //! Base class for log sinks.
+    //!
+    //! Sinks are called from the log system thread with batches of log
+    //! items.
+    class ILogSink : public std::enable_shared_from_this<ILogSink>
+    {
+        FEATHER_TK_NON_COPYABLE(ILogSink);
+
+    protected:
+        ILogSink() = default;
+
+    public:
+        virtual ~ILogSink() = 0;
+
+        //! Write log items.
+        virtual void write(const std::vector<LogItem>&) = 0;
+    };
+
+    //! Log sink that writes to the standard error.
+    class StdErrLogSink : public ILogSink
+    {
+    protected:
+        StdErrLogSink() = default;
+
+    public:
+        virtual ~StdErrLogSink();
+
+        //! Create a new sink.
+        static std::shared_ptr<StdErrLogSink> create();
+
+        void write(const std::vector<LogItem>&) override;
+    };
+
+    //! Log sink that writes to a file.
+    //!
+    //! When the file reaches the maximum size it is renamed with the
+    //! suffix ".1", the previous files are shifted to ".2", ".3", etc., and
+    //! a new file is started. Only the given number of previous files are
+    //! kept.
+    class FileLogSink : public ILogSink
+    {
+    protected:
+        FileLogSink(
+            const std::filesystem::path&,
+            size_t maxSize,
+            size_t maxFiles);
+
+    public:
+        virtual ~FileLogSink();
+
+        //! Create a new sink.
+        static std::shared_ptr<FileLogSink> create(
+            const std::filesystem::path&,
+            size_t maxSize = 10 * 1024 * 1024,
+            size_t maxFiles = 3);
+
+        void write(const std::vector<LogItem>&) override;
+
+    private:
+        FEATHER_TK_PRIVATE();
+    };
         
     //! Log system.
+    //!
+    //! Printing to the log does not lock or allocate memory in the common
+    //! case. The messages are copied into a fixed size ring buffer, and a
+    //! separate thread drains the buffer to the sinks. The thread sleeps
+    //! until the first message after a drain wakes it up. The log items are
+    //! also available to observers on the main thread when the system is
+    //! ticked.
+    //!
+    //! If the ring buffer is full the messages are dropped, and a warning
+    //! with the number of dropped messages is added to the log. Long
+    //! messages are allocated separately.
     class LogSystem : public ISystem
     {
     protected:
@@ -54,6 +128,26 @@ namespace feather_tk
             const std::string& prefix,
             const std::string&,
             LogType = LogType::Message);
+
+        //! Get the log level. Messages with a lower type than the log
+        //! level are ignored.
+        LogType getLevel() const;
+
+        //! Set the log level.
+        void setLevel(LogType);
+
+        //! Get whether messages of the given type are logged. This can be
+        //! used to skip formatting messages that would be ignored.
+        bool isLogged(LogType) const;
+
+        //! Add a sink.
+        void addSink(const std::shared_ptr<ILogSink>&);
+
+        //! Remove a sink.
+        void removeSink(const std::shared_ptr<ILogSink>&);
+
+        //! Write the pending messages to the sinks.
+        void flush();
             
         //! Observe the log items.
         std::shared_ptr<IObservableList<LogItem> > observeLogItems() const;
@@ -62,6 +156,8 @@ namespace feather_tk
         std::chrono::milliseconds getTickTime() const override;
 
     private:
+        bool _drain();
+
         FEATHER_TK_PRIVATE();
     };
 
@@ -6,8 +6,127 @@
 
 #include <feather-tk/core/Math.h>
 
+#include <algorithm>
+#include <map>
+
 namespace feather_tk
 {
+    void CompactMesh2F::addTriangle(uint32_t a, uint32_t b, uint32_t c)
+    {
+        if (indices32.empty() && std::max(a, std::max(b, c)) > 65535)
+        {
+            indices32.reserve(indices16.size() + 3);
+            indices32.assign(indices16.begin(), indices16.end());
+            std::vector<uint16_t>().swap(indices16);
+        }
+        if (indices32.empty())
+        {
+            indices16.push_back(static_cast<uint16_t>(a));
+            indices16.push_back(static_cast<uint16_t>(b));
+            indices16.push_back(static_cast<uint16_t>(c));
+        }
+        else
+        {
+            indices32.push_back(a);
+            indices32.push_back(b);
+            indices32.push_back(c);
+        }
+    }
+
+    size_t CompactMesh2F::getByteCount() const
+    {
+        return
+            v.size() * sizeof(V2F) +
+            c.size() * sizeof(V4F) +
+            t.size() * sizeof(V2F) +
+            indices16.size() * sizeof(uint16_t) +
+            indices32.size() * sizeof(uint32_t);
+    }
+
+    bool CompactMesh2F::operator == (const CompactMesh2F& other) const
+    {
+        return
+            v == other.v &&
+            c == other.c &&
+            t == other.t &&
+            indices16 == other.indices16 &&
+            indices32 == other.indices32;
+    }
+
+    bool CompactMesh2F::operator != (const CompactMesh2F& other) const
+    {
+        return !(*this == other);
+    }
+
+    CompactMesh2F compactMesh(const TriMesh2F& mesh)
+    {
+        CompactMesh2F out;
+        bool hasColors = false;
+        bool hasTextures = false;
+        for (const auto& triangle : mesh.triangles)
+        {
+            for (const auto& vertex : triangle.v)
+            {
+                hasColors |= vertex.c != 0;
+                hasTextures |= vertex.t != 0;
+            }
+        }
+        std::map<std::array<size_t, 3>, uint32_t> vertices;
+        out.v.reserve(mesh.v.size());
+        for (const auto& triangle : mesh.triangles)
+        {
+            std::array<uint32_t, 3> indices;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const Vertex2& vertex = triangle.v[k];
+                const std::array<size_t, 3> key = { vertex.v, vertex.c, vertex.t };
+                const auto i = vertices.find(key);
+                if (i != vertices.end())
+                {
+                    indices[k] = i->second;
+                }
+                else
+                {
+                    indices[k] = static_cast<uint32_t>(out.v.size());
+                    vertices[key] = indices[k];
+                    out.v.push_back(vertex.v ? mesh.v[vertex.v - 1] : V2F());
+                    if (hasColors)
+                    {
+                        out.c.push_back(vertex.c ? mesh.c[vertex.c - 1] : V4F(1.F, 1.F, 1.F, 1.F));
+                    }
+                    if (hasTextures)
+                    {
+                        out.t.push_back(vertex.t ? mesh.t[vertex.t - 1] : V2F());
+                    }
+                }
+            }
+            out.addTriangle(indices[0], indices[1], indices[2]);
+        }
+        return out;
+    }
+
+    TriMesh2F triMesh(const CompactMesh2F& mesh)
+    {
+        TriMesh2F out;
+        out.v = mesh.v;
+        out.c = mesh.c;
+        out.t = mesh.t;
+        const size_t triangleCount = mesh.getTriangleCount();
+        out.triangles.resize(triangleCount);
+        for (size_t i = 0; i < triangleCount; ++i)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const size_t index = mesh.getIndex(i * 3 + k) + 1;
+                out.triangles[i].v[k] = Vertex2(
+                    index,
+                    !mesh.t.empty() ? index : 0,
+                    !mesh.c.empty() ? index : 0);
+            }
+        }
+        return out;
+    }
+
     TriMesh2F mesh(const Box2I& box, bool flipV)
     {
         TriMesh2F out;
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace feather_tk
@@ -75,6 +76,53 @@ namespace feather_tk
     typedef TriangleMesh2<float> TriMesh2F;
     typedef TriangleMesh3<float> TriMesh3F;
 
+    //! Compact two-dimensional triangle mesh.
+    //!
+    //! The vertex attributes are stored in separate arrays. The colors
+    //! and texture coordinates are optional, they are either empty or
+    //! have one element per position.
+    //!
+    //! Triangles are stored as zero-based indices. The indices are 16-bit
+    //! while the mesh has less than 65536 vertices, and are converted to
+    //! 32-bit when a triangle references a larger index.
+    struct CompactMesh2F
+    {
+        std::vector<V2F>      v;
+        std::vector<V4F>      c;
+        std::vector<V2F>      t;
+        std::vector<uint16_t> indices16;
+        std::vector<uint32_t> indices32;
+
+        //! Get whether the indices are 32-bit.
+        bool is32Bit() const;
+
+        //! Get the number of indices.
+        size_t getIndexCount() const;
+
+        //! Get the number of triangles.
+        size_t getTriangleCount() const;
+
+        //! Get an index.
+        uint32_t getIndex(size_t) const;
+
+        //! Add a triangle.
+        void addTriangle(uint32_t, uint32_t, uint32_t);
+
+        //! Get the number of bytes used by the mesh.
+        size_t getByteCount() const;
+
+        bool operator == (const CompactMesh2F&) const;
+        bool operator != (const CompactMesh2F&) const;
+    };
+
+    //! Convert a triangle mesh to a compact mesh. Triangle corners that
+    //! share the same position, color, and texture coordinate indices
+    //! share a vertex.
+    CompactMesh2F compactMesh(const TriMesh2F&);
+
+    //! Convert a compact mesh to a triangle mesh.
+    TriMesh2F triMesh(const CompactMesh2F&);
+
     //! Edge function.
     float edge(const V2F& p, const V2F& v0, const V2F& v1);
         
@@ -17,6 +17,26 @@ namespace feather_tk
         c(c)
     {}
 
+    inline bool CompactMesh2F::is32Bit() const
+    {
+        return !indices32.empty();
+    }
+
+    inline size_t CompactMesh2F::getIndexCount() const
+    {
+        return indices32.empty() ? indices16.size() : indices32.size();
+    }
+
+    inline size_t CompactMesh2F::getTriangleCount() const
+    {
+        return getIndexCount() / 3;
+    }
+
+    inline uint32_t CompactMesh2F::getIndex(size_t value) const
+    {
+        return indices32.empty() ? indices16[value] : indices32[value];
+    }
+
     inline float edge(const V2F& p, const V2F& v0, const V2F& v1)
     {
         return
@@ -15,6 +15,15 @@ namespace feather_tk
         Trigger,
         Suppress
     };
+
+    //! Observable change types.
+    enum class ObservableChangeType
+    {
+        Reset,  //!< The whole value changed
+        Insert, //!< Items were inserted
+        Remove, //!< Items were removed
+        Update  //!< Items were updated in place
+    };
         
     ///@}
 }
@@ -22,6 +22,25 @@ namespace feather_tk
     //! Invalid index.
     static const std::size_t ObservableListInvalidIndex = static_cast<std::size_t>(-1);
 
+    //! List change. The index refers to the list after the previous
+    //! changes have been applied. For removed items the index and count
+    //! refer to the list before the items were removed.
+    struct ListChange
+    {
+        ListChange() = default;
+        ListChange(
+            ObservableChangeType,
+            std::size_t index = 0,
+            std::size_t count = 0);
+
+        ObservableChangeType type  = ObservableChangeType::Reset;
+        std::size_t          index = 0;
+        std::size_t          count = 0;
+
+        bool operator == (const ListChange&) const;
+        bool operator != (const ListChange&) const;
+    };
+
     //! List observer.
     template<typename T>
     class ListObserver : public std::enable_shared_from_this<ListObserver<T> >
@@ -53,6 +72,42 @@ namespace feather_tk
         std::weak_ptr<IObservableList<T> > _value;
     };
 
+    //! List change observer.
+    //!
+    //! The callback receives the list and the changes since the previous
+    //! callback, so that views can be updated incrementally. A reset change
+    //! means that the whole list should be reloaded.
+    template<typename T>
+    class ListChangeObserver : public std::enable_shared_from_this<ListChangeObserver<T> >
+    {
+        FEATHER_TK_NON_COPYABLE(ListChangeObserver);
+
+    protected:
+        void _init(
+            const std::shared_ptr<IObservableList<T> >&,
+            const std::function<void(const std::vector<T>&, const std::vector<ListChange>&)>&,
+            ObserverAction);
+
+        ListChangeObserver() = default;
+
+    public:
+        ~ListChangeObserver();
+
+        //! Create a new list change observer. If the callback is
+        //! triggered, it receives a reset change.
+        static std::shared_ptr<ListChangeObserver<T> > create(
+            const std::shared_ptr<IObservableList<T> >&,
+            const std::function<void(const std::vector<T>&, const std::vector<ListChange>&)>&,
+            ObserverAction = ObserverAction::Trigger);
+
+        //! Execute the callback.
+        void doCallback(const std::vector<T>&, const std::vector<ListChange>&);
+
+    private:
+        std::function<void(const std::vector<T>&, const std::vector<ListChange>&)> _callback;
+        std::weak_ptr<IObservableList<T> > _value;
+    };
+
     //! Base class for observable lists.
     template<typename T>
     class IObservableList
@@ -83,11 +138,14 @@ namespace feather_tk
 
     protected:
         void _add(const std::weak_ptr<ListObserver<T> >&);
+        void _add(const std::weak_ptr<ListChangeObserver<T> >&);
         void _removeExpired();
 
         std::vector<std::weak_ptr<ListObserver<T> > > _observers;
+        std::vector<std::weak_ptr<ListChangeObserver<T> > > _changeObservers;
 
         friend ListObserver<T>;
+        friend ListChangeObserver<T>;
     };
 
     //! Observable list.
@@ -125,9 +183,20 @@ namespace feather_tk
         //! Append a list item.
         void pushBack(const T&);
 
+        //! Insert a list item.
+        void insertItem(std::size_t, const T&);
+
         //! Remove an item.
         void removeItem(std::size_t);
 
+        //! Begin a batch of changes. The observers are not called until
+        //! the batch is ended, and then only once with all of the changes.
+        //! Batches may be nested.
+        void beginBatch();
+
+        //! End a batch of changes.
+        void endBatch();
+
         const std::vector<T>& get() const override;
         std::size_t getSize() const override;
         bool isEmpty() const override;
@@ -136,7 +205,12 @@ namespace feather_tk
         std::size_t indexOf(const T&) const override;
 
     private:
+        void _change(const ListChange&);
+        void _notify();
+
         std::vector<T> _value;
+        std::size_t _batch = 0;
+        std::vector<ListChange> _changes;
     };
         
     ///@}
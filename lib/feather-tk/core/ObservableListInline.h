@@ -6,6 +6,28 @@
 
 namespace feather_tk
 {
+    inline ListChange::ListChange(
+        ObservableChangeType type,
+        std::size_t index,
+        std::size_t count) :
+        type(type),
+        index(index),
+        count(count)
+    {}
+
+    inline bool ListChange::operator == (const ListChange& other) const
+    {
+        return
+            type == other.type &&
+            index == other.index &&
+            count == other.count;
+    }
+
+    inline bool ListChange::operator != (const ListChange& other) const
+    {
+        return !(*this == other);
+    }
+
     template<typename T>
     inline void ListObserver<T>::_init(
         const std::shared_ptr<IObservableList<T> >& value,
@@ -50,6 +72,52 @@ namespace feather_tk
         _callback(value);
     }
 
+    template<typename T>
+    inline void ListChangeObserver<T>::_init(
+        const std::shared_ptr<IObservableList<T> >& value,
+        const std::function<void(const std::vector<T>&, const std::vector<ListChange>&)>& callback,
+        ObserverAction action)
+    {
+        _value = value;
+        _callback = callback;
+        if (auto value = _value.lock())
+        {
+            value->_add(ListChangeObserver<T>::shared_from_this());
+            if (ObserverAction::Trigger == action)
+            {
+                _callback(value->get(), { ListChange(ObservableChangeType::Reset) });
+            }
+        }
+    }
+
+    template<typename T>
+    inline ListChangeObserver<T>::~ListChangeObserver()
+    {
+        if (auto value = _value.lock())
+        {
+            value->_removeExpired();
+        }
+    }
+
+    template<typename T>
+    inline std::shared_ptr<ListChangeObserver<T> > ListChangeObserver<T>::create(
+        const std::shared_ptr<IObservableList<T> >& value,
+        const std::function<void(const std::vector<T>&, const std::vector<ListChange>&)>& callback,
+        ObserverAction action)
+    {
+        std::shared_ptr<ListChangeObserver<T> > out(new ListChangeObserver<T>);
+        out->_init(value, callback, action);
+        return out;
+    }
+
+    template<typename T>
+    inline void ListChangeObserver<T>::doCallback(
+        const std::vector<T>& value,
+        const std::vector<ListChange>& changes)
+    {
+        _callback(value, changes);
+    }
+
     template<typename T>
     inline IObservableList<T>::~IObservableList()
     {}
@@ -57,7 +125,7 @@ namespace feather_tk
     template<typename T>
     inline std::size_t IObservableList<T>::getObserversCount() const
     {
-        return _observers.size();
+        return _observers.size() + _changeObservers.size();
     }
 
     template<typename T>
@@ -66,6 +134,12 @@ namespace feather_tk
         _observers.push_back(observer);
     }
 
+    template<typename T>
+    inline void IObservableList<T>::_add(const std::weak_ptr<ListChangeObserver<T> >& observer)
+    {
+        _changeObservers.push_back(observer);
+    }
+
     template<typename T>
     inline void IObservableList<T>::_removeExpired()
     {
@@ -81,6 +155,18 @@ namespace feather_tk
                 ++i;
             }
         }
+        auto j = _changeObservers.begin();
+        while (j != _changeObservers.end())
+        {
+            if (j->expired())
+            {
+                j = _changeObservers.erase(j);
+            }
+            else
+            {
+                ++j;
+            }
+        }
     }
 
     template<typename T>
@@ -104,28 +190,49 @@ namespace feather_tk
     inline void ObservableList<T>::setAlways(const std::vector<T>& value)
     {
         _value = value;
-        for (const auto& i : IObservableList<T>::_observers)
-        {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
-        }
+        _change(ListChange(ObservableChangeType::Reset));
     }
 
     template<typename T>
     inline bool ObservableList<T>::setIfChanged(const std::vector<T>& value)
     {
-        if (value == _value)
+        // Find the items that have changed between the common prefix and
+        // suffix, so that the observers only need to update that range.
+        const std::size_t oldSize = _value.size();
+        const std::size_t newSize = value.size();
+        const std::size_t size = std::min(oldSize, newSize);
+        std::size_t prefix = 0;
+        while (prefix < size && value[prefix] == _value[prefix])
+        {
+            ++prefix;
+        }
+        if (prefix == oldSize && prefix == newSize)
             return false;
+        std::size_t suffix = 0;
+        while (suffix < size - prefix &&
+            value[newSize - 1 - suffix] == _value[oldSize - 1 - suffix])
+        {
+            ++suffix;
+        }
         _value = value;
-        for (const auto& i : IObservableList<T>::_observers)
+
+        const std::size_t oldCount = oldSize - prefix - suffix;
+        const std::size_t newCount = newSize - prefix - suffix;
+        const std::size_t updateCount = std::min(oldCount, newCount);
+        beginBatch();
+        if (updateCount > 0)
         {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
+            _change(ListChange(ObservableChangeType::Update, prefix, updateCount));
+        }
+        if (oldCount > newCount)
+        {
+            _change(ListChange(ObservableChangeType::Remove, prefix + updateCount, oldCount - newCount));
         }
+        else if (newCount > oldCount)
+        {
+            _change(ListChange(ObservableChangeType::Insert, prefix + updateCount, newCount - oldCount));
+        }
+        endBatch();
         return true;
     }
 
@@ -134,14 +241,9 @@ namespace feather_tk
     {
         if (_value.size())
         {
+            const std::size_t size = _value.size();
             _value.clear();
-            for (const auto& i : IObservableList<T>::_observers)
-            {
-                if (auto observer = i.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _change(ListChange(ObservableChangeType::Remove, 0, size));
         }
     }
 
@@ -149,13 +251,7 @@ namespace feather_tk
     inline void ObservableList<T>::setItem(std::size_t index, const T& value)
     {
         _value[index] = value;
-        for (const auto& i : IObservableList<T>::_observers)
-        {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
-        }
+        _change(ListChange(ObservableChangeType::Update, index, 1));
     }
 
     template<typename T>
@@ -164,37 +260,45 @@ namespace feather_tk
         if (value == _value[index])
             return;
         _value[index] = value;
-        for (const auto& i : IObservableList<T>::_observers)
-        {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
-        }
+        _change(ListChange(ObservableChangeType::Update, index, 1));
     }
 
     template<typename T>
     inline void ObservableList<T>::pushBack(const T& value)
     {
         _value.push_back(value);
-        for (const auto& i : IObservableList<T>::_observers)
-        {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
-        }
+        _change(ListChange(ObservableChangeType::Insert, _value.size() - 1, 1));
+    }
+
+    template<typename T>
+    inline void ObservableList<T>::insertItem(std::size_t index, const T& value)
+    {
+        _value.insert(_value.begin() + index, value);
+        _change(ListChange(ObservableChangeType::Insert, index, 1));
     }
 
     template<typename T>
     inline void ObservableList<T>::removeItem(std::size_t index)
     {
         _value.erase(_value.begin() + index);
-        for (const auto& i : IObservableList<T>::_observers)
+        _change(ListChange(ObservableChangeType::Remove, index, 1));
+    }
+
+    template<typename T>
+    inline void ObservableList<T>::beginBatch()
+    {
+        ++_batch;
+    }
+
+    template<typename T>
+    inline void ObservableList<T>::endBatch()
+    {
+        if (_batch > 0)
         {
-            if (auto observer = i.lock())
+            --_batch;
+            if (0 == _batch && !_changes.empty())
             {
-                observer->doCallback(_value);
+                _notify();
             }
         }
     }
@@ -248,4 +352,101 @@ namespace feather_tk
             });
         return i != _value.end() ? i - _value.begin() : ObservableListInvalidIndex;
     }
+
+    template<typename T>
+    inline void ObservableList<T>::_change(const ListChange& change)
+    {
+        // Merge the change with the previous one when possible, so that a
+        // batch of appends is reported as a single range.
+        bool merged = false;
+        if (!_changes.empty())
+        {
+            auto& last = _changes.back();
+            if (ObservableChangeType::Reset == last.type)
+            {
+                merged = true;
+            }
+            else if (ObservableChangeType::Reset == change.type)
+            {
+                _changes.clear();
+            }
+            else if (change.type == last.type)
+            {
+                switch (change.type)
+                {
+                case ObservableChangeType::Insert:
+                    if (change.index >= last.index &&
+                        change.index <= last.index + last.count)
+                    {
+                        last.count += change.count;
+                        merged = true;
+                    }
+                    break;
+                case ObservableChangeType::Remove:
+                    if (change.index == last.index)
+                    {
+                        last.count += change.count;
+                        merged = true;
+                    }
+                    else if (change.index + change.count == last.index)
+                    {
+                        last.index = change.index;
+                        last.count += change.count;
+                        merged = true;
+                    }
+                    break;
+                case ObservableChangeType::Update:
+                    if (change.index <= last.index + last.count &&
+                        change.index + change.count >= last.index)
+                    {
+                        const std::size_t end = std::max(
+                            last.index + last.count,
+                            change.index + change.count);
+                        last.index = std::min(last.index, change.index);
+                        last.count = end - last.index;
+                        merged = true;
+                    }
+                    break;
+                default: break;
+                }
+            }
+        }
+        if (!merged)
+        {
+            _changes.push_back(change);
+        }
+
+        // If there are more changes than items it is simpler for the
+        // observers to reload the list.
+        if (_changes.size() > 1 && _changes.size() > _value.size())
+        {
+            _changes = { ListChange(ObservableChangeType::Reset) };
+        }
+
+        if (0 == _batch)
+        {
+            _notify();
+        }
+    }
+
+    template<typename T>
+    inline void ObservableList<T>::_notify()
+    {
+        std::vector<ListChange> changes;
+        changes.swap(_changes);
+        for (const auto& i : IObservableList<T>::_observers)
+        {
+            if (auto observer = i.lock())
+            {
+                observer->doCallback(_value);
+            }
+        }
+        for (const auto& i : IObservableList<T>::_changeObservers)
+        {
+            if (auto observer = i.lock())
+            {
+                observer->doCallback(_value, changes);
+            }
+        }
+    }
 }
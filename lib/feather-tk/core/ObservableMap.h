@@ -20,6 +20,17 @@ namespace feather_tk
     template<typename T, typename U>
     class IObservableMap;
 
+    //! Map change.
+    template<typename T>
+    struct MapChange
+    {
+        ObservableChangeType type = ObservableChangeType::Reset;
+        T                    key  = T();
+
+        bool operator == (const MapChange<T>&) const;
+        bool operator != (const MapChange<T>&) const;
+    };
+
     //! Map observer.
     template<typename T, typename U>
     class MapObserver : public std::enable_shared_from_this<MapObserver<T, U> >
@@ -50,6 +61,41 @@ namespace feather_tk
         std::weak_ptr<IObservableMap<T, U> > _value;
     };
 
+    //! Map change observer.
+    //!
+    //! The callback receives the map and the keys that have changed since
+    //! the previous callback. A reset change means that the whole map
+    //! should be reloaded.
+    template<typename T, typename U>
+    class MapChangeObserver : public std::enable_shared_from_this<MapChangeObserver<T, U> >
+    {
+        FEATHER_TK_NON_COPYABLE(MapChangeObserver);
+
+        void _init(
+            const std::shared_ptr<IObservableMap<T, U> >&,
+            const std::function<void(const std::map<T, U>&, const std::vector<MapChange<T> >&)>&,
+            ObserverAction);
+
+        MapChangeObserver() = default;
+
+    public:
+        ~MapChangeObserver();
+
+        //! Create a new map change observer. If the callback is triggered,
+        //! it receives a reset change.
+        static std::shared_ptr<MapChangeObserver<T, U> > create(
+            const std::shared_ptr<IObservableMap<T, U> >&,
+            const std::function<void(const std::map<T, U>&, const std::vector<MapChange<T> >&)>&,
+            ObserverAction = ObserverAction::Trigger);
+
+        //! Execute the callback.
+        void doCallback(const std::map<T, U>&, const std::vector<MapChange<T> >&);
+
+    private:
+        std::function<void(const std::map<T, U>&, const std::vector<MapChange<T> >&)> _callback;
+        std::weak_ptr<IObservableMap<T, U> > _value;
+    };
+
     //! Base class for observable maps.
     template<typename T, typename U>
     class IObservableMap
@@ -77,11 +123,14 @@ namespace feather_tk
 
     protected:
         void _add(const std::weak_ptr<MapObserver<T, U> >&);
+        void _add(const std::weak_ptr<MapChangeObserver<T, U> >&);
         void _removeExpired();
 
         std::vector<std::weak_ptr<MapObserver<T, U> > > _observers;
+        std::vector<std::weak_ptr<MapChangeObserver<T, U> > > _changeObservers;
 
         friend MapObserver<T, U>;
+        friend MapChangeObserver<T, U>;
     };
 
     //! Observable map.
@@ -116,6 +165,17 @@ namespace feather_tk
         //! Set a map item only if it has changed.
         void setItemOnlyIfChanged(const T&, const U&);
 
+        //! Remove a map item.
+        void removeItem(const T&);
+
+        //! Begin a batch of changes. The observers are not called until
+        //! the batch is ended, and then only once with all of the changes.
+        //! Batches may be nested.
+        void beginBatch();
+
+        //! End a batch of changes.
+        void endBatch();
+
         const std::map<T, U>& get() const override;
         std::size_t getSize() const override;
         bool isEmpty() const override;
@@ -123,7 +183,13 @@ namespace feather_tk
         const U& getItem(const T&) const override;
 
     private:
+        void _change(ObservableChangeType, const T& = T());
+        void _notify();
+
         std::map<T, U> _value;
+        std::size_t _batch = 0;
+        bool _reset = false;
+        std::map<T, ObservableChangeType> _changes;
     };
         
     ///@}
@@ -6,6 +6,20 @@
 
 namespace feather_tk
 {
+    template<typename T>
+    inline bool MapChange<T>::operator == (const MapChange<T>& other) const
+    {
+        return
+            type == other.type &&
+            key == other.key;
+    }
+
+    template<typename T>
+    inline bool MapChange<T>::operator != (const MapChange<T>& other) const
+    {
+        return !(*this == other);
+    }
+
     template<typename T, typename U>
     inline void MapObserver<T, U>::_init(
         const std::shared_ptr<IObservableMap<T, U> >& value,
@@ -50,6 +64,52 @@ namespace feather_tk
         _callback(value);
     }
 
+    template<typename T, typename U>
+    inline void MapChangeObserver<T, U>::_init(
+        const std::shared_ptr<IObservableMap<T, U> >& value,
+        const std::function<void(const std::map<T, U>&, const std::vector<MapChange<T> >&)>& callback,
+        ObserverAction action)
+    {
+        _value = value;
+        _callback = callback;
+        if (auto value = _value.lock())
+        {
+            value->_add(MapChangeObserver<T, U>::shared_from_this());
+            if (ObserverAction::Trigger == action)
+            {
+                _callback(value->get(), { MapChange<T>() });
+            }
+        }
+    }
+
+    template<typename T, typename U>
+    inline MapChangeObserver<T, U>::~MapChangeObserver()
+    {
+        if (auto value = _value.lock())
+        {
+            value->_removeExpired();
+        }
+    }
+
+    template<typename T, typename U>
+    inline std::shared_ptr<MapChangeObserver<T, U> > MapChangeObserver<T, U>::create(
+        const std::shared_ptr<IObservableMap<T, U> >& value,
+        const std::function<void(const std::map<T, U>&, const std::vector<MapChange<T> >&)>& callback,
+        ObserverAction action)
+    {
+        std::shared_ptr<MapChangeObserver<T, U> > out(new MapChangeObserver<T, U>);
+        out->_init(value, callback, action);
+        return out;
+    }
+
+    template<typename T, typename U>
+    inline void MapChangeObserver<T, U>::doCallback(
+        const std::map<T, U>& value,
+        const std::vector<MapChange<T> >& changes)
+    {
+        _callback(value, changes);
+    }
+
     template<typename T, typename U>
     inline IObservableMap<T, U>::~IObservableMap()
     {}
@@ -57,7 +117,7 @@ namespace feather_tk
     template<typename T, typename U>
     inline std::size_t IObservableMap<T, U>::getObserversCount() const
     {
-        return _observers.size();
+        return _observers.size() + _changeObservers.size();
     }
 
     template<typename T, typename U>
@@ -66,6 +126,12 @@ namespace feather_tk
         _observers.push_back(observer);
     }
 
+    template<typename T, typename U>
+    inline void IObservableMap<T, U>::_add(const std::weak_ptr<MapChangeObserver<T, U> >& observer)
+    {
+        _changeObservers.push_back(observer);
+    }
+
     template<typename T, typename U>
     inline void IObservableMap<T, U>::_removeExpired()
     {
@@ -81,6 +147,18 @@ namespace feather_tk
                 ++i;
             }
         }
+        auto j = _changeObservers.begin();
+        while (j != _changeObservers.end())
+        {
+            if (j->expired())
+            {
+                j = _changeObservers.erase(j);
+            }
+            else
+            {
+                ++j;
+            }
+        }
     }
 
     template<typename T, typename U>
@@ -104,29 +182,48 @@ namespace feather_tk
     inline void ObservableMap<T, U>::setAlways(const std::map<T, U>& value)
     {
         _value = value;
-        for (const auto& i : IObservableMap<T, U>::_observers)
-        {
-            if (auto observer = i.lock())
-            {
-                observer->doCallback(_value);
-            }
-        }
+        _change(ObservableChangeType::Reset);
     }
 
     template<typename T, typename U>
     inline bool ObservableMap<T, U>::setIfChanged(const std::map<T, U>& value)
     {
-        if (value == _value)
-            return false;
-        _value = value;
-        for (const auto& i : IObservableMap<T, U>::_observers)
+        // Walk both maps in key order to find the changed keys.
+        beginBatch();
+        bool changed = false;
+        auto i = _value.begin();
+        auto j = value.begin();
+        while (i != _value.end() || j != value.end())
         {
-            if (auto observer = i.lock())
+            if (j == value.end() || (i != _value.end() && i->first < j->first))
             {
-                observer->doCallback(_value);
+                _change(ObservableChangeType::Remove, i->first);
+                changed = true;
+                ++i;
+            }
+            else if (i == _value.end() || j->first < i->first)
+            {
+                _change(ObservableChangeType::Insert, j->first);
+                changed = true;
+                ++j;
             }
+            else
+            {
+                if (!(i->second == j->second))
+                {
+                    _change(ObservableChangeType::Update, i->first);
+                    changed = true;
+                }
+                ++i;
+                ++j;
+            }
+        }
+        if (changed)
+        {
+            _value = value;
         }
-        return true;
+        endBatch();
+        return changed;
     }
 
     template<typename T, typename U>
@@ -135,27 +232,23 @@ namespace feather_tk
         if (_value.size())
         {
             _value.clear();
-            for (const auto& s : IObservableMap<T, U>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _change(ObservableChangeType::Reset);
         }
     }
 
     template<typename T, typename U>
     inline void ObservableMap<T, U>::setItem(const T& key, const U& value)
     {
-        _value[key] = value;
-
-        for (const auto& s : IObservableMap<T, U>::_observers)
+        const auto i = _value.find(key);
+        if (i != _value.end())
         {
-            if (auto observer = s.lock())
-            {
-                observer->doCallback(_value);
-            }
+            i->second = value;
+            _change(ObservableChangeType::Update, key);
+        }
+        else
+        {
+            _value[key] = value;
+            _change(ObservableChangeType::Insert, key);
         }
     }
 
@@ -165,12 +258,35 @@ namespace feather_tk
         const auto i = _value.find(key);
         if (i != _value.end() && i->second == value)
             return;
-        _value[key] = value;
-        for (const auto& s : IObservableMap<T, U>::_observers)
+        setItem(key, value);
+    }
+
+    template<typename T, typename U>
+    inline void ObservableMap<T, U>::removeItem(const T& key)
+    {
+        const auto i = _value.find(key);
+        if (i != _value.end())
+        {
+            _value.erase(i);
+            _change(ObservableChangeType::Remove, key);
+        }
+    }
+
+    template<typename T, typename U>
+    inline void ObservableMap<T, U>::beginBatch()
+    {
+        ++_batch;
+    }
+
+    template<typename T, typename U>
+    inline void ObservableMap<T, U>::endBatch()
+    {
+        if (_batch > 0)
         {
-            if (auto observer = s.lock())
+            --_batch;
+            if (0 == _batch && (_reset || !_changes.empty()))
             {
-                observer->doCallback(_value);
+                _notify();
             }
         }
     }
@@ -204,4 +320,78 @@ namespace feather_tk
     {
         return _value.find(key)->second;
     }
+
+    template<typename T, typename U>
+    inline void ObservableMap<T, U>::_change(ObservableChangeType type, const T& key)
+    {
+        if (ObservableChangeType::Reset == type)
+        {
+            _reset = true;
+            _changes.clear();
+        }
+        else if (!_reset)
+        {
+            // Combine the changes for the same key.
+            const auto i = _changes.find(key);
+            if (i == _changes.end())
+            {
+                _changes[key] = type;
+            }
+            else if (ObservableChangeType::Insert == i->second)
+            {
+                if (ObservableChangeType::Remove == type)
+                {
+                    _changes.erase(i);
+                }
+            }
+            else if (ObservableChangeType::Remove == i->second)
+            {
+                if (ObservableChangeType::Insert == type)
+                {
+                    i->second = ObservableChangeType::Update;
+                }
+            }
+            else
+            {
+                i->second = type;
+            }
+        }
+        if (0 == _batch)
+        {
+            _notify();
+        }
+    }
+
+    template<typename T, typename U>
+    inline void ObservableMap<T, U>::_notify()
+    {
+        std::vector<MapChange<T> > changes;
+        if (_reset)
+        {
+            changes.push_back(MapChange<T>());
+        }
+        else
+        {
+            for (const auto& i : _changes)
+            {
+                changes.push_back({ i.second, i.first });
+            }
+        }
+        _reset = false;
+        _changes.clear();
+        for (const auto& i : IObservableMap<T, U>::_observers)
+        {
+            if (auto observer = i.lock())
+            {
+                observer->doCallback(_value);
+            }
+        }
+        for (const auto& i : IObservableMap<T, U>::_changeObservers)
+        {
+            if (auto observer = i.lock())
+            {
+                observer->doCallback(_value, changes);
+            }
+        }
+    }
 }
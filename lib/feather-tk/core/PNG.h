@@ -14,6 +14,9 @@ namespace feather_tk
         ///@{
 
         //! PNG image reader.
+        //!
+        //! Files are read from a memory-map when possible. Interlaced
+        //! images are read one pass at a time.
         class ImageReader : public IImageReader
         {
         public:
@@ -26,12 +29,18 @@ namespace feather_tk
 
             const ImageInfo& getInfo() const override;
             std::shared_ptr<Image> read() override;
+            bool read(
+                const std::shared_ptr<Image>&,
+                const ImageReadCallback& = nullptr) override;
 
         private:
             FEATHER_TK_PRIVATE();
         };
 
         //! PNG image writer.
+        //!
+        //! Options:
+        //! * Interlace - Write an interlaced image ("0" or "1")
         class ImageWriter : public IImageWriter
         {
         public:
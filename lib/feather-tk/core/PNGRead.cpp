@@ -38,7 +38,8 @@ namespace feather_tk
                 uint16_t& width,
                 uint16_t& height,
                 uint8_t& channels,
-                uint8_t& bitDepth)
+                uint8_t& bitDepth,
+                int& passes)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
@@ -93,10 +94,7 @@ namespace feather_tk
                 png_set_sig_bytes(png, 8);
                 png_read_info(png, *pngInfo);
 
-                if (png_get_interlace_type(png, *pngInfo) != PNG_INTERLACE_NONE)
-                {
-                    return false;
-                }
+                passes = png_set_interlace_handling(png);
 
                 png_set_expand(png);
                 //png_set_gray_1_2_4_to_8(png);
@@ -156,9 +154,11 @@ namespace feather_tk
             png_infop    pngInfo = nullptr;
             png_infop    pngInfoEnd = nullptr;
             FILE*        f = nullptr;
+            std::shared_ptr<FileIO> fileIO;
             InMemoryFile memory;
             ErrorStruct  error;
             size_t       scanlineSize = 0;
+            int          passes = 1;
             ImageInfo    info;
         };
 
@@ -183,17 +183,30 @@ namespace feather_tk
             }
             else
             {
-#if defined(_WINDOWS)
-                if (_wfopen_s(&p.f, path.wstring().c_str(), L"rb") != 0)
+                // Read directly from a memory-map if it is available.
+                try
                 {
-                    p.f = nullptr;
+                    p.fileIO = FileIO::create(path, FileMode::Read);
+                    p.memory.p = p.fileIO->getMemoryStart();
+                    p.memory.size = p.fileIO->getSize();
                 }
+                catch (const std::exception&)
+                {}
+                if (!p.memory.p)
+                {
+                    p.fileIO.reset();
+#if defined(_WINDOWS)
+                    if (_wfopen_s(&p.f, path.wstring().c_str(), L"rb") != 0)
+                    {
+                        p.f = nullptr;
+                    }
 #else // _WINDOWS
-                p.f = fopen(path.u8string().c_str(), "rb");
+                    p.f = fopen(path.u8string().c_str(), "rb");
 #endif // _WINDOWS
-                if (!p.f)
-                {
-                    throw std::runtime_error(Format("Cannot open: \"{0}\"").arg(path.u8string()));
+                    if (!p.f)
+                    {
+                        throw std::runtime_error(Format("Cannot open: \"{0}\"").arg(path.u8string()));
+                    }
                 }
             }
 
@@ -210,7 +223,8 @@ namespace feather_tk
                 width,
                 height,
                 channels,
-                bitDepth))
+                bitDepth,
+                p.passes))
             {
                 throw std::runtime_error(Format("Cannot open: \"{0}\"").arg(path.u8string()));
             }
@@ -287,12 +301,52 @@ namespace feather_tk
         {
             FEATHER_TK_P();
             auto out = Image::create(p.info);
-            uint8_t* data = out->getData();
-            for (uint16_t y = 0; y < p.info.size.h; ++y, data += p.scanlineSize)
+            read(out);
+            return out;
+        }
+
+        bool ImageReader::read(
+            const std::shared_ptr<Image>& image,
+            const ImageReadCallback& callback)
+        {
+            FEATHER_TK_P();
+            if (!image ||
+                image->getSize() != p.info.size ||
+                image->getType() != p.info.type ||
+                image->getInfo().layout.endian != p.info.layout.endian)
+            {
+                return false;
+            }
+
+            // The rows are decoded directly into the image. Interlaced
+            // images combine each pass with the rows from the previous
+            // passes, and the callback is called once per pass.
+            const int h = p.info.size.h;
+            const size_t rowByteCount = getAlignedByteCount(
+                p.scanlineSize,
+                image->getInfo().layout.alignment);
+            const int callbackRows = 64;
+            uint8_t* data = image->getData();
+            bool out = true;
+            for (int pass = 0; pass < p.passes && out; ++pass)
             {
-                if (!scanline(p.png, data))
+                int y0 = 0;
+                for (int y = 0; y < h; ++y)
+                {
+                    if (!scanline(p.png, data + y * rowByteCount))
+                    {
+                        out = false;
+                        break;
+                    }
+                    if (callback && 1 == p.passes && (y - y0 + 1 == callbackRows || y == h - 1))
+                    {
+                        callback(image, y0, y - y0 + 1);
+                        y0 = y + 1;
+                    }
+                }
+                if (callback && out && p.passes > 1)
                 {
-                    break;
+                    callback(image, 0, h);
                 }
             }
             end(p.png, p.pngInfoEnd);
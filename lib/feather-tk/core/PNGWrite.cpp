@@ -9,6 +9,8 @@
 #include <feather-tk/core/Memory.h>
 #include <feather-tk/core/String.h>
 
+#include <cstdlib>
+
 namespace feather_tk
 {
     namespace png
@@ -19,7 +21,8 @@ namespace feather_tk
                 FILE* f,
                 png_structp png,
                 png_infop* pngInfo,
-                const ImageInfo& info)
+                const ImageInfo& info,
+                bool interlace)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
@@ -62,7 +65,7 @@ namespace feather_tk
                     info.size.h,
                     bitDepth,
                     colorType,
-                    PNG_INTERLACE_NONE,
+                    interlace ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
                     PNG_COMPRESSION_TYPE_DEFAULT,
                     PNG_FILTER_TYPE_DEFAULT);
                 png_write_info(png, *pngInfo);
@@ -97,6 +100,7 @@ namespace feather_tk
             png_structp png = nullptr;
             png_infop   pngInfo = nullptr;
             FILE* f = nullptr;
+            bool interlace = false;
             ErrorStruct error;
         };
 
@@ -118,6 +122,12 @@ namespace feather_tk
                 throw std::runtime_error(Format("Cannot open: \"{0}\"").arg(path.u8string()));
             }
 
+            auto i = options.find("Interlace");
+            if (i != options.end())
+            {
+                p.interlace = std::atoi(i->second.c_str());
+            }
+
 #if defined(_WINDOWS)
             if (_wfopen_s(&p.f, path.wstring().c_str(), L"wb") != 0)
             {
@@ -136,7 +146,7 @@ namespace feather_tk
         {
             FEATHER_TK_P();
             const ImageInfo& info = image->getInfo();
-            if (!open(p.f, p.png, &p.pngInfo, info))
+            if (!open(p.f, p.png, &p.pngInfo, info, p.interlace))
             {
                 throw std::runtime_error(Format("Cannot open: \"{0}\"").arg(_path.u8string()));
             }
@@ -155,12 +165,16 @@ namespace feather_tk
             default: break;
             }
             scanlineByteCount = getAlignedByteCount(scanlineByteCount, info.layout.alignment);
-            const uint8_t* data = image->getData() + (info.size.h - 1) * scanlineByteCount;
-            for (uint16_t y = 0; y < info.size.h; ++y, data -= scanlineByteCount)
+            const int passes = p.interlace ? png_set_interlace_handling(p.png) : 1;
+            for (int pass = 0; pass < passes; ++pass)
             {
-                if (!scanline(p.png, data))
+                const uint8_t* data = image->getData() + (info.size.h - 1) * scanlineByteCount;
+                for (uint16_t y = 0; y < info.size.h; ++y, data -= scanlineByteCount)
                 {
-                    throw std::runtime_error(Format("Cannot write scanline: \"{0}\": {1}").arg(_path.u8string()).arg(y));
+                    if (!scanline(p.png, data))
+                    {
+                        throw std::runtime_error(Format("Cannot write scanline: \"{0}\": {1}").arg(_path.u8string()).arg(y));
+                    }
                 }
             }
             if (!end(p.png, p.pngInfo))
@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/ProfileSystem.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/FileIO.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+
+namespace feather_tk
+{
+    bool ProfileEvent::operator == (const ProfileEvent& other) const
+    {
+        return
+            name == other.name &&
+            start == other.start &&
+            duration == other.duration &&
+            depth == other.depth &&
+            gpu == other.gpu;
+    }
+
+    bool ProfileEvent::operator != (const ProfileEvent& other) const
+    {
+        return !(*this == other);
+    }
+
+    int64_t ProfileFrame::getDuration(const std::string& name, bool gpu) const
+    {
+        int64_t out = 0;
+        for (const auto& event : events)
+        {
+            if (0 == event.depth && gpu == event.gpu && name == event.name)
+            {
+                out += event.duration;
+            }
+        }
+        return out;
+    }
+
+    struct ProfileSystem::Private
+    {
+        std::shared_ptr<ObservableValue<bool> > enabled;
+        int widgetDepth = 2;
+        std::chrono::steady_clock::time_point startTime;
+
+        std::vector<ProfileFrame> frames;
+        size_t frameCount = 300;
+        size_t frameIndex = 0;
+        uint64_t frameID = 0;
+
+        bool inFrame = false;
+        ProfileFrame frame;
+        std::vector<size_t> stack;
+    };
+
+    ProfileSystem::ProfileSystem(const std::shared_ptr<Context>& context) :
+        ISystem(context, "feather_tk::ProfileSystem"),
+        _p(new Private)
+    {
+        FEATHER_TK_P();
+        p.enabled = ObservableValue<bool>::create(false);
+        p.startTime = std::chrono::steady_clock::now();
+    }
+
+    ProfileSystem::~ProfileSystem()
+    {}
+
+    std::shared_ptr<ProfileSystem> ProfileSystem::create(
+        const std::shared_ptr<Context>& context)
+    {
+        auto out = context->getSystem<ProfileSystem>();
+        if (!out)
+        {
+            out = std::shared_ptr<ProfileSystem>(new ProfileSystem(context));
+        }
+        return out;
+    }
+
+    bool ProfileSystem::isEnabled() const
+    {
+        return _p->enabled->get();
+    }
+
+    std::shared_ptr<IObservableValue<bool> > ProfileSystem::observeEnabled() const
+    {
+        return _p->enabled;
+    }
+
+    void ProfileSystem::setEnabled(bool value)
+    {
+        FEATHER_TK_P();
+        if (p.enabled->setIfChanged(value) && !value)
+        {
+            p.inFrame = false;
+            p.stack.clear();
+        }
+    }
+
+    size_t ProfileSystem::getFrameCount() const
+    {
+        return _p->frameCount;
+    }
+
+    void ProfileSystem::setFrameCount(size_t value)
+    {
+        FEATHER_TK_P();
+        const size_t frameCount = std::max(value, static_cast<size_t>(1));
+        if (frameCount == p.frameCount)
+            return;
+        const auto frames = getFrames();
+        p.frameCount = frameCount;
+        p.frames.clear();
+        p.frameIndex = 0;
+        const size_t size = frames.size();
+        for (size_t i = size > frameCount ? size - frameCount : 0; i < size; ++i)
+        {
+            p.frames.push_back(frames[i]);
+        }
+        p.frameIndex = p.frames.size() % p.frameCount;
+    }
+
+    int ProfileSystem::getWidgetDepth() const
+    {
+        return _p->widgetDepth;
+    }
+
+    void ProfileSystem::setWidgetDepth(int value)
+    {
+        _p->widgetDepth = value;
+    }
+
+    int64_t ProfileSystem::getTime() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _p->startTime).count();
+    }
+
+    void ProfileSystem::beginFrame()
+    {
+        FEATHER_TK_P();
+        if (!p.enabled->get())
+            return;
+        if (p.inFrame)
+        {
+            endFrame();
+        }
+        p.inFrame = true;
+        p.frame = ProfileFrame();
+        p.frame.id = p.frameID;
+        p.frame.start = getTime();
+        p.stack.clear();
+    }
+
+    void ProfileSystem::endFrame()
+    {
+        FEATHER_TK_P();
+        if (!p.inFrame)
+            return;
+        const int64_t t = getTime();
+        while (!p.stack.empty())
+        {
+            endEvent();
+        }
+        p.frame.duration = t - p.frame.start;
+        if (p.frames.size() < p.frameCount)
+        {
+            p.frames.push_back(std::move(p.frame));
+        }
+        else
+        {
+            p.frames[p.frameIndex] = std::move(p.frame);
+        }
+        p.frameIndex = (p.frameIndex + 1) % p.frameCount;
+        p.inFrame = false;
+        ++p.frameID;
+    }
+
+    uint64_t ProfileSystem::getFrameID() const
+    {
+        return _p->frameID;
+    }
+
+    void ProfileSystem::beginEvent(const std::string& name)
+    {
+        FEATHER_TK_P();
+        if (!p.inFrame)
+            return;
+        ProfileEvent event;
+        event.name = name;
+        event.start = getTime();
+        event.depth = static_cast<int>(p.stack.size());
+        p.stack.push_back(p.frame.events.size());
+        p.frame.events.push_back(event);
+    }
+
+    void ProfileSystem::endEvent()
+    {
+        FEATHER_TK_P();
+        if (!p.inFrame || p.stack.empty())
+            return;
+        auto& event = p.frame.events[p.stack.back()];
+        event.duration = getTime() - event.start;
+        p.stack.pop_back();
+    }
+
+    bool ProfileSystem::addEvent(uint64_t frame, const ProfileEvent& event)
+    {
+        FEATHER_TK_P();
+        if (p.inFrame && frame == p.frame.id)
+        {
+            p.frame.events.push_back(event);
+            return true;
+        }
+        for (auto& i : p.frames)
+        {
+            if (frame == i.id)
+            {
+                i.events.push_back(event);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<ProfileFrame> ProfileSystem::getFrames() const
+    {
+        FEATHER_TK_P();
+        std::vector<ProfileFrame> out;
+        out.reserve(p.frames.size());
+        if (p.frames.size() < p.frameCount)
+        {
+            out = p.frames;
+        }
+        else
+        {
+            for (size_t i = 0; i < p.frames.size(); ++i)
+            {
+                out.push_back(p.frames[(p.frameIndex + i) % p.frames.size()]);
+            }
+        }
+        return out;
+    }
+
+    ProfileFrame ProfileSystem::getLastFrame() const
+    {
+        FEATHER_TK_P();
+        ProfileFrame out;
+        if (!p.frames.empty())
+        {
+            out = p.frames[(p.frameIndex + p.frameCount - 1) % p.frameCount];
+        }
+        return out;
+    }
+
+    void ProfileSystem::clear()
+    {
+        FEATHER_TK_P();
+        p.frames.clear();
+        p.frameIndex = 0;
+    }
+
+    std::string ProfileSystem::getChromeTrace() const
+    {
+        nlohmann::json events = nlohmann::json::array();
+        for (const auto& frame : getFrames())
+        {
+            nlohmann::json json;
+            json["name"] = "Frame";
+            json["cat"] = "frame";
+            json["ph"] = "X";
+            json["ts"] = frame.start;
+            json["dur"] = frame.duration;
+            json["pid"] = 0;
+            json["tid"] = 0;
+            json["args"]["id"] = frame.id;
+            events.push_back(json);
+            for (const auto& event : frame.events)
+            {
+                json = nlohmann::json();
+                json["name"] = event.name;
+                json["cat"] = event.gpu ? "gpu" : "cpu";
+                json["ph"] = "X";
+                json["ts"] = event.start;
+                json["dur"] = event.duration;
+                json["pid"] = 0;
+                json["tid"] = event.gpu ? 1 : 0;
+                events.push_back(json);
+            }
+        }
+        nlohmann::json json;
+        json["traceEvents"] = events;
+        json["displayTimeUnit"] = "ms";
+        return json.dump();
+    }
+
+    void ProfileSystem::writeChromeTrace(const std::filesystem::path& path) const
+    {
+        auto io = FileIO::create(path, FileMode::Write);
+        io->write(getChromeTrace());
+    }
+
+    ProfileTimer::ProfileTimer(
+        const std::shared_ptr<ProfileSystem>& system,
+        const std::string& name)
+    {
+        if (system && system->isEnabled())
+        {
+            _system = system.get();
+            _system->beginEvent(name);
+        }
+    }
+
+    ProfileTimer::~ProfileTimer()
+    {
+        if (_system)
+        {
+            _system->endEvent();
+        }
+    }
+}
\ No newline at end of file
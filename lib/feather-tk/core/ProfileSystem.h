@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/ISystem.h>
+#include <feather-tk/core/ObservableValue.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace feather_tk
+{
+    //! \name Profiling
+    ///@{
+
+    //! Profile event.
+    struct ProfileEvent
+    {
+        std::string name;
+        int64_t     start    = 0; //!< Start time in microseconds
+        int64_t     duration = 0; //!< Duration in microseconds
+        int         depth    = 0;
+        bool        gpu      = false;
+
+        bool operator == (const ProfileEvent&) const;
+        bool operator != (const ProfileEvent&) const;
+    };
+
+    //! Profile frame.
+    struct ProfileFrame
+    {
+        uint64_t                  id       = 0;
+        int64_t                   start    = 0; //!< Start time in microseconds
+        int64_t                   duration = 0; //!< Duration in microseconds
+        std::vector<ProfileEvent> events;
+
+        //! Get the total duration of the top level events with the given
+        //! name in microseconds.
+        int64_t getDuration(const std::string&, bool gpu = false) const;
+    };
+
+    //! Profile system.
+    //!
+    //! The profile system records timed events for each frame into a ring
+    //! buffer of frames. Events are recorded with ProfileTimer from the
+    //! main thread, and only while the system is enabled and a frame has
+    //! been started.
+    class ProfileSystem : public ISystem
+    {
+    protected:
+        ProfileSystem(const std::shared_ptr<Context>&);
+
+    public:
+        virtual ~ProfileSystem();
+
+        //! Create a new system.
+        static std::shared_ptr<ProfileSystem> create(const std::shared_ptr<Context>&);
+
+        //! Get whether profiling is enabled.
+        bool isEnabled() const;
+
+        //! Observe whether profiling is enabled.
+        std::shared_ptr<IObservableValue<bool> > observeEnabled() const;
+
+        //! Set whether profiling is enabled.
+        void setEnabled(bool);
+
+        //! Get the maximum number of frames.
+        size_t getFrameCount() const;
+
+        //! Set the maximum number of frames.
+        void setFrameCount(size_t);
+
+        //! Get the widget depth. Widgets are timed individually down to
+        //! this depth in the widget hierarchy.
+        int getWidgetDepth() const;
+
+        //! Set the widget depth.
+        void setWidgetDepth(int);
+
+        //! Get the current time in microseconds.
+        int64_t getTime() const;
+
+        //! \name Recording
+        ///@{
+
+        //! Begin a frame.
+        void beginFrame();
+
+        //! End the frame.
+        void endFrame();
+
+        //! Get the ID of the current frame, or the next frame if a frame
+        //! has not been started.
+        uint64_t getFrameID() const;
+
+        //! Begin an event. Events may be nested.
+        void beginEvent(const std::string&);
+
+        //! End the event.
+        void endEvent();
+
+        //! Add an event to a frame. This can be used for GPU timings that
+        //! are available after the frame has ended. Returns false if the
+        //! frame is no longer available.
+        bool addEvent(uint64_t frame, const ProfileEvent&);
+
+        ///@}
+
+        //! \name Results
+        ///@{
+
+        //! Get the frames, from oldest to newest.
+        std::vector<ProfileFrame> getFrames() const;
+
+        //! Get the most recent frame.
+        ProfileFrame getLastFrame() const;
+
+        //! Clear the frames.
+        void clear();
+
+        //! Get the frames as Chrome trace JSON, which can be loaded in
+        //! chrome://tracing or Perfetto.
+        std::string getChromeTrace() const;
+
+        //! Write the frames as a Chrome trace JSON file.
+        void writeChromeTrace(const std::filesystem::path&) const;
+
+        ///@}
+
+    private:
+        FEATHER_TK_PRIVATE();
+    };
+
+    //! Scoped profile timer.
+    class ProfileTimer
+    {
+        FEATHER_TK_NON_COPYABLE(ProfileTimer);
+
+    public:
+        ProfileTimer(
+            const std::shared_ptr<ProfileSystem>&,
+            const std::string&);
+
+        ~ProfileTimer();
+
+    private:
+        ProfileSystem* _system = nullptr;
+    };
+
+    ///@}
+}
\ No newline at end of file
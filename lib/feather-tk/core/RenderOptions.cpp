@@ -51,6 +51,7 @@ namespace feather_tk
         json["AlphaBlend"] = to_string(in.alphaBlend);
         json["ImageFilters"] = in.imageFilters;
         json["Cache"] = in.cache;
+        json["Stream"] = in.stream;
     }
 
     void from_json(const nlohmann::json& json, ImageFilters& out)
@@ -66,5 +67,6 @@ namespace feather_tk
         from_string(json.at("AlphaBlend").get<std::string>(), out.alphaBlend);
         json.at("ImageFilters").get_to(out.imageFilters);
         json.at("Cache").get_to(out.cache);
+        json.at("Stream").get_to(out.stream);
     }
 }
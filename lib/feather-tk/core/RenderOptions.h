@@ -37,6 +37,9 @@ namespace feather_tk
             4096;
 #endif // FEATHER_TK_API_GLES_2
 
+        //! Maximum number of glyph texture atlas pages.
+        int glyphAtlasPageCount = 4;
+
         //! Enable logging.
         bool log = true;
 
@@ -124,6 +127,11 @@ namespace feather_tk
         ImageFilters     imageFilters;
         bool             cache          = true;
 
+        //! Stream the image. Streamed images are uploaded to textures that
+        //! are reused for images with the same information, for example
+        //! the frames of a video. The image cache is not used.
+        bool             stream         = false;
+
         bool operator == (const ImageOptions&) const;
         bool operator != (const ImageOptions&) const;
     };
@@ -11,6 +11,7 @@ namespace feather_tk
             clearColor == other.clearColor &&
             textureCacheByteCount == other.textureCacheByteCount &&
             glyphAtlasSize == other.glyphAtlasSize &&
+            glyphAtlasPageCount == other.glyphAtlasPageCount &&
             log == other.log;
     }
 
@@ -48,7 +49,8 @@ namespace feather_tk
             videoLevels == other.videoLevels &&
             alphaBlend == other.alphaBlend &&
             imageFilters == other.imageFilters &&
-            cache == other.cache;
+            cache == other.cache &&
+            stream == other.stream;
     }
 
     inline bool ImageOptions::operator != (const ImageOptions& other) const
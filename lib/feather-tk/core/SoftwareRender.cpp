@@ -0,0 +1,1181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/SoftwareRender.h>
+
+#include <feather-tk/core/ImageUtilPrivate.h>
+
+#include <feather-tk/core/LRUCache.h>
+#include <feather-tk/core/Math.h>
+#include <feather-tk/core/Memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+namespace feather_tk
+{
+    namespace
+    {
+        const int tileSize = 64;
+
+        struct Pixel
+        {
+            float r = 0.F;
+            float g = 0.F;
+            float b = 0.F;
+            float a = 0.F;
+        };
+
+        inline Pixel fromColor(const Color4F& value)
+        {
+            return Pixel{ value.r, value.g, value.b, value.a };
+        }
+
+        inline Pixel operator * (const Pixel& a, const Pixel& b)
+        {
+            return Pixel{ a.r * b.r, a.g * b.g, a.b * b.b, a.a * b.a };
+        }
+
+        inline uint8_t toU8(float value)
+        {
+            return static_cast<uint8_t>(clamp(value, 0.F, 1.F) * 255.F + .5F);
+        }
+
+        //! Image data converted to floating point RGBA. This does the same
+        //! work as the sampleTexture() function in the OpenGL shaders.
+        struct Texture
+        {
+            int w = 0;
+            int h = 0;
+            ImageMirror mirror;
+            VideoLevels videoLevels = VideoLevels::FullRange;
+            std::vector<Pixel> data;
+        };
+
+        std::shared_ptr<Texture> createTexture(
+            const std::shared_ptr<Image>& image,
+            VideoLevels videoLevels)
+        {
+            auto out = std::make_shared<Texture>();
+            const ImageInfo& info = image->getInfo();
+            const int w = info.size.w;
+            const int h = info.size.h;
+            out->w = w;
+            out->h = h;
+            out->mirror = info.layout.mirror;
+            out->videoLevels = videoLevels;
+            out->data.resize(static_cast<size_t>(w) * h);
+            const uint8_t* data = image->getData();
+            const bool swap = info.layout.endian != getEndian();
+            const size_t alignment = info.layout.alignment;
+            Pixel* outP = out->data.data();
+            switch (info.type)
+            {
+            case ImageType::YUV_420P_U8:
+            case ImageType::YUV_422P_U8:
+            case ImageType::YUV_444P_U8:
+            case ImageType::YUV_420P_U16:
+            case ImageType::YUV_422P_U16:
+            case ImageType::YUV_444P_U16:
+            {
+                int cw = w;
+                int ch = h;
+                switch (info.type)
+                {
+                case ImageType::YUV_420P_U8:
+                case ImageType::YUV_420P_U16:
+                    cw = w / 2;
+                    ch = h / 2;
+                    break;
+                case ImageType::YUV_422P_U8:
+                case ImageType::YUV_422P_U16:
+                    cw = w / 2;
+                    break;
+                default: break;
+                }
+                const bool u16 =
+                    ImageType::YUV_420P_U16 == info.type ||
+                    ImageType::YUV_422P_U16 == info.type ||
+                    ImageType::YUV_444P_U16 == info.type;
+                const size_t bytes = u16 ? 2 : 1;
+                const float scale = u16 ? 1.F / 65535.F : 1.F / 255.F;
+                const uint8_t* yP = data;
+                const uint8_t* uP = yP + static_cast<size_t>(w) * h * bytes;
+                const uint8_t* vP = uP + static_cast<size_t>(cw) * ch * bytes;
+                auto read = [u16, swap, scale](const uint8_t* p)
+                {
+                    return (u16 ? image::readWord<uint16_t>(p, swap) : *p) * scale;
+                };
+                const V4F k = getYUVCoefficients(info.yuvCoefficients);
+                for (int y = 0; y < h; ++y)
+                {
+                    const int cy = ch > 0 ? std::min(y * ch / h, ch - 1) : 0;
+                    for (int x = 0; x < w; ++x, ++outP)
+                    {
+                        const int cx = cw > 0 ? std::min(x * cw / w, cw - 1) : 0;
+                        const size_t ci = (static_cast<size_t>(cy) * cw + cx) * bytes;
+                        float yv = read(yP + (static_cast<size_t>(y) * w + x) * bytes);
+                        float cb = read(uP + ci);
+                        float cr = read(vP + ci);
+                        if (VideoLevels::LegalRange == videoLevels)
+                        {
+                            yv = image::legalY(yv);
+                            cb = image::legalC(cb);
+                            cr = image::legalC(cr);
+                        }
+                        cb -= .5F;
+                        cr -= .5F;
+                        outP->r = yv + k.x * cr;
+                        outP->g = yv - k.y * cr - k.z * cb;
+                        outP->b = yv + k.w * cb;
+                        outP->a = 1.F;
+                    }
+                }
+                break;
+            }
+            case ImageType::RGB_U10:
+            {
+                const size_t rowBytes = getAlignedByteCount(w * 4, alignment);
+                for (int y = 0; y < h; ++y)
+                {
+                    const uint8_t* p = data + y * rowBytes;
+                    for (int x = 0; x < w; ++x, p += 4, ++outP)
+                    {
+                        const uint32_t v = image::readWord<uint32_t>(p, swap);
+                        outP->r = ((v >> 22) & 0x3ff) / 1023.F;
+                        outP->g = ((v >> 12) & 0x3ff) / 1023.F;
+                        outP->b = ((v >> 2) & 0x3ff) / 1023.F;
+                        outP->a = 1.F;
+                    }
+                }
+                break;
+            }
+            case ImageType::ARGB_4444_Premult:
+            {
+                const uint8_t* p = data;
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int x = 0; x < w; ++x, p += 2, ++outP)
+                    {
+                        const uint16_t v = image::readWord<uint16_t>(p, swap);
+                        outP->b = (v & 0xf) / 15.F;
+                        outP->g = ((v >> 4) & 0xf) / 15.F;
+                        outP->r = ((v >> 8) & 0xf) / 15.F;
+                        outP->a = ((v >> 12) & 0xf) / 15.F;
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                const int channelCount = getChannelCount(info.type);
+                const int bitDepth = getBitDepth(info.type);
+                const bool isFloat =
+                    ImageType::L_F16 == info.type ||
+                    ImageType::L_F32 == info.type ||
+                    ImageType::LA_F16 == info.type ||
+                    ImageType::LA_F32 == info.type ||
+                    ImageType::RGB_F16 == info.type ||
+                    ImageType::RGB_F32 == info.type ||
+                    ImageType::RGBA_F16 == info.type ||
+                    ImageType::RGBA_F32 == info.type;
+                const size_t bytes = bitDepth / 8;
+                const size_t rowBytes = getAlignedByteCount(
+                    w * channelCount * bytes,
+                    alignment);
+                for (int y = 0; y < h; ++y)
+                {
+                    const uint8_t* p = data + y * rowBytes;
+                    for (int x = 0; x < w; ++x, ++outP)
+                    {
+                        float c[4] = { 0.F, 0.F, 0.F, 1.F };
+                        for (int i = 0; i < channelCount; ++i, p += bytes)
+                        {
+                            switch (bitDepth)
+                            {
+                            case 8:
+                                c[i] = *p / 255.F;
+                                break;
+                            case 16:
+                                c[i] = isFloat ?
+                                    image::halfToFloat(image::readWord<uint16_t>(p, swap)) :
+                                    image::readWord<uint16_t>(p, swap) / 65535.F;
+                                break;
+                            case 32:
+                                c[i] = isFloat ?
+                                    image::readWord<float>(p, swap) :
+                                    static_cast<float>(image::readWord<uint32_t>(p, swap) / 4294967295.0);
+                                break;
+                            default: break;
+                            }
+                        }
+                        if (VideoLevels::LegalRange == videoLevels)
+                        {
+                            c[0] = image::legalY(c[0]);
+                            c[1] = image::legalC(c[1]);
+                            c[2] = image::legalC(c[2]);
+                        }
+                        switch (channelCount)
+                        {
+                        case 1:
+                            c[1] = c[2] = c[0];
+                            c[3] = 1.F;
+                            break;
+                        case 2:
+                            c[3] = c[1];
+                            c[1] = c[2] = c[0];
+                            break;
+                        case 3:
+                            c[3] = 1.F;
+                            break;
+                        default: break;
+                        }
+                        outP->r = c[0];
+                        outP->g = c[1];
+                        outP->b = c[2];
+                        outP->a = c[3];
+                    }
+                }
+                break;
+            }
+            }
+            return out;
+        }
+
+        inline Pixel sampleNearest(const Texture& texture, float u, float v)
+        {
+            const int x = clamp(static_cast<int>(std::floor(u * texture.w)), 0, texture.w - 1);
+            const int y = clamp(static_cast<int>(std::floor(v * texture.h)), 0, texture.h - 1);
+            return texture.data[static_cast<size_t>(y) * texture.w + x];
+        }
+
+        inline Pixel sampleLinear(const Texture& texture, float u, float v)
+        {
+            const float fx = u * texture.w - .5F;
+            const float fy = v * texture.h - .5F;
+            const int x0 = static_cast<int>(std::floor(fx));
+            const int y0 = static_cast<int>(std::floor(fy));
+            const float tx = fx - x0;
+            const float ty = fy - y0;
+            const int xa = clamp(x0, 0, texture.w - 1);
+            const int xb = clamp(x0 + 1, 0, texture.w - 1);
+            const int ya = clamp(y0, 0, texture.h - 1);
+            const int yb = clamp(y0 + 1, 0, texture.h - 1);
+            const Pixel& p00 = texture.data[static_cast<size_t>(ya) * texture.w + xa];
+            const Pixel& p10 = texture.data[static_cast<size_t>(ya) * texture.w + xb];
+            const Pixel& p01 = texture.data[static_cast<size_t>(yb) * texture.w + xa];
+            const Pixel& p11 = texture.data[static_cast<size_t>(yb) * texture.w + xb];
+            const float w00 = (1.F - tx) * (1.F - ty);
+            const float w10 = tx * (1.F - ty);
+            const float w01 = (1.F - tx) * ty;
+            const float w11 = tx * ty;
+            return Pixel{
+                p00.r * w00 + p10.r * w10 + p01.r * w01 + p11.r * w11,
+                p00.g * w00 + p10.g * w10 + p01.g * w01 + p11.g * w11,
+                p00.b * w00 + p10.b * w10 + p01.b * w01 + p11.b * w11,
+                p00.a * w00 + p10.a * w10 + p01.a * w01 + p11.a * w11 };
+        }
+
+        //! Blend a pixel using the same equations as the OpenGL renderer.
+        inline void blend(uint8_t* dst, const Pixel& src, AlphaBlend alphaBlend)
+        {
+            switch (alphaBlend)
+            {
+            case AlphaBlend::None:
+                dst[0] = toU8(src.r);
+                dst[1] = toU8(src.g);
+                dst[2] = toU8(src.b);
+                dst[3] = toU8(src.a);
+                break;
+            case AlphaBlend::Straight:
+            {
+                const float a = clamp(src.a, 0.F, 1.F);
+                const float k = (1.F - a) / 255.F;
+                dst[0] = toU8(src.r * a + dst[0] * k);
+                dst[1] = toU8(src.g * a + dst[1] * k);
+                dst[2] = toU8(src.b * a + dst[2] * k);
+                dst[3] = toU8(a + dst[3] * k);
+                break;
+            }
+            case AlphaBlend::Premultiplied:
+            {
+                const float a = clamp(src.a, 0.F, 1.F);
+                const float k = (1.F - a) / 255.F;
+                dst[0] = toU8(src.r + dst[0] * k);
+                dst[1] = toU8(src.g + dst[1] * k);
+                dst[2] = toU8(src.b + dst[2] * k);
+                dst[3] = toU8(a + dst[3] * k);
+                break;
+            }
+            default: break;
+            }
+        }
+
+        //! Fill a span with a constant color. Opaque spans are written as
+        //! 32-bit words, and blended spans use a constant per channel
+        //! multiply and add; both loops are simple enough for the compiler
+        //! to vectorize.
+        void fillSpan(
+            uint8_t* dst,
+            int count,
+            const Pixel& src,
+            AlphaBlend alphaBlend)
+        {
+            const float a = clamp(src.a, 0.F, 1.F);
+            if (AlphaBlend::None == alphaBlend ||
+                (AlphaBlend::Straight == alphaBlend && a >= 1.F))
+            {
+                const uint8_t c[4] =
+                {
+                    toU8(src.r),
+                    toU8(src.g),
+                    toU8(src.b),
+                    toU8(AlphaBlend::None == alphaBlend ? src.a : 1.F)
+                };
+                uint32_t word = 0;
+                std::memcpy(&word, c, 4);
+                uint32_t* dst32 = reinterpret_cast<uint32_t*>(dst);
+                std::fill(dst32, dst32 + count, word);
+            }
+            else if (AlphaBlend::Straight == alphaBlend ||
+                AlphaBlend::Premultiplied == alphaBlend)
+            {
+                const float m = AlphaBlend::Straight == alphaBlend ? a : 1.F;
+                const float add[4] =
+                {
+                    clamp(src.r * m, 0.F, 1.F) * 255.F + .5F,
+                    clamp(src.g * m, 0.F, 1.F) * 255.F + .5F,
+                    clamp(src.b * m, 0.F, 1.F) * 255.F + .5F,
+                    a * 255.F + .5F
+                };
+                const float k = 1.F - a;
+                for (int i = 0; i < count * 4; i += 4)
+                {
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        dst[i + c] = static_cast<uint8_t>(std::min(
+                            add[c] + dst[i + c] * k,
+                            255.F));
+                    }
+                }
+            }
+        }
+
+        struct Vertex
+        {
+            float x = 0.F;
+            float y = 0.F;
+            float u = 0.F;
+            float v = 0.F;
+            Pixel c;
+        };
+
+        struct GlyphBlit
+        {
+            std::shared_ptr<Image> image;
+            int x = 0;
+            int y = 0;
+        };
+
+        enum class CommandType
+        {
+            Clear,
+            Triangles,
+            Text
+        };
+
+        struct Command
+        {
+            CommandType type = CommandType::Triangles;
+            Box2I bbox;
+            Pixel color;
+            AlphaBlend alphaBlend = AlphaBlend::Straight;
+
+            std::vector<Vertex> vertices;
+            bool vertexColors = false;
+            std::shared_ptr<Texture> texture;
+            ImageFilter filter = ImageFilter::Linear;
+            ChannelDisplay channelDisplay = ChannelDisplay::Color;
+
+            std::vector<GlyphBlit> glyphs;
+        };
+
+        void rasterTriangle(
+            const Command& command,
+            const Vertex* v,
+            const Box2I& rect,
+            uint8_t* data,
+            int width)
+        {
+            const Vertex* v0 = &v[0];
+            const Vertex* v1 = &v[1];
+            const Vertex* v2 = &v[2];
+            float area =
+                (v1->x - v0->x) * (v2->y - v0->y) -
+                (v1->y - v0->y) * (v2->x - v0->x);
+            if (area < 0.F)
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+            if (area <= 0.F)
+                return;
+
+            // Edge functions E(x, y) = A * x + B * y + C, where the pixel
+            // is inside the triangle when all of them are positive. Pixels
+            // exactly on an edge use the top-left rule so that triangles
+            // sharing an edge do not draw the pixels twice.
+            const Vertex* edges[3][2] = { { v1, v2 }, { v2, v0 }, { v0, v1 } };
+            float A[3];
+            float B[3];
+            float C[3];
+            bool topLeft[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                const float dx = edges[i][1]->x - edges[i][0]->x;
+                const float dy = edges[i][1]->y - edges[i][0]->y;
+                A[i] = -dy;
+                B[i] = dx;
+                C[i] = dy * edges[i][0]->x - dx * edges[i][0]->y;
+                topLeft[i] = (0.F == dy && dx > 0.F) || dy < 0.F;
+            }
+
+            const bool flat = !command.vertexColors && !command.texture;
+            const bool linear = ImageFilter::Linear == command.filter;
+            const Texture* texture = command.texture.get();
+            for (int y = rect.min.y; y <= rect.max.y; ++y)
+            {
+                // Find the span of pixel centers inside the triangle.
+                const float py = y + .5F;
+                int x0 = rect.min.x;
+                int x1 = rect.max.x;
+                for (int i = 0; i < 3 && x0 <= x1; ++i)
+                {
+                    const float e = B[i] * py + C[i];
+                    if (A[i] > 0.F)
+                    {
+                        const float t = -e / A[i] - .5F;
+                        x0 = std::max(x0, topLeft[i] ?
+                            static_cast<int>(std::ceil(t)) :
+                            static_cast<int>(std::floor(t)) + 1);
+                    }
+                    else if (A[i] < 0.F)
+                    {
+                        const float t = -e / A[i] - .5F;
+                        x1 = std::min(x1, topLeft[i] ?
+                            static_cast<int>(std::floor(t)) :
+                            static_cast<int>(std::ceil(t)) - 1);
+                    }
+                    else if (e < 0.F || (0.F == e && !topLeft[i]))
+                    {
+                        x1 = x0 - 1;
+                    }
+                }
+                if (x0 > x1)
+                    continue;
+
+                uint8_t* dst = data + (static_cast<size_t>(y) * width + x0) * 4;
+                if (flat)
+                {
+                    fillSpan(dst, x1 - x0 + 1, command.color, command.alphaBlend);
+                    continue;
+                }
+                for (int x = x0; x <= x1; ++x, dst += 4)
+                {
+                    const float px = x + .5F;
+                    const float w0 = (A[0] * px + B[0] * py + C[0]) / area;
+                    const float w1 = (A[1] * px + B[1] * py + C[1]) / area;
+                    const float w2 = 1.F - w0 - w1;
+                    Pixel src = command.color;
+                    if (command.vertexColors)
+                    {
+                        src = src * Pixel{
+                            v0->c.r * w0 + v1->c.r * w1 + v2->c.r * w2,
+                            v0->c.g * w0 + v1->c.g * w1 + v2->c.g * w2,
+                            v0->c.b * w0 + v1->c.b * w1 + v2->c.b * w2,
+                            v0->c.a * w0 + v1->c.a * w1 + v2->c.a * w2 };
+                    }
+                    if (texture)
+                    {
+                        float u = v0->u * w0 + v1->u * w1 + v2->u * w2;
+                        float v = v0->v * w0 + v1->v * w1 + v2->v * w2;
+                        if (texture->mirror.x)
+                        {
+                            u = 1.F - u;
+                        }
+                        if (!texture->mirror.y)
+                        {
+                            v = 1.F - v;
+                        }
+                        src = (linear ?
+                            sampleLinear(*texture, u, v) :
+                            sampleNearest(*texture, u, v)) * src;
+                        switch (command.channelDisplay)
+                        {
+                        case ChannelDisplay::Red: src.g = src.b = src.r; break;
+                        case ChannelDisplay::Green: src.r = src.b = src.g; break;
+                        case ChannelDisplay::Blue: src.r = src.g = src.b; break;
+                        case ChannelDisplay::Alpha: src.r = src.g = src.b = src.a; break;
+                        default: break;
+                        }
+                    }
+                    blend(dst, src, command.alphaBlend);
+                }
+            }
+        }
+
+        void rasterText(
+            const Command& command,
+            const Box2I& rect,
+            uint8_t* data,
+            int width)
+        {
+            for (const auto& glyph : command.glyphs)
+            {
+                const int w = glyph.image->getWidth();
+                const int h = glyph.image->getHeight();
+                const int channelCount = getChannelCount(glyph.image->getType());
+                const Box2I box = intersect(rect, Box2I(glyph.x, glyph.y, w, h));
+                if (!box.isValid())
+                    continue;
+                const uint8_t* glyphData = glyph.image->getData();
+                for (int y = box.min.y; y <= box.max.y; ++y)
+                {
+                    const uint8_t* src = glyphData +
+                        (static_cast<size_t>(y - glyph.y) * w + (box.min.x - glyph.x)) * channelCount;
+                    uint8_t* dst = data + (static_cast<size_t>(y) * width + box.min.x) * 4;
+                    for (int x = box.min.x; x <= box.max.x; ++x, src += channelCount, dst += 4)
+                    {
+                        if (*src)
+                        {
+                            Pixel c = command.color;
+                            c.a *= *src / 255.F;
+                            blend(dst, c, AlphaBlend::Straight);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    struct SoftwareRender::Private
+    {
+        size_t threadCount = 1;
+        Size2I size;
+        RenderOptions options;
+        Box2I viewport;
+        bool clipRectEnabled = false;
+        Box2I clipRect;
+        M44F matrix;
+
+        std::shared_ptr<Image> image;
+        std::vector<Command> commands;
+        LRUCache<std::shared_ptr<Image>, std::shared_ptr<Texture> > textureCache;
+
+        Box2I getClip() const;
+        Vertex transform(const V2F&) const;
+        void addTriangles(Command&);
+    };
+
+    Box2I SoftwareRender::Private::getClip() const
+    {
+        Box2I out(0, 0, size.w, size.h);
+        out = intersect(out, viewport);
+        if (clipRectEnabled)
+        {
+            out = intersect(out, clipRect);
+        }
+        return out;
+    }
+
+    Vertex SoftwareRender::Private::transform(const V2F& value) const
+    {
+        const V4F v = V4F(value.x, value.y, 0.F, 1.F) * matrix;
+        const float w = v.w != 0.F ? v.w : 1.F;
+        Vertex out;
+        out.x = viewport.min.x + (v.x / w * .5F + .5F) * viewport.w();
+        out.y = viewport.min.y + (.5F - v.y / w * .5F) * viewport.h();
+        return out;
+    }
+
+    void SoftwareRender::Private::addTriangles(Command& command)
+    {
+        if (command.vertices.empty())
+            return;
+        float minX = command.vertices[0].x;
+        float maxX = minX;
+        float minY = command.vertices[0].y;
+        float maxY = minY;
+        for (const auto& v : command.vertices)
+        {
+            minX = std::min(minX, v.x);
+            maxX = std::max(maxX, v.x);
+            minY = std::min(minY, v.y);
+            maxY = std::max(maxY, v.y);
+        }
+        const Box2I bbox(
+            V2I(static_cast<int>(std::floor(minX)), static_cast<int>(std::floor(minY))),
+            V2I(static_cast<int>(std::ceil(maxX)), static_cast<int>(std::ceil(maxY))));
+        command.bbox = intersect(bbox, getClip());
+        if (command.bbox.isValid())
+        {
+            command.type = CommandType::Triangles;
+            commands.push_back(std::move(command));
+        }
+    }
+
+    void SoftwareRender::_init(
+        const std::shared_ptr<Context>& context,
+        size_t threadCount)
+    {
+        IRender::_init(context);
+        FEATHER_TK_P();
+        if (0 == threadCount)
+        {
+            threadCount = std::max(
+                static_cast<size_t>(1),
+                static_cast<size_t>(std::thread::hardware_concurrency()));
+        }
+        p.threadCount = threadCount;
+    }
+
+    SoftwareRender::SoftwareRender() :
+        _p(new Private)
+    {}
+
+    SoftwareRender::~SoftwareRender()
+    {}
+
+    std::shared_ptr<SoftwareRender> SoftwareRender::create(
+        const std::shared_ptr<Context>& context,
+        size_t threadCount)
+    {
+        auto out = std::shared_ptr<SoftwareRender>(new SoftwareRender);
+        out->_init(context, threadCount);
+        return out;
+    }
+
+    size_t SoftwareRender::getThreadCount() const
+    {
+        return _p->threadCount;
+    }
+
+    const std::shared_ptr<Image>& SoftwareRender::getImage() const
+    {
+        return _p->image;
+    }
+
+    void SoftwareRender::flush()
+    {
+        FEATHER_TK_P();
+        if (p.commands.empty() || !p.image)
+            return;
+
+        const int w = p.size.w;
+        const int h = p.size.h;
+        const int tilesX = (w + tileSize - 1) / tileSize;
+        const int tilesY = (h + tileSize - 1) / tileSize;
+        const int tileCount = tilesX * tilesY;
+        uint8_t* data = p.image->getData();
+        std::atomic<int> next(0);
+        auto work = [&p, &next, data, w, h, tilesX, tileCount]
+        {
+            int tile = 0;
+            while ((tile = next++) < tileCount)
+            {
+                const int tx = tile % tilesX * tileSize;
+                const int ty = tile / tilesX * tileSize;
+                const Box2I tileBox(
+                    tx,
+                    ty,
+                    std::min(tileSize, w - tx),
+                    std::min(tileSize, h - ty));
+                for (const auto& command : p.commands)
+                {
+                    if (!intersects(command.bbox, tileBox))
+                        continue;
+                    const Box2I rect = intersect(command.bbox, tileBox);
+                    switch (command.type)
+                    {
+                    case CommandType::Clear:
+                        for (int y = rect.min.y; y <= rect.max.y; ++y)
+                        {
+                            fillSpan(
+                                data + (static_cast<size_t>(y) * w + rect.min.x) * 4,
+                                rect.w(),
+                                command.color,
+                                AlphaBlend::None);
+                        }
+                        break;
+                    case CommandType::Triangles:
+                        for (size_t i = 0; i + 2 < command.vertices.size(); i += 3)
+                        {
+                            rasterTriangle(command, &command.vertices[i], rect, data, w);
+                        }
+                        break;
+                    case CommandType::Text:
+                        rasterText(command, rect, data, w);
+                        break;
+                    default: break;
+                    }
+                }
+            }
+        };
+        std::vector<std::future<void> > futures;
+        const size_t threadCount = std::min(p.threadCount, static_cast<size_t>(tileCount));
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            futures.push_back(std::async(std::launch::async, work));
+        }
+        work();
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+        p.commands.clear();
+    }
+
+    void SoftwareRender::begin(
+        const Size2I& size,
+        const RenderOptions& options)
+    {
+        FEATHER_TK_P();
+        p.commands.clear();
+        p.size = size;
+        p.options = options;
+        p.textureCache.setMax(options.textureCacheByteCount);
+        if (!p.image || p.image->getSize() != size)
+        {
+            ImageInfo info(size, ImageType::RGBA_U8);
+            info.layout.mirror.y = true;
+            p.image = Image::create(info);
+        }
+        setViewport(Box2I(0, 0, size.w, size.h));
+        if (options.clear)
+        {
+            clearViewport(options.clearColor);
+        }
+        setTransform(ortho(
+            0.F,
+            static_cast<float>(size.w),
+            static_cast<float>(size.h),
+            0.F,
+            -1.F,
+            1.F));
+    }
+
+    void SoftwareRender::end()
+    {
+        flush();
+    }
+
+    Size2I SoftwareRender::getRenderSize() const
+    {
+        return _p->size;
+    }
+
+    void SoftwareRender::setRenderSize(const Size2I& value)
+    {
+        _p->size = value;
+    }
+
+    RenderOptions SoftwareRender::getRenderOptions() const
+    {
+        return _p->options;
+    }
+
+    Box2I SoftwareRender::getViewport() const
+    {
+        return _p->viewport;
+    }
+
+    void SoftwareRender::setViewport(const Box2I& value)
+    {
+        _p->viewport = value;
+    }
+
+    void SoftwareRender::clearViewport(const Color4F& value)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.type = CommandType::Clear;
+        command.color = fromColor(value);
+        command.bbox = Box2I(0, 0, p.size.w, p.size.h);
+        if (p.clipRectEnabled)
+        {
+            command.bbox = intersect(command.bbox, p.clipRect);
+        }
+        if (command.bbox.isValid())
+        {
+            p.commands.push_back(std::move(command));
+        }
+    }
+
+    bool SoftwareRender::getClipRectEnabled() const
+    {
+        return _p->clipRectEnabled;
+    }
+
+    void SoftwareRender::setClipRectEnabled(bool value)
+    {
+        _p->clipRectEnabled = value;
+    }
+
+    Box2I SoftwareRender::getClipRect() const
+    {
+        return _p->clipRect;
+    }
+
+    void SoftwareRender::setClipRect(const Box2I& value)
+    {
+        _p->clipRect = value;
+    }
+
+    M44F SoftwareRender::getTransform() const
+    {
+        return _p->matrix;
+    }
+
+    void SoftwareRender::setTransform(const M44F& value)
+    {
+        _p->matrix = value;
+    }
+
+    void SoftwareRender::drawRect(
+        const Box2F& rect,
+        const Color4F& color)
+    {
+        FEATHER_TK_P();
+        const V2F v[] =
+        {
+            rect.min,
+            V2F(rect.max.x, rect.min.y),
+            rect.max,
+            V2F(rect.min.x, rect.max.y)
+        };
+        Command command;
+        command.color = fromColor(color);
+        for (size_t i : { 0, 1, 2, 2, 3, 0 })
+        {
+            command.vertices.push_back(p.transform(v[i]));
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawRects(
+        const std::vector<Box2F>& rects,
+        const Color4F& color)
+    {
+        for (const auto& rect : rects)
+        {
+            drawRect(rect, color);
+        }
+    }
+
+    void SoftwareRender::drawLine(
+        const V2F& v0,
+        const V2F& v1,
+        const Color4F& color,
+        const LineOptions& options)
+    {
+        drawLines({ std::make_pair(v0, v1) }, color, options);
+    }
+
+    void SoftwareRender::drawLines(
+        const std::vector<std::pair<V2F, V2F> >& lines,
+        const Color4F& color,
+        const LineOptions& options)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.color = fromColor(color);
+        for (const auto& i : lines)
+        {
+            const V2F v2 = normalize(i.second - i.first);
+            const V2F v2CW = perpCW(v2) * options.width / 2.F;
+            const V2F v2CCW = perpCCW(v2) * options.width / 2.F;
+            const V2F v[] =
+            {
+                i.first + v2CCW,
+                i.first + v2CW,
+                i.second + v2CW,
+                i.second + v2CCW
+            };
+            for (size_t j : { 0, 1, 2, 2, 3, 0 })
+            {
+                command.vertices.push_back(p.transform(v[j]));
+            }
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawMesh(
+        const TriMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.color = fromColor(color);
+        for (const auto& triangle : mesh.triangles)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const size_t v = triangle.v[k].v;
+                command.vertices.push_back(p.transform(v ? (mesh.v[v - 1] + pos) : pos));
+            }
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawMesh(
+        const CompactMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.color = fromColor(color);
+        std::vector<Vertex> vertices(mesh.v.size());
+        for (size_t i = 0; i < mesh.v.size(); ++i)
+        {
+            vertices[i] = p.transform(mesh.v[i] + pos);
+        }
+        const size_t indexCount = mesh.getIndexCount();
+        command.vertices.reserve(indexCount);
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            command.vertices.push_back(vertices[mesh.getIndex(i)]);
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawColorMesh(
+        const TriMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.color = fromColor(color);
+        command.vertexColors = true;
+        for (const auto& triangle : mesh.triangles)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const size_t v = triangle.v[k].v;
+                const size_t c = triangle.v[k].c;
+                Vertex vertex = p.transform(v ? (mesh.v[v - 1] + pos) : pos);
+                vertex.c = c ?
+                    Pixel{ mesh.c[c - 1].x, mesh.c[c - 1].y, mesh.c[c - 1].z, mesh.c[c - 1].w } :
+                    Pixel{ 1.F, 1.F, 1.F, 1.F };
+                command.vertices.push_back(vertex);
+            }
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawColorMesh(
+        const CompactMesh2F& mesh,
+        const Color4F& color,
+        const V2F& pos)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.color = fromColor(color);
+        command.vertexColors = true;
+        std::vector<Vertex> vertices(mesh.v.size());
+        for (size_t i = 0; i < mesh.v.size(); ++i)
+        {
+            vertices[i] = p.transform(mesh.v[i] + pos);
+            vertices[i].c = i < mesh.c.size() ?
+                Pixel{ mesh.c[i].x, mesh.c[i].y, mesh.c[i].z, mesh.c[i].w } :
+                Pixel{ 1.F, 1.F, 1.F, 1.F };
+        }
+        const size_t indexCount = mesh.getIndexCount();
+        command.vertices.reserve(indexCount);
+        for (size_t i = 0; i < indexCount; ++i)
+        {
+            command.vertices.push_back(vertices[mesh.getIndex(i)]);
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawTexture(
+        unsigned int,
+        const Box2I&,
+        const Color4F&,
+        AlphaBlend)
+    {}
+
+    void SoftwareRender::drawText(
+        const std::vector<std::shared_ptr<Glyph> >& glyphs,
+        const FontMetrics& fontMetrics,
+        const V2F& pos,
+        const Color4F& color)
+    {
+        FEATHER_TK_P();
+        Command command;
+        command.type = CommandType::Text;
+        command.color = fromColor(color);
+        const Box2I clip = p.getClip();
+        int x = 0;
+        int y = 0;
+        int32_t rsbDeltaPrev = 0;
+        Box2I lineRect(p.clipRect.min.x, pos.y, p.clipRect.w(), fontMetrics.lineHeight);
+        for (auto glyphIt = glyphs.begin(); glyphIt != glyphs.end(); ++glyphIt)
+        {
+            if (*glyphIt)
+            {
+                if ('\n' == (*glyphIt)->info.code)
+                {
+                    x = 0;
+                    y += fontMetrics.lineHeight;
+                    rsbDeltaPrev = 0;
+                    lineRect = Box2I(p.clipRect.min.x, pos.y + y, p.clipRect.w(), fontMetrics.lineHeight);
+                }
+                else if (!p.clipRectEnabled ||
+                    (p.clipRectEnabled && intersects(p.clipRect, lineRect)))
+                {
+                    if (rsbDeltaPrev - (*glyphIt)->lsbDelta > 32)
+                    {
+                        x -= 1;
+                    }
+                    else if (rsbDeltaPrev - (*glyphIt)->lsbDelta < -31)
+                    {
+                        x += 1;
+                    }
+                    rsbDeltaPrev = (*glyphIt)->rsbDelta;
+
+                    if ((*glyphIt)->image && (*glyphIt)->image->isValid())
+                    {
+                        const V2I& offset = (*glyphIt)->offset;
+                        //! \bug Off by one?
+                        const int extraOffset = 1;
+                        const Vertex v = p.transform(V2F(
+                            pos.x + x + offset.x,
+                            pos.y + y + fontMetrics.ascender - offset.y - extraOffset));
+                        GlyphBlit blit;
+                        blit.image = (*glyphIt)->image;
+                        blit.x = static_cast<int>(std::floor(v.x + .5F));
+                        blit.y = static_cast<int>(std::floor(v.y + .5F));
+                        const Box2I box(
+                            blit.x,
+                            blit.y,
+                            blit.image->getWidth(),
+                            blit.image->getHeight());
+                        if (intersects(box, clip))
+                        {
+                            command.bbox = command.glyphs.empty() ?
+                                box :
+                                expand(command.bbox, box);
+                            command.glyphs.push_back(blit);
+                        }
+                    }
+
+                    x += (*glyphIt)->advance;
+                }
+            }
+        }
+        if (!command.glyphs.empty())
+        {
+            command.bbox = intersect(command.bbox, clip);
+            p.commands.push_back(std::move(command));
+        }
+    }
+
+    void SoftwareRender::drawImage(
+        const std::shared_ptr<Image>& image,
+        const TriMesh2F& mesh,
+        const Color4F& color,
+        const ImageOptions& imageOptions)
+    {
+        FEATHER_TK_P();
+        const auto& info = image->getInfo();
+        if (!info.isValid())
+            return;
+
+        VideoLevels videoLevels = info.videoLevels;
+        switch (imageOptions.videoLevels)
+        {
+        case InputVideoLevels::FullRange:
+            videoLevels = VideoLevels::FullRange;
+            break;
+        case InputVideoLevels::LegalRange:
+            videoLevels = VideoLevels::LegalRange;
+            break;
+        default: break;
+        }
+        std::shared_ptr<Texture> texture;
+        if (!imageOptions.cache ||
+            !p.textureCache.get(image, texture) ||
+            texture->videoLevels != videoLevels)
+        {
+            texture = createTexture(image, videoLevels);
+            if (imageOptions.cache)
+            {
+                // The texture is stored as floating point RGBA, so charge
+                // the cache for the converted size rather than the image.
+                p.textureCache.add(
+                    image,
+                    texture,
+                    texture->data.size() * sizeof(Pixel));
+            }
+        }
+
+        Command command;
+        command.color = fromColor(color);
+        command.alphaBlend = imageOptions.alphaBlend;
+        command.texture = texture;
+        command.channelDisplay = imageOptions.channelDisplay;
+        for (const auto& triangle : mesh.triangles)
+        {
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const size_t v = triangle.v[k].v;
+                const size_t t = triangle.v[k].t;
+                Vertex vertex = p.transform(v ? mesh.v[v - 1] : V2F());
+                if (t)
+                {
+                    vertex.u = mesh.t[t - 1].x;
+                    vertex.v = mesh.t[t - 1].y;
+                }
+                command.vertices.push_back(vertex);
+            }
+        }
+        if (!command.vertices.empty())
+        {
+            // Use the magnification filter when the image is drawn at
+            // least as large as its native size.
+            float minX = command.vertices[0].x;
+            float maxX = minX;
+            float minY = command.vertices[0].y;
+            float maxY = minY;
+            for (const auto& i : command.vertices)
+            {
+                minX = std::min(minX, i.x);
+                maxX = std::max(maxX, i.x);
+                minY = std::min(minY, i.y);
+                maxY = std::max(maxY, i.y);
+            }
+            command.filter = maxX - minX >= info.size.w && maxY - minY >= info.size.h ?
+                imageOptions.imageFilters.magnify :
+                imageOptions.imageFilters.minify;
+        }
+        p.addTriangles(command);
+    }
+
+    void SoftwareRender::drawImage(
+        const std::shared_ptr<Image>& image,
+        const Box2F& box,
+        const Color4F& color,
+        const ImageOptions& imageOptions)
+    {
+        drawImage(image, mesh(box), color, imageOptions);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/IRender.h>
+
+namespace feather_tk
+{
+    //! \name Rendering
+    ///@{
+
+    //! Software renderer.
+    //!
+    //! The software renderer draws into an RGBA_U8 image without requiring
+    //! a GPU, for example to render UI snapshots on headless machines.
+    //!
+    //! Draw calls are recorded and then rasterized when the render ends.
+    //! The image is split into tiles that are rasterized in parallel, each
+    //! tile processing the draw calls in order so the results are the same
+    //! as drawing serially.
+    //!
+    //! Textures are not supported, drawTexture() does nothing.
+    class SoftwareRender : public IRender
+    {
+    protected:
+        void _init(
+            const std::shared_ptr<Context>&,
+            size_t threadCount);
+
+        SoftwareRender();
+
+    public:
+        virtual ~SoftwareRender();
+
+        //! Create a new renderer. If the thread count is zero it is chosen
+        //! automatically.
+        static std::shared_ptr<SoftwareRender> create(
+            const std::shared_ptr<Context>&,
+            size_t threadCount = 0);
+
+        //! Get the number of threads.
+        size_t getThreadCount() const;
+
+        //! Get the rendered image. The image is valid after the render
+        //! has ended.
+        const std::shared_ptr<Image>& getImage() const;
+
+        void begin(
+            const Size2I&,
+            const RenderOptions& = RenderOptions()) override;
+        void end() override;
+        Size2I getRenderSize() const override;
+        void setRenderSize(const Size2I&) override;
+        RenderOptions getRenderOptions() const override;
+        Box2I getViewport() const override;
+        void setViewport(const Box2I&) override;
+        void clearViewport(const Color4F&) override;
+        bool getClipRectEnabled() const override;
+        void setClipRectEnabled(bool) override;
+        Box2I getClipRect() const override;
+        void setClipRect(const Box2I&) override;
+        M44F getTransform() const override;
+        void setTransform(const M44F&) override;
+        void flush() override;
+        void drawRect(
+            const Box2F&,
+            const Color4F&) override;
+        void drawRects(
+            const std::vector<Box2F>&,
+            const Color4F&) override;
+        void drawLine(
+            const V2F&,
+            const V2F&,
+            const Color4F&,
+            const LineOptions& = LineOptions()) override;
+        void drawLines(
+            const std::vector<std::pair<V2F, V2F> >&,
+            const Color4F&,
+            const LineOptions& = LineOptions()) override;
+        void drawMesh(
+            const TriMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F()) override;
+        void drawMesh(
+            const CompactMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F()) override;
+        void drawColorMesh(
+            const TriMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F()) override;
+        void drawColorMesh(
+            const CompactMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const V2F& pos = V2F()) override;
+        void drawTexture(
+            unsigned int,
+            const Box2I&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F),
+            AlphaBlend = AlphaBlend::Straight) override;
+        using IRender::drawText;
+        void drawText(
+            const std::vector<std::shared_ptr<Glyph> >&,
+            const FontMetrics&,
+            const V2F& position,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F)) override;
+        void drawImage(
+            const std::shared_ptr<Image>&,
+            const TriMesh2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const ImageOptions& = ImageOptions()) override;
+        void drawImage(
+            const std::shared_ptr<Image>&,
+            const Box2F&,
+            const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+            const ImageOptions& = ImageOptions()) override;
+
+    private:
+        FEATHER_TK_PRIVATE();
+    };
+
+    ///@}
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <feather-tk/core/Random.h>
 
 #include <algorithm>
+#include <cctype>
 #include <codecvt>
 #include <locale>
 
@@ -176,6 +177,15 @@ namespace feather_tk
         return out;
     }
 
+    namespace
+    {
+        bool equalInsensitive(char a, char b)
+        {
+            return std::tolower(static_cast<unsigned char>(a)) ==
+                std::tolower(static_cast<unsigned char>(b));
+        }
+    }
+
     bool compare(
         const std::string& a,
         const std::string& b,
@@ -188,7 +198,8 @@ namespace feather_tk
             out = a == b;
             break;
         case CaseCompare::Insensitive:
-            out = toLower(a) == toLower(b);
+            out = a.size() == b.size() &&
+                std::equal(a.begin(), a.end(), b.begin(), equalInsensitive);
             break;
         }
         return out;
@@ -206,9 +217,20 @@ namespace feather_tk
             i = input.find(substr);
             break;
         case CaseCompare::Insensitive:
-            i = toLower(input).find(toLower(substr));
+        {
+            const auto j = std::search(
+                input.begin(),
+                input.end(),
+                substr.begin(),
+                substr.end(),
+                equalInsensitive);
+            if (j != input.end() || substr.empty())
+            {
+                i = j - input.begin();
+            }
             break;
         }
+        }
         return i != std::string::npos;
     }
 
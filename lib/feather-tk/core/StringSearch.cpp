@@ -0,0 +1,521 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/core/StringSearch.h>
+
+#include <feather-tk/core/Error.h>
+#include <feather-tk/core/String.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+
+namespace feather_tk
+{
+    FEATHER_TK_ENUM_IMPL(
+        StringSearchMode,
+        "Substring",
+        "Fuzzy");
+
+    bool StringSearchResult::operator == (const StringSearchResult& other) const
+    {
+        return
+            index == other.index &&
+            score == other.score;
+    }
+
+    bool StringSearchResult::operator != (const StringSearchResult& other) const
+    {
+        return !(*this == other);
+    }
+
+    namespace
+    {
+        uint32_t foldCodePoint(uint32_t c)
+        {
+            uint32_t out = c;
+            if (c >= 0xc0 && c <= 0xde && c != 0xd7)
+            {
+                // Latin-1
+                out = c + 0x20;
+            }
+            else if (
+                (c >= 0x100 && c <= 0x12f) ||
+                (c >= 0x132 && c <= 0x137) ||
+                (c >= 0x14a && c <= 0x177) ||
+                (c >= 0x460 && c <= 0x481) ||
+                (c >= 0x48a && c <= 0x4bf))
+            {
+                // Latin Extended-A and Cyrillic pairs, upper case is even.
+                out = c | 1;
+            }
+            else if (
+                (c >= 0x139 && c <= 0x148) ||
+                (c >= 0x179 && c <= 0x17e))
+            {
+                // Latin Extended-A pairs, upper case is odd.
+                out = (c & 1) ? c + 1 : c;
+            }
+            else if (0x178 == c)
+            {
+                out = 0xff;
+            }
+            else if (c >= 0x391 && c <= 0x3a9 && c != 0x3a2)
+            {
+                // Greek
+                out = c + 0x20;
+            }
+            else if (0x386 == c)
+            {
+                out = 0x3ac;
+            }
+            else if (c >= 0x388 && c <= 0x38a)
+            {
+                out = c + 0x25;
+            }
+            else if (0x38c == c)
+            {
+                out = 0x3cc;
+            }
+            else if (c >= 0x38e && c <= 0x38f)
+            {
+                out = c + 0x3f;
+            }
+            else if (0x3c2 == c)
+            {
+                // Final sigma
+                out = 0x3c3;
+            }
+            else if (c >= 0x400 && c <= 0x40f)
+            {
+                // Cyrillic
+                out = c + 0x50;
+            }
+            else if (c >= 0x410 && c <= 0x42f)
+            {
+                out = c + 0x20;
+            }
+            return out;
+        }
+
+        void foldCase(char* data, size_t size)
+        {
+            for (size_t i = 0; i < size;)
+            {
+                const uint8_t c = static_cast<uint8_t>(data[i]);
+                if (c >= 'A' && c <= 'Z')
+                {
+                    data[i] = static_cast<char>(c + ('a' - 'A'));
+                    ++i;
+                }
+                else if (
+                    0xc0 == (c & 0xe0) &&
+                    i + 1 < size &&
+                    0x80 == (static_cast<uint8_t>(data[i + 1]) & 0xc0))
+                {
+                    // Only two byte characters are folded, and they fold to
+                    // two byte characters.
+                    const uint32_t cp =
+                        ((c & 0x1f) << 6) |
+                        (static_cast<uint8_t>(data[i + 1]) & 0x3f);
+                    const uint32_t folded = foldCodePoint(cp);
+                    if (folded != cp)
+                    {
+                        data[i] = static_cast<char>(0xc0 | (folded >> 6));
+                        data[i + 1] = static_cast<char>(0x80 | (folded & 0x3f));
+                    }
+                    i += 2;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        size_t getCharSize(const char* data, size_t size)
+        {
+            size_t out = 1;
+            while (out < size && 0x80 == (static_cast<uint8_t>(data[out]) & 0xc0))
+            {
+                ++out;
+            }
+            return out;
+        }
+
+        bool isWordStart(const char* data, size_t i)
+        {
+            bool out = 0 == i;
+            if (!out)
+            {
+                const char prev = data[i - 1];
+                const char c = data[i];
+                out =
+                    ' ' == prev || '_' == prev || '-' == prev || '.' == prev ||
+                    '/' == prev || '\\' == prev || ':' == prev ||
+                    (prev >= 'a' && prev <= 'z' && c >= 'A' && c <= 'Z');
+            }
+            return out;
+        }
+
+        //! Match a fuzzy search. The characters are matched greedily from
+        //! the start, and the ranges of the matching characters are
+        //! optionally returned.
+        bool fuzzyMatch(
+            const char* text,
+            const char* folded,
+            size_t size,
+            const std::string& search,
+            int& score,
+            std::vector<std::pair<size_t, size_t> >* ranges = nullptr)
+        {
+            score = 0;
+            size_t j = 0;
+            size_t first = 0;
+            size_t last = 0;
+            size_t prevEnd = std::string::npos;
+            size_t i = 0;
+            while (i < size && j < search.size())
+            {
+                // Find the next character with memchr. The first byte of a
+                // UTF-8 character never matches a continuation byte, so the
+                // result is always at the start of a character.
+                const void* p = std::memchr(folded + i, search[j], size - i);
+                if (!p)
+                    break;
+                i = static_cast<const char*>(p) - folded;
+                const size_t charSize = getCharSize(search.data() + j, search.size() - j);
+                if (charSize > size - i ||
+                    std::memcmp(folded + i, search.data() + j, charSize) != 0)
+                {
+                    ++i;
+                    continue;
+                }
+                int charScore = 1;
+                if (i == prevEnd)
+                {
+                    charScore += 4;
+                }
+                if (isWordStart(text, i))
+                {
+                    charScore += 8;
+                }
+                score += charScore;
+                if (0 == j)
+                {
+                    first = i;
+                }
+                last = i + charSize;
+                if (ranges)
+                {
+                    if (i == prevEnd && !ranges->empty())
+                    {
+                        ranges->back().second += charSize;
+                    }
+                    else
+                    {
+                        ranges->push_back(std::make_pair(i, charSize));
+                    }
+                }
+                prevEnd = i + charSize;
+                i += charSize;
+                j += charSize;
+            }
+            const bool out = j == search.size();
+            if (out)
+            {
+                // Penalize the characters between the matches.
+                score -= static_cast<int>(last - first - search.size()) / 2;
+            }
+            return out;
+        }
+    }
+
+    std::string foldCase(const std::string& value)
+    {
+        std::string out = value;
+        foldCase(out.data(), out.size());
+        return out;
+    }
+
+    struct StringSearch::Private
+    {
+        std::string text;
+        std::string folded;
+        std::vector<size_t> offsets = { 0 };
+        std::string search;
+        std::string searchFolded;
+        StringSearchMode mode = StringSearchMode::Substring;
+        std::vector<StringSearchResult> results;
+        std::vector<uint8_t> matches;
+
+        bool match(size_t index, int& score) const
+        {
+            bool out = true;
+            score = 0;
+            if (!searchFolded.empty())
+            {
+                const size_t offset = offsets[index];
+                const size_t size = offsets[index + 1] - offset;
+                switch (mode)
+                {
+                case StringSearchMode::Substring:
+                    // The search uses memchr to find the first character,
+                    // which is vectorized by the C library.
+                    out = std::string_view(folded.data() + offset, size).find(searchFolded) !=
+                        std::string_view::npos;
+                    break;
+                case StringSearchMode::Fuzzy:
+                    out = fuzzyMatch(
+                        text.data() + offset,
+                        folded.data() + offset,
+                        size,
+                        searchFolded,
+                        score);
+                    break;
+                default: break;
+                }
+            }
+            return out;
+        }
+
+        void sort()
+        {
+            if (StringSearchMode::Fuzzy == mode && results.size() > 1)
+            {
+                // The results are in index order, so a stable counting
+                // sort by score keeps the index order for equal scores.
+                const auto minMax = std::minmax_element(
+                    results.begin(),
+                    results.end(),
+                    [](const StringSearchResult& a, const StringSearchResult& b)
+                    {
+                        return a.score < b.score;
+                    });
+                const int min = minMax.first->score;
+                const int max = minMax.second->score;
+                std::vector<size_t> counts(max - min + 2, 0);
+                for (const auto& result : results)
+                {
+                    ++counts[max - result.score + 1];
+                }
+                for (size_t i = 1; i < counts.size(); ++i)
+                {
+                    counts[i] += counts[i - 1];
+                }
+                std::vector<StringSearchResult> sorted(results.size());
+                for (const auto& result : results)
+                {
+                    sorted[counts[max - result.score]++] = result;
+                }
+                results = std::move(sorted);
+            }
+        }
+    };
+
+    StringSearch::StringSearch() :
+        _p(new Private)
+    {}
+
+    StringSearch::~StringSearch()
+    {}
+
+    size_t StringSearch::getItemCount() const
+    {
+        return _p->offsets.size() - 1;
+    }
+
+    std::string StringSearch::getItem(size_t index) const
+    {
+        FEATHER_TK_P();
+        return p.text.substr(p.offsets[index], p.offsets[index + 1] - p.offsets[index]);
+    }
+
+    void StringSearch::setItems(const std::vector<std::string>& value)
+    {
+        clear();
+        addItems(value);
+    }
+
+    void StringSearch::addItems(const std::vector<std::string>& value)
+    {
+        FEATHER_TK_P();
+        const size_t begin = getItemCount();
+        const size_t textSize = p.text.size();
+        size_t size = 0;
+        for (const auto& i : value)
+        {
+            size += i.size();
+        }
+        p.text.reserve(textSize + size);
+        p.offsets.reserve(p.offsets.size() + value.size());
+        for (const auto& i : value)
+        {
+            p.text.append(i);
+            p.offsets.push_back(p.text.size());
+        }
+        p.folded.append(p.text, textSize, size);
+        foldCase(p.folded.data() + textSize, size);
+        p.matches.resize(getItemCount(), 0);
+        if (StringSearchMode::Fuzzy == p.mode)
+        {
+            std::sort(
+                p.results.begin(),
+                p.results.end(),
+                [](const StringSearchResult& a, const StringSearchResult& b)
+                {
+                    return a.index < b.index;
+                });
+        }
+        _match(begin, getItemCount());
+        p.sort();
+    }
+
+    void StringSearch::clear()
+    {
+        FEATHER_TK_P();
+        p.text.clear();
+        p.folded.clear();
+        p.offsets = { 0 };
+        p.results.clear();
+        p.matches.clear();
+    }
+
+    const std::string& StringSearch::getSearch() const
+    {
+        return _p->search;
+    }
+
+    StringSearchMode StringSearch::getMode() const
+    {
+        return _p->mode;
+    }
+
+    const std::vector<StringSearchResult>& StringSearch::search(
+        const std::string& value,
+        StringSearchMode mode)
+    {
+        FEATHER_TK_P();
+        const std::string searchFolded = foldCase(value);
+        bool incremental = false;
+        if (mode == p.mode && !p.searchFolded.empty())
+        {
+            switch (mode)
+            {
+            case StringSearchMode::Substring:
+                incremental = searchFolded.find(p.searchFolded) != std::string::npos;
+                break;
+            case StringSearchMode::Fuzzy:
+                incremental = 0 == searchFolded.compare(0, p.searchFolded.size(), p.searchFolded);
+                break;
+            default: break;
+            }
+        }
+        p.search = value;
+        p.searchFolded = searchFolded;
+        p.mode = mode;
+        _search(incremental);
+        return p.results;
+    }
+
+    const std::vector<StringSearchResult>& StringSearch::getResults() const
+    {
+        return _p->results;
+    }
+
+    bool StringSearch::isMatch(size_t index) const
+    {
+        FEATHER_TK_P();
+        return index < p.matches.size() ? p.matches[index] : false;
+    }
+
+    std::vector<std::pair<size_t, size_t> > StringSearch::getMatchRanges(size_t index) const
+    {
+        FEATHER_TK_P();
+        std::vector<std::pair<size_t, size_t> > out;
+        if (index < getItemCount() && !p.searchFolded.empty())
+        {
+            const size_t offset = p.offsets[index];
+            const size_t size = p.offsets[index + 1] - offset;
+            switch (p.mode)
+            {
+            case StringSearchMode::Substring:
+            {
+                const size_t i = std::string_view(p.folded.data() + offset, size).find(p.searchFolded);
+                if (i != std::string_view::npos)
+                {
+                    out.push_back(std::make_pair(i, p.searchFolded.size()));
+                }
+                break;
+            }
+            case StringSearchMode::Fuzzy:
+            {
+                int score = 0;
+                if (!fuzzyMatch(
+                    p.text.data() + offset,
+                    p.folded.data() + offset,
+                    size,
+                    p.searchFolded,
+                    score,
+                    &out))
+                {
+                    out.clear();
+                }
+                break;
+            }
+            default: break;
+            }
+        }
+        return out;
+    }
+
+    void StringSearch::_search(bool incremental)
+    {
+        FEATHER_TK_P();
+        if (incremental)
+        {
+            // Only search the previous results. The results are visited
+            // in index order so that they can be sorted.
+            p.results.clear();
+            for (size_t i = 0; i < p.matches.size(); ++i)
+            {
+                if (p.matches[i])
+                {
+                    int score = 0;
+                    if (p.match(i, score))
+                    {
+                        p.results.push_back({ i, score });
+                    }
+                    else
+                    {
+                        p.matches[i] = 0;
+                    }
+                }
+            }
+        }
+        else
+        {
+            p.results.clear();
+            std::fill(p.matches.begin(), p.matches.end(), 0);
+            _match(0, getItemCount());
+        }
+        p.sort();
+    }
+
+    void StringSearch::_match(size_t begin, size_t end)
+    {
+        FEATHER_TK_P();
+        for (size_t i = begin; i < end; ++i)
+        {
+            int score = 0;
+            if (p.match(i, score))
+            {
+                p.results.push_back({ i, score });
+                p.matches[i] = 1;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/core/Util.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace feather_tk
+{
+    //! \name Strings
+    ///@{
+
+    //! String search mode.
+    enum class StringSearchMode
+    {
+        Substring, //!< Case insensitive substring
+        Fuzzy,     //!< Case insensitive subsequence, ranked by score
+
+        Count,
+        First = Substring
+    };
+    FEATHER_TK_ENUM(StringSearchMode);
+
+    //! String search result.
+    struct StringSearchResult
+    {
+        size_t index = 0;
+        int    score = 0;
+
+        bool operator == (const StringSearchResult&) const;
+        bool operator != (const StringSearchResult&) const;
+    };
+
+    //! Fold the case of a UTF-8 string for case insensitive matching.
+    //! ASCII, Latin-1, Latin Extended-A, Greek, and Cyrillic letters are
+    //! folded. The number of bytes is not changed, so offsets into the
+    //! folded string are also valid for the original string.
+    std::string foldCase(const std::string&);
+
+    //! String search.
+    //!
+    //! The items are case folded once when they are added, so searching
+    //! does not allocate per item. When a search extends the previous
+    //! search, for example when a character is typed, only the previous
+    //! results are searched again.
+    //!
+    //! Substring results are ordered by index. Fuzzy results are ordered
+    //! by score, with a bonus for consecutive characters and characters
+    //! at the start of words.
+    class StringSearch
+    {
+    public:
+        StringSearch();
+
+        ~StringSearch();
+
+        //! Get the number of items.
+        size_t getItemCount() const;
+
+        //! Get an item.
+        std::string getItem(size_t) const;
+
+        //! Set the items. The current search is applied to the items.
+        void setItems(const std::vector<std::string>&);
+
+        //! Add items. The current search is applied to the new items.
+        void addItems(const std::vector<std::string>&);
+
+        //! Clear the items.
+        void clear();
+
+        //! Get the search.
+        const std::string& getSearch() const;
+
+        //! Get the search mode.
+        StringSearchMode getMode() const;
+
+        //! Set the search. An empty search matches all of the items.
+        const std::vector<StringSearchResult>& search(
+            const std::string&,
+            StringSearchMode = StringSearchMode::Substring);
+
+        //! Get the search results.
+        const std::vector<StringSearchResult>& getResults() const;
+
+        //! Get whether an item matches the search.
+        bool isMatch(size_t) const;
+
+        //! Get the byte ranges of an item that match the search, for
+        //! highlighting. The ranges are given as the first byte and the
+        //! number of bytes.
+        std::vector<std::pair<size_t, size_t> > getMatchRanges(size_t) const;
+
+    private:
+        void _search(bool incremental);
+        void _match(size_t begin, size_t end);
+
+        FEATHER_TK_PRIVATE();
+    };
+
+    ///@}
+}
\ No newline at end of file
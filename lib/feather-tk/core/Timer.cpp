@@ -6,6 +6,7 @@
 
 #include <feather-tk/core/Context.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace feather_tk
@@ -95,6 +96,19 @@ namespace feather_tk
         return _p->timeout;
     }
 
+    std::chrono::microseconds Timer::getTimeRemaining() const
+    {
+        FEATHER_TK_P();
+        std::chrono::microseconds out = std::chrono::microseconds::zero();
+        const auto now = std::chrono::steady_clock::now();
+        if (now < p.start + p.timeout)
+        {
+            out = std::chrono::duration_cast<std::chrono::microseconds>(
+                p.start + p.timeout - now);
+        }
+        return out;
+    }
+
     void Timer::tick()
     {
         FEATHER_TK_P();
@@ -154,6 +168,23 @@ namespace feather_tk
         _p->timers.push_back(timer);
     }
 
+    std::chrono::microseconds TimerSystem::getTimeRemaining() const
+    {
+        FEATHER_TK_P();
+        std::chrono::microseconds out = std::chrono::microseconds::max();
+        for (const auto& i : p.timers)
+        {
+            if (auto timer = i.lock())
+            {
+                if (timer->isActive())
+                {
+                    out = std::min(out, timer->getTimeRemaining());
+                }
+            }
+        }
+        return out;
+    }
+
     void TimerSystem::tick()
     {
         FEATHER_TK_P();
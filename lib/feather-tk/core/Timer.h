@@ -57,6 +57,9 @@ namespace feather_tk
         //! Get the timeout.
         const std::chrono::microseconds& getTimeout() const;
 
+        //! Get the time remaining until the timer times out.
+        std::chrono::microseconds getTimeRemaining() const;
+
         void tick();
 
     private:
@@ -77,6 +80,11 @@ namespace feather_tk
 
         void addTimer(const std::shared_ptr<Timer>&);
 
+        //! Get the time remaining until the next active timer times out,
+        //! or std::chrono::microseconds::max() if there are no active
+        //! timers.
+        std::chrono::microseconds getTimeRemaining() const;
+
         void tick() override;
         std::chrono::milliseconds getTickTime() const override;
 
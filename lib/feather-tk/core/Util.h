@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <functional>
+
 //! Convenience macro for making a class non-copyable.
 #define FEATHER_TK_NON_COPYABLE(CLASS) \
     CLASS(const CLASS&) = delete; \
@@ -107,3 +109,13 @@
         out = static_cast<ENUM>(i - labels.begin()); \
         return is; \
     }
+
+namespace feather_tk
+{
+    //! Combine a value with a hash.
+    template<typename T>
+    inline void hashCombine(std::size_t& hash, const T& value)
+    {
+        hash ^= std::hash<T>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+}
\ No newline at end of file
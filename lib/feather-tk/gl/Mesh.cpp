@@ -161,6 +161,59 @@ namespace feather_tk
             return out;
         }
 
+        std::vector<uint8_t> convert(const CompactMesh2F& mesh, VBOType type)
+        {
+            const size_t vertexByteCount = getByteCount(type);
+            std::vector<uint8_t> out(mesh.v.size() * vertexByteCount);
+            uint8_t* p = out.data();
+            switch (type)
+            {
+            case VBOType::Pos2_F32:
+                for (size_t i = 0; i < mesh.v.size(); ++i)
+                {
+                    float* pf = reinterpret_cast<float*>(p);
+                    pf[0] = mesh.v[i].x;
+                    pf[1] = mesh.v[i].y;
+                    p += 2 * sizeof(float);
+                }
+                break;
+            case VBOType::Pos2_F32_UV_U16:
+                for (size_t i = 0; i < mesh.v.size(); ++i)
+                {
+                    float* pf = reinterpret_cast<float*>(p);
+                    pf[0] = mesh.v[i].x;
+                    pf[1] = mesh.v[i].y;
+                    p += 2 * sizeof(float);
+
+                    const bool t = i < mesh.t.size();
+                    uint16_t* pu16 = reinterpret_cast<uint16_t*>(p);
+                    pu16[0] = t ? clamp(static_cast<int>(mesh.t[i].x * 65535.F), 0, 65535) : 0;
+                    pu16[1] = t ? clamp(static_cast<int>(mesh.t[i].y * 65535.F), 0, 65535) : 0;
+                    p += 2 * sizeof(uint16_t);
+                }
+                break;
+            case VBOType::Pos2_F32_Color_F32:
+                for (size_t i = 0; i < mesh.v.size(); ++i)
+                {
+                    float* pf = reinterpret_cast<float*>(p);
+                    pf[0] = mesh.v[i].x;
+                    pf[1] = mesh.v[i].y;
+                    p += 2 * sizeof(float);
+
+                    const bool c = i < mesh.c.size();
+                    pf = reinterpret_cast<float*>(p);
+                    pf[0] = c ? mesh.c[i].x : 1.F;
+                    pf[1] = c ? mesh.c[i].y : 1.F;
+                    pf[2] = c ? mesh.c[i].z : 1.F;
+                    pf[3] = c ? mesh.c[i].w : 1.F;
+                    p += 4 * sizeof(float);
+                }
+                break;
+            default: break;
+            }
+            return out;
+        }
+
         std::vector<uint8_t> convert(const TriMesh3F& mesh, VBOType type)
         {
             return convert(
@@ -466,6 +519,62 @@ namespace feather_tk
             glBufferSubData(GL_ARRAY_BUFFER, offset, static_cast<GLsizei>(size), (void*)data.data());
         }
 
+        struct EBO::Private
+        {
+            std::size_t size = 0;
+            GLuint ebo = 0;
+        };
+
+        EBO::EBO(std::size_t size) :
+            _p(new Private)
+        {
+            FEATHER_TK_P();
+            p.size = size;
+            glGenBuffers(1, &p.ebo);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, p.ebo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizei>(p.size * sizeof(uint16_t)), NULL, GL_DYNAMIC_DRAW);
+        }
+
+        EBO::~EBO()
+        {
+            FEATHER_TK_P();
+            if (p.ebo)
+            {
+                glDeleteBuffers(1, &p.ebo);
+                p.ebo = 0;
+            }
+        }
+
+        std::shared_ptr<EBO> EBO::create(std::size_t size)
+        {
+            return std::shared_ptr<EBO>(new EBO(size));
+        }
+
+        std::size_t EBO::getSize() const
+        {
+            return _p->size;
+        }
+
+        unsigned int EBO::getID() const
+        {
+            return _p->ebo;
+        }
+
+        void EBO::bind()
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _p->ebo);
+        }
+
+        void EBO::copy(const uint16_t* data, std::size_t offset, std::size_t size)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _p->ebo);
+            glBufferSubData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                offset * sizeof(uint16_t),
+                static_cast<GLsizei>(size * sizeof(uint16_t)),
+                (void*)data);
+        }
+
         struct VAO::Private
         {
             GLuint vao = 0;
@@ -578,5 +687,14 @@ namespace feather_tk
         {
             glDrawArrays(mode, static_cast<GLsizei>(offset), static_cast<GLsizei>(size));
         }
+
+        void VAO::drawElements(unsigned int mode, std::size_t offset, std::size_t size)
+        {
+            glDrawElements(
+                mode,
+                static_cast<GLsizei>(size),
+                GL_UNSIGNED_SHORT,
+                (GLvoid*)(offset * sizeof(uint16_t)));
+        }
     }
 }
@@ -46,6 +46,10 @@ namespace feather_tk
         //! Convert a triangle mesh to vertex buffer data.
         std::vector<uint8_t> convert(const TriMesh2F&, VBOType, const RangeSizeT&);
 
+        //! Convert the vertices of a compact mesh to vertex buffer data.
+        //! The data is not de-indexed, use the mesh indices to draw it.
+        std::vector<uint8_t> convert(const CompactMesh2F&, VBOType);
+
         //! Convert a triangle mesh to vertex buffer data.
         std::vector<uint8_t> convert(const TriMesh3F&, VBOType);
 
@@ -88,6 +92,38 @@ namespace feather_tk
             FEATHER_TK_PRIVATE();
         };
 
+        //! Element buffer object with 16-bit indices.
+        class EBO : public std::enable_shared_from_this<EBO>
+        {
+            FEATHER_TK_NON_COPYABLE(EBO);
+
+        protected:
+            EBO(std::size_t size);
+
+        public:
+            ~EBO();
+
+            //! Create a new object.
+            static std::shared_ptr<EBO> create(std::size_t size);
+
+            //! Get the size.
+            std::size_t getSize() const;
+
+            //! Get the OpenGL ID.
+            unsigned int getID() const;
+
+            //! Bind the element buffer object. The binding is stored in the
+            //! currently bound vertex array object.
+            void bind();
+
+            //! Copy indices to the element buffer object. The offset and
+            //! size are given in indices.
+            void copy(const uint16_t*, std::size_t offset, std::size_t size);
+
+        private:
+            FEATHER_TK_PRIVATE();
+        };
+
         //! Vertex array object.
         class VAO : public std::enable_shared_from_this<VAO>
         {
@@ -111,6 +147,11 @@ namespace feather_tk
             //! Draw the vertex array object.
             void draw(unsigned int mode, std::size_t offset, std::size_t size);
 
+            //! Draw the vertex array object with the indices from the bound
+            //! element buffer object. The offset and size are given in
+            //! indices.
+            void drawElements(unsigned int mode, std::size_t offset, std::size_t size);
+
         private:
             FEATHER_TK_PRIVATE();
         };
@@ -4,10 +4,14 @@
 
 #include <feather-tk/gl/RenderPrivate.h>
 
+#include <feather-tk/gl/GL.h>
+
 #include <feather-tk/core/Context.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/LogSystem.h>
 
+#include <algorithm>
+
 namespace feather_tk
 {
     namespace gl
@@ -16,6 +20,341 @@ namespace feather_tk
         {
             const int pboSizeMin = 1024;
             const size_t statsAverageCount = 10;
+            const size_t meshArenaPageSize = 65536;
+            const size_t textureStreamFrameMax = 10;
+
+            const std::array<std::string, static_cast<size_t>(ShaderSlot::Count)> shaderNames =
+            {
+                "rect",
+                "line",
+                "mesh",
+                "colorMesh",
+                "texture",
+                "text",
+                "image"
+            };
+
+            const std::array<std::string, static_cast<size_t>(UniformSlot::Count)> uniformNames =
+            {
+                "transform.mvp",
+                "color",
+                "textureSampler",
+                "textureSampler0",
+                "textureSampler1",
+                "textureSampler2",
+                "imageType",
+                "channelCount",
+                "channelDisplay",
+                "videoLevels",
+                "yuvCoefficients",
+                "mirrorX",
+                "mirrorY"
+            };
+
+            std::map<size_t, size_t>::iterator findFree(
+                std::map<size_t, size_t>& free,
+                size_t size)
+            {
+                auto i = free.begin();
+                for (; i != free.end() && i->second < size; ++i)
+                    ;
+                return i;
+            }
+
+            size_t takeFree(
+                std::map<size_t, size_t>& free,
+                std::map<size_t, size_t>::iterator i,
+                size_t size)
+            {
+                const size_t offset = i->first;
+                const size_t remaining = i->second - size;
+                free.erase(i);
+                if (remaining > 0)
+                {
+                    free[offset + size] = remaining;
+                }
+                return offset;
+            }
+
+            void addFree(
+                std::map<size_t, size_t>& free,
+                size_t offset,
+                size_t size)
+            {
+                if (0 == size)
+                    return;
+
+                // Merge with the adjacent free ranges.
+                auto next = free.lower_bound(offset);
+                if (next != free.end() && offset + size == next->first)
+                {
+                    size += next->second;
+                    next = free.erase(next);
+                }
+                if (next != free.begin())
+                {
+                    auto prev = std::prev(next);
+                    if (prev->first + prev->second == offset)
+                    {
+                        offset = prev->first;
+                        size += prev->second;
+                        free.erase(prev);
+                    }
+                }
+                free[offset] = size;
+            }
+        }
+
+        MeshArena::Range MeshArena::allocate(size_t vertexCount, size_t indexCount)
+        {
+            Range out;
+            out.vertexCount = vertexCount;
+            out.indexCount = indexCount;
+            this->vertexCount += vertexCount;
+            this->indexCount += indexCount;
+
+            // Find the first page with enough free vertices and indices.
+            if (vertexCount <= meshArenaPageSize)
+            {
+                for (out.page = 0; out.page < pages.size(); ++out.page)
+                {
+                    Page& page = pages[out.page];
+                    if (page.vertexSize != meshArenaPageSize)
+                        continue;
+                    auto v = findFree(page.freeVertices, vertexCount);
+                    auto i = indexCount > 0 ?
+                        findFree(page.freeIndices, indexCount) :
+                        page.freeIndices.end();
+                    if (v != page.freeVertices.end() &&
+                        (0 == indexCount || i != page.freeIndices.end()))
+                    {
+                        out.vertexOffset = takeFree(page.freeVertices, v, vertexCount);
+                        if (indexCount > 0)
+                        {
+                            out.indexOffset = takeFree(page.freeIndices, i, indexCount);
+                        }
+                        return out;
+                    }
+                }
+            }
+
+            // Add a new page, reusing an empty slot if there is one.
+            Page page;
+            if (vertexCount <= meshArenaPageSize)
+            {
+                // Dense meshes can have more indices than a shared page
+                // holds, so the element buffer is grown to fit.
+                page.vertexSize = meshArenaPageSize;
+                page.indexSize = std::max(meshArenaPageSize * 3, indexCount);
+            }
+            else
+            {
+                page.vertexSize = vertexCount;
+            }
+            page.vbo = VBO::create(page.vertexSize, VBOType::Pos2_F32);
+            page.vao = VAO::create(page.vbo->getType(), page.vbo->getID());
+            addFree(page.freeVertices, vertexCount, page.vertexSize - vertexCount);
+            if (page.indexSize > 0)
+            {
+                page.ebo = EBO::create(page.indexSize);
+                addFree(page.freeIndices, indexCount, page.indexSize - indexCount);
+            }
+            for (out.page = 0; out.page < pages.size() && pages[out.page].vbo; ++out.page)
+                ;
+            if (out.page < pages.size())
+            {
+                pages[out.page] = std::move(page);
+            }
+            else
+            {
+                pages.push_back(std::move(page));
+            }
+            out.vertexOffset = 0;
+            out.indexOffset = 0;
+            return out;
+        }
+
+        void MeshArena::release(const Range& range)
+        {
+            std::unique_lock<std::mutex> lock(releasedMutex);
+            released.push_back(range);
+        }
+
+        void MeshArena::collect()
+        {
+            std::vector<Range> ranges;
+            {
+                std::unique_lock<std::mutex> lock(releasedMutex);
+                ranges.swap(released);
+            }
+            for (const auto& range : ranges)
+            {
+                if (range.page >= pages.size())
+                    continue;
+                vertexCount -= range.vertexCount;
+                indexCount -= range.indexCount;
+                Page& page = pages[range.page];
+                addFree(page.freeVertices, range.vertexOffset, range.vertexCount);
+                addFree(page.freeIndices, range.indexOffset, range.indexCount);
+
+                // Release pages that are empty, except for the first page
+                // that is shared.
+                const auto i = page.freeVertices.find(0);
+                if ((range.page > 0 || page.vertexSize != meshArenaPageSize) &&
+                    i != page.freeVertices.end() &&
+                    i->second == page.vertexSize)
+                {
+                    page = Page();
+                }
+            }
+        }
+
+        RetainedMesh::RetainedMesh(
+            const std::shared_ptr<IRender>& render,
+            const CompactMesh2F& mesh,
+            const std::shared_ptr<MeshArena>& arena) :
+            RenderMesh(render, mesh),
+            arena(arena)
+        {}
+
+        RetainedMesh::~RetainedMesh()
+        {
+            if (auto arena = this->arena.lock())
+            {
+                arena->release(range);
+            }
+        }
+
+        gl::Shader& Render::Private::bindShader(ShaderSlot slot)
+        {
+            auto& data = pipeline.shaders[static_cast<size_t>(slot)];
+            if (slot != pipeline.shader)
+            {
+                data.shader->bind();
+                pipeline.shader = slot;
+                stats.stateChangeCount += 1;
+            }
+            else
+            {
+                stats.stateChangeSkipCount += 1;
+            }
+            if (data.transformId != pipeline.transformId)
+            {
+                data.shader->setUniform(
+                    data.uniforms[static_cast<size_t>(UniformSlot::Transform)],
+                    transform);
+                data.transformId = pipeline.transformId;
+            }
+            return *data.shader;
+        }
+
+        void Render::Private::setBlend(
+            unsigned int srcRGB,
+            unsigned int dstRGB,
+            unsigned int srcAlpha,
+            unsigned int dstAlpha)
+        {
+            const std::array<unsigned int, 4> blend = { srcRGB, dstRGB, srcAlpha, dstAlpha };
+            if (!pipeline.blendValid || blend != pipeline.blend)
+            {
+#if defined(FEATHER_TK_API_GL_4_1)
+                glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+#elif defined(FEATHER_TK_API_GLES_2)
+                glBlendFunc(srcRGB, dstRGB);
+#endif // FEATHER_TK_API_GL_4_1
+                pipeline.blend = blend;
+                pipeline.blendValid = true;
+                stats.stateChangeCount += 1;
+            }
+            else
+            {
+                stats.stateChangeSkipCount += 1;
+            }
+        }
+
+        void Render::Private::setAlphaBlend(AlphaBlend value)
+        {
+            switch (value)
+            {
+            case AlphaBlend::None:
+                setBlend(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+                break;
+            case AlphaBlend::Straight:
+                setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case AlphaBlend::Premultiplied:
+                setBlend(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            default: break;
+            }
+        }
+
+        void Render::Private::bindTexture(unsigned int unit, unsigned int id)
+        {
+            if (unit != pipeline.activeTexture)
+            {
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+                pipeline.activeTexture = unit;
+            }
+            if (unit >= pipeline.textures.size() || id != pipeline.textures[unit])
+            {
+                glBindTexture(GL_TEXTURE_2D, id);
+                if (unit < pipeline.textures.size())
+                {
+                    pipeline.textures[unit] = id;
+                }
+                stats.stateChangeCount += 1;
+            }
+            else
+            {
+                stats.stateChangeSkipCount += 1;
+            }
+        }
+
+        void Render::Private::bindVAO(const std::shared_ptr<VAO>& vao)
+        {
+            if (vao->getID() != pipeline.vao)
+            {
+                vao->bind();
+                pipeline.vao = vao->getID();
+                stats.stateChangeCount += 1;
+            }
+            else
+            {
+                stats.stateChangeSkipCount += 1;
+            }
+        }
+
+        void Render::Private::resetState()
+        {
+            pipeline.shader = ShaderSlot::Count;
+            pipeline.blendValid = false;
+            resetTextures();
+            resetVAO();
+        }
+
+        void Render::Private::resetTextures()
+        {
+            pipeline.activeTexture = PipelineState::invalid;
+            pipeline.textures.fill(PipelineState::invalid);
+        }
+
+        void Render::Private::resetVAO()
+        {
+            pipeline.vao = PipelineState::invalid;
+        }
+
+        size_t Render::Private::getSkippedUniformCount() const
+        {
+            size_t out = 0;
+            for (const auto& data : pipeline.shaders)
+            {
+                if (data.shader)
+                {
+                    out += data.shader->getSkippedUniformCount();
+                }
+            }
+            return out;
         }
 
         void Render::_init(
@@ -30,6 +369,7 @@ namespace feather_tk
             {
                 p.textureCache = std::make_shared<TextureCache>();
             }
+            p.meshArena = std::make_shared<MeshArena>();
             
             p.logTimer = Timer::create(context);
             p.logTimer->setRepeating(true);
@@ -63,7 +403,17 @@ namespace feather_tk
 
         std::shared_ptr<Shader> Render::getShader(const std::string& value)
         {
-            return _p->shaders[value];
+            FEATHER_TK_P();
+            std::shared_ptr<Shader> out;
+            const auto i = std::find(shaderNames.begin(), shaderNames.end(), value);
+            if (i != shaderNames.end())
+            {
+                out = p.pipeline.shaders[i - shaderNames.begin()].shader;
+            }
+
+            // The caller may bind the shader.
+            p.pipeline.shader = ShaderSlot::Count;
+            return out;
         }
 
         const std::shared_ptr<TextureCache>& Render::getTextureCache() const
@@ -71,6 +421,76 @@ namespace feather_tk
             return _p->textureCache;
         }
 
+        const RenderStats& Render::getStats() const
+        {
+            return _p->stats;
+        }
+
+        void Render::flush()
+        {
+            FEATHER_TK_P();
+            if (p.batch.vertexCount > 0)
+            {
+                Private::BatchBuffers* buffers = nullptr;
+                VBOType vboType = VBOType::Pos2_F32_Color_F32;
+                switch (p.batch.type)
+                {
+                case BatchType::Mesh:
+                    buffers = &p.meshBatch;
+                    p.bindShader(ShaderSlot::ColorMesh);
+                    p.setUniform(UniformSlot::Color, Color4F(1.F, 1.F, 1.F, 1.F));
+                    break;
+                case BatchType::Text:
+                    buffers = &p.textBatch;
+                    vboType = VBOType::Pos2_F32_UV_U16;
+                    p.bindShader(ShaderSlot::Text);
+                    p.setUniform(UniformSlot::Color, p.batch.color);
+                    p.setUniform(UniformSlot::TextureSampler, 0);
+                    p.bindTexture(0, p.glyphAtlas->getTexture(p.batch.page));
+                    break;
+                default: break;
+                }
+                if (buffers)
+                {
+                    p.setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+                    auto& vbo = buffers->vbo;
+                    auto& ebo = buffers->ebo;
+                    auto& vao = buffers->vao;
+                    if (!vbo || (vbo && vbo->getSize() < p.batch.vertexCount))
+                    {
+                        const size_t size = vbo ? vbo->getSize() : 0;
+                        vbo = VBO::create(std::max(p.batch.vertexCount, size * 2), vboType);
+                        vao.reset();
+                    }
+                    if (!ebo || (ebo && ebo->getSize() < p.batch.indexCount))
+                    {
+                        const size_t size = ebo ? ebo->getSize() : 0;
+                        ebo = EBO::create(std::max(p.batch.indexCount, size * 2));
+                    }
+                    if (!vao)
+                    {
+                        vao = VAO::create(vbo->getType(), vbo->getID());
+                        p.resetVAO();
+                    }
+                    vbo->copy(p.batch.data, 0, p.batch.byteCount);
+                    p.bindVAO(vao);
+                    ebo->bind();
+                    ebo->copy(p.batch.indices.data(), 0, p.batch.indexCount);
+                    vao->drawElements(GL_TRIANGLES, 0, p.batch.indexCount);
+                    p.stats.drawCount += 1;
+                    p.stats.batchCount += 1;
+                    p.stats.byteCount +=
+                        p.batch.byteCount +
+                        p.batch.indexCount * sizeof(uint16_t);
+                }
+            }
+            p.batch.type = BatchType::None;
+            p.batch.byteCount = 0;
+            p.batch.vertexCount = 0;
+            p.batch.indexCount = 0;
+        }
+
         void Render::begin(
             const Size2I& size,
             const RenderOptions& options)
@@ -78,14 +498,22 @@ namespace feather_tk
             FEATHER_TK_P();
 
             p.startTime = std::chrono::steady_clock::now();
-            p.stats = Private::Stats();
+            p.stats = RenderStats();
+            p.stats.uniformSkipCount = p.getSkippedUniformCount();
+            ++p.frame;
+            p.batch.type = BatchType::None;
+            p.batch.byteCount = 0;
+            p.batch.vertexCount = 0;
+            p.batch.indexCount = 0;
+            p.meshArena->collect();
             
             p.size = size;
             p.options = options;
             p.textureCache->setMax(options.textureCacheByteCount);
 
             if (!p.glyphAtlas ||
-                (p.glyphAtlas && options.glyphAtlasSize != p.glyphAtlas->getSize()))
+                (p.glyphAtlas && options.glyphAtlasSize != p.glyphAtlas->getSize()) ||
+                (p.glyphAtlas && options.glyphAtlasPageCount != p.glyphAtlas->getPageCountMax()))
             {
                 ImageType imageType = ImageType::L_U8;
 #if defined(FEATHER_TK_API_GLES_2)
@@ -95,62 +523,56 @@ namespace feather_tk
                 p.glyphAtlas = TextureAtlas::create(
                     options.glyphAtlasSize,
                     imageType,
-                    ImageFilter::Linear);
+                    ImageFilter::Linear,
+                    1,
+                    options.glyphAtlasPageCount);
+                p.glyphAtlas->setEvictCallback(
+                    [this](int)
+                    {
+                        // Draw the batch before the page it may use is
+                        // cleared.
+                        flush();
+                    });
+                p.glyphIDs.clear();
             }
 
             glEnable(GL_BLEND);
             glBlendEquation(GL_FUNC_ADD);
 
-            if (!p.shaders["rect"])
-            {
-                p.shaders["rect"] = Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
-            }
-            if (!p.shaders["line"])
-            {
-                p.shaders["line"] = Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
-            }
-            if (!p.shaders["mesh"])
-            {
-                p.shaders["mesh"] = Shader::create(
-                    vertexSource(),
-                    meshFragmentSource());
-            }
-            if (!p.shaders["colorMesh"])
-            {
-                p.shaders["colorMesh"] = Shader::create(
-                    colorMeshVertexSource(),
-                    colorMeshFragmentSource());
-            }
-            if (!p.shaders["texture"])
-            {
-                p.shaders["texture"] = gl::Shader::create(
-                    vertexSource(),
-                    textureFragmentSource());
-            }
-            if (!p.shaders["text"])
+            // The OpenGL state may have been changed since the last render.
+            p.resetState();
+
+            if (!p.pipeline.shaders[0].shader)
             {
-                p.shaders["text"] = Shader::create(
-                    vertexSource(),
-                    textFragmentSource());
+                const std::array<std::pair<std::string, std::string>, static_cast<size_t>(ShaderSlot::Count)> sources =
+                {
+                    std::make_pair(vertexSource(), meshFragmentSource()),
+                    std::make_pair(vertexSource(), meshFragmentSource()),
+                    std::make_pair(vertexSource(), meshFragmentSource()),
+                    std::make_pair(colorMeshVertexSource(), colorMeshFragmentSource()),
+                    std::make_pair(vertexSource(), textureFragmentSource()),
+                    std::make_pair(vertexSource(), textFragmentSource()),
+                    std::make_pair(vertexSource(), imageFragmentSource())
+                };
+                for (size_t i = 0; i < sources.size(); ++i)
+                {
+                    auto& data = p.pipeline.shaders[i];
+                    data.shader = Shader::create(sources[i].first, sources[i].second);
+                    for (size_t j = 0; j < uniformNames.size(); ++j)
+                    {
+                        data.uniforms[j] = data.shader->getUniformLocation(uniformNames[j]);
+                    }
+                    data.transformId = 0;
+                }
             }
-            if (!p.shaders["image"])
+
+            if (!p.textureVBO)
             {
-                p.shaders["image"] = Shader::create(
-                    vertexSource(),
-                    imageFragmentSource());
+                p.textureVBO = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
+                p.textureVAO = gl::VAO::create(p.textureVBO->getType(), p.textureVBO->getID());
+                p.resetVAO();
             }
 
-            p.vbos["rect"] = VBO::create(2 * 3, VBOType::Pos2_F32);
-            p.vaos["rect"] = VAO::create(p.vbos["rect"]->getType(), p.vbos["rect"]->getID());
-            p.vbos["line"] = VBO::create(2 * 3, VBOType::Pos2_F32);
-            p.vaos["line"] = VAO::create(p.vbos["line"]->getType(), p.vbos["line"]->getID());
-            p.vbos["texture"] = gl::VBO::create(2 * 3, gl::VBOType::Pos2_F32_UV_U16);
-            p.vaos["texture"] = gl::VAO::create(p.vbos["texture"]->getType(), p.vbos["texture"]->getID());
-
             setViewport(Box2I(0, 0, size.w, size.h));
             if (options.clear)
             {
@@ -168,9 +590,29 @@ namespace feather_tk
         void Render::end()
         {
             FEATHER_TK_P();
+            flush();
             const auto now = std::chrono::steady_clock::now();
             const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - p.startTime);
             p.stats.renderTime = diff.count();
+            p.stats.glyphAtlasPageCount = p.glyphAtlas->getPageCount();
+            p.stats.glyphAtlasPercentage = p.glyphAtlas->getPercentageUsed() * 100.F;
+            p.stats.retainedVertexCount = p.meshArena->vertexCount;
+
+            // Release texture streams that have not been drawn recently.
+            for (auto i = p.textureStreams.begin(); i != p.textureStreams.end();)
+            {
+                if (p.frame - i->frame > textureStreamFrameMax)
+                {
+                    i = p.textureStreams.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            p.stats.textureStreamCount = p.textureStreams.size();
+            p.stats.uniformSkipCount = p.getSkippedUniformCount() - p.stats.uniformSkipCount;
+
             p.statsList.push_back(p.stats);
             while (p.statsList.size() > statsAverageCount)
             {
@@ -201,6 +643,7 @@ namespace feather_tk
         void Render::setViewport(const Box2I& value)
         {
             FEATHER_TK_P();
+            flush();
             p.viewport = value;
             glViewport(
                 value.x(),
@@ -211,6 +654,7 @@ namespace feather_tk
 
         void Render::clearViewport(const Color4F& value)
         {
+            flush();
             glClearColor(value.r, value.g, value.b, value.a);
             glClear(GL_COLOR_BUFFER_BIT);
         }
@@ -223,6 +667,7 @@ namespace feather_tk
         void Render::setClipRectEnabled(bool value)
         {
             FEATHER_TK_P();
+            flush();
             p.clipRectEnabled = value;
             if (p.clipRectEnabled)
             {
@@ -242,6 +687,10 @@ namespace feather_tk
         void Render::setClipRect(const Box2I& value)
         {
             FEATHER_TK_P();
+            if (value != p.clipRect)
+            {
+                flush();
+            }
             p.clipRect = value;
             const Size2I size = value.size();
             if (size.isValid())
@@ -262,12 +711,91 @@ namespace feather_tk
         void Render::setTransform(const M44F& value)
         {
             FEATHER_TK_P();
+            flush();
             p.transform = value;
-            for (auto i : p.shaders)
+
+            // The shaders are updated with the new transform when they are
+            // bound.
+            ++p.pipeline.transformId;
+        }
+
+        void Render::resetState()
+        {
+            _p->resetState();
+        }
+
+        Render::BatchData Render::_batch(
+            BatchType type,
+            size_t vertexCount,
+            size_t indexCount,
+            const Color4F& color,
+            int page)
+        {
+            FEATHER_TK_P();
+            if (type != p.batch.type ||
+                (BatchType::Text == type && (color != p.batch.color || page != p.batch.page)) ||
+                p.batch.vertexCount + vertexCount > batchVertexMax)
+            {
+                flush();
+                p.batch.type = type;
+                p.batch.color = color;
+                p.batch.page = page;
+            }
+            const size_t byteCount = vertexCount * getByteCount(
+                BatchType::Text == type ?
+                VBOType::Pos2_F32_UV_U16 :
+                VBOType::Pos2_F32_Color_F32);
+            if (p.batch.byteCount + byteCount > p.batch.data.size())
+            {
+                p.batch.data.resize(std::max(
+                    p.batch.byteCount + byteCount,
+                    p.batch.data.size() * 2));
+            }
+            if (p.batch.indexCount + indexCount > p.batch.indices.size())
             {
-                i.second->bind();
-                i.second->setUniform("transform.mvp", value);
+                p.batch.indices.resize(std::max(
+                    p.batch.indexCount + indexCount,
+                    p.batch.indices.size() * 2));
             }
+            BatchData out;
+            out.vertices = p.batch.data.data() + p.batch.byteCount;
+            out.indices = p.batch.indices.data() + p.batch.indexCount;
+            out.base = static_cast<uint16_t>(p.batch.vertexCount);
+            p.batch.byteCount += byteCount;
+            p.batch.vertexCount += vertexCount;
+            p.batch.indexCount += indexCount;
+            return out;
+        }
+
+        std::shared_ptr<TextureStream> Render::_getTextureStream(
+            const ImageInfo& info,
+            const ImageFilters& imageFilters)
+        {
+            FEATHER_TK_P();
+
+            // Find a stream that has not already been drawn this frame, so
+            // that multiple images with the same information can be drawn.
+            auto i = std::find_if(
+                p.textureStreams.begin(),
+                p.textureStreams.end(),
+                [&p, info, imageFilters](const Private::TextureStreamData& value)
+                {
+                    return
+                        value.frame != p.frame &&
+                        value.filters == imageFilters &&
+                        value.stream->isCompatible(info);
+                });
+            if (i == p.textureStreams.end())
+            {
+                TextureOptions options;
+                options.filters = imageFilters;
+                Private::TextureStreamData data;
+                data.stream = TextureStream::create(info, options);
+                data.filters = imageFilters;
+                i = p.textureStreams.insert(p.textureStreams.end(), data);
+            }
+            i->frame = p.frame;
+            return i->stream;
         }
 
         std::vector<std::shared_ptr<Texture> > Render::_getTextures(
@@ -445,79 +973,61 @@ namespace feather_tk
             const std::vector<std::shared_ptr<Texture> >& textures,
             size_t offset)
         {
+            FEATHER_TK_P();
             switch (info.type)
             {
             case ImageType::YUV_420P_U8:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             case ImageType::YUV_422P_U8:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             case ImageType::YUV_444P_U8:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             case ImageType::YUV_420P_U16:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             case ImageType::YUV_422P_U16:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             case ImageType::YUV_444P_U16:
                 if (3 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 1 + offset));
-                    textures[1]->bind();
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + 2 + offset));
-                    textures[2]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
+                    p.bindTexture(1 + offset, textures[1]->getID());
+                    p.bindTexture(2 + offset, textures[2]->getID());
                 }
                 break;
             default:
                 if (1 == textures.size())
                 {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + offset));
-                    textures[0]->bind();
+                    p.bindTexture(offset, textures[0]->getID());
                 }
                 break;
             }
@@ -529,7 +1039,7 @@ namespace feather_tk
             if (auto context = _context.lock())
             {
                 auto logSystem = context->getSystem<LogSystem>();
-                Private::Stats average;
+                RenderStats average;
                 const size_t size = p.statsList.size();
                 if (size)
                 {
@@ -539,24 +1049,74 @@ namespace feather_tk
                         average.triCount     += i.triCount;
                         average.textureCount += i.textureCount;
                         average.glyphCount   += i.glyphCount;
+                        average.drawCount        += i.drawCount;
+                        average.batchCount       += i.batchCount;
+                        average.stateChangeCount += i.stateChangeCount;
+                        average.stateChangeSkipCount += i.stateChangeSkipCount;
+                        average.uniformSkipCount += i.uniformSkipCount;
+                        average.byteCount        += i.byteCount;
+                        average.glyphAtlasPageCount  += i.glyphAtlasPageCount;
+                        average.glyphAtlasPercentage += i.glyphAtlasPercentage;
+                        average.glyphAddCount        += i.glyphAddCount;
+                        average.glyphEvictionCount   += i.glyphEvictionCount;
+                        average.retainedDrawCount    += i.retainedDrawCount;
+                        average.retainedVertexCount  += i.retainedVertexCount;
+                        average.textureStreamCount       += i.textureStreamCount;
+                        average.textureStreamUploadCount += i.textureStreamUploadCount;
                     }
-                    average.renderTime   /= size;
-                    average.triCount     /= size;
-                    average.textureCount /= size;
-                    average.glyphCount   /= size;
+                    average.renderTime               /= size;
+                    average.triCount                 /= size;
+                    average.textureCount             /= size;
+                    average.glyphCount               /= size;
+                    average.drawCount                /= size;
+                    average.batchCount               /= size;
+                    average.stateChangeCount         /= size;
+                    average.stateChangeSkipCount     /= size;
+                    average.uniformSkipCount         /= size;
+                    average.byteCount                /= size;
+                    average.glyphAtlasPageCount      /= size;
+                    average.glyphAtlasPercentage     /= size;
+                    average.glyphAddCount            /= size;
+                    average.glyphEvictionCount       /= size;
+                    average.retainedDrawCount        /= size;
+                    average.retainedVertexCount      /= size;
+                    average.textureStreamCount       /= size;
+                    average.textureStreamUploadCount /= size;
                 }
                 logSystem->print(
                     "feather_tk::gl::Render",
                     Format(
                         "Averages:\n"
-                        "    Render time:    {0}ms\n"
-                        "    Triangle count: {1}\n"
-                        "    Texture count:  {2}\n"
-                        "    Glyph count:    {3}").
+                        "    Render time:     {0}ms\n"
+                        "    Triangle count:  {1}\n"
+                        "    Texture count:   {2}\n"
+                        "    Glyph count:     {3}\n"
+                        "    Draw calls:      {4}, {5} batches\n"
+                        "    State changes:   {6}, {7} skipped, {8} uniforms skipped\n"
+                        "    Bytes uploaded:  {9}\n"
+                        "    Glyph atlas:     {10} pages, {11}% used\n"
+                        "    Glyph uploads:   {12}\n"
+                        "    Glyph evicts:    {13}\n"
+                        "    Retained draws:  {14}, {15} vertices\n"
+                        "    Texture streams: {16}, {17} uploads").
                         arg(average.renderTime).
                         arg(average.triCount).
                         arg(average.textureCount).
-                        arg(average.glyphCount));
+                        arg(average.glyphCount).
+                        arg(average.drawCount).
+                        arg(average.batchCount).
+                        arg(average.stateChangeCount).
+                        arg(average.stateChangeSkipCount).
+                        arg(average.uniformSkipCount).
+                        arg(average.byteCount).
+                        arg(average.glyphAtlasPageCount).
+                        arg(average.glyphAtlasPercentage).
+                        arg(average.glyphAddCount).
+                        arg(average.glyphEvictionCount).
+                        arg(average.retainedDrawCount).
+                        arg(average.retainedVertexCount).
+                        arg(average.textureStreamCount).
+                        arg(average.textureStreamUploadCount));
             }
         }
     }
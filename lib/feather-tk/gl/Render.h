@@ -14,6 +14,7 @@ namespace feather_tk
     {
         class Shader;
         class Texture;
+        class TextureStream;
 
         //! \name Renderer
         ///@{
@@ -22,6 +23,29 @@ namespace feather_tk
         typedef LRUCache<
             std::shared_ptr<Image>,
             std::vector<std::shared_ptr<Texture> > > TextureCache;
+
+        //! Render statistics for a frame.
+        struct RenderStats
+        {
+            int renderTime = 0; //!< Render time in milliseconds
+            size_t triCount = 0;
+            size_t textureCount = 0;
+            size_t glyphCount = 0;
+            size_t drawCount = 0;
+            size_t batchCount = 0; //!< Draw calls made for batches
+            size_t stateChangeCount = 0;
+            size_t stateChangeSkipCount = 0;
+            size_t uniformSkipCount = 0;
+            size_t byteCount = 0;
+            size_t glyphAtlasPageCount = 0;
+            float glyphAtlasPercentage = 0.F;
+            size_t glyphAddCount = 0;
+            size_t glyphEvictionCount = 0;
+            size_t retainedDrawCount = 0;
+            size_t retainedVertexCount = 0;
+            size_t textureStreamCount = 0;
+            size_t textureStreamUploadCount = 0;
+        };
         
         //! OpenGL renderer.
         class Render : public IRender
@@ -47,6 +71,29 @@ namespace feather_tk
             //! Get the texture cache.
             const std::shared_ptr<TextureCache>& getTextureCache() const;
 
+            //! Get the statistics for the current frame. The statistics
+            //! are reset by begin().
+            const RenderStats& getStats() const;
+
+            //! \name Texture Streams
+            //! Draw a texture stream. This can be used to upload images
+            //! that are written from another thread with
+            //! TextureStream::map().
+            ///@{
+
+            void drawImage(
+                const std::shared_ptr<TextureStream>&,
+                const TriMesh2F&,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                const ImageOptions& = ImageOptions());
+            void drawImage(
+                const std::shared_ptr<TextureStream>&,
+                const Box2F&,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                const ImageOptions& = ImageOptions());
+
+            ///@}
+
             void begin(
                 const Size2I&,
                 const RenderOptions& = RenderOptions()) override;
@@ -63,6 +110,8 @@ namespace feather_tk
             void setClipRect(const Box2I&) override;
             M44F getTransform() const override;
             void setTransform(const M44F&) override;
+            void flush() override;
+            void resetState() override;
             void drawRect(
                 const Box2F&,
                 const Color4F&) override;
@@ -82,15 +131,30 @@ namespace feather_tk
                 const TriMesh2F&,
                 const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
                 const V2F& pos = V2F()) override;
+            void drawMesh(
+                const CompactMesh2F&,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                const V2F& pos = V2F()) override;
+            std::shared_ptr<RenderMesh> createMesh(const TriMesh2F&) override;
+            std::shared_ptr<RenderMesh> createMesh(const CompactMesh2F&) override;
+            void drawMesh(
+                const std::shared_ptr<RenderMesh>&,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                const V2F& pos = V2F()) override;
             void drawColorMesh(
                 const TriMesh2F&,
                 const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
                 const V2F& pos = V2F()) override;
+            void drawColorMesh(
+                const CompactMesh2F&,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                const V2F& pos = V2F()) override;
             void drawTexture(
                 unsigned int,
                 const Box2I&,
                 const Color4F& = Color4F(1.F, 1.F, 1.F),
                 AlphaBlend = AlphaBlend::Straight) override;
+            using IRender::drawText;
             void drawText(
                 const std::vector<std::shared_ptr<Glyph> >&,
                 const FontMetrics&,
@@ -108,6 +172,47 @@ namespace feather_tk
                 const ImageOptions& = ImageOptions()) override;
 
         private:
+            enum class BatchType
+            {
+                None,
+                Mesh,
+                Text
+            };
+
+            //! Batch data. The indices are relative to the start of the
+            //! batch, add the base to the mesh indices.
+            struct BatchData
+            {
+                uint8_t* vertices = nullptr;
+                uint16_t* indices = nullptr;
+                uint16_t base = 0;
+            };
+
+            //! Add vertices and indices to the batch. A batch holds up to
+            //! 65536 vertices so they can be addressed with 16-bit indices.
+            BatchData _batch(
+                BatchType,
+                size_t vertexCount,
+                size_t indexCount,
+                const Color4F& = Color4F(1.F, 1.F, 1.F, 1.F),
+                int page = 0);
+
+            void _batchCompactMesh(
+                const CompactMesh2F&,
+                const Color4F&,
+                const V2F& pos,
+                bool vertexColors);
+
+            std::shared_ptr<TextureStream> _getTextureStream(
+                const ImageInfo&,
+                const ImageFilters&);
+            void _drawImage(
+                const ImageInfo&,
+                const std::vector<std::shared_ptr<Texture> >&,
+                const TriMesh2F&,
+                const Color4F&,
+                const ImageOptions&);
+
             std::vector<std::shared_ptr<Texture> > _getTextures(
                 const ImageInfo&,
                 const ImageFilters&,
@@ -121,8 +226,6 @@ namespace feather_tk
                 const std::vector<std::shared_ptr<Texture> >&,
                 size_t offset = 0);
 
-            void _drawTextMesh(const TriMesh2F&);
-            
             void _log();
 
             FEATHER_TK_PRIVATE();
@@ -6,55 +6,98 @@
 
 #include <feather-tk/gl/Util.h>
 
+#include <feather-tk/core/Math.h>
+
+#include <algorithm>
+
 namespace feather_tk
 {
     namespace gl
     {
-        void Render::drawRect(
-            const Box2F& rect,
-            const Color4F& color)
+        namespace
         {
-            FEATHER_TK_P();
-
-            p.shaders["rect"]->bind();
-            p.shaders["rect"]->setUniform("color", color);
+            inline uint8_t* batchVertex(
+                uint8_t* data,
+                const V2F& v,
+                const Color4F& c)
+            {
+                float* pf = reinterpret_cast<float*>(data);
+                pf[0] = v.x;
+                pf[1] = v.y;
+                pf[2] = c.r;
+                pf[3] = c.g;
+                pf[4] = c.b;
+                pf[5] = c.a;
+                return data + 6 * sizeof(float);
+            }
 
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            inline uint8_t* batchVertex(
+                uint8_t* data,
+                float x,
+                float y,
+                float u,
+                float v)
+            {
+                float* pf = reinterpret_cast<float*>(data);
+                pf[0] = x;
+                pf[1] = y;
+                uint16_t* pu16 = reinterpret_cast<uint16_t*>(data + 2 * sizeof(float));
+                pu16[0] = clamp(static_cast<int>(u * 65535.F), 0, 65535);
+                pu16[1] = clamp(static_cast<int>(v * 65535.F), 0, 65535);
+                return data + 2 * sizeof(float) + 2 * sizeof(uint16_t);
+            }
 
-            if (p.vbos["rect"])
+            inline void batchQuad(uint16_t* indices, uint16_t base)
             {
-                const auto mesh = feather_tk::mesh(rect);
-                p.vbos["rect"]->copy(convert(mesh, p.vbos["rect"]->getType()));
-                p.stats.triCount += mesh.triangles.size();
+                indices[0] = base + 0;
+                indices[1] = base + 1;
+                indices[2] = base + 2;
+                indices[3] = base + 2;
+                indices[4] = base + 3;
+                indices[5] = base + 0;
             }
-            if (p.vaos["rect"])
+
+            inline void batchSequence(uint16_t* indices, uint16_t base, size_t count)
             {
-                p.vaos["rect"]->bind();
-                p.vaos["rect"]->draw(GL_TRIANGLES, 0, p.vbos["rect"]->getSize());
+                for (size_t i = 0; i < count; ++i)
+                {
+                    indices[i] = static_cast<uint16_t>(base + i);
+                }
             }
+
+            const size_t batchTriangleMax = batchVertexMax / 3;
+        }
+
+        void Render::drawRect(
+            const Box2F& rect,
+            const Color4F& color)
+        {
+            FEATHER_TK_P();
+            const BatchData batch = _batch(BatchType::Mesh, 4, 6);
+            uint8_t* data = batch.vertices;
+            data = batchVertex(data, rect.min, color);
+            data = batchVertex(data, V2F(rect.max.x, rect.min.y), color);
+            data = batchVertex(data, rect.max, color);
+            data = batchVertex(data, V2F(rect.min.x, rect.max.y), color);
+            batchQuad(batch.indices, batch.base);
+            p.stats.triCount += 2;
         }
 
         void Render::drawRects(
             const std::vector<Box2F>& rects,
             const Color4F& color)
         {
-            TriMesh2F mesh;
-            mesh.v.resize(rects.size() * 4);
-            mesh.triangles.resize(rects.size() * 2);
-            size_t v = 0;
-            size_t t = 0;
+            CompactMesh2F mesh;
+            mesh.v.reserve(rects.size() * 4);
             for (const auto& rect : rects)
             {
-                mesh.v[v + 0] = rect.min;
-                mesh.v[v + 1].x = rect.max.x;
-                mesh.v[v + 1].y = rect.min.y;
-                mesh.v[v + 2] = rect.max;
-                mesh.v[v + 3].x = rect.min.x;
-                mesh.v[v + 3].y = rect.max.y;
-                mesh.triangles[t + 0] = { v + 1, v + 2, v + 3 };
-                mesh.triangles[t + 1] = { v + 3, v + 4, v + 1 };
-                v += 4;
-                t += 2;
+                const uint32_t v = static_cast<uint32_t>(mesh.v.size());
+                mesh.v.push_back(rect.min);
+                mesh.v.push_back(V2F(rect.max.x, rect.min.y));
+                mesh.v.push_back(rect.max);
+                mesh.v.push_back(V2F(rect.min.x, rect.max.y));
+                mesh.addTriangle(v + 0, v + 1, v + 2);
+                mesh.addTriangle(v + 2, v + 3, v + 0);
             }
             drawMesh(mesh, color);
         }
@@ -66,33 +109,17 @@ namespace feather_tk
             const LineOptions& options)
         {
             FEATHER_TK_P();
-
-            p.shaders["line"]->bind();
-            p.shaders["line"]->setUniform("color", color);
-
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
             const V2F v2 = normalize(v1 - v0);
             const V2F v2CW = perpCW(v2) * options.width / 2.F;
             const V2F v2CCW = perpCCW(v2) * options.width / 2.F;
-            TriMesh2F mesh;
-            mesh.v.push_back(v0 + v2CCW);
-            mesh.v.push_back(v0 + v2CW);
-            mesh.v.push_back(v1 + v2CW);
-            mesh.v.push_back(v1 + v2CCW);
-            mesh.triangles.push_back({ 1, 2, 3 });
-            mesh.triangles.push_back({ 3, 4, 1 });
-
-            if (p.vbos["line"])
-            {
-                p.vbos["line"]->copy(convert(mesh, p.vbos["line"]->getType()));
-                p.stats.triCount += mesh.triangles.size();
-            }
-            if (p.vaos["line"])
-            {
-                p.vaos["line"]->bind();
-                p.vaos["line"]->draw(GL_TRIANGLES, 0, p.vbos["line"]->getSize());
-            }
+            const BatchData batch = _batch(BatchType::Mesh, 4, 6);
+            uint8_t* data = batch.vertices;
+            data = batchVertex(data, v0 + v2CCW, color);
+            data = batchVertex(data, v0 + v2CW, color);
+            data = batchVertex(data, v1 + v2CW, color);
+            data = batchVertex(data, v1 + v2CCW, color);
+            batchQuad(batch.indices, batch.base);
+            p.stats.triCount += 2;
         }
 
         void Render::drawLines(
@@ -100,25 +127,20 @@ namespace feather_tk
             const Color4F& color,
             const LineOptions& options)
         {
-            FEATHER_TK_P();
-            TriMesh2F mesh;
-            mesh.v.resize(lines.size() * 4);
-            mesh.triangles.resize(lines.size() * 2);
-            size_t v = 0;
-            size_t t = 0;
+            CompactMesh2F mesh;
+            mesh.v.reserve(lines.size() * 4);
             for (const auto& i : lines)
             {
                 const V2F v2 = normalize(i.second - i.first);
                 const V2F v2CW = perpCW(v2) * options.width / 2.F;
                 const V2F v2CCW = perpCCW(v2) * options.width / 2.F;
-                mesh.v[v + 0] = i.first + v2CCW;
-                mesh.v[v + 1] = i.first + v2CW;
-                mesh.v[v + 2] = i.second + v2CW;
-                mesh.v[v + 3] = i.second + v2CCW;
-                mesh.triangles[t + 0] = { v + 1, v + 2, v + 3 };
-                mesh.triangles[t + 1] = { v + 3, v + 4, v + 1 };
-                v += 4;
-                t += 2;
+                const uint32_t v = static_cast<uint32_t>(mesh.v.size());
+                mesh.v.push_back(i.first + v2CCW);
+                mesh.v.push_back(i.first + v2CW);
+                mesh.v.push_back(i.second + v2CW);
+                mesh.v.push_back(i.second + v2CCW);
+                mesh.addTriangle(v + 0, v + 1, v + 2);
+                mesh.addTriangle(v + 2, v + 3, v + 0);
             }
             drawMesh(mesh, color);
         }
@@ -129,41 +151,146 @@ namespace feather_tk
             const V2F& pos)
         {
             FEATHER_TK_P();
+
+            // The triangle mesh is not shared by vertex, so each corner is
+            // added as a separate vertex.
             const size_t size = mesh.triangles.size();
-            if (size > 0)
+            for (size_t i = 0; i < size; i += batchTriangleMax)
             {
-                p.shaders["mesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    translate(V3F(pos.x, pos.y, 0.F));
-                p.shaders["mesh"]->setUniform("transform.mvp", transform);
-                p.shaders["mesh"]->setUniform("color", color);
-
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-                if (!p.vbos["mesh"] || (p.vbos["mesh"] && p.vbos["mesh"]->getSize() < size * 3))
-                {
-                    p.vbos["mesh"] = VBO::create(size * 3, VBOType::Pos2_F32);
-                    p.vaos["mesh"].reset();
-                }
-                if (p.vbos["mesh"])
+                const size_t count = std::min(size - i, batchTriangleMax);
+                const BatchData batch = _batch(BatchType::Mesh, count * 3, count * 3);
+                uint8_t* data = batch.vertices;
+                for (size_t j = 0; j < count; ++j)
                 {
-                    p.vbos["mesh"]->copy(convert(mesh, VBOType::Pos2_F32));
-                    p.stats.triCount += mesh.triangles.size();
+                    const Triangle2& triangle = mesh.triangles[i + j];
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const size_t v = triangle.v[k].v;
+                        data = batchVertex(
+                            data,
+                            v ? (mesh.v[v - 1] + pos) : pos,
+                            color);
+                    }
                 }
+                batchSequence(batch.indices, batch.base, count * 3);
+            }
+            p.stats.triCount += size;
+        }
 
-                if (!p.vaos["mesh"] && p.vbos["mesh"])
+        void Render::drawMesh(
+            const CompactMesh2F& mesh,
+            const Color4F& color,
+            const V2F& pos)
+        {
+            _batchCompactMesh(mesh, color, pos, false);
+        }
+
+        std::shared_ptr<RenderMesh> Render::createMesh(const TriMesh2F& mesh)
+        {
+            return createMesh(compactMesh(mesh));
+        }
+
+        std::shared_ptr<RenderMesh> Render::createMesh(const CompactMesh2F& mesh)
+        {
+            FEATHER_TK_P();
+            auto out = std::shared_ptr<RetainedMesh>(new RetainedMesh(
+                shared_from_this(),
+                mesh,
+                p.meshArena));
+            const size_t indexCount = mesh.getIndexCount();
+            if (indexCount > 0)
+            {
+                // Meshes that are too large to be addressed with 16-bit
+                // indices are de-indexed.
+                const bool indexed = mesh.v.size() <= batchVertexMax;
+                out->range = indexed ?
+                    p.meshArena->allocate(mesh.v.size(), indexCount) :
+                    p.meshArena->allocate(indexCount, 0);
+                const MeshArena::Page& page = p.meshArena->pages[out->range.page];
+                const size_t byteCount = getByteCount(VBOType::Pos2_F32);
+
+                // Adding a page creates a new VAO.
+                p.resetVAO();
+                if (indexed)
                 {
-                    p.vaos["mesh"] = VAO::create(p.vbos["mesh"]->getType(), p.vbos["mesh"]->getID());
+                    const auto data = convert(mesh, VBOType::Pos2_F32);
+                    page.vbo->copy(data, out->range.vertexOffset * byteCount, data.size());
+                    std::vector<uint16_t> indices(indexCount);
+                    for (size_t i = 0; i < indexCount; ++i)
+                    {
+                        indices[i] = static_cast<uint16_t>(
+                            out->range.vertexOffset + mesh.getIndex(i));
+                    }
+                    page.ebo->copy(indices.data(), out->range.indexOffset, indexCount);
+                    p.stats.byteCount += data.size() + indexCount * sizeof(uint16_t);
                 }
-                if (p.vaos["mesh"] && p.vbos["mesh"])
+                else
                 {
-                    p.vaos["mesh"]->bind();
-                    p.vaos["mesh"]->draw(GL_TRIANGLES, 0, size * 3);
+                    std::vector<uint8_t> data(indexCount * byteCount);
+                    float* pf = reinterpret_cast<float*>(data.data());
+                    for (size_t i = 0; i < indexCount; ++i, pf += 2)
+                    {
+                        const V2F& v = mesh.v[mesh.getIndex(i)];
+                        pf[0] = v.x;
+                        pf[1] = v.y;
+                    }
+                    page.vbo->copy(data, out->range.vertexOffset * byteCount, data.size());
+                    p.stats.byteCount += data.size();
                 }
             }
+            return out;
         }
-        
+
+        void Render::drawMesh(
+            const std::shared_ptr<RenderMesh>& mesh,
+            const Color4F& color,
+            const V2F& pos)
+        {
+            FEATHER_TK_P();
+            if (!mesh)
+                return;
+            if (mesh->getRender().get() != this)
+            {
+                IRender::drawMesh(mesh, color, pos);
+                return;
+            }
+            const MeshArena::Range& range = static_cast<const RetainedMesh*>(mesh.get())->range;
+            if (0 == range.vertexCount)
+                return;
+
+            flush();
+
+            p.bindShader(ShaderSlot::Mesh);
+            p.setUniform(UniformSlot::Color, color);
+            const bool offset = pos.x != 0.F || pos.y != 0.F;
+            if (offset)
+            {
+                // The transform is restored the next time the shader is
+                // bound.
+                p.setUniform(
+                    UniformSlot::Transform,
+                    p.transform * translate(V3F(pos.x, pos.y, 0.F)));
+                p.pipeline.shaders[static_cast<size_t>(ShaderSlot::Mesh)].transformId = 0;
+            }
+            p.setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            MeshArena::Page& page = p.meshArena->pages[range.page];
+            p.bindVAO(page.vao);
+            if (range.indexCount > 0)
+            {
+                page.ebo->bind();
+                page.vao->drawElements(GL_TRIANGLES, range.indexOffset, range.indexCount);
+                p.stats.triCount += range.indexCount / 3;
+            }
+            else
+            {
+                page.vao->draw(GL_TRIANGLES, range.vertexOffset, range.vertexCount);
+                p.stats.triCount += range.vertexCount / 3;
+            }
+            p.stats.drawCount += 1;
+            p.stats.retainedDrawCount += 1;
+        }
+
         void Render::drawColorMesh(
             const TriMesh2F& mesh,
             const Color4F& color,
@@ -171,38 +298,94 @@ namespace feather_tk
         {
             FEATHER_TK_P();
             const size_t size = mesh.triangles.size();
-            if (size > 0)
+            for (size_t i = 0; i < size; i += batchTriangleMax)
             {
-                p.shaders["colorMesh"]->bind();
-                const auto transform =
-                    p.transform *
-                    translate(V3F(pos.x, pos.y, 0.F));
-                p.shaders["colorMesh"]->setUniform("transform.mvp", transform);
-                p.shaders["colorMesh"]->setUniform("color", color);
+                const size_t count = std::min(size - i, batchTriangleMax);
+                const BatchData batch = _batch(BatchType::Mesh, count * 3, count * 3);
+                uint8_t* data = batch.vertices;
+                for (size_t j = 0; j < count; ++j)
+                {
+                    const Triangle2& triangle = mesh.triangles[i + j];
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const size_t v = triangle.v[k].v;
+                        const size_t c = triangle.v[k].c;
+                        data = batchVertex(
+                            data,
+                            v ? (mesh.v[v - 1] + pos) : pos,
+                            c ?
+                            Color4F(
+                                mesh.c[c - 1].x * color.r,
+                                mesh.c[c - 1].y * color.g,
+                                mesh.c[c - 1].z * color.b,
+                                mesh.c[c - 1].w * color.a) :
+                            color);
+                    }
+                }
+                batchSequence(batch.indices, batch.base, count * 3);
+            }
+            p.stats.triCount += size;
+        }
 
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        void Render::drawColorMesh(
+            const CompactMesh2F& mesh,
+            const Color4F& color,
+            const V2F& pos)
+        {
+            _batchCompactMesh(mesh, color, pos, true);
+        }
 
-                if (!p.vbos["colorMesh"] || (p.vbos["colorMesh"] && p.vbos["colorMesh"]->getSize() < size * 3))
+        void Render::_batchCompactMesh(
+            const CompactMesh2F& mesh,
+            const Color4F& color,
+            const V2F& pos,
+            bool vertexColors)
+        {
+            FEATHER_TK_P();
+            const size_t indexCount = mesh.getIndexCount();
+            if (0 == indexCount)
+                return;
+            auto getColor = [&mesh, &color, vertexColors](size_t i)
                 {
-                    p.vbos["colorMesh"] = VBO::create(size * 3, VBOType::Pos2_F32_Color_F32);
-                    p.vaos["colorMesh"].reset();
-                }
-                if (p.vbos["colorMesh"])
+                    return vertexColors && i < mesh.c.size() ?
+                        Color4F(
+                            mesh.c[i].x * color.r,
+                            mesh.c[i].y * color.g,
+                            mesh.c[i].z * color.b,
+                            mesh.c[i].w * color.a) :
+                        color;
+                };
+            if (mesh.v.size() <= batchVertexMax)
+            {
+                const BatchData batch = _batch(BatchType::Mesh, mesh.v.size(), indexCount);
+                uint8_t* data = batch.vertices;
+                for (size_t i = 0; i < mesh.v.size(); ++i)
                 {
-                    p.vbos["colorMesh"]->copy(convert(mesh, VBOType::Pos2_F32_Color_F32));
-                    p.stats.triCount += mesh.triangles.size();
+                    data = batchVertex(data, mesh.v[i] + pos, getColor(i));
                 }
-
-                if (!p.vaos["colorMesh"] && p.vbos["colorMesh"])
+                for (size_t i = 0; i < indexCount; ++i)
                 {
-                    p.vaos["colorMesh"] = VAO::create(p.vbos["colorMesh"]->getType(), p.vbos["colorMesh"]->getID());
+                    batch.indices[i] = batch.base + mesh.getIndex(i);
                 }
-                if (p.vaos["colorMesh"] && p.vbos["colorMesh"])
+            }
+            else
+            {
+                // The mesh is too large to be addressed with 16-bit
+                // indices, so it is de-indexed.
+                for (size_t i = 0; i < indexCount; i += batchTriangleMax * 3)
                 {
-                    p.vaos["colorMesh"]->bind();
-                    p.vaos["colorMesh"]->draw(GL_TRIANGLES, 0, size * 3);
+                    const size_t count = std::min(indexCount - i, batchTriangleMax * 3);
+                    const BatchData batch = _batch(BatchType::Mesh, count, count);
+                    uint8_t* data = batch.vertices;
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        const uint32_t index = mesh.getIndex(i + j);
+                        data = batchVertex(data, mesh.v[index] + pos, getColor(index));
+                    }
+                    batchSequence(batch.indices, batch.base, count);
                 }
             }
+            p.stats.triCount += indexCount / 3;
         }
 
         void Render::drawTexture(
@@ -212,23 +395,27 @@ namespace feather_tk
             AlphaBlend alphaBlend)
         {
             FEATHER_TK_P();
-            p.shaders["texture"]->bind();
-            p.shaders["texture"]->setUniform("color", color);
-            p.shaders["texture"]->setUniform("textureSampler", 0);
+            flush();
+
+            p.bindShader(ShaderSlot::Texture);
+            p.setUniform(UniformSlot::Color, color);
+            p.setUniform(UniformSlot::TextureSampler, 0);
 
-            setAlphaBlend(alphaBlend);
+            p.setAlphaBlend(alphaBlend);
 
-            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
-            glBindTexture(GL_TEXTURE_2D, id);
+            p.bindTexture(0, id);
 
-            if (p.vbos["texture"])
+            if (p.textureVBO)
             {
-                p.vbos["texture"]->copy(convert(mesh(rect), p.vbos["texture"]->getType()));
+                const auto data = convert(mesh(rect), p.textureVBO->getType());
+                p.textureVBO->copy(data);
+                p.stats.byteCount += data.size();
             }
-            if (p.vaos["texture"])
+            if (p.textureVAO)
             {
-                p.vaos["texture"]->bind();
-                p.vaos["texture"]->draw(GL_TRIANGLES, 0, p.vbos["texture"]->getSize());
+                p.bindVAO(p.textureVAO);
+                p.textureVAO->draw(GL_TRIANGLES, 0, p.textureVBO->getSize());
+                p.stats.drawCount += 1;
             }
         }
 
@@ -239,34 +426,9 @@ namespace feather_tk
             const Color4F& color)
         {
             FEATHER_TK_P();
-
-            p.shaders["text"]->bind();
-            p.shaders["text"]->setUniform("color", color);
-            p.shaders["text"]->setUniform("textureSampler", 0);
-
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0));
-            glBindTexture(GL_TEXTURE_2D, p.glyphAtlas->getTexture());
-
-            size_t glyphCount = 0;
-            for (const auto& glyph : glyphs)
-            {
-                if (glyph && glyph->image && glyph->image->isValid())
-                {
-                    ++glyphCount;
-                }
-            }
-            p.stats.glyphCount += glyphCount;
-
             int x = 0;
             int y = 0;
             int32_t rsbDeltaPrev = 0;
-            p.textMesh.v.resize(glyphCount * 4);
-            p.textMesh.t.resize(glyphCount * 4);
-            p.textMesh.triangles.resize(glyphCount * 2);
-            size_t v = 0;
-            size_t t = 0;
             Box2I lineRect(p.clipRect.min.x, pos.y, p.clipRect.w(), fontMetrics.lineHeight);
             for (auto glyphIt = glyphs.begin(); glyphIt != glyphs.end(); ++glyphIt)
             {
@@ -285,7 +447,7 @@ namespace feather_tk
                         lineRect = Box2I(p.clipRect.min.x, pos.y + y, p.clipRect.w(), fontMetrics.lineHeight);
                     }
                     else if (!p.clipRectEnabled ||
-                        p.clipRectEnabled && intersects(p.clipRect, lineRect))
+                        (p.clipRectEnabled && intersects(p.clipRect, lineRect)))
                     {
                         if (rsbDeltaPrev - (*glyphIt)->lsbDelta > 32)
                         {
@@ -309,8 +471,19 @@ namespace feather_tk
                             if (boxPackInvalidID == id ||
                                 !p.glyphAtlas->getItem(id, item))
                             {
-                                p.glyphAtlas->addItem((*glyphIt)->image, item);
+                                // The atlas eviction callback draws the
+                                // batch if a page needs to be re-used.
+                                const size_t evictionCount = p.glyphAtlas->getEvictionCount();
+                                if (!p.glyphAtlas->addItem((*glyphIt)->image, item))
+                                {
+                                    x += (*glyphIt)->advance;
+                                    continue;
+                                }
                                 p.glyphIDs[(*glyphIt)->info] = item.id;
+                                p.resetTextures();
+                                p.stats.glyphAddCount += 1;
+                                p.stats.glyphEvictionCount +=
+                                    p.glyphAtlas->getEvictionCount() - evictionCount;
                             }
 
                             const V2I& offset = (*glyphIt)->offset;
@@ -321,42 +494,29 @@ namespace feather_tk
                                 pos.y + y + fontMetrics.ascender - offset.y - extraOffset,
                                 (*glyphIt)->image->getWidth(),
                                 (*glyphIt)->image->getHeight());
-                            const V2I& min = box.min;
-                            const V2I& max = box.max;
-
-                            p.textMesh.v[v + 0].x = min.x;
-                            p.textMesh.v[v + 0].y = min.y;
-                            p.textMesh.v[v + 1].x = max.x + 1;
-                            p.textMesh.v[v + 1].y = min.y;
-                            p.textMesh.v[v + 2].x = max.x + 1;
-                            p.textMesh.v[v + 2].y = max.y + 1;
-                            p.textMesh.v[v + 3].x = min.x;
-                            p.textMesh.v[v + 3].y = max.y + 1;
-                            p.textMesh.t[v + 0].x = item.u.min();
-                            p.textMesh.t[v + 0].y = item.v.min();
-                            p.textMesh.t[v + 1].x = item.u.max();
-                            p.textMesh.t[v + 1].y = item.v.min();
-                            p.textMesh.t[v + 2].x = item.u.max();
-                            p.textMesh.t[v + 2].y = item.v.max();
-                            p.textMesh.t[v + 3].x = item.u.min();
-                            p.textMesh.t[v + 3].y = item.v.max();
-
-                            p.textMesh.triangles[t + 0].v[0] = { v + 1, v + 1 };
-                            p.textMesh.triangles[t + 0].v[1] = { v + 2, v + 2 };
-                            p.textMesh.triangles[t + 0].v[2] = { v + 3, v + 3 };
-                            p.textMesh.triangles[t + 1].v[0] = { v + 3, v + 3 };
-                            p.textMesh.triangles[t + 1].v[1] = { v + 4, v + 4 };
-                            p.textMesh.triangles[t + 1].v[2] = { v + 1, v + 1 };
-
-                            v += 4;
-                            t += 2;
+                            const float x0 = box.min.x;
+                            const float y0 = box.min.y;
+                            const float x1 = box.max.x + 1;
+                            const float y1 = box.max.y + 1;
+                            const float u0 = item.u.min();
+                            const float v0 = item.v.min();
+                            const float u1 = item.u.max();
+                            const float v1 = item.v.max();
+                            const BatchData batch = _batch(BatchType::Text, 4, 6, color, item.page);
+                            uint8_t* data = batch.vertices;
+                            data = batchVertex(data, x0, y0, u0, v0);
+                            data = batchVertex(data, x1, y0, u1, v0);
+                            data = batchVertex(data, x1, y1, u1, v1);
+                            data = batchVertex(data, x0, y1, u0, v1);
+                            batchQuad(batch.indices, batch.base);
+                            p.stats.triCount += 2;
+                            p.stats.glyphCount += 1;
                         }
 
                         x += (*glyphIt)->advance;
                     }
                 }
             }
-            _drawTextMesh(p.textMesh);
         }
 
         void Render::drawImage(
@@ -371,8 +531,20 @@ namespace feather_tk
             if (!info.isValid())
                 return;
 
+            flush();
+
             std::vector<std::shared_ptr<Texture> > textures;
-            if (!imageOptions.cache)
+            if (imageOptions.stream)
+            {
+                auto stream = _getTextureStream(info, imageOptions.imageFilters);
+                if (stream->copy(image))
+                {
+                    p.stats.textureStreamUploadCount += 1;
+                    p.stats.byteCount += image->getByteCount();
+                }
+                textures = stream->getTextures();
+            }
+            else if (!imageOptions.cache)
             {
                 textures = _getTextures(info, imageOptions.imageFilters);
                 _copyTextures(image, textures);
@@ -383,14 +555,56 @@ namespace feather_tk
                 _copyTextures(image, textures);
                 p.textureCache->add(image, textures, image->getByteCount());
             }
+            _drawImage(info, textures, mesh, color, imageOptions);
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<Image>& image,
+            const Box2F& box,
+            const Color4F& color,
+            const ImageOptions& imageOptions)
+        {
+            drawImage(image, mesh(box), color, imageOptions);
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<TextureStream>& stream,
+            const TriMesh2F& mesh,
+            const Color4F& color,
+            const ImageOptions& imageOptions)
+        {
+            flush();
+            _drawImage(stream->getInfo(), stream->getTextures(), mesh, color, imageOptions);
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<TextureStream>& stream,
+            const Box2F& box,
+            const Color4F& color,
+            const ImageOptions& imageOptions)
+        {
+            drawImage(stream, mesh(box), color, imageOptions);
+        }
+
+        void Render::_drawImage(
+            const ImageInfo& info,
+            const std::vector<std::shared_ptr<Texture> >& textures,
+            const TriMesh2F& mesh,
+            const Color4F& color,
+            const ImageOptions& imageOptions)
+        {
+            FEATHER_TK_P();
+
+            // Textures are bound when they are created or copied.
+            p.resetTextures();
             _setActiveTextures(info, textures);
             p.stats.textureCount += textures.size();
 
-            p.shaders["image"]->bind();
-            p.shaders["image"]->setUniform("color", color);
-            p.shaders["image"]->setUniform("imageType", static_cast<int>(info.type));
-            p.shaders["image"]->setUniform("channelCount", getChannelCount(info.type));
-            p.shaders["image"]->setUniform("channelDisplay", static_cast<int>(imageOptions.channelDisplay));
+            p.bindShader(ShaderSlot::Image);
+            p.setUniform(UniformSlot::Color, color);
+            p.setUniform(UniformSlot::ImageType, static_cast<int>(info.type));
+            p.setUniform(UniformSlot::ChannelCount, getChannelCount(info.type));
+            p.setUniform(UniformSlot::ChannelDisplay, static_cast<int>(imageOptions.channelDisplay));
             VideoLevels videoLevels = info.videoLevels;
             switch (imageOptions.videoLevels)
             {
@@ -402,10 +616,10 @@ namespace feather_tk
                 break;
             default: break;
             }
-            p.shaders["image"]->setUniform("videoLevels", static_cast<int>(videoLevels));
-            p.shaders["image"]->setUniform("yuvCoefficients", getYUVCoefficients(info.yuvCoefficients));
-            p.shaders["image"]->setUniform("mirrorX", info.layout.mirror.x);
-            p.shaders["image"]->setUniform("mirrorY", info.layout.mirror.y);
+            p.setUniform(UniformSlot::VideoLevels, static_cast<int>(videoLevels));
+            p.setUniform(UniformSlot::YUVCoefficients, getYUVCoefficients(info.yuvCoefficients));
+            p.setUniform(UniformSlot::MirrorX, info.layout.mirror.x);
+            p.setUniform(UniformSlot::MirrorY, info.layout.mirror.y);
             switch (info.type)
             {
             case ImageType::YUV_420P_U8:
@@ -414,72 +628,39 @@ namespace feather_tk
             case ImageType::YUV_420P_U16:
             case ImageType::YUV_422P_U16:
             case ImageType::YUV_444P_U16:
-                p.shaders["image"]->setUniform("textureSampler1", 1);
-                p.shaders["image"]->setUniform("textureSampler2", 2);
+                p.setUniform(UniformSlot::TextureSampler1, 1);
+                p.setUniform(UniformSlot::TextureSampler2, 2);
             default:
-                p.shaders["image"]->setUniform("textureSampler0", 0);
+                p.setUniform(UniformSlot::TextureSampler0, 0);
                 break;
             }
 
-            setAlphaBlend(imageOptions.alphaBlend);
+            p.setAlphaBlend(imageOptions.alphaBlend);
 
             const size_t size = mesh.triangles.size();
-            if (!p.vbos["image"] || (p.vbos["image"] && p.vbos["image"]->getSize() < size * 3))
+            if (!p.imageVBO || (p.imageVBO && p.imageVBO->getSize() < size * 3))
             {
-                p.vbos["image"] = VBO::create(size * 3, VBOType::Pos2_F32_UV_U16);
-                p.vaos["image"].reset();
+                p.imageVBO = VBO::create(size * 3, VBOType::Pos2_F32_UV_U16);
+                p.imageVAO.reset();
             }
-            if (p.vbos["image"])
+            if (p.imageVBO)
             {
-                p.vbos["image"]->copy(convert(mesh, VBOType::Pos2_F32_UV_U16));
+                const auto data = convert(mesh, VBOType::Pos2_F32_UV_U16);
+                p.imageVBO->copy(data);
                 p.stats.triCount += mesh.triangles.size();
+                p.stats.byteCount += data.size();
             }
 
-            if (!p.vaos["image"] && p.vbos["image"])
+            if (!p.imageVAO && p.imageVBO)
             {
-                p.vaos["image"] = VAO::create(p.vbos["image"]->getType(), p.vbos["image"]->getID());
+                p.imageVAO = VAO::create(p.imageVBO->getType(), p.imageVBO->getID());
+                p.resetVAO();
             }
-            if (p.vaos["image"] && p.vbos["image"])
+            if (p.imageVAO && p.imageVBO)
             {
-                p.vaos["image"]->bind();
-                p.vaos["image"]->draw(GL_TRIANGLES, 0, size * 3);
-            }
-        }
-
-        void Render::drawImage(
-            const std::shared_ptr<Image>& image,
-            const Box2F& box,
-            const Color4F& color,
-            const ImageOptions& imageOptions)
-        {
-            drawImage(image, mesh(box), color, imageOptions);
-        }
-
-        void Render::_drawTextMesh(const TriMesh2F& mesh)
-        {
-            FEATHER_TK_P();
-            const size_t size = mesh.triangles.size();
-            if (size > 0)
-            {
-                if (!p.vbos["text"] || (p.vbos["text"] && p.vbos["text"]->getSize() < size * 3))
-                {
-                    p.vbos["text"] = VBO::create(size * 3, VBOType::Pos2_F32_UV_U16);
-                    p.vaos["text"].reset();
-                }
-                if (p.vbos["text"])
-                {
-                    p.vbos["text"]->copy(convert(mesh, p.vbos["text"]->getType()));
-                    p.stats.triCount += mesh.triangles.size();
-                }
-                if (!p.vaos["text"] && p.vbos["text"])
-                {
-                    p.vaos["text"] = VAO::create(p.vbos["text"]->getType(), p.vbos["text"]->getID());
-                }
-                if (p.vaos["text"] && p.vbos["text"])
-                {
-                    p.vaos["text"]->bind();
-                    p.vaos["text"]->draw(GL_TRIANGLES, 0, size * 3);
-                }
+                p.bindVAO(p.imageVAO);
+                p.imageVAO->draw(GL_TRIANGLES, 0, size * 3);
+                p.stats.drawCount += 1;
             }
         }
     }
@@ -8,12 +8,16 @@
 #include <feather-tk/gl/Mesh.h>
 #include <feather-tk/gl/Shader.h>
 #include <feather-tk/gl/TextureAtlas.h>
+#include <feather-tk/gl/TextureStream.h>
 
 #include <feather-tk/core/Timer.h>
 
+#include <array>
 #include <chrono>
 #include <list>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace feather_tk
 {
@@ -27,6 +31,136 @@ namespace feather_tk
         std::string textFragmentSource();
         std::string imageFragmentSource();
 
+        //! The maximum number of vertices in a batch, so they can be
+        //! addressed with 16-bit indices.
+        const size_t batchVertexMax = 65536;
+
+        //! Retained mesh arena. Meshes are sub-allocated from shared
+        //! vertex and element buffer pages so they can be uploaded once
+        //! and drawn by offset.
+        //!
+        //! The pages hold up to 65536 vertices so they can be addressed
+        //! with 16-bit indices. Meshes with more vertices are de-indexed
+        //! into a page of their own, and meshes with more indices than a
+        //! page holds get a page with a larger element buffer.
+        class MeshArena
+        {
+        public:
+            struct Page
+            {
+                size_t vertexSize = 0;
+                size_t indexSize = 0;
+                std::shared_ptr<VBO> vbo;
+                std::shared_ptr<EBO> ebo;
+                std::shared_ptr<VAO> vao;
+
+                //! Free ranges, offset to size.
+                std::map<size_t, size_t> freeVertices;
+                std::map<size_t, size_t> freeIndices;
+            };
+
+            //! Range of vertices and indices.
+            struct Range
+            {
+                size_t page = 0;
+                size_t vertexOffset = 0;
+                size_t vertexCount = 0;
+                size_t indexOffset = 0;
+                size_t indexCount = 0;
+            };
+
+            //! Allocate a range. If the index count is zero the vertices
+            //! are drawn without indices.
+            Range allocate(size_t vertexCount, size_t indexCount);
+
+            //! Queue a range to be released. This can be called when the
+            //! OpenGL context is not current, the range is freed by the
+            //! next call to collect().
+            void release(const Range&);
+
+            //! Free the released ranges and delete the empty pages. This
+            //! must be called with the OpenGL context current.
+            void collect();
+
+            std::vector<Page> pages;
+            std::mutex releasedMutex;
+            std::vector<Range> released;
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+        };
+
+        //! Retained mesh.
+        class RetainedMesh : public RenderMesh
+        {
+        public:
+            RetainedMesh(
+                const std::shared_ptr<IRender>&,
+                const CompactMesh2F&,
+                const std::shared_ptr<MeshArena>&);
+
+            virtual ~RetainedMesh();
+
+            std::weak_ptr<MeshArena> arena;
+            MeshArena::Range range;
+        };
+
+        //! Shader slots.
+        enum class ShaderSlot
+        {
+            Rect,
+            Line,
+            Mesh,
+            ColorMesh,
+            Texture,
+            Text,
+            Image,
+
+            Count
+        };
+
+        //! Uniform slots.
+        enum class UniformSlot
+        {
+            Transform,
+            Color,
+            TextureSampler,
+            TextureSampler0,
+            TextureSampler1,
+            TextureSampler2,
+            ImageType,
+            ChannelCount,
+            ChannelDisplay,
+            VideoLevels,
+            YUVCoefficients,
+            MirrorX,
+            MirrorY,
+
+            Count
+        };
+
+        //! Pipeline state. The OpenGL state set by the renderer is tracked
+        //! so that redundant state changes can be skipped.
+        struct PipelineState
+        {
+            struct ShaderData
+            {
+                std::shared_ptr<gl::Shader> shader;
+                std::array<int, static_cast<size_t>(UniformSlot::Count)> uniforms;
+                size_t transformId = 0;
+            };
+            std::array<ShaderData, static_cast<size_t>(ShaderSlot::Count)> shaders;
+            ShaderSlot shader = ShaderSlot::Count;
+            size_t transformId = 1;
+
+            std::array<unsigned int, 4> blend;
+            bool blendValid = false;
+
+            static const unsigned int invalid = static_cast<unsigned int>(-1);
+            unsigned int activeTexture = invalid;
+            std::array<unsigned int, 3> textures;
+            unsigned int vao = invalid;
+        };
+
         struct Render::Private
         {
             Size2I size;
@@ -36,26 +170,83 @@ namespace feather_tk
             Box2I clipRect;
             M44F transform;
             
-            std::map<std::string, std::shared_ptr<gl::Shader> > shaders;
+            PipelineState pipeline;
             std::shared_ptr<TextureCache> textureCache;
             std::shared_ptr<gl::TextureAtlas> glyphAtlas;
-            std::map<GlyphInfo, BoxPackID> glyphIDs;
-            TriMesh2F textMesh;
-            std::map<std::string, std::shared_ptr<gl::VBO> > vbos;
-            std::map<std::string, std::shared_ptr<gl::VAO> > vaos;
+            std::unordered_map<GlyphInfo, BoxPackID> glyphIDs;
+            std::shared_ptr<gl::VBO> textureVBO;
+            std::shared_ptr<gl::VAO> textureVAO;
+            std::shared_ptr<gl::VBO> imageVBO;
+            std::shared_ptr<gl::VAO> imageVAO;
+            struct BatchBuffers
+            {
+                std::shared_ptr<gl::VBO> vbo;
+                std::shared_ptr<gl::EBO> ebo;
+                std::shared_ptr<gl::VAO> vao;
+            };
+            BatchBuffers meshBatch;
+            BatchBuffers textBatch;
+            std::shared_ptr<MeshArena> meshArena;
 
-            std::chrono::time_point<std::chrono::steady_clock> startTime;
-            struct Stats
+            struct TextureStreamData
             {
-                int renderTime = 0;
-                size_t triCount = 0;
-                size_t textureCount = 0;
-                size_t glyphCount = 0;
+                std::shared_ptr<TextureStream> stream;
+                ImageFilters filters;
+                size_t frame = 0;
             };
-            Stats stats;
-            std::list<Stats> statsList;
+            std::list<TextureStreamData> textureStreams;
+            size_t frame = 0;
+
+            struct Batch
+            {
+                BatchType type = BatchType::None;
+                Color4F color;
+                int page = 0;
+                std::vector<uint8_t> data;
+                size_t byteCount = 0;
+                size_t vertexCount = 0;
+                std::vector<uint16_t> indices;
+                size_t indexCount = 0;
+            };
+            Batch batch;
+
+            std::chrono::time_point<std::chrono::steady_clock> startTime;
+            RenderStats stats;
+            std::list<RenderStats> statsList;
             std::shared_ptr<Timer> logTimer;
+
+            //! Bind a shader and update the transform if it has changed.
+            gl::Shader& bindShader(ShaderSlot);
+
+            //! Set a uniform on the bound shader.
+            template<typename T>
+            void setUniform(UniformSlot, const T&);
+
+            void setBlend(
+                unsigned int srcRGB,
+                unsigned int dstRGB,
+                unsigned int srcAlpha,
+                unsigned int dstAlpha);
+            void setAlphaBlend(AlphaBlend);
+            void bindTexture(unsigned int unit, unsigned int id);
+            void bindVAO(const std::shared_ptr<VAO>&);
+
+            //! Reset the tracked state. This is called when the state may
+            //! have been changed outside of the pipeline, for example
+            //! textures are bound when they are copied.
+            void resetState();
+            void resetTextures();
+            void resetVAO();
+
+            size_t getSkippedUniformCount() const;
         };
+
+        template<typename T>
+        inline void Render::Private::setUniform(UniformSlot uniform, const T& value)
+        {
+            auto& data = pipeline.shaders[static_cast<size_t>(pipeline.shader)];
+            data.shader->setUniform(data.uniforms[static_cast<size_t>(uniform)], value);
+        }
     }
 }
 
@@ -10,7 +10,11 @@
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/String.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <iostream>
+#include <unordered_map>
 
 namespace feather_tk
 {
@@ -23,8 +27,50 @@ namespace feather_tk
             GLuint vertex = 0;
             GLuint fragment = 0;
             GLuint program = 0;
+
+            std::unordered_map<std::string, GLint> locations;
+            struct Value
+            {
+                std::array<uint8_t, sizeof(M44F)> data;
+                size_t size = 0;
+            };
+            std::vector<Value> values;
+            size_t skippedUniformCount = 0;
+
+            bool update(GLint location, const void* data, size_t size);
+            void invalidate(GLint location, size_t count);
         };
 
+        bool Shader::Private::update(GLint location, const void* data, size_t size)
+        {
+            bool out = true;
+            if (location >= 0 && location < static_cast<GLint>(values.size()))
+            {
+                Value& value = values[location];
+                if (size == value.size && 0 == memcmp(value.data.data(), data, size))
+                {
+                    ++skippedUniformCount;
+                    out = false;
+                }
+                else
+                {
+                    memcpy(value.data.data(), data, size);
+                    value.size = size;
+                }
+            }
+            return out;
+        }
+
+        void Shader::Private::invalidate(GLint location, size_t count)
+        {
+            for (GLint i = std::max(location, 0);
+                i < location + static_cast<GLint>(count) && i < static_cast<GLint>(values.size());
+                ++i)
+            {
+                values[i].size = 0;
+            }
+        }
+
         void Shader::_init()
         {
             FEATHER_TK_P();
@@ -93,6 +139,33 @@ namespace feather_tk
                 glGetProgramInfoLog(p.program, cStringSize, NULL, infoLog);
                 throw std::runtime_error(infoLog);
             }
+
+            // Query the uniform locations. Arrays are also added without
+            // the "[0]" suffix.
+            GLint count = 0;
+            glGetProgramiv(p.program, GL_ACTIVE_UNIFORMS, &count);
+            GLint locationMax = -1;
+            for (GLint i = 0; i < count; ++i)
+            {
+                char name[cStringSize];
+                GLsizei length = 0;
+                GLint size = 0;
+                GLenum type = 0;
+                glGetActiveUniform(p.program, i, cStringSize, &length, &size, &type, name);
+                const GLint location = glGetUniformLocation(p.program, name);
+                if (location >= 0)
+                {
+                    std::string s(name, length);
+                    p.locations[s] = location;
+                    const size_t arrayIndex = s.rfind("[0]");
+                    if (arrayIndex != std::string::npos && arrayIndex == s.size() - 3)
+                    {
+                        p.locations[s.substr(0, arrayIndex)] = location;
+                    }
+                    locationMax = std::max(locationMax, location + size - 1);
+                }
+            }
+            p.values.resize(locationMax + 1);
         }
 
         Shader::Shader() :
@@ -150,148 +223,191 @@ namespace feather_tk
             glUseProgram(_p->program);
         }
 
+        int Shader::getUniformLocation(const std::string& name) const
+        {
+            FEATHER_TK_P();
+            const auto i = p.locations.find(name);
+            return i != p.locations.end() ? i->second : -1;
+        }
+
+        size_t Shader::getSkippedUniformCount() const
+        {
+            return _p->skippedUniformCount;
+        }
+
         void Shader::setUniform(int location, int value)
         {
-            glUniform1i(location, value);
+            if (_p->update(location, &value, sizeof(value)))
+            {
+                glUniform1i(location, value);
+            }
         }
 
         void Shader::setUniform(int location, float value)
         {
-            glUniform1f(location, value);
+            if (_p->update(location, &value, sizeof(value)))
+            {
+                glUniform1f(location, value);
+            }
         }
 
         void Shader::setUniform(int location, const V2F& value)
         {
-            glUniform2fv(location, 1, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 2))
+            {
+                glUniform2fv(location, 1, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const V3F& value)
         {
-            glUniform3fv(location, 1, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 3))
+            {
+                glUniform3fv(location, 1, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const V4F& value)
         {
-            glUniform4fv(location, 1, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 4))
+            {
+                glUniform4fv(location, 1, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const M33F& value)
         {
-            // Transpose the matrix for OpenGL (column-major).
-            glUniformMatrix3fv(location, 1, GL_TRUE, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 9))
+            {
+                // Transpose the matrix for OpenGL (column-major).
+                glUniformMatrix3fv(location, 1, GL_TRUE, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const M44F& value)
         {
-            // Transpose the matrix for OpenGL (column-major).
-            glUniformMatrix4fv(location, 1, GL_TRUE, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 16))
+            {
+                // Transpose the matrix for OpenGL (column-major).
+                glUniformMatrix4fv(location, 1, GL_TRUE, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const Color4F& value)
         {
-            glUniform4fv(location, 1, value.data());
+            if (_p->update(location, value.data(), sizeof(float) * 4))
+            {
+                glUniform4fv(location, 1, value.data());
+            }
         }
 
         void Shader::setUniform(int location, const float value[4])
         {
-            glUniform4fv(location, 1, value);
+            if (_p->update(location, value, sizeof(float) * 4))
+            {
+                glUniform4fv(location, 1, value);
+            }
         }
 
         void Shader::setUniform(int location, const std::vector<int>& value)
         {
+            _p->invalidate(location, value.size());
             glUniform1iv(location, value.size(), &value[0]);
         }
 
         void Shader::setUniform(int location, const std::vector<float>& value)
         {
+            _p->invalidate(location, value.size());
             glUniform1fv(location, value.size(), &value[0]);
         }
 
         void Shader::setUniform(int location, const std::vector<V3F>& value)
         {
+            _p->invalidate(location, value.size());
             glUniform3fv(location, value.size(), value[0].data());
         }
 
         void Shader::setUniform(int location, const std::vector<V4F>& value)
         {
+            _p->invalidate(location, value.size());
             glUniform4fv(location, value.size(), value[0].data());
         }
 
         void Shader::setUniform(const std::string& name, int value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, float value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const V2F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const V3F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const V4F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const M33F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const M44F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
         
         void Shader::setUniform(const std::string& name, const Color4F& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const float value[4])
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const std::vector<int>& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const std::vector<float>& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const std::vector<V3F>& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
 
         void Shader::setUniform(const std::string& name, const std::vector<V4F>& value)
         {
-            const GLint location = glGetUniformLocation(_p->program, name.c_str());
+            const GLint location = getUniformLocation(name);
             setUniform(location, value);
         }
     }
@@ -50,8 +50,18 @@ namespace feather_tk
             //! Bind the shader.
             void bind();
 
+            //! Get a uniform location. The locations are queried when the
+            //! shader is linked. Returns -1 if the uniform does not exist.
+            int getUniformLocation(const std::string&) const;
+
+            //! Get the number of uniform updates that were skipped because
+            //! the value had not changed.
+            size_t getSkippedUniformCount() const;
+
             //! \name Uniforms
-            //! Set uniform values.
+            //! Set uniform values. The shader must be bound. The values are
+            //! cached, and setting a uniform to the value it already has
+            //! does nothing.
             ///@{
 
             void setUniform(int, int);
@@ -7,39 +7,71 @@
 #include <feather-tk/gl/Texture.h>
 
 #include <feather-tk/core/Assert.h>
-#include <feather-tk/core/BoxPack.h>
 
-#include <map>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 namespace feather_tk
 {
     namespace gl
     {
+        namespace
+        {
+            struct SkylineNode
+            {
+                int x = 0;
+                int y = 0;
+                int w = 0;
+            };
+        }
+
         struct TextureAtlas::Private
         {
             int size = 0;
             ImageType type = ImageType::None;
+            ImageFilter filter = ImageFilter::Linear;
             int border = 0;
-            std::shared_ptr<Texture> texture;
-            std::shared_ptr<BoxPack> boxPack;
+            int pageCountMax = 1;
+
+            struct Page
+            {
+                std::shared_ptr<Texture> texture;
+                std::vector<SkylineNode> skyline;
+                std::vector<BoxPackID> ids;
+                int64_t area = 0;
+                uint64_t used = 0;
+            };
+            std::vector<Page> pages;
+
+            struct Item
+            {
+                int page = 0;
+                Box2I box;
+            };
+            std::unordered_map<BoxPackID, Item> items;
+            BoxPackID id = 0;
+            uint64_t used = 0;
+
+            size_t addCount = 0;
+            size_t evictionCount = 0;
+
+            std::function<void(int)> evictCallback;
         };
 
         void TextureAtlas::_init(
             int size,
             ImageType type,
             ImageFilter filter,
-            int border)
+            int border,
+            int pageCountMax)
         {
             FEATHER_TK_P();
-
             p.size = size;
             p.type = type;
+            p.filter = filter;
             p.border = border;
-            TextureOptions textureOptions;
-            textureOptions.filters.minify = filter;
-            textureOptions.filters.magnify = filter;
-            p.texture = Texture::create(ImageInfo(size, size, type), textureOptions);
-            p.boxPack = BoxPack::create(Size2I(size, size), border);
+            p.pageCountMax = std::max(1, pageCountMax);
         }
 
         TextureAtlas::TextureAtlas() :
@@ -53,10 +85,11 @@ namespace feather_tk
             int textureSize,
             ImageType textureType,
             ImageFilter filter,
-            int border)
+            int border,
+            int pageCountMax)
         {
             auto out = std::shared_ptr<TextureAtlas>(new TextureAtlas);
-            out->_init(textureSize, textureType, filter, border);
+            out->_init(textureSize, textureType, filter, border, pageCountMax);
             return out;
         }
 
@@ -70,18 +103,33 @@ namespace feather_tk
             return _p->type;
         }
 
-        unsigned int TextureAtlas::getTexture() const
+        int TextureAtlas::getPageCount() const
         {
-            return _p->texture->getID();
+            return static_cast<int>(_p->pages.size());
+        }
+
+        int TextureAtlas::getPageCountMax() const
+        {
+            return _p->pageCountMax;
+        }
+
+        unsigned int TextureAtlas::getTexture(int page) const
+        {
+            FEATHER_TK_P();
+            return page >= 0 && page < static_cast<int>(p.pages.size()) ?
+                p.pages[page].texture->getID() :
+                0;
         }
 
         bool TextureAtlas::getItem(BoxPackID id, TextureAtlasItem& item)
         {
             FEATHER_TK_P();
             bool out = false;
-            if (auto node = p.boxPack->getNode(id))
+            const auto i = p.items.find(id);
+            if (i != p.items.end())
             {
-                _toItem(node, item);
+                p.pages[i->second.page].used = ++p.used;
+                _toItem(id, i->second.page, i->second.box, item);
                 out = true;
             }
             return out;
@@ -92,56 +140,233 @@ namespace feather_tk
             TextureAtlasItem& item)
         {
             FEATHER_TK_P();
-            bool out = false;
-            if (auto node = p.boxPack->insert(image->getSize() + p.border * 2))
+            const Size2I size = image->getSize() + p.border * 2;
+            if (size.w > p.size || size.h > p.size)
             {
-                out = true;
+                return false;
+            }
 
-                auto zero = Image::create(
-                    node->box.size(),
-                    p.type);
-                zero->zero();
-                p.texture->copy(
-                    zero,
-                    node->box.min.x,
-                    node->box.min.y);
-
-                p.texture->copy(
-                    image,
-                    node->box.min.x + p.border,
-                    node->box.min.y + p.border);
-
-                _toItem(node, item);
+            // Try the existing pages, most recently used first.
+            std::vector<int> pages;
+            for (int i = 0; i < static_cast<int>(p.pages.size()); ++i)
+            {
+                pages.push_back(i);
             }
-            return out;
+            std::sort(
+                pages.begin(),
+                pages.end(),
+                [&p](int a, int b)
+                {
+                    return p.pages[a].used > p.pages[b].used;
+                });
+            int page = -1;
+            Box2I box;
+            for (int i : pages)
+            {
+                if (_insert(i, size, box))
+                {
+                    page = i;
+                    break;
+                }
+            }
+
+            // Add a new page.
+            if (-1 == page && static_cast<int>(p.pages.size()) < p.pageCountMax)
+            {
+                Private::Page newPage;
+                TextureOptions textureOptions;
+                textureOptions.filters.minify = p.filter;
+                textureOptions.filters.magnify = p.filter;
+                newPage.texture = Texture::create(
+                    ImageInfo(p.size, p.size, p.type),
+                    textureOptions);
+                p.pages.push_back(newPage);
+                page = static_cast<int>(p.pages.size()) - 1;
+                _clear(page);
+                _insert(page, size, box);
+            }
+
+            // Evict the least recently used page.
+            if (-1 == page && !pages.empty())
+            {
+                page = pages.back();
+                if (p.evictCallback)
+                {
+                    p.evictCallback(page);
+                }
+                p.evictionCount += p.pages[page].ids.size();
+                _clear(page);
+                _insert(page, size, box);
+            }
+
+            const BoxPackID id = p.id++;
+            auto& pageRef = p.pages[page];
+            pageRef.ids.push_back(id);
+            pageRef.area += feather_tk::area(box.size());
+            pageRef.used = ++p.used;
+            p.items[id] = { page, box };
+            ++p.addCount;
+
+            auto zero = Image::create(box.size(), p.type);
+            zero->zero();
+            pageRef.texture->copy(zero, box.min.x, box.min.y);
+            pageRef.texture->copy(
+                image,
+                box.min.x + p.border,
+                box.min.y + p.border);
+
+            _toItem(id, page, box, item);
+            return true;
+        }
+
+        void TextureAtlas::setEvictCallback(const std::function<void(int)>& value)
+        {
+            _p->evictCallback = value;
         }
 
         float TextureAtlas::getPercentageUsed() const
         {
             FEATHER_TK_P();
-            float area = 0.F;
-            for (const auto node : p.boxPack->getNodes())
+            float out = 0.F;
+            if (!p.pages.empty())
             {
-                if (node->id != boxPackInvalidID)
+                int64_t area = 0;
+                for (const auto& page : p.pages)
                 {
-                    area += feather_tk::area(node->box.size());
+                    area += page.area;
                 }
+                out = area / (static_cast<float>(p.size) * p.size * p.pages.size());
+            }
+            return out;
+        }
+
+        size_t TextureAtlas::getItemCount() const
+        {
+            return _p->items.size();
+        }
+
+        size_t TextureAtlas::getAddCount() const
+        {
+            return _p->addCount;
+        }
+
+        size_t TextureAtlas::getEvictionCount() const
+        {
+            return _p->evictionCount;
+        }
+
+        bool TextureAtlas::_insert(int page, const Size2I& size, Box2I& box)
+        {
+            FEATHER_TK_P();
+            auto& skyline = p.pages[page].skyline;
+
+            // Find the position that leaves the lowest top edge, using the
+            // narrowest segment to break ties.
+            int bestIndex = -1;
+            int bestX = 0;
+            int bestY = std::numeric_limits<int>::max();
+            int bestW = std::numeric_limits<int>::max();
+            for (size_t i = 0; i < skyline.size(); ++i)
+            {
+                const int x = skyline[i].x;
+                if (x + size.w > p.size)
+                {
+                    break;
+                }
+                int y = 0;
+                int widthLeft = size.w;
+                size_t j = i;
+                while (widthLeft > 0 && j < skyline.size())
+                {
+                    y = std::max(y, skyline[j].y);
+                    widthLeft -= skyline[j].w;
+                    ++j;
+                }
+                if (y + size.h <= p.size &&
+                    (y + size.h < bestY || (y + size.h == bestY && skyline[i].w < bestW)))
+                {
+                    bestIndex = static_cast<int>(i);
+                    bestX = x;
+                    bestY = y + size.h;
+                    bestW = skyline[i].w;
+                }
+            }
+            if (-1 == bestIndex)
+            {
+                return false;
+            }
+
+            // Update the skyline.
+            SkylineNode node;
+            node.x = bestX;
+            node.y = bestY;
+            node.w = size.w;
+            skyline.insert(skyline.begin() + bestIndex, node);
+            for (size_t i = bestIndex + 1; i < skyline.size();)
+            {
+                const int right = skyline[i - 1].x + skyline[i - 1].w;
+                if (skyline[i].x < right)
+                {
+                    const int shrink = right - skyline[i].x;
+                    skyline[i].x += shrink;
+                    skyline[i].w -= shrink;
+                    if (skyline[i].w <= 0)
+                    {
+                        skyline.erase(skyline.begin() + i);
+                        continue;
+                    }
+                }
+                break;
+            }
+            for (size_t i = 0; i + 1 < skyline.size();)
+            {
+                if (skyline[i].y == skyline[i + 1].y)
+                {
+                    skyline[i].w += skyline[i + 1].w;
+                    skyline.erase(skyline.begin() + i + 1);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            box = Box2I(bestX, bestY - size.h, size.w, size.h);
+            return true;
+        }
+
+        void TextureAtlas::_clear(int page)
+        {
+            FEATHER_TK_P();
+            auto& pageRef = p.pages[page];
+            for (const auto id : pageRef.ids)
+            {
+                p.items.erase(id);
             }
-            return area / static_cast<float>(p.size * p.size);
+            pageRef.ids.clear();
+            pageRef.area = 0;
+            pageRef.skyline.clear();
+            SkylineNode node;
+            node.w = p.size;
+            pageRef.skyline.push_back(node);
         }
 
         void TextureAtlas::_toItem(
-            const std::shared_ptr<BoxPackNode>& node,
+            BoxPackID id,
+            int page,
+            const Box2I& box,
             TextureAtlasItem& out)
         {
             FEATHER_TK_P();
-            out.id = node->id;
+            out.id = id;
+            out.page = page;
+            out.size = Size2I(box.w() - p.border * 2, box.h() - p.border * 2);
             out.u = RangeF(
-                (node->box.min.x + p.border) / static_cast<float>(p.size),
-                (node->box.max.x - 1 - p.border) / static_cast<float>(p.size));
+                (box.min.x + p.border) / static_cast<float>(p.size),
+                (box.max.x - 1 - p.border) / static_cast<float>(p.size));
             out.v = RangeF(
-                (node->box.min.y + p.border) / static_cast<float>(p.size),
-                (node->box.max.y - 1 - p.border) / static_cast<float>(p.size));
+                (box.min.y + p.border) / static_cast<float>(p.size),
+                (box.max.y - 1 - p.border) / static_cast<float>(p.size));
         }
     }
-}
+}
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <feather-tk/core/Image.h>
 #include <feather-tk/core/Range.h>
 
+#include <functional>
+
 namespace feather_tk
 {
     namespace gl
@@ -21,12 +23,18 @@ namespace feather_tk
         struct TextureAtlasItem
         {
             BoxPackID id = boxPackInvalidID;
+            int page = 0;
             Size2I size;
             RangeF u;
             RangeF v;
         };
 
         //! Texture atlas.
+        //!
+        //! The atlas is made up of one or more texture pages, each packed with
+        //! a skyline packer. Pages are added on demand up to the maximum page
+        //! count. When all of the pages are full the least recently used page
+        //! is cleared and re-used, which invalidates all of its items.
         class TextureAtlas : public std::enable_shared_from_this<TextureAtlas>
         {
             FEATHER_TK_NON_COPYABLE(TextureAtlas);
@@ -36,7 +44,8 @@ namespace feather_tk
                 int size,
                 ImageType,
                 ImageFilter,
-                int border);
+                int border,
+                int pageCountMax);
 
             TextureAtlas();
 
@@ -48,28 +57,51 @@ namespace feather_tk
                 int size,
                 ImageType,
                 ImageFilter = ImageFilter::Linear,
-                int border = 1);
+                int border = 1,
+                int pageCountMax = 1);
 
-            //! Get the texture atlas size.
+            //! Get the texture atlas page size.
             int getSize() const;
 
             //! Get the texture atlas type.
             ImageType getType() const;
 
-            //! Get the texture atlas ID.
-            unsigned int getTexture() const;
+            //! Get the number of texture atlas pages.
+            int getPageCount() const;
+
+            //! Get the maximum number of texture atlas pages.
+            int getPageCountMax() const;
 
-            //! Get a texture atlas item.
+            //! Get a texture atlas page texture ID.
+            unsigned int getTexture(int page = 0) const;
+
+            //! Get a texture atlas item. This also marks the item's page as
+            //! recently used.
             bool getItem(BoxPackID, TextureAtlasItem&);
 
             //! Add a texture atlas item.
             bool addItem(const std::shared_ptr<Image>&, TextureAtlasItem&);
 
-            //! Get the percentage of the texture atlas that is in use.
+            //! Set a callback that is called with the page index before a
+            //! page is evicted.
+            void setEvictCallback(const std::function<void(int)>&);
+
+            //! Get the percentage of the texture atlas pages that is in use.
             float getPercentageUsed() const;
 
+            //! \name Statistics
+            ///@{
+
+            size_t getItemCount() const;
+            size_t getAddCount() const;
+            size_t getEvictionCount() const;
+
+            ///@}
+
         private:
-            void _toItem(const std::shared_ptr<BoxPackNode>&, TextureAtlasItem&);
+            bool _insert(int page, const Size2I&, Box2I&);
+            void _clear(int page);
+            void _toItem(BoxPackID, int page, const Box2I&, TextureAtlasItem&);
 
             FEATHER_TK_PRIVATE();
         };
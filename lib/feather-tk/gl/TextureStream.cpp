@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/gl/TextureStream.h>
+
+#include <feather-tk/gl/GL.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace feather_tk
+{
+    namespace gl
+    {
+        namespace
+        {
+            //! Fence timeout in nanoseconds.
+            const GLuint64 fenceTimeout = 1000000000;
+
+            //! Image plane.
+            struct Plane
+            {
+                ImageInfo info;
+                size_t offset = 0;
+            };
+
+            std::vector<Plane> getPlanes(const ImageInfo& info)
+            {
+                std::vector<Plane> out;
+                const size_t w = info.size.w;
+                const size_t h = info.size.h;
+                const size_t w2 = w / 2;
+                const size_t h2 = h / 2;
+                switch (info.type)
+                {
+                case ImageType::YUV_420P_U8:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U8), 0 });
+                    out.push_back({ ImageInfo(w2, h2, ImageType::L_U8), w * h });
+                    out.push_back({ ImageInfo(w2, h2, ImageType::L_U8), w * h + w2 * h2 });
+                    break;
+                case ImageType::YUV_422P_U8:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U8), 0 });
+                    out.push_back({ ImageInfo(w2, h, ImageType::L_U8), w * h });
+                    out.push_back({ ImageInfo(w2, h, ImageType::L_U8), w * h + w2 * h });
+                    break;
+                case ImageType::YUV_444P_U8:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U8), 0 });
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U8), w * h });
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U8), w * h * 2 });
+                    break;
+                case ImageType::YUV_420P_U16:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U16), 0 });
+                    out.push_back({ ImageInfo(w2, h2, ImageType::L_U16), (w * h) * 2 });
+                    out.push_back({ ImageInfo(w2, h2, ImageType::L_U16), (w * h) * 2 + (w2 * h2) * 2 });
+                    break;
+                case ImageType::YUV_422P_U16:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U16), 0 });
+                    out.push_back({ ImageInfo(w2, h, ImageType::L_U16), (w * h) * 2 });
+                    out.push_back({ ImageInfo(w2, h, ImageType::L_U16), (w * h) * 2 + (w2 * h) * 2 });
+                    break;
+                case ImageType::YUV_444P_U16:
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U16), 0 });
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U16), (w * h) * 2 });
+                    out.push_back({ ImageInfo(w, h, ImageType::L_U16), (w * h) * 4 });
+                    break;
+                default:
+                    out.push_back({ info, 0 });
+                    break;
+                }
+                return out;
+            }
+        }
+
+        struct TextureStream::Private
+        {
+            ImageInfo info;
+            size_t byteCount = 0;
+            std::vector<Plane> planes;
+            std::vector<std::shared_ptr<Texture> > textures;
+
+#if defined(FEATHER_TK_API_GL_4_1)
+            struct Buffer
+            {
+                GLuint pbo = 0;
+                GLsync fence = nullptr;
+            };
+            std::vector<Buffer> buffers;
+            size_t current = 0;
+#elif defined(FEATHER_TK_API_GLES_2)
+            std::vector<uint8_t> buffer;
+#endif // FEATHER_TK_API_GL_4_1
+            uint8_t* mapped = nullptr;
+            std::weak_ptr<Image> image;
+        };
+
+        TextureStream::TextureStream(
+            const ImageInfo& info,
+            const TextureOptions& options,
+            size_t bufferCount) :
+            _p(new Private)
+        {
+            FEATHER_TK_P();
+
+            p.info = info;
+            if (!p.info.isValid())
+            {
+                throw std::runtime_error("Invalid texture stream");
+            }
+            p.byteCount = p.info.getByteCount();
+            p.planes = getPlanes(p.info);
+
+            // The stream has its own pixel buffers.
+            TextureOptions textureOptions = options;
+            textureOptions.pbo = false;
+            for (const auto& plane : p.planes)
+            {
+                p.textures.push_back(Texture::create(plane.info, textureOptions));
+            }
+
+#if defined(FEATHER_TK_API_GL_4_1)
+            p.buffers.resize(std::max(bufferCount, static_cast<size_t>(1)));
+            for (auto& buffer : p.buffers)
+            {
+                glGenBuffers(1, &buffer.pbo);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+                glBufferData(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    p.byteCount,
+                    NULL,
+                    GL_STREAM_DRAW);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#elif defined(FEATHER_TK_API_GLES_2)
+            p.buffer.resize(p.byteCount);
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        TextureStream::~TextureStream()
+        {
+            FEATHER_TK_P();
+#if defined(FEATHER_TK_API_GL_4_1)
+            if (p.mapped)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.buffers[p.current].pbo);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            for (auto& buffer : p.buffers)
+            {
+                if (buffer.fence)
+                {
+                    glDeleteSync(buffer.fence);
+                    buffer.fence = nullptr;
+                }
+                if (buffer.pbo)
+                {
+                    glDeleteBuffers(1, &buffer.pbo);
+                    buffer.pbo = 0;
+                }
+            }
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        std::shared_ptr<TextureStream> TextureStream::create(
+            const ImageInfo& info,
+            const TextureOptions& options,
+            size_t bufferCount)
+        {
+            return std::shared_ptr<TextureStream>(new TextureStream(info, options, bufferCount));
+        }
+
+        const ImageInfo& TextureStream::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t TextureStream::getBufferCount() const
+        {
+#if defined(FEATHER_TK_API_GL_4_1)
+            return _p->buffers.size();
+#elif defined(FEATHER_TK_API_GLES_2)
+            return 1;
+#endif // FEATHER_TK_API_GL_4_1
+        }
+
+        const std::vector<std::shared_ptr<Texture> >& TextureStream::getTextures() const
+        {
+            return _p->textures;
+        }
+
+        bool TextureStream::isCompatible(const ImageInfo& info) const
+        {
+            FEATHER_TK_P();
+            return
+                info.size == p.info.size &&
+                info.type == p.info.type &&
+                info.layout.alignment == p.info.layout.alignment &&
+                info.layout.endian == p.info.layout.endian;
+        }
+
+        uint8_t* TextureStream::map()
+        {
+            FEATHER_TK_P();
+            if (p.mapped)
+                return p.mapped;
+#if defined(FEATHER_TK_API_GL_4_1)
+            auto& buffer = p.buffers[p.current];
+
+            // Wait for the last upload from this buffer. If the upload has
+            // finished the buffer can be mapped without synchronizing,
+            // otherwise let the driver synchronize.
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+            if (buffer.fence)
+            {
+                const GLenum result = glClientWaitSync(
+                    buffer.fence,
+                    GL_SYNC_FLUSH_COMMANDS_BIT,
+                    fenceTimeout);
+                if (GL_ALREADY_SIGNALED == result || GL_CONDITION_SATISFIED == result)
+                {
+                    flags |= GL_MAP_UNSYNCHRONIZED_BIT;
+                }
+                glDeleteSync(buffer.fence);
+                buffer.fence = nullptr;
+            }
+            else
+            {
+                flags |= GL_MAP_UNSYNCHRONIZED_BIT;
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+            p.mapped = static_cast<uint8_t*>(glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                p.byteCount,
+                flags));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+#elif defined(FEATHER_TK_API_GLES_2)
+            p.mapped = p.buffer.data();
+#endif // FEATHER_TK_API_GL_4_1
+            return p.mapped;
+        }
+
+        void TextureStream::upload()
+        {
+            FEATHER_TK_P();
+            if (!p.mapped)
+                return;
+#if defined(FEATHER_TK_API_GL_4_1)
+            auto& buffer = p.buffers[p.current];
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+            if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+            {
+                for (size_t i = 0; i < p.planes.size(); ++i)
+                {
+                    const auto& info = p.planes[i].info;
+                    p.textures[i]->bind();
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+                    glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != getEndian());
+                    glTexSubImage2D(
+                        GL_TEXTURE_2D,
+                        0,
+                        0,
+                        0,
+                        info.size.w,
+                        info.size.h,
+                        getTextureFormat(info.type),
+                        getTextureType(info.type),
+                        reinterpret_cast<const void*>(p.planes[i].offset));
+                }
+                buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            p.current = (p.current + 1) % p.buffers.size();
+#elif defined(FEATHER_TK_API_GLES_2)
+            for (size_t i = 0; i < p.planes.size(); ++i)
+            {
+                p.textures[i]->copy(p.mapped + p.planes[i].offset, p.planes[i].info);
+            }
+#endif // FEATHER_TK_API_GL_4_1
+            p.mapped = nullptr;
+            p.image.reset();
+        }
+
+        bool TextureStream::copy(const std::shared_ptr<Image>& image)
+        {
+            FEATHER_TK_P();
+            bool out = false;
+            if (image && isCompatible(image->getInfo()) && image != p.image.lock())
+            {
+                if (uint8_t* data = map())
+                {
+                    memcpy(data, image->getData(), std::min(p.byteCount, image->getByteCount()));
+                    upload();
+                    p.image = image;
+                    out = true;
+                }
+            }
+            return out;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/gl/Texture.h>
+
+namespace feather_tk
+{
+    namespace gl
+    {
+        //! \name Textures
+        ///@{
+
+        //! Texture stream.
+        //!
+        //! A texture stream uploads a sequence of images with the same
+        //! information, for example video frames, to a set of textures
+        //! that are reused for each image. Planar YUV images are uploaded
+        //! to a texture for each plane.
+        //!
+        //! The images are uploaded through a ring of pixel buffers with
+        //! fences, so that copying the next image can overlap with the
+        //! upload of the previous images. The buffer returned by map() may
+        //! be written from another thread, for example by a decoder, while
+        //! the renderer continues to draw.
+        //!
+        //! With OpenGL ES 2 the images are copied from system memory.
+        class TextureStream : public std::enable_shared_from_this<TextureStream>
+        {
+            FEATHER_TK_NON_COPYABLE(TextureStream);
+
+        protected:
+            TextureStream(
+                const ImageInfo&,
+                const TextureOptions&,
+                size_t bufferCount);
+
+        public:
+            ~TextureStream();
+
+            //! Create a new texture stream.
+            static std::shared_ptr<TextureStream> create(
+                const ImageInfo&,
+                const TextureOptions& = TextureOptions(),
+                size_t bufferCount = 3);
+
+            //! Get the image information.
+            const ImageInfo& getInfo() const;
+
+            //! Get the number of buffers.
+            size_t getBufferCount() const;
+
+            //! Get the textures.
+            const std::vector<std::shared_ptr<Texture> >& getTextures() const;
+
+            //! Get whether an image is compatible with the stream.
+            bool isCompatible(const ImageInfo&) const;
+
+            //! Map the next buffer for writing. This waits for the upload
+            //! that last used the buffer to finish. The buffer has the size
+            //! of the image information byte count, and is valid until
+            //! upload() is called. Returns null on error.
+            uint8_t* map();
+
+            //! Upload the mapped buffer to the textures.
+            void upload();
+
+            //! Copy an image to the textures. Returns false if the image is
+            //! not compatible, or if it is the same image that was copied
+            //! last.
+            bool copy(const std::shared_ptr<Image>&);
+
+        private:
+            FEATHER_TK_PRIVATE();
+        };
+
+        ///@}
+    }
+}
\ No newline at end of file
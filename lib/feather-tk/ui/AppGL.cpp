@@ -14,8 +14,8 @@
 #include <feather-tk/core/Error.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/LogSystem.h>
+#include <feather-tk/core/ProfileSystem.h>
 #include <feather-tk/core/String.h>
-#include <feather-tk/core/Time.h>
 #include <feather-tk/core/Timer.h>
 
 #define GLFW_INCLUDE_NONE
@@ -23,11 +23,13 @@
 
 #include <algorithm>
 #include <iostream>
+#include <set>
 
 namespace feather_tk
 {
     namespace
     {
+        // The time between ticks while widgets are animating.
         const std::chrono::milliseconds timeout(5);
     }
 
@@ -52,10 +54,13 @@ namespace feather_tk
             std::shared_ptr<CmdLineFlagOption> exit;
             std::shared_ptr<CmdLineValueOption<float> > displayScale;
             std::shared_ptr<CmdLineValueOption<ColorStyle> > colorStyle;
+            std::shared_ptr<CmdLineFlagOption> profile;
+            std::shared_ptr<CmdLineValueOption<std::string> > profileTrace;
         };
         CmdLine cmdLine;
 
         std::shared_ptr<FontSystem> fontSystem;
+        std::shared_ptr<ProfileSystem> profileSystem;
         std::shared_ptr<IconSystem> iconSystem;
         std::shared_ptr<Style> style;
         std::shared_ptr<ObservableValue<ColorStyle> > colorStyle;
@@ -64,10 +69,21 @@ namespace feather_tk
         std::shared_ptr<ObservableValue<bool> > tooltipsEnabled;
         bool running = true;
         std::list<std::shared_ptr<Window> > windows;
+        std::set<float> iconScales;
         std::list<int> tickTimes;
         std::shared_ptr<Timer> logTimer;
+
+        void preloadIcons(float displayScale);
     };
 
+    void App::Private::preloadIcons(float displayScale)
+    {
+        if (displayScale > 0.F && iconScales.insert(displayScale).second)
+        {
+            iconSystem->preload(iconSystem->getNames(), { displayScale });
+        }
+    }
+
     void App::_init(
         const std::shared_ptr<Context>& context,
         const std::vector<std::string>& argv,
@@ -96,6 +112,16 @@ namespace feather_tk
             std::optional<ColorStyle>(),
             quotes(getColorStyleLabels()));
         cmdLineOptionsTmp.push_back(p.cmdLine.colorStyle);
+        p.cmdLine.profile = CmdLineFlagOption::create(
+            { "-profile" },
+            "Enable frame profiling.",
+            "Profiling");
+        cmdLineOptionsTmp.push_back(p.cmdLine.profile);
+        p.cmdLine.profileTrace = CmdLineValueOption<std::string>::create(
+            { "-profileTrace" },
+            "Enable frame profiling and write a Chrome trace file on exit.",
+            "Profiling");
+        cmdLineOptionsTmp.push_back(p.cmdLine.profileTrace);
 
         IApp::_init(
             context,
@@ -107,8 +133,20 @@ namespace feather_tk
         uiInit(context);
         gl::init(context);
 
+        // Background threads wake the event loop when they have results.
+        context->setWakeCallback(
+            []
+            {
+                glfwPostEmptyEvent();
+            });
+
         p.fontSystem = context->getSystem<FontSystem>();
         p.iconSystem = context->getSystem<IconSystem>();
+        p.profileSystem = context->getSystem<ProfileSystem>();
+        if (p.cmdLine.profile->found() || p.cmdLine.profileTrace->hasValue())
+        {
+            p.profileSystem->setEnabled(true);
+        }
         p.style = Style::create(context);
         p.colorStyle = ObservableValue<ColorStyle>::create(ColorStyle::Dark);
         if (p.cmdLine.colorStyle->hasValue())
@@ -123,6 +161,20 @@ namespace feather_tk
         }
         p.tooltipsEnabled = ObservableValue<bool>::create(true);
 
+        // Rasterize the icons in the background while the windows are
+        // created, so they are ready when the windows are first shown.
+        float displayScale = p.displayScale->get();
+        if (displayScale <= 0.F)
+        {
+            displayScale = 1.F;
+            if (GLFWmonitor* monitor = glfwGetPrimaryMonitor())
+            {
+                float y = 1.F;
+                glfwGetMonitorContentScale(monitor, &displayScale, &y);
+            }
+        }
+        p.preloadIcons(displayScale);
+
         _styleUpdate();
 
         p.logTimer = Timer::create(context);
@@ -144,7 +196,9 @@ namespace feather_tk
     {}
 
     App::~App()
-    {}
+    {
+        _context->setWakeCallback(nullptr);
+    }
 
     std::shared_ptr<App> App::create(
         const std::shared_ptr<Context>& context,
@@ -191,6 +245,7 @@ namespace feather_tk
         window->setDisplayScale(p.displayScale->get());
         window->setTooltipsEnabled(p.tooltipsEnabled->get());
         p.windows.push_back(window);
+        p.preloadIcons(window->getDisplayScale());
     }
 
     void App::removeWindow(const std::shared_ptr<Window>& window)
@@ -293,6 +348,7 @@ namespace feather_tk
         for (const auto& window : p.windows)
         {
             window->setDisplayScale(value);
+            p.preloadIcons(window->getDisplayScale());
         }
     }
 
@@ -324,40 +380,75 @@ namespace feather_tk
     void App::exit()
     {
         _p->running = false;
+        glfwPostEmptyEvent();
     }
 
     void App::run()
     {
         FEATHER_TK_P();
+        auto timerSystem = _context->getSystem<TimerSystem>();
         auto t0 = std::chrono::steady_clock::now();
+        std::chrono::microseconds wait = std::chrono::microseconds::zero();
         while (p.running && !p.windows.empty())
         {
-            glfwPollEvents();
+            // Wait for events, or until the next timer times out. Background
+            // threads post an empty event to wake the loop when they have
+            // results.
+            if (std::chrono::microseconds::max() == wait)
+            {
+                glfwWaitEvents();
+            }
+            else if (wait > std::chrono::microseconds::zero())
+            {
+                glfwWaitEventsTimeout(std::chrono::duration<double>(wait).count());
+            }
+            else
+            {
+                glfwPollEvents();
+            }
+            const auto frameStart = std::chrono::steady_clock::now();
 
-            _context->tick();
+            p.profileSystem->beginFrame();
+            {
+                ProfileTimer timer(p.profileSystem, "Context Tick");
+                _context->tick();
+            }
 
-            _tick();
+            {
+                ProfileTimer timer(p.profileSystem, "App Tick");
+                _tick();
+            }
 
             size_t visibleWindows = 0;
+            bool tickEvents = false;
             for (const auto& window : p.windows)
             {
-                TickEvent tickEvent;
-                _tickRecursive(
-                    window,
-                    window->isVisible(false),
-                    window->isEnabled(false),
-                    tickEvent);
+                {
+                    ProfileTimer timer(p.profileSystem, "Widget Tick");
+                    TickEvent tickEvent;
+                    _tickRecursive(
+                        window,
+                        true,
+                        true,
+                        tickEvent);
+                }
+                tickEvents |= window->hasTickEvents();
 
                 if (window->isVisible(false))
                 {
                     ++visibleWindows;
+
+                    // The display scale changes when the window is moved
+                    // to a different screen.
+                    p.preloadIcons(window->getDisplayScale());
+
                     window->update(p.fontSystem, p.iconSystem, p.style);
                 }
             }
 
-            auto t1 = std::chrono::steady_clock::now();
-            sleep(timeout, t0, t1);
-            t1 = std::chrono::steady_clock::now();
+            p.profileSystem->endFrame();
+
+            const auto t1 = std::chrono::steady_clock::now();
             const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
             p.tickTimes.push_back(diff.count());
             while (p.tickTimes.size() > 10)
@@ -366,11 +457,44 @@ namespace feather_tk
             }
             t0 = t1;
 
+            // If widgets are animating then wait for the rest of the frame,
+            // otherwise wait until the next timer times out.
+            if (tickEvents)
+            {
+                wait = std::max(
+                    std::chrono::duration_cast<std::chrono::microseconds>(timeout - (t1 - frameStart)),
+                    std::chrono::microseconds::zero());
+            }
+            else if (timerSystem)
+            {
+                wait = timerSystem->getTimeRemaining();
+            }
+            else
+            {
+                wait = std::chrono::microseconds::max();
+            }
+
             if (p.cmdLine.exit->found() || 0 == visibleWindows)
             {
                 break;
             }
         }
+
+        if (p.cmdLine.profileTrace->hasValue())
+        {
+            const std::string& path = p.cmdLine.profileTrace->getValue();
+            try
+            {
+                p.profileSystem->writeChromeTrace(std::filesystem::u8path(path));
+            }
+            catch (const std::exception& e)
+            {
+                _context->getSystem<LogSystem>()->print(
+                    "feather_tk::App",
+                    Format("Cannot write profile trace: {0}: {1}").arg(path).arg(e.what()),
+                    LogType::Error);
+            }
+        }
     }
 
     void App::_tickRecursive(
@@ -384,11 +508,14 @@ namespace feather_tk
         const bool parentsEnabled = enabled && widget->isEnabled(false);
         for (const auto& child : widget->getChildren())
         {
-            _tickRecursive(
-                child,
-                parentsVisible,
-                parentsEnabled,
-                event);
+            if (child->hasTickEvents())
+            {
+                _tickRecursive(
+                    child,
+                    parentsVisible,
+                    parentsEnabled,
+                    event);
+            }
         }
         widget->tickEvent(visible, enabled, event);
     }
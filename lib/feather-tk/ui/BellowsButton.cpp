@@ -28,7 +28,7 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F border;
+            CompactMesh2F border;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
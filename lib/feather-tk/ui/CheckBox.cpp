@@ -31,8 +31,8 @@ namespace feather_tk
             Box2I g;
             Box2I g2;
             Box2I g3;
-            TriMesh2F border;
-            TriMesh2F checkBox;
+            CompactMesh2F border;
+            CompactMesh2F checkBox;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
@@ -30,7 +30,7 @@ namespace feather_tk
 
         struct DrawData
         {
-            TriMesh2F border;
+            CompactMesh2F border;
             Box2I g2;
         };
         std::optional<DrawData> draw;
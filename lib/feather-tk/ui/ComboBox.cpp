@@ -5,6 +5,7 @@
 #include <feather-tk/ui/ComboBoxPrivate.h>
 
 #include <feather-tk/ui/DrawUtil.h>
+#include <feather-tk/ui/IconSystem.h>
 
 #include <optional>
 
@@ -37,7 +38,9 @@ namespace feather_tk
         std::string text;
         std::string icon;
         std::shared_ptr<Image> iconImage;
+        IconRequest iconRequest;
         std::shared_ptr<Image> arrowIconImage;
+        IconRequest arrowIconRequest;
         float iconScale = 1.F;
         std::shared_ptr<ComboBoxMenu> menu;
 
@@ -57,8 +60,8 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F mesh;
-            TriMesh2F border;
+            CompactMesh2F mesh;
+            CompactMesh2F border;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
@@ -128,6 +131,7 @@ namespace feather_tk
         p.text = item.text;
         p.icon = item.icon;
         p.iconImage.reset();
+        p.iconRequest = IconRequest();
         p.size.displayScale.reset();
         _setSizeUpdate();
         _setDrawUpdate();
@@ -162,6 +166,7 @@ namespace feather_tk
         p.text = item.text;
         p.icon = item.icon;
         p.iconImage.reset();
+        p.iconRequest = IconRequest();
         p.size.displayScale.reset();
         _setSizeUpdate();
         _setDrawUpdate();
@@ -204,6 +209,26 @@ namespace feather_tk
         }
     }
 
+    void ComboBox::tickEvent(
+        bool parentsVisible,
+        bool parentsEnabled,
+        const TickEvent& event)
+    {
+        IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+        FEATHER_TK_P();
+        bool iconUpdate = takeIcon(p.iconRequest, p.iconImage);
+        iconUpdate |= takeIcon(p.arrowIconRequest, p.arrowIconImage);
+        if (iconUpdate)
+        {
+            _setSizeUpdate();
+            _setDrawUpdate();
+        }
+        if (!p.iconRequest.isPending() && !p.arrowIconRequest.isPending())
+        {
+            _setTickEvents(false);
+        }
+    }
+
     void ComboBox::sizeHintEvent(const SizeHintEvent& event)
     {
         IWidget::sizeHintEvent(event);
@@ -235,15 +260,26 @@ namespace feather_tk
         {
             p.iconScale = event.displayScale;
             p.iconImage.reset();
+            p.iconRequest = IconRequest();
             p.arrowIconImage.reset();
+            p.arrowIconRequest = IconRequest();
         }
-        if (!p.icon.empty() && !p.iconImage)
-        {
-            p.iconImage = event.iconSystem->get(p.icon, event.displayScale);
-        }
-        if (!p.arrowIconImage)
+
+        // Cached icons are ready immediately, otherwise the icons are
+        // received in the tick event.
+        bool iconRequests = p.iconRequest.request(
+            event.iconSystem,
+            p.icon,
+            event.displayScale,
+            p.iconImage);
+        iconRequests |= p.arrowIconRequest.request(
+            event.iconSystem,
+            "MenuArrow",
+            event.displayScale,
+            p.arrowIconImage);
+        if (iconRequests)
         {
-            p.arrowIconImage = event.iconSystem->get("MenuArrow", event.displayScale);
+            _setTickEvents(true);
         }
 
         Size2I sizeHint;
@@ -84,6 +84,10 @@ namespace feather_tk
         void setFontRole(FontRole);
 
         void setGeometry(const Box2I&) override;
+        void tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const TickEvent&) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void clipEvent(const Box2I&, bool) override;
         void drawEvent(const Box2I&, const DrawEvent&) override;
@@ -14,26 +14,26 @@ namespace feather_tk
     ///@{
         
     //! Create a mesh for drawing a rectangle.
-    TriMesh2F rect(
+    CompactMesh2F rect(
         const Box2I&,
         int cornerRadius = 0,
         size_t resolution = 8);
 
     //! Create a mesh for drawing a circle.
-    TriMesh2F circle(
+    CompactMesh2F circle(
         const V2I&,
         int radius,
         size_t resolution = 120);
 
     //! Create a mesh for drawing a border.
-    TriMesh2F border(
+    CompactMesh2F border(
         const Box2I&,
         int width,
         int radius = 0,
         size_t resolution = 8);
 
-    //! Create a mesh for drawing a shadow.
-    TriMesh2F shadow(
+    //! Create a mesh for drawing a shadow. The mesh has vertex colors.
+    CompactMesh2F shadow(
         const Box2I&,
         int cornerRadius,
         const float alpha = .2F,
@@ -8,6 +8,8 @@
 
 #include <feather-tk/ui/IButton.h>
 
+#include <feather-tk/core/DirSystem.h>
+
 namespace feather_tk
 {
     class FileBrowserPath : public IWidget
@@ -180,14 +182,6 @@ namespace feather_tk
         FEATHER_TK_PRIVATE();
     };
 
-    struct FileBrowserInfo
-    {
-        std::filesystem::path           path;
-        bool                            isDir = false;
-        size_t                          size  = 0;
-        std::filesystem::file_time_type time;
-    };
-
     class FileBrowserView : public IWidget
     {
     protected:
@@ -220,6 +214,10 @@ namespace feather_tk
 
         Box2I getRect(int) const;
 
+        void tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const TickEvent&) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void drawEvent(const Box2I& drawRect, const DrawEvent&) override;
         void mouseEnterEvent(MouseEnterEvent&) override;
@@ -234,9 +232,13 @@ namespace feather_tk
     private:
         int _getItem(const V2I&) const;
         void _directoryUpdate();
+        void _entriesUpdate(const std::vector<DirEntry>&);
+        void _directoryRefresh();
+        void _entriesRefresh(const std::vector<DirEntry>&);
+        void _filterUpdate();
         void _setCurrent(int);
         void _doubleClick(int);
 
         FEATHER_TK_PRIVATE();
     };
-}
+}
\ No newline at end of file
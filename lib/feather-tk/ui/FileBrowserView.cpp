@@ -5,12 +5,17 @@
 #include <feather-tk/ui/FileBrowserPrivate.h>
 
 #include <feather-tk/ui/DrawUtil.h>
+#include <feather-tk/ui/IconSystem.h>
 
 #include <feather-tk/core/File.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/String.h>
+#include <feather-tk/core/StringSearch.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <map>
+#include <numeric>
 #include <optional>
 
 namespace feather_tk
@@ -18,14 +23,56 @@ namespace feather_tk
     namespace
     {
         const float doubleClickTime = .5F;
+        const size_t measureMax = 8;
 
         struct FileBrowserItem
         {
-            std::shared_ptr<Image> icon;
+            bool init = false;
             std::vector<std::string> text;
             std::vector<Size2I> textSizes;
-            Size2I size;
         };
+
+        std::vector<std::string> getText(const DirEntry& info)
+        {
+            std::vector<std::string> out;
+
+            // File name.
+            std::string text = info.path.filename().u8string();
+            out.push_back(text);
+
+            // File extension.
+            text = !info.isDir ?
+                info.path.extension().u8string() :
+                std::string();
+            out.push_back(text);
+
+            // File size.
+            if (!info.isDir)
+            {
+                if (info.size < megabyte)
+                {
+                    text = Format("{0}KB").
+                        arg(info.size / static_cast<float>(kilobyte), 2);
+                }
+                else if (info.size < gigabyte)
+                {
+                    text = Format("{0}MB").
+                        arg(info.size / static_cast<float>(megabyte), 2);
+                }
+                else
+                {
+                    text = Format("{0}GB").
+                        arg(info.size / static_cast<float>(gigabyte), 2);
+                }
+                out.push_back(text);
+            }
+
+            // File last modification time.
+            // \todo std::format is available in C++20.
+            //text = std::format("{}", info.time);
+
+            return out;
+        }
     }
 
     struct FileBrowserView::Private
@@ -33,7 +80,11 @@ namespace feather_tk
         FileBrowserMode mode = FileBrowserMode::File;
         std::shared_ptr<FileBrowserModel> model;
         std::string search;
-        std::vector<FileBrowserInfo> info;
+        StringSearch stringSearch;
+        std::shared_ptr<DirSystem> dirSystem;
+        uint64_t scanId = 0;
+        std::vector<DirEntry> entries;
+        std::vector<DirEntry> info;
         std::shared_ptr<ObservableValue<int> > current;
         std::vector<FileBrowserItem> items;
         std::function<void(const std::filesystem::path&)> callback;
@@ -42,10 +93,13 @@ namespace feather_tk
         std::shared_ptr<ValueObserver<std::filesystem::path> > pathObserver;
         std::shared_ptr<ValueObserver<FileBrowserOptions> > optionsObserver;
         std::shared_ptr<ValueObserver<std::string> > extensionObserver;
+        std::shared_ptr<ValueObserver<std::filesystem::path> > changedObserver;
 
         float iconScale = 1.F;
         std::shared_ptr<Image> directoryImage;
+        IconRequest directoryRequest;
         std::shared_ptr<Image> fileImage;
+        IconRequest fileRequest;
 
         struct SizeData
         {
@@ -55,9 +109,30 @@ namespace feather_tk
             int pad = 0;
             FontInfo fontInfo;
             FontMetrics fontMetrics;
+            int rowHeight = 0;
+            std::optional<int> width;
         };
         SizeData size;
 
+        // The items are initialized when they are first drawn, so only
+        // the visible items are measured.
+        const FileBrowserItem& getItem(
+            size_t index,
+            const std::shared_ptr<FontSystem>& fontSystem)
+        {
+            FileBrowserItem& item = items[index];
+            if (!item.init)
+            {
+                item.init = true;
+                item.text = getText(info[index]);
+                for (const auto& text : item.text)
+                {
+                    item.textSizes.push_back(fontSystem->getSize(text, size.fontInfo));
+                }
+            }
+            return item;
+        }
+
         struct MouseData
         {
             int hover = -1;
@@ -84,6 +159,7 @@ namespace feather_tk
 
         p.mode = mode;
         p.model = model;
+        p.dirSystem = context->getSystem<DirSystem>();
         p.current = ObservableValue<int>::create(-1);
 
         p.pathObserver = ValueObserver<std::filesystem::path>::create(
@@ -97,15 +173,27 @@ namespace feather_tk
             model->observeOptions(),
             [this](const FileBrowserOptions&)
             {
-                _directoryUpdate();
+                _filterUpdate();
             });
 
         p.extensionObserver = ValueObserver<std::string>::create(
             model->observeExtension(),
             [this](const std::string&)
             {
-                _directoryUpdate();
+                _filterUpdate();
             });
+
+        p.changedObserver = ValueObserver<std::filesystem::path>::create(
+            p.dirSystem->observeChanged(),
+            [this](const std::filesystem::path& value)
+            {
+                FEATHER_TK_P();
+                if (value.lexically_normal() == p.model->getPath().lexically_normal())
+                {
+                    _directoryRefresh();
+                }
+            },
+            ObserverAction::Suppress);
     }
 
     FileBrowserView::FileBrowserView() :
@@ -113,7 +201,13 @@ namespace feather_tk
     {}
 
     FileBrowserView::~FileBrowserView()
-    {}
+    {
+        FEATHER_TK_P();
+        if (p.dirSystem)
+        {
+            p.dirSystem->cancel(p.scanId);
+        }
+    }
 
     std::shared_ptr<FileBrowserView> FileBrowserView::create(
         const std::shared_ptr<Context>& context,
@@ -128,6 +222,8 @@ namespace feather_tk
 
     void FileBrowserView::reload()
     {
+        FEATHER_TK_P();
+        p.dirSystem->invalidate(p.model->getPath());
         _directoryUpdate();
     }
 
@@ -147,7 +243,7 @@ namespace feather_tk
         if (value == p.search)
             return;
         p.search = value;
-        _directoryUpdate();
+        _filterUpdate();
     }
 
     std::shared_ptr<IObservableValue<int> > FileBrowserView::observeCurrent() const
@@ -158,19 +254,35 @@ namespace feather_tk
     Box2I FileBrowserView::getRect(int index) const
     {
         FEATHER_TK_P();
-        int y = 0;
-        int i = 0;
-        for (; i < index && i < p.items.size(); ++i)
+        const int count = static_cast<int>(p.items.size());
+        const int row = clamp(index, 0, count);
+        return Box2I(
+            0,
+            row * p.size.rowHeight,
+            getGeometry().w(),
+            row < count ? p.size.rowHeight : 0);
+    }
+
+    void FileBrowserView::tickEvent(
+        bool parentsVisible,
+        bool parentsEnabled,
+        const TickEvent& event)
+    {
+        IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+        FEATHER_TK_P();
+        bool iconUpdate = takeIcon(p.directoryRequest, p.directoryImage);
+        iconUpdate |= takeIcon(p.fileRequest, p.fileImage);
+        if (iconUpdate)
         {
-            const FileBrowserItem& item = p.items[i];
-            y += item.size.h;
+            // The row height depends on the icon size.
+            p.size.displayScale.reset();
+            _setSizeUpdate();
+            _setDrawUpdate();
         }
-        int h = 0;
-        if (i < p.items.size())
+        if (!p.directoryRequest.isPending() && !p.fileRequest.isPending())
         {
-            h = p.items[i].size.h;
+            _setTickEvents(false);
         }
-        return Box2I(0, y, getGeometry().w(), h);
     }
 
     void FileBrowserView::sizeHintEvent(const SizeHintEvent& event)
@@ -182,15 +294,26 @@ namespace feather_tk
         {
             p.iconScale = event.displayScale;
             p.directoryImage.reset();
+            p.directoryRequest = IconRequest();
             p.fileImage.reset();
+            p.fileRequest = IconRequest();
         }
-        if (!p.directoryImage)
-        {
-            p.directoryImage = event.iconSystem->get("Directory", event.displayScale);
-        }
-        if (!p.fileImage)
+
+        // Cached icons are ready immediately, otherwise the icons are
+        // received in the tick event.
+        bool iconRequests = p.directoryRequest.request(
+            event.iconSystem,
+            "Directory",
+            event.displayScale,
+            p.directoryImage);
+        iconRequests |= p.fileRequest.request(
+            event.iconSystem,
+            "File",
+            event.displayScale,
+            p.fileImage);
+        if (iconRequests)
         {
-            p.fileImage = event.iconSystem->get("File", event.displayScale);
+            _setTickEvents(true);
         }
 
         if (!p.size.displayScale.has_value() ||
@@ -202,29 +325,59 @@ namespace feather_tk
             p.size.pad = event.style->getSizeRole(SizeRole::LabelPad, event.displayScale);
             p.size.fontInfo = event.style->getFontRole(FontRole::Label, event.displayScale);
             p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
-            for (size_t i = 0; i < p.info.size() && i < p.items.size(); ++i)
+            int iconHeight = 0;
+            if (p.directoryImage)
             {
-                auto& item = p.items[i];
-                item.icon = p.info[i].isDir ? p.directoryImage : p.fileImage;
-                item.size = item.icon ? item.icon->getSize() : Size2I();
-                item.textSizes.clear();
-                for (const auto& text : item.text)
-                {
-                    const Size2I textSize = event.fontSystem->getSize(text, p.size.fontInfo);
-                    item.textSizes.push_back(textSize);
-                    item.size.w += textSize.w + p.size.pad * 2 + p.size.margin * 2;
-                    item.size.h = std::max(item.size.h, textSize.h) + p.size.margin * 2;
-                }
+                iconHeight = std::max(iconHeight, p.directoryImage->getHeight());
+            }
+            if (p.fileImage)
+            {
+                iconHeight = std::max(iconHeight, p.fileImage->getHeight());
             }
+            p.size.rowHeight =
+                std::max(iconHeight, p.size.fontMetrics.lineHeight) +
+                p.size.margin * 2;
+            p.size.width.reset();
+            p.items = std::vector<FileBrowserItem>(p.info.size());
         }
 
-        Size2I sizeHint;
-        for (const auto& item : p.items)
+        // Only measure the items with the longest text instead of every
+        // item. Measuring a few candidates handles proportional fonts where
+        // the item with the most characters is not the widest.
+        if (!p.size.width.has_value())
         {
-            sizeHint.w = std::max(sizeHint.w, item.size.w);
-            sizeHint.h += item.size.h;
+            std::vector<size_t> items(p.info.size());
+            std::iota(items.begin(), items.end(), 0);
+            const size_t count = std::min(items.size(), measureMax);
+            std::partial_sort(
+                items.begin(),
+                items.begin() + count,
+                items.end(),
+                [&p](size_t a, size_t b)
+                {
+                    return p.info[a].path.filename().native().size() >
+                        p.info[b].path.filename().native().size();
+                });
+            int width = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t index = items[i];
+                int itemWidth = p.info[index].isDir ?
+                    (p.directoryImage ? p.directoryImage->getWidth() : 0) :
+                    (p.fileImage ? p.fileImage->getWidth() : 0);
+                const FileBrowserItem& item = p.getItem(index, event.fontSystem);
+                for (const auto& textSize : item.textSizes)
+                {
+                    itemWidth += textSize.w + p.size.pad * 2 + p.size.margin * 2;
+                }
+                width = std::max(width, itemWidth);
+            }
+            p.size.width = width;
         }
-        _setSizeHint(sizeHint);
+
+        _setSizeHint(Size2I(
+            p.size.width.value(),
+            static_cast<int>(p.info.size()) * p.size.rowHeight));
     }
 
     void FileBrowserView::drawEvent(
@@ -253,22 +406,27 @@ namespace feather_tk
                 event.style->getColorRole(ColorRole::Hover));
         }
 
-        // Draw the items.
-        int y = g.min.y;
-        for (const auto& item : p.items)
+        // Draw the visible items.
+        const Box2I visible = intersect(g, drawRect);
+        if (p.size.rowHeight > 0 && !p.items.empty() && visible.h() > 0)
         {
-            int x = g.min.x;
-            const Box2I g2(x, y, item.size.w, item.size.h);
-            if (intersects(g2, drawRect))
+            const int rowsMax = static_cast<int>(p.items.size()) - 1;
+            const int first = clamp((visible.min.y - g.min.y) / p.size.rowHeight, 0, rowsMax);
+            const int last = clamp((visible.max.y - g.min.y) / p.size.rowHeight, 0, rowsMax);
+            for (int row = first; row <= last; ++row)
             {
-                if (item.icon)
+                const FileBrowserItem& item = p.getItem(row, event.fontSystem);
+                const int y = g.min.y + row * p.size.rowHeight;
+                int x = g.min.x;
+                const auto& icon = p.info[row].isDir ? p.directoryImage : p.fileImage;
+                if (icon)
                 {
-                    const Size2I& iconSize = item.icon->getSize();
+                    const Size2I& iconSize = icon->getSize();
                     event.render->drawImage(
-                        item.icon,
+                        icon,
                         Box2I(
                             x,
-                            y + item.size.h / 2 - iconSize.h / 2,
+                            y + p.size.rowHeight / 2 - iconSize.h / 2,
                             iconSize.w,
                             iconSize.h),
                         event.style->getColorRole(ColorRole::Text));
@@ -285,7 +443,7 @@ namespace feather_tk
                     event.render->drawText(
                         glyphs,
                         p.size.fontMetrics,
-                        V2I(x + p.size.pad + p.size.margin, y + item.size.h / 2 - item.textSizes[i].h / 2),
+                        V2I(x + p.size.pad + p.size.margin, y + p.size.rowHeight / 2 - item.textSizes[i].h / 2),
                         event.style->getColorRole(isEnabled() ?
                             ColorRole::Text :
                             ColorRole::TextDisabled));
@@ -295,11 +453,10 @@ namespace feather_tk
                     }
                     else
                     {
-                        x += item.textSizes[i].w + +p.size.pad * 2 + p.size.margin * 2;
+                        x += item.textSizes[i].w + p.size.pad * 2 + p.size.margin * 2;
                     }
                 }
             }
-            y += item.size.h;
         }
     }
 
@@ -460,183 +617,309 @@ namespace feather_tk
         FEATHER_TK_P();
         int out = -1;
         const Box2I& g = getGeometry();
-        int y = 0;
-        for (size_t i = 0; i < p.items.size(); ++i)
+        if (p.size.rowHeight > 0 && contains(g, value))
         {
-            const auto& item = p.items[i];
-            const Box2I g2(g.min.x, g.min.y + y, g.w(), item.size.h);
-            if (contains(g2, value))
+            const int row = (value.y - g.min.y) / p.size.rowHeight;
+            if (row < p.items.size())
             {
-                out = i;
-                break;
+                out = row;
             }
-            y += item.size.h;
         }
         return out;
     }
 
     namespace
     {
-        void list(
+        bool filter(
+            const DirEntry& entry,
             FileBrowserMode mode,
-            const std::filesystem::path& path,
             const FileBrowserOptions& options,
             const std::string& extension,
-            const std::string& search,
-            std::vector<FileBrowserInfo>& out)
+            bool searchMatch)
         {
-            try
+            const std::string fileName = entry.path.filename().u8string();
+            bool out = true;
+            if (out && !options.hidden && isDotFile(fileName))
             {
-                for (const auto& i : std::filesystem::directory_iterator(path))
-                {
-                    const std::filesystem::path& path = i.path();
-                    const std::string fileName = path.filename().u8string();
-
-                    bool keep = true;
-                    if (keep && !options.hidden && isDotFile(fileName))
-                    {
-                        keep = false;
-                    }
-                    const bool isDir = std::filesystem::is_directory(path);
-                    if (keep && !isDir && !extension.empty())
-                    {
-                        keep = compare(
-                            extension,
-                            path.extension().u8string(),
-                            CaseCompare::Insensitive);
-                    }
-                    if (keep && !search.empty())
-                    {
-                        keep = contains(
-                            fileName,
-                            search,
-                            CaseCompare::Insensitive);
-                    }
-                    if (keep && FileBrowserMode::Dir == mode && !isDir)
-                    {
-                        keep = false;
-                    }
-
-                    if (keep)
-                    {
-                        out.push_back({
-                            path,
-                            isDir,
-                            isDir ? 0 : std::filesystem::file_size(path),
-                            std::filesystem::last_write_time(path) });
-                    }
-                }
+                out = false;
+            }
+            if (out && !entry.isDir && !extension.empty())
+            {
+                out = compare(
+                    extension,
+                    entry.path.extension().u8string(),
+                    CaseCompare::Insensitive);
+            }
+            if (out && !searchMatch)
+            {
+                out = false;
+            }
+            if (out && FileBrowserMode::Dir == mode && !entry.isDir)
+            {
+                out = false;
             }
-            catch (const std::exception&)
-            {}
+            return out;
+        }
 
-            std::function<int(const FileBrowserInfo& a, const FileBrowserInfo& b)> sort;
+        std::function<bool(const DirEntry&, const DirEntry&)> getSort(
+            const FileBrowserOptions& options)
+        {
+            std::function<bool(const DirEntry&, const DirEntry&)> sort;
             switch (options.sort)
             {
             case FileBrowserSort::Name:
-                sort = [](const FileBrowserInfo& a, const FileBrowserInfo& b)
+                sort = [](const DirEntry& a, const DirEntry& b)
                     {
                         return a.path.filename() < b.path.filename();
                     };
                 break;
             case FileBrowserSort::Extension:
-                sort = [](const FileBrowserInfo& a, const FileBrowserInfo& b)
+                sort = [](const DirEntry& a, const DirEntry& b)
                     {
                         return a.path.extension() < b.path.extension();
                     };
                 break;
             case FileBrowserSort::Size:
-                sort = [](const FileBrowserInfo& a, const FileBrowserInfo& b)
+                sort = [](const DirEntry& a, const DirEntry& b)
                     {
                         return a.size < b.size;
                     };
                 break;
             case FileBrowserSort::Time:
-                sort = [](const FileBrowserInfo& a, const FileBrowserInfo& b)
+                sort = [](const DirEntry& a, const DirEntry& b)
                     {
                         return a.time < b.time;
                     };
                 break;
             default: break;
             }
-            if (sort)
-            {
-                if (options.reverseSort)
-                {
-                    std::sort(out.rbegin(), out.rend(), sort);
-                }
-                else
-                {
-                    std::sort(out.begin(), out.end(), sort);
-                }
-            }
-            std::stable_sort(
-                out.begin(),
-                out.end(),
-                [](const FileBrowserInfo& a, const FileBrowserInfo& b)
+
+            // Directories are always listed first.
+            const bool reverse = options.reverseSort;
+            return [sort, reverse](const DirEntry& a, const DirEntry& b)
                 {
-                    return a.isDir > b.isDir;
-                });
+                    if (a.isDir != b.isDir)
+                    {
+                        return a.isDir;
+                    }
+                    if (!sort)
+                    {
+                        return false;
+                    }
+                    return reverse ? sort(b, a) : sort(a, b);
+                };
         }
     }
 
     void FileBrowserView::_directoryUpdate()
     {
         FEATHER_TK_P();
+        p.dirSystem->cancel(p.scanId);
+        p.entries.clear();
+        p.stringSearch.clear();
         p.info.clear();
         p.items.clear();
-        list(
-            p.mode,
+        p.size.width.reset();
+
+        p.current->setIfChanged(-1);
+        if (p.selectCallback)
+        {
+            p.selectCallback(std::filesystem::path());
+        }
+
+        _setSizeUpdate();
+        _setDrawUpdate();
+
+        // The entries are passed in batches as the directory is read, or
+        // immediately if the directory is cached.
+        p.scanId = p.dirSystem->scan(
             p.model->getPath(),
-            p.model->getOptions(),
-            p.model->getExtension(),
-            p.search,
-            p.info);
-        if (auto context = getContext())
+            [this](const std::vector<DirEntry>& entries, bool)
+            {
+                _entriesUpdate(entries);
+            });
+    }
+
+    void FileBrowserView::_entriesUpdate(const std::vector<DirEntry>& entries)
+    {
+        FEATHER_TK_P();
+        if (entries.empty())
+            return;
+
+        // Get the current item before the new entries are merged so it
+        // can be kept when it moves.
+        std::filesystem::path path;
+        const int current = p.current->get();
+        if (current >= 0 && current < p.info.size())
         {
-            for (size_t i = 0; i < p.info.size(); ++i)
+            path = p.info[current].path;
+        }
+
+        const size_t entriesSize = p.entries.size();
+        p.entries.insert(p.entries.end(), entries.begin(), entries.end());
+        std::vector<std::string> fileNames;
+        fileNames.reserve(entries.size());
+        for (const auto& entry : entries)
+        {
+            fileNames.push_back(entry.path.filename().u8string());
+        }
+        p.stringSearch.addItems(fileNames);
+
+        // Filter and sort the new entries and merge them with the
+        // entries that have already been listed.
+        const FileBrowserOptions& options = p.model->getOptions();
+        const std::string& extension = p.model->getExtension();
+        const size_t size = p.info.size();
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (filter(
+                entries[i],
+                p.mode,
+                options,
+                extension,
+                p.stringSearch.isMatch(entriesSize + i)))
             {
-                const FileBrowserInfo& info = p.info[i];
-                FileBrowserItem item;
+                p.info.push_back(entries[i]);
+            }
+        }
+        if (p.info.size() == size)
+            return;
+        const auto sort = getSort(options);
+        std::sort(p.info.begin() + size, p.info.end(), sort);
+        std::inplace_merge(p.info.begin(), p.info.begin() + size, p.info.end(), sort);
+
+        // Keep the current item when it moves.
+        p.items = std::vector<FileBrowserItem>(p.info.size());
+        if (!path.empty())
+        {
+            const auto i = std::find_if(
+                p.info.begin(),
+                p.info.end(),
+                [&path](const DirEntry& value)
+                {
+                    return path == value.path;
+                });
+            p.current->setIfChanged(i - p.info.begin());
+        }
+        p.size.width.reset();
 
-                // File name.
-                std::string text = info.path.filename().u8string();
-                item.text.push_back(text);
+        _setSizeUpdate();
+        _setDrawUpdate();
+    }
 
-                // File extension.
-                text = !info.isDir ?
-                    info.path.extension().u8string() :
-                    std::string();
-                item.text.push_back(text);
+    void FileBrowserView::_directoryRefresh()
+    {
+        FEATHER_TK_P();
+        p.dirSystem->cancel(p.scanId);
 
-                // File size.
-                if (!info.isDir)
+        // The directory is listed again without clearing the view, and
+        // the changes are applied when the listing is complete.
+        auto entries = std::make_shared<std::vector<DirEntry> >();
+        p.scanId = p.dirSystem->scan(
+            p.model->getPath(),
+            [this, entries](const std::vector<DirEntry>& value, bool complete)
+            {
+                entries->insert(entries->end(), value.begin(), value.end());
+                if (complete)
                 {
-                    if (info.size < megabyte)
-                    {
-                        text = Format("{0}KB").
-                            arg(info.size / static_cast<float>(kilobyte), 2);
-                    }
-                    else if (info.size < gigabyte)
-                    {
-                        text = Format("{0}MB").
-                            arg(info.size / static_cast<float>(megabyte), 2);
-                    }
-                    else
-                    {
-                        text = Format("{0}GB").
-                            arg(info.size / static_cast<float>(gigabyte), 2);
-                    }
-                    item.text.push_back(text);
+                    _entriesRefresh(*entries);
                 }
+            });
+    }
 
-                // File last modification time.
-                // \todo std::format is available in C++20.
-                //text = std::format("{}", info.time);
+    void FileBrowserView::_entriesRefresh(const std::vector<DirEntry>& entries)
+    {
+        FEATHER_TK_P();
 
-                p.items.push_back(item);
+        // Keep the current item, and the items that have already been
+        // measured if their entries have not changed.
+        std::filesystem::path path;
+        const int current = p.current->get();
+        if (current >= 0 && current < p.info.size())
+        {
+            path = p.info[current].path;
+        }
+        std::map<std::filesystem::path, std::pair<DirEntry, FileBrowserItem> > items;
+        for (size_t i = 0; i < p.info.size() && i < p.items.size(); ++i)
+        {
+            if (p.items[i].init)
+            {
+                items[p.info[i].path] = std::make_pair(p.info[i], std::move(p.items[i]));
+            }
+        }
+
+        p.entries = entries;
+        std::vector<std::string> fileNames;
+        fileNames.reserve(entries.size());
+        for (const auto& entry : entries)
+        {
+            fileNames.push_back(entry.path.filename().u8string());
+        }
+        p.stringSearch.setItems(fileNames);
+
+        const FileBrowserOptions& options = p.model->getOptions();
+        const std::string& extension = p.model->getExtension();
+        p.info.clear();
+        for (size_t i = 0; i < p.entries.size(); ++i)
+        {
+            if (filter(
+                p.entries[i],
+                p.mode,
+                options,
+                extension,
+                p.stringSearch.isMatch(i)))
+            {
+                p.info.push_back(p.entries[i]);
+            }
+        }
+        std::sort(p.info.begin(), p.info.end(), getSort(options));
+        p.items = std::vector<FileBrowserItem>(p.info.size());
+        int index = -1;
+        for (size_t i = 0; i < p.info.size(); ++i)
+        {
+            const auto j = items.find(p.info[i].path);
+            if (j != items.end() && j->second.first == p.info[i])
+            {
+                p.items[i] = std::move(j->second.second);
+            }
+            if (!path.empty() && path == p.info[i].path)
+            {
+                index = static_cast<int>(i);
+            }
+        }
+        p.size.width.reset();
+
+        if (p.current->setIfChanged(index) && -1 == index && p.selectCallback)
+        {
+            p.selectCallback(std::filesystem::path());
+        }
+
+        _setSizeUpdate();
+        _setDrawUpdate();
+    }
+
+    void FileBrowserView::_filterUpdate()
+    {
+        FEATHER_TK_P();
+        const FileBrowserOptions& options = p.model->getOptions();
+        const std::string& extension = p.model->getExtension();
+        p.info.clear();
+        p.stringSearch.search(p.search);
+        for (size_t i = 0; i < p.entries.size(); ++i)
+        {
+            if (filter(
+                p.entries[i],
+                p.mode,
+                options,
+                extension,
+                p.stringSearch.isMatch(i)))
+            {
+                p.info.push_back(p.entries[i]);
             }
         }
+        std::sort(p.info.begin(), p.info.end(), getSort(options));
+        p.items = std::vector<FileBrowserItem>(p.info.size());
+        p.size.width.reset();
 
         p.current->setIfChanged(-1);
         if (p.selectCallback)
@@ -646,7 +929,6 @@ namespace feather_tk
 
         _setSizeUpdate();
         _setDrawUpdate();
-        p.size.displayScale.reset();
     }
 
     void FileBrowserView::_setCurrent(int index)
@@ -676,7 +958,7 @@ namespace feather_tk
         takeKeyFocus();
         if (index >= 0 && index < p.info.size())
         {
-            const FileBrowserInfo info = p.info[index];
+            const DirEntry info = p.info[index];
             switch (p.mode)
             {
             case FileBrowserMode::File:
@@ -5,6 +5,7 @@
 #include <feather-tk/ui/IButton.h>
 
 #include <feather-tk/ui/DrawUtil.h>
+#include <feather-tk/ui/IconSystem.h>
 
 namespace feather_tk
 {
@@ -12,6 +13,8 @@ namespace feather_tk
     {
         bool checkable = false;
         float iconScale = 1.F;
+        IconRequest iconRequest;
+        IconRequest checkedIconRequest;
         bool repeatClick = false;
         bool repeatClickInit = false;
         std::chrono::steady_clock::time_point repeatClickTimer;
@@ -106,6 +109,7 @@ namespace feather_tk
             return;
         _icon = icon;
         _iconImage.reset();
+        p.iconRequest = IconRequest();
         _setSizeUpdate();
         _setDrawUpdate();
     }
@@ -122,6 +126,7 @@ namespace feather_tk
             return;
         _checkedIcon = icon;
         _checkedIconImage.reset();
+        p.checkedIconRequest = IconRequest();
         _setSizeUpdate();
         _setDrawUpdate();
     }
@@ -207,7 +212,21 @@ namespace feather_tk
     {
         IWidget::tickEvent(parentsVisible, parentsEnabled, event);
         FEATHER_TK_P();
-        if (_isMousePressed() && p.repeatClick)
+        bool iconUpdate = takeIcon(p.iconRequest, _iconImage);
+        iconUpdate |= takeIcon(p.checkedIconRequest, _checkedIconImage);
+        if (iconUpdate)
+        {
+            _setSizeUpdate();
+            _setDrawUpdate();
+        }
+        const bool iconRequests =
+            p.iconRequest.isPending() ||
+            p.checkedIconRequest.isPending();
+        if (!_isMousePressed() || !p.repeatClick)
+        {
+            _setTickEvents(iconRequests);
+        }
+        else
         {
             const float duration = p.repeatClickInit ? .4F : .02F;
             const auto now = std::chrono::steady_clock::now();
@@ -230,14 +249,25 @@ namespace feather_tk
             p.iconScale = event.displayScale;
             _iconImage.reset();
             _checkedIconImage.reset();
+            p.iconRequest = IconRequest();
+            p.checkedIconRequest = IconRequest();
         }
-        if (!_icon.empty() && !_iconImage)
-        {
-            _iconImage = event.iconSystem->get(_icon, event.displayScale);
-        }
-        if (!_checkedIcon.empty() && !_checkedIconImage)
+
+        // Cached icons are ready immediately, otherwise the icons are
+        // received in the tick event.
+        bool iconRequests = p.iconRequest.request(
+            event.iconSystem,
+            _icon,
+            event.displayScale,
+            _iconImage);
+        iconRequests |= p.checkedIconRequest.request(
+            event.iconSystem,
+            _checkedIcon,
+            event.displayScale,
+            _checkedIconImage);
+        if (iconRequests)
         {
-            _checkedIconImage = event.iconSystem->get(_checkedIcon, event.displayScale);
+            _setTickEvents(true);
         }
     }
 
@@ -279,12 +309,20 @@ namespace feather_tk
         {
             p.repeatClickInit = true;
             p.repeatClickTimer = std::chrono::steady_clock::now();
+            _setTickEvents(true);
         }
     }
 
     void IButton::mouseReleaseEvent(MouseClickEvent& event)
     {
         IWidget::mouseReleaseEvent(event);
+        FEATHER_TK_P();
+        if (p.repeatClick)
+        {
+            _setTickEvents(
+                p.iconRequest.isPending() ||
+                p.checkedIconRequest.isPending());
+        }
         _setDrawUpdate();
         if (contains(getGeometry(), _getMousePos()))
         {
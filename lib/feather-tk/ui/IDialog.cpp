@@ -29,8 +29,8 @@ namespace feather_tk
         struct DrawData
         {
             Box2I g;
-            TriMesh2F shadow;
-            TriMesh2F border;
+            CompactMesh2F shadow;
+            CompactMesh2F border;
         };
         std::optional<DrawData> draw;
     };
@@ -181,8 +181,8 @@ namespace feather_tk
             else
             {
                 p.draw->g = Box2I();
-                p.draw->shadow = TriMesh2F();
-                p.draw->border = TriMesh2F();
+                p.draw->shadow = CompactMesh2F();
+                p.draw->border = CompactMesh2F();
             }
         }
 
@@ -101,7 +101,7 @@ namespace feather_tk
         struct DrawData
         {
             Box2I g;
-            TriMesh2F shadow;
+            CompactMesh2F shadow;
         };
         std::optional<DrawData> draw;
     };
@@ -22,6 +22,9 @@ namespace feather_tk
         {
             parent->_children.push_back(
                 std::static_pointer_cast<IWidget>(shared_from_this()));
+            _setParentsVisibleEnabled(
+                parent->isVisible(true),
+                parent->isEnabled(true));
 
             ChildAddEvent event(shared_from_this());
             parent->childAddEvent(event);
@@ -81,6 +84,10 @@ namespace feather_tk
             }
             if (i != parent->_children.end())
             {
+                if (_tickEventsCount > 0)
+                {
+                    parent->_addTickEventsCount(-static_cast<int>(_tickEventsCount));
+                }
                 ChildRemoveEvent event(*i, j);
                 parent->_children.erase(i);
                 parent->childRemoveEvent(event);
@@ -93,11 +100,23 @@ namespace feather_tk
         {
             value->_children.push_back(
                 std::static_pointer_cast<IWidget>(shared_from_this()));
+            _setParentUpdates(_updates | _childUpdates);
+            if (_tickEventsCount > 0)
+            {
+                value->_addTickEventsCount(static_cast<int>(_tickEventsCount));
+            }
+            _setParentsVisibleEnabled(
+                value->isVisible(true),
+                value->isEnabled(true));
             ChildAddEvent event(shared_from_this());
             value->childAddEvent(event);
             value->_setSizeUpdate();
             value->_setDrawUpdate();
         }
+        else
+        {
+            _setParentsVisibleEnabled(true, true);
+        }
     }
 
     int IWidget::getChildIndex(const std::shared_ptr<IWidget>& value) const
@@ -274,6 +293,7 @@ namespace feather_tk
             parent->_setSizeUpdate();
             parent->_setDrawUpdate();
         }
+        _setParentsVisibleEnabled(_parentsVisible, _parentsEnabled);
     }
 
     void IWidget::show()
@@ -303,6 +323,7 @@ namespace feather_tk
         }
         _setSizeUpdate();
         _setDrawUpdate();
+        _setParentsVisibleEnabled(_parentsVisible, _parentsEnabled);
     }
 
     void IWidget::setAcceptsKeyFocus(bool value)
@@ -365,6 +386,13 @@ namespace feather_tk
             _releaseMouse();
             releaseKeyFocus();
         }
+        else if (!clipped && clipped != _clipped)
+        {
+            // The window clears the draw update flags of clipped widgets
+            // from the parents, so set them again when the widget is
+            // no longer clipped.
+            _setParentUpdates(_updates & static_cast<int>(Update::Draw));
+        }
         _clipped = clipped;
     }
 
@@ -469,6 +497,14 @@ namespace feather_tk
     void IWidget::dropEvent(DragAndDropEvent&)
     {}
 
+    void IWidget::_setTickEvents(bool value)
+    {
+        if (value == _tickEvents)
+            return;
+        _tickEvents = value;
+        _addTickEventsCount(_tickEvents ? 1 : -1);
+    }
+
     void IWidget::_setMouseHoverEnabled(bool value)
     {
         _mouseHoverEnabled = value;
@@ -494,4 +530,42 @@ namespace feather_tk
             child->_releaseMouse();
         }
     }
+
+    void IWidget::_addTickEventsCount(int value)
+    {
+        _tickEventsCount += value;
+        if (auto parent = _parent.lock())
+        {
+            parent->_addTickEventsCount(value);
+        }
+    }
+
+    void IWidget::_setParentUpdates(int value)
+    {
+        // Stop at the first parent that already has the flags, the
+        // flags are only cleared from the top down so the rest of the
+        // hierarchy above it is already marked.
+        auto parent = _parent.lock();
+        while (parent && (parent->_childUpdates & value) != value)
+        {
+            parent->_childUpdates |= value;
+            parent = parent->_parent.lock();
+        }
+    }
+
+    void IWidget::_setParentsVisibleEnabled(bool visible, bool enabled)
+    {
+        _parentsVisible = visible;
+        _parentsEnabled = enabled;
+        const bool childVisible = visible && _visible;
+        const bool childEnabled = enabled && _enabled;
+        for (const auto& child : _children)
+        {
+            if (child->_parentsVisible != childVisible ||
+                child->_parentsEnabled != childEnabled)
+            {
+                child->_setParentsVisibleEnabled(childVisible, childEnabled);
+            }
+        }
+    }
 }
\ No newline at end of file
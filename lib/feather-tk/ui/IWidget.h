@@ -50,6 +50,12 @@ namespace feather_tk
         //! Get whether updates are needed.
         int getUpdates() const;
 
+        //! Get whether updates are needed by any of the child widgets.
+        //! The flags are propagated up the hierarchy when a widget
+        //! requests an update, so the window only needs to visit the
+        //! branches that changed.
+        int getChildUpdates() const;
+
         //! Hierarchy
         ///@{
 
@@ -211,7 +217,12 @@ namespace feather_tk
         //! Child remove event.
         virtual void childRemoveEvent(const ChildRemoveEvent&);
 
-        //! Tick event.
+        //! Get whether this widget or any of its children have tick
+        //! events enabled.
+        bool hasTickEvents() const;
+
+        //! Tick event. Tick events are only sent to widgets that have
+        //! them enabled, and to their parents.
         virtual void tickEvent(
             bool parentsVisible,
             bool parentsEnabled,
@@ -279,6 +290,11 @@ namespace feather_tk
 
         void _setSizeHint(const Size2I&);
 
+        //! Set whether the widget receives tick events. Widgets that
+        //! animate should only enable tick events while animating, so
+        //! that the application can sleep when it is idle.
+        void _setTickEvents(bool);
+
         void _setMouseHoverEnabled(bool);
         void _setMousePressEnabled(bool, int button = -1, int modifiers = -1);
         virtual void _releaseMouse();
@@ -292,6 +308,7 @@ namespace feather_tk
         std::string _objectName;
         ColorRole _backgroundRole = ColorRole::None;
         int _updates = 0;
+        int _childUpdates = 0;
         std::weak_ptr<IWidget> _parent;
         std::list<std::shared_ptr<IWidget> > _children;
         Size2I _sizeHint;
@@ -300,6 +317,7 @@ namespace feather_tk
         HAlign _hAlign = HAlign::Fill;
         VAlign _vAlign = VAlign::Fill;
         Box2I _geometry;
+        Box2I _drawGeometry = Box2I(0, 0, 0, 0);
         bool _visible = true;
         bool _parentsVisible = true;
         bool _clipped = false;
@@ -316,6 +334,14 @@ namespace feather_tk
         bool _acceptsKeyFocus = false;
         bool _keyFocus = false;
         std::string _tooltip;
+        bool _tickEvents = false;
+        size_t _tickEventsCount = 0;
+
+        void _addTickEventsCount(int);
+        void _setParentUpdates(int);
+        void _setParentsVisibleEnabled(bool visible, bool enabled);
+
+        friend class IWindow;
     };
 }
 
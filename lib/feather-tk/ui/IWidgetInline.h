@@ -24,6 +24,11 @@ namespace feather_tk
         return _updates;
     }
 
+    inline int IWidget::getChildUpdates() const
+    {
+        return _childUpdates;
+    }
+
     inline const std::weak_ptr<IWidget>& IWidget::getParent() const
     {
         return _parent;
@@ -121,14 +126,21 @@ namespace feather_tk
         return _tooltip;
     }
 
+    inline bool IWidget::hasTickEvents() const
+    {
+        return _tickEventsCount > 0;
+    }
+
     inline void IWidget::_setDrawUpdate()
     {
         _updates |= static_cast<int>(Update::Draw);
+        _setParentUpdates(static_cast<int>(Update::Draw));
     }
 
     inline void IWidget::_setSizeUpdate()
     {
         _updates |= static_cast<int>(Update::Size);
+        _setParentUpdates(static_cast<int>(Update::Size));
     }
 
     inline void IWidget::_setSizeHint(const Size2I& value)
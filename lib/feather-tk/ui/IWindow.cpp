@@ -9,8 +9,27 @@
 #include <feather-tk/ui/IPopup.h>
 #include <feather-tk/ui/Tooltip.h>
 
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ProfileSystem.h>
+#include <feather-tk/core/Timer.h>
+
 namespace feather_tk
 {
+    namespace
+    {
+        void addDrawRect(
+            const Box2I& rect,
+            const Box2I& clipRect,
+            std::vector<Box2I>& out)
+        {
+            const Box2I tmp = intersect(rect, clipRect);
+            if (tmp.w() > 0 && tmp.h() > 0)
+            {
+                out.push_back(tmp);
+            }
+        }
+    }
+
     struct IWindow::Private
     {
         bool inside = false;
@@ -36,7 +55,11 @@ namespace feather_tk
         bool tooltipsEnabled = true;
         std::shared_ptr<Tooltip> tooltip;
         V2I tooltipPos;
-        std::chrono::steady_clock::time_point tooltipTimer;
+        std::shared_ptr<Timer> tooltipTimer;
+
+        std::shared_ptr<ProfileSystem> profileSystem;
+        int drawDepth = 0;
+        std::vector<std::string> drawPath;
 
         struct SizeData
         {
@@ -45,6 +68,17 @@ namespace feather_tk
         SizeData size;
     };
 
+    void IWindow::_init(
+        const std::shared_ptr<Context>& context,
+        const std::string& objectName,
+        const std::shared_ptr<IWidget>& parent)
+    {
+        IWidget::_init(context, objectName, parent);
+        FEATHER_TK_P();
+        p.tooltipTimer = Timer::create(context);
+        p.profileSystem = context->getSystem<ProfileSystem>();
+    }
+
     IWindow::IWindow() :
         _p(new Private)
     {
@@ -237,37 +271,6 @@ namespace feather_tk
                 MouseMoveEvent mouseMoveEvent(p.cursorPos, p.cursorPos);
                 _hoverUpdate(mouseMoveEvent);
             }
-
-            if (p.tooltipsEnabled)
-            {
-                const auto tooltipTime = std::chrono::steady_clock::now();
-                const auto tooltipDiff = std::chrono::duration_cast<std::chrono::milliseconds>(tooltipTime - p.tooltipTimer);
-                if (tooltipDiff > tooltipTimeout && !p.tooltip && !p.mousePress.lock())
-                {
-                    if (auto context = getContext())
-                    {
-                        std::string text;
-                        const auto widgets = _getUnderCursor(UnderCursor::Tooltip, p.cursorPos);
-                        for (const auto& widget : widgets)
-                        {
-                            text = widget->getTooltip();
-                            if (!text.empty())
-                            {
-                                break;
-                            }
-                        }
-                        if (!text.empty())
-                        {
-                            p.tooltip = Tooltip::create(
-                                context,
-                                text,
-                                p.cursorPos,
-                                shared_from_this());
-                            p.tooltipPos = p.cursorPos;
-                        }
-                    }
-                }
-            }
         }
     }
 
@@ -297,66 +300,147 @@ namespace feather_tk
 
     bool IWindow::_hasSizeUpdate(const std::shared_ptr<IWidget>& widget) const
     {
-        bool out = widget->getUpdates() & static_cast<int>(Update::Size);
-        if (out)
-        {
-            //std::cout << "Size update: " << widget->getObjectName() << std::endl;
-        }
-        else
-        {
+        return (widget->_updates | widget->_childUpdates) &
+            static_cast<int>(Update::Size);
+    }
+
+    bool IWindow::_sizeHintEventRecursive(
+        const std::shared_ptr<IWidget>& widget,
+        const SizeHintEvent& event,
+        bool all)
+    {
+        // Only visit the children that need a size update, and only call
+        // the size hint event for this widget if it needs an update or
+        // one of the child size hints changed.
+        const int size = static_cast<int>(Update::Size);
+        bool childrenChanged = false;
+        if (all || (widget->_childUpdates & size))
+        {
+            widget->_childUpdates &= ~size;
             for (const auto& child : widget->getChildren())
             {
-                out |= _hasSizeUpdate(child);
+                if (all || ((child->_updates | child->_childUpdates) & size))
+                {
+                    childrenChanged |= _sizeHintEventRecursive(child, event, all);
+                }
             }
         }
+        bool out = false;
+        if (all || childrenChanged || (widget->_updates & size))
+        {
+            const Size2I sizeHint = widget->getSizeHint();
+            widget->sizeHintEvent(event);
+            out = widget->getSizeHint() != sizeHint;
+        }
         return out;
     }
 
-    void IWindow::_sizeHintEventRecursive(
-        const std::shared_ptr<IWidget>& widget,
-        const SizeHintEvent& event)
+    bool IWindow::_hasDrawUpdate(const std::shared_ptr<IWidget>& widget) const
     {
-        for (const auto& child : widget->getChildren())
-        {
-            _sizeHintEventRecursive(child, event);
-        }
-        widget->sizeHintEvent(event);
+        return !widget->isClipped() &&
+            ((widget->_updates | widget->_childUpdates) & static_cast<int>(Update::Draw));
     }
 
-    bool IWindow::_hasDrawUpdate(const std::shared_ptr<IWidget>& widget) const
+    void IWindow::_getDrawRects(
+        const std::shared_ptr<IWidget>& widget,
+        const Box2I& clipRect,
+        std::vector<Box2I>& out)
     {
-        bool out = false;
-        if (!widget->isClipped())
+        const int draw = static_cast<int>(Update::Draw);
+        const Box2I& g = widget->getGeometry();
+        if (!widget->isClipped() && g.w() > 0 && g.h() > 0)
         {
-            out = widget->getUpdates() & static_cast<int>(Update::Draw);
-            if (out)
+            if (widget->_updates & draw)
             {
-                //std::cout << "Draw update: " << widget->getObjectName() << std::endl;
+                // The previous geometry is also redrawn so that widgets
+                // that moved or shrank do not leave stale pixels. The
+                // children are drawn with the widget, so they do not need
+                // to be checked.
+                addDrawRect(widget->_drawGeometry, clipRect, out);
+                addDrawRect(g, clipRect, out);
+                _clearChildUpdates(widget, draw);
             }
-            else
+            else if (widget->_childUpdates & draw)
             {
+                widget->_childUpdates &= ~draw;
+                const Box2I childrenClipRect = intersect(
+                    widget->getChildrenClipRect(),
+                    clipRect);
                 for (const auto& child : widget->getChildren())
                 {
-                    out |= _hasDrawUpdate(child);
+                    if ((child->_updates | child->_childUpdates) & draw)
+                    {
+                        _getDrawRects(child, childrenClipRect, out);
+                    }
                 }
             }
         }
-        return out;
+        else
+        {
+            // Redraw where a hidden or clipped widget was last drawn.
+            if (widget->_updates & draw)
+            {
+                addDrawRect(widget->_drawGeometry, clipRect, out);
+                widget->_drawGeometry = Box2I(0, 0, 0, 0);
+            }
+            _clearChildUpdates(widget, draw);
+        }
+    }
+
+    void IWindow::_clearChildUpdates(
+        const std::shared_ptr<IWidget>& widget,
+        int value)
+    {
+        if (widget->_childUpdates & value)
+        {
+            widget->_childUpdates &= ~value;
+            for (const auto& child : widget->getChildren())
+            {
+                _clearChildUpdates(child, value);
+            }
+        }
     }
 
     void IWindow::_drawEventRecursive(
         const std::shared_ptr<IWidget>& widget,
         const Box2I& drawRect,
-        const DrawEvent& event)
+        const DrawEvent& event,
+        size_t index)
     {
+        FEATHER_TK_P();
         const Box2I& g = widget->getGeometry();
         if (!widget->isClipped() && g.w() > 0 && g.h() > 0)
         {
+            // Time the widgets near the top of the hierarchy, so that the
+            // draw time can be attributed to each sub-tree.
+            const bool profile =
+                p.profileSystem &&
+                p.profileSystem->isEnabled() &&
+                p.drawDepth < p.profileSystem->getWidgetDepth();
+            if (profile)
+            {
+                // Name the events with the path of the widget, so that
+                // siblings with the same name are kept separate.
+                std::string name = widget->getObjectName();
+                if (!p.drawPath.empty())
+                {
+                    name = Format("{0}/{1}[{2}]").
+                        arg(p.drawPath.back()).
+                        arg(name).
+                        arg(index);
+                }
+                p.drawPath.push_back(name);
+                p.profileSystem->beginEvent(name);
+            }
+            ++p.drawDepth;
+
             event.render->setClipRect(drawRect);
             widget->drawEvent(drawRect, event);
+            widget->_drawGeometry = g;
             const Box2I childrenClipRect = intersect(
                 widget->getChildrenClipRect(),
                 drawRect);
+            size_t childIndex = 0;
             for (const auto& child : widget->getChildren())
             {
                 const Box2I& childGeometry = child->getGeometry();
@@ -365,11 +449,20 @@ namespace feather_tk
                     _drawEventRecursive(
                         child,
                         intersect(childGeometry, childrenClipRect),
-                        event);
+                        event,
+                        childIndex);
                 }
+                ++childIndex;
             }
             event.render->setClipRect(drawRect);
             widget->drawOverlayEvent(drawRect, event);
+
+            --p.drawDepth;
+            if (profile)
+            {
+                p.profileSystem->endEvent();
+                p.drawPath.pop_back();
+            }
         }
     }
 
@@ -462,7 +555,11 @@ namespace feather_tk
     {
         FEATHER_TK_P();
         p.inside = enter;
-        if (!p.inside)
+        if (p.inside)
+        {
+            _closeTooltip();
+        }
+        else
         {
             if (auto hover = p.hover.lock())
             {
@@ -559,6 +656,10 @@ namespace feather_tk
         {
             _closeTooltip();
         }
+        else if (!p.tooltip && !p.tooltipTimer->isActive())
+        {
+            _tooltipUpdate();
+        }
     }
 
     void IWindow::_mouseButton(int button, bool press, int modifiers)
@@ -760,7 +861,45 @@ namespace feather_tk
             p.tooltip->close();
             p.tooltip.reset();
         }
-        p.tooltipTimer = std::chrono::steady_clock::now();
         p.tooltipPos = p.cursorPos;
+        if (p.tooltipTimer)
+        {
+            p.tooltipTimer->start(
+                tooltipTimeout,
+                [this]
+                {
+                    _tooltipUpdate();
+                });
+        }
+    }
+
+    void IWindow::_tooltipUpdate()
+    {
+        FEATHER_TK_P();
+        if (p.inside && p.tooltipsEnabled && !p.tooltip && !p.mousePress.lock())
+        {
+            if (auto context = getContext())
+            {
+                std::string text;
+                const auto widgets = _getUnderCursor(UnderCursor::Tooltip, p.cursorPos);
+                for (const auto& widget : widgets)
+                {
+                    text = widget->getTooltip();
+                    if (!text.empty())
+                    {
+                        break;
+                    }
+                }
+                if (!text.empty())
+                {
+                    p.tooltip = Tooltip::create(
+                        context,
+                        text,
+                        p.cursorPos,
+                        shared_from_this());
+                    p.tooltipPos = p.cursorPos;
+                }
+            }
+        }
     }
 }
\ No newline at end of file
@@ -14,6 +14,11 @@ namespace feather_tk
     class IWindow : public IWidget
     {
     protected:
+        void _init(
+            const std::shared_ptr<Context>&,
+            const std::string& objectName,
+            const std::shared_ptr<IWidget>& parent);
+
         IWindow();
 
     public:
@@ -67,15 +72,32 @@ namespace feather_tk
 
     protected:
         bool _hasSizeUpdate(const std::shared_ptr<IWidget>&) const;
-        void _sizeHintEventRecursive(
+
+        //! Send size hint events to the widgets that need a size update.
+        //! If "all" is true the event is sent to every widget, for example
+        //! when the display scale or style changes. Returns whether the
+        //! size hint of the widget changed.
+        bool _sizeHintEventRecursive(
             const std::shared_ptr<IWidget>&,
-            const SizeHintEvent&);
+            const SizeHintEvent&,
+            bool all = false);
 
         bool _hasDrawUpdate(const std::shared_ptr<IWidget>&) const;
+
+        //! Get the regions that need to be redrawn. This also clears the
+        //! child draw update flags.
+        void _getDrawRects(
+            const std::shared_ptr<IWidget>&,
+            const Box2I&,
+            std::vector<Box2I>&);
+
+        //! Draw the widget and its children. The index of the widget among
+        //! its siblings is used to name the profile events.
         void _drawEventRecursive(
             const std::shared_ptr<IWidget>&,
             const Box2I&,
-            const DrawEvent&);
+            const DrawEvent&,
+            size_t index = 0);
 
         bool _key(Key, bool press, int modifiers);
         void _text(const std::string&);
@@ -108,11 +130,14 @@ namespace feather_tk
 
         void _hoverUpdate(MouseMoveEvent&);
 
+        void _clearChildUpdates(const std::shared_ptr<IWidget>&, int);
+
         void _getKeyFocus(
             const std::shared_ptr<IWidget>&,
             std::list<std::shared_ptr<IWidget> >&);
 
         void _closeTooltip();
+        void _tooltipUpdate();
 
         FEATHER_TK_PRIVATE();
     };
@@ -4,6 +4,7 @@
 
 #include <feather-tk/ui/Icon.h>
 
+#include <feather-tk/ui/IconSystem.h>
 #include <feather-tk/ui/LayoutUtil.h>
 
 #include <feather-tk/core/String.h>
@@ -17,6 +18,7 @@ namespace feather_tk
         std::string icon;
         float iconScale = 1.F;
         std::shared_ptr<Image> iconImage;
+        IconRequest iconRequest;
         SizeRole marginRole = SizeRole::None;
 
         struct SizeData
@@ -74,6 +76,7 @@ namespace feather_tk
             return;
         p.icon = value;
         p.iconImage.reset();
+        p.iconRequest = IconRequest();
         _setSizeUpdate();
         _setDrawUpdate();
     }
@@ -93,6 +96,24 @@ namespace feather_tk
         _setDrawUpdate();
     }
 
+    void Icon::tickEvent(
+        bool parentsVisible,
+        bool parentsEnabled,
+        const TickEvent& event)
+    {
+        IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+        FEATHER_TK_P();
+        if (takeIcon(p.iconRequest, p.iconImage))
+        {
+            _setSizeUpdate();
+            _setDrawUpdate();
+        }
+        if (!p.iconRequest.isPending())
+        {
+            _setTickEvents(false);
+        }
+    }
+
     void Icon::sizeHintEvent(const SizeHintEvent& event)
     {
         IWidget::sizeHintEvent(event);
@@ -109,10 +130,14 @@ namespace feather_tk
         {
             p.iconScale = event.displayScale;
             p.iconImage.reset();
+            p.iconRequest = IconRequest();
         }
-        if (!p.icon.empty() && !p.iconImage)
+
+        // Cached icons are ready immediately, otherwise the icon is
+        // received in the tick event.
+        if (p.iconRequest.request(event.iconSystem, p.icon, event.displayScale, p.iconImage))
         {
-            p.iconImage = event.iconSystem->get(p.icon, event.displayScale);
+            _setTickEvents(true);
         }
 
         Size2I sizeHint;
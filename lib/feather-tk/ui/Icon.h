@@ -47,6 +47,10 @@ namespace feather_tk
         //! Set the margin role.
         void setMarginRole(SizeRole);
 
+        void tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const TickEvent&) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void drawEvent(const Box2I&, const DrawEvent&) override;
 
@@ -7,13 +7,17 @@
 #include <feather-tk/core/ImageIO.h>
 
 #include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Context.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/LRUCache.h>
+#include <feather-tk/core/Memory.h>
 
 #include <lunasvg/lunasvg.h>
 
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -81,14 +85,81 @@ namespace feather_tk
 {
     namespace
     {
-        const size_t requestCount = 1;
+        const size_t threadCountMax = 4;
+        
+        //! Convert lunasvg's premultiplied ARGB, stored as native endian
+        //! 32-bit words, to RGBA bytes and flip the image vertically. The
+        //! pixels are processed as 32-bit words so the loop can be
+        //! vectorized by the compiler.
+        void convertBitmap(
+            const uint8_t* bitmapData,
+            int bitmapStride,
+            int w,
+            int h,
+            uint8_t* imageData)
+        {
+            const bool lsb = Endian::LSB == getEndian();
+            for (int y = 0; y < h; ++y)
+            {
+                const uint8_t* bitmapP = bitmapData + (h - 1 - y) * bitmapStride;
+                uint8_t* imageP = imageData + y * w * 4;
+                for (int x = 0; x < w; ++x, bitmapP += 4, imageP += 4)
+                {
+                    uint32_t v = 0;
+                    std::memcpy(&v, bitmapP, 4);
+                    v = lsb ?
+                        ((v & 0xff00ff00) | ((v >> 16) & 0xff) | ((v & 0xff) << 16)) :
+                        ((v << 8) | (v >> 24));
+                    std::memcpy(imageP, &v, 4);
+                }
+            }
+        }
+    }
+
+    bool IconRequest::isPending() const
+    {
+        return future.valid();
+    }
+
+    bool IconRequest::request(
+        const std::shared_ptr<IconSystem>& iconSystem,
+        const std::string& name,
+        float displayScale,
+        std::shared_ptr<Image>& image)
+    {
+        if (!name.empty() && !image && !future.valid())
+        {
+            *this = iconSystem->request(name, displayScale, true);
+            takeIcon(*this, image);
+        }
+        return future.valid();
+    }
+
+    bool takeIcon(IconRequest& request, std::shared_ptr<Image>& image)
+    {
+        bool out = false;
+        if (request.future.valid() &&
+            request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            try
+            {
+                image = request.future.get();
+            }
+            catch (const std::exception&)
+            {
+                // Canceled requests are not fulfilled.
+                image.reset();
+            }
+            request = IconRequest();
+            out = true;
+        }
+        return out;
     }
 
     struct IconSystem::Private
     {
         std::weak_ptr<Context> context;
-
-        std::map<std::string, std::vector<uint8_t> > iconData;
+        std::function<void()> contextWake;
 
         uint64_t id = 0;
 
@@ -99,14 +170,32 @@ namespace feather_tk
             float displayScale = 1.F;
             std::promise<std::shared_ptr<Image> > promise;
         };
-        const size_t requestTimeout = 5;
 
         typedef std::pair<std::string, float> CacheKey;
+        struct CacheKeyHash
+        {
+            std::size_t operator() (const CacheKey& value) const noexcept
+            {
+                std::size_t out = 0;
+                hashCombine(out, value.first);
+                hashCombine(out, value.second);
+                return out;
+            }
+        };
+
+        struct Document
+        {
+            std::unique_ptr<lunasvg::Document> doc;
+            std::mutex mutex;
+        };
 
         struct Mutex
         {
+            std::map<std::string, std::vector<uint8_t> > iconData;
+            std::map<std::string, std::shared_ptr<Document> > documents;
+            std::list<std::shared_ptr<Request> > priorityRequests;
             std::list<std::shared_ptr<Request> > requests;
-            LRUCache<CacheKey, std::shared_ptr<Image> > cache;
+            LRUCache<CacheKey, std::shared_ptr<Image>, CacheKeyHash> cache;
             bool stopped = false;
             std::mutex mutex;
         };
@@ -115,172 +204,99 @@ namespace feather_tk
         struct Thread
         {
             std::condition_variable cv;
-            std::thread thread;
+            std::vector<std::thread> threads;
             std::atomic<bool> running;
         };
         Thread thread;
 
-        void _cancelRequests();
+        void run();
+        std::shared_ptr<Image> render(const std::string&, float displayScale);
+        std::shared_ptr<Document> getDocument(const std::string&);
+        void cancelRequests();
     };
 
-    void IconSystem::_init(const std::shared_ptr<Context>& context)
+    void IconSystem::_init(
+        const std::shared_ptr<Context>& context,
+        size_t threadCount)
     {
         FEATHER_TK_P();
         p.context = context;
+        p.contextWake = context->getWakeFunc();
 
-        p.iconData["ArrowDown"] = feather_tk_resource::ArrowDown;
-        p.iconData["ArrowLeft"] = feather_tk_resource::ArrowLeft;
-        p.iconData["ArrowRight"] = feather_tk_resource::ArrowRight;
-        p.iconData["ArrowUp"] = feather_tk_resource::ArrowUp;
-        p.iconData["Audio"] = feather_tk_resource::Audio;
-        p.iconData["BellowsClosed"] = feather_tk_resource::BellowsClosed;
-        p.iconData["BellowsOpen"] = feather_tk_resource::BellowsOpen;
-        p.iconData["Clear"] = feather_tk_resource::Clear;
-        p.iconData["Close"] = feather_tk_resource::Close;
-        p.iconData["Copy"] = feather_tk_resource::Copy;
-        p.iconData["Decrement"] = feather_tk_resource::Decrement;
-        p.iconData["Directory"] = feather_tk_resource::Directory;
-        p.iconData["DirectoryBack"] = feather_tk_resource::DirectoryBack;
-        p.iconData["DirectoryForward"] = feather_tk_resource::DirectoryForward;
-        p.iconData["DirectoryUp"] = feather_tk_resource::DirectoryUp;
-        p.iconData["Edit"] = feather_tk_resource::Edit;
-        p.iconData["Empty"] = feather_tk_resource::Empty;
-        p.iconData["File"] = feather_tk_resource::File;
-        p.iconData["FileBrowser"] = feather_tk_resource::FileBrowser;
-        p.iconData["FileClose"] = feather_tk_resource::FileClose;
-        p.iconData["FileCloseAll"] = feather_tk_resource::FileCloseAll;
-        p.iconData["FileOpen"] = feather_tk_resource::FileOpen;
-        p.iconData["FileReload"] = feather_tk_resource::FileReload;
-        p.iconData["FrameEnd"] = feather_tk_resource::FrameEnd;
-        p.iconData["FrameInOut"] = feather_tk_resource::FrameInOut;
-        p.iconData["FrameNext"] = feather_tk_resource::FrameNext;
-        p.iconData["FramePrev"] = feather_tk_resource::FramePrev;
-        p.iconData["FrameStart"] = feather_tk_resource::FrameStart;
-        p.iconData["Increment"] = feather_tk_resource::Increment;
-        p.iconData["MenuArrow"] = feather_tk_resource::MenuArrow;
-        p.iconData["MenuChecked"] = feather_tk_resource::MenuChecked;
-        p.iconData["Mute"] = feather_tk_resource::Mute;
-        p.iconData["Next"] = feather_tk_resource::Next;
-        p.iconData["PanelBottom"] = feather_tk_resource::PanelBottom;
-        p.iconData["PanelLeft"] = feather_tk_resource::PanelLeft;
-        p.iconData["PanelRight"] = feather_tk_resource::PanelRight;
-        p.iconData["PanelTop"] = feather_tk_resource::PanelTop;
-        p.iconData["PlaybackForward"] = feather_tk_resource::PlaybackForward;
-        p.iconData["PlaybackReverse"] = feather_tk_resource::PlaybackReverse;
-        p.iconData["PlaybackStop"] = feather_tk_resource::PlaybackStop;
-        p.iconData["Prev"] = feather_tk_resource::Prev;
-        p.iconData["Reload"] = feather_tk_resource::Reload;
-        p.iconData["Reset"] = feather_tk_resource::Reset;
-        p.iconData["ReverseSort"] = feather_tk_resource::ReverseSort;
-        p.iconData["Search"] = feather_tk_resource::Search;
-        p.iconData["Settings"] = feather_tk_resource::Settings;
-        p.iconData["SubMenuArrow"] = feather_tk_resource::SubMenuArrow;
-        p.iconData["TimeEnd"] = feather_tk_resource::TimeEnd;
-        p.iconData["TimeStart"] = feather_tk_resource::TimeStart;
-        p.iconData["ViewFrame"] = feather_tk_resource::ViewFrame;
-        p.iconData["ViewZoomIn"] = feather_tk_resource::ViewZoomIn;
-        p.iconData["ViewZoomOut"] = feather_tk_resource::ViewZoomOut;
-        p.iconData["ViewZoomReset"] = feather_tk_resource::ViewZoomReset;
-        p.iconData["Volume"] = feather_tk_resource::Volume;
-        p.iconData["WindowFullScreen"] = feather_tk_resource::WindowFullScreen;
+        p.mutex.iconData["ArrowDown"] = feather_tk_resource::ArrowDown;
+        p.mutex.iconData["ArrowLeft"] = feather_tk_resource::ArrowLeft;
+        p.mutex.iconData["ArrowRight"] = feather_tk_resource::ArrowRight;
+        p.mutex.iconData["ArrowUp"] = feather_tk_resource::ArrowUp;
+        p.mutex.iconData["Audio"] = feather_tk_resource::Audio;
+        p.mutex.iconData["BellowsClosed"] = feather_tk_resource::BellowsClosed;
+        p.mutex.iconData["BellowsOpen"] = feather_tk_resource::BellowsOpen;
+        p.mutex.iconData["Clear"] = feather_tk_resource::Clear;
+        p.mutex.iconData["Close"] = feather_tk_resource::Close;
+        p.mutex.iconData["Copy"] = feather_tk_resource::Copy;
+        p.mutex.iconData["Decrement"] = feather_tk_resource::Decrement;
+        p.mutex.iconData["Directory"] = feather_tk_resource::Directory;
+        p.mutex.iconData["DirectoryBack"] = feather_tk_resource::DirectoryBack;
+        p.mutex.iconData["DirectoryForward"] = feather_tk_resource::DirectoryForward;
+        p.mutex.iconData["DirectoryUp"] = feather_tk_resource::DirectoryUp;
+        p.mutex.iconData["Edit"] = feather_tk_resource::Edit;
+        p.mutex.iconData["Empty"] = feather_tk_resource::Empty;
+        p.mutex.iconData["File"] = feather_tk_resource::File;
+        p.mutex.iconData["FileBrowser"] = feather_tk_resource::FileBrowser;
+        p.mutex.iconData["FileClose"] = feather_tk_resource::FileClose;
+        p.mutex.iconData["FileCloseAll"] = feather_tk_resource::FileCloseAll;
+        p.mutex.iconData["FileOpen"] = feather_tk_resource::FileOpen;
+        p.mutex.iconData["FileReload"] = feather_tk_resource::FileReload;
+        p.mutex.iconData["FrameEnd"] = feather_tk_resource::FrameEnd;
+        p.mutex.iconData["FrameInOut"] = feather_tk_resource::FrameInOut;
+        p.mutex.iconData["FrameNext"] = feather_tk_resource::FrameNext;
+        p.mutex.iconData["FramePrev"] = feather_tk_resource::FramePrev;
+        p.mutex.iconData["FrameStart"] = feather_tk_resource::FrameStart;
+        p.mutex.iconData["Increment"] = feather_tk_resource::Increment;
+        p.mutex.iconData["MenuArrow"] = feather_tk_resource::MenuArrow;
+        p.mutex.iconData["MenuChecked"] = feather_tk_resource::MenuChecked;
+        p.mutex.iconData["Mute"] = feather_tk_resource::Mute;
+        p.mutex.iconData["Next"] = feather_tk_resource::Next;
+        p.mutex.iconData["PanelBottom"] = feather_tk_resource::PanelBottom;
+        p.mutex.iconData["PanelLeft"] = feather_tk_resource::PanelLeft;
+        p.mutex.iconData["PanelRight"] = feather_tk_resource::PanelRight;
+        p.mutex.iconData["PanelTop"] = feather_tk_resource::PanelTop;
+        p.mutex.iconData["PlaybackForward"] = feather_tk_resource::PlaybackForward;
+        p.mutex.iconData["PlaybackReverse"] = feather_tk_resource::PlaybackReverse;
+        p.mutex.iconData["PlaybackStop"] = feather_tk_resource::PlaybackStop;
+        p.mutex.iconData["Prev"] = feather_tk_resource::Prev;
+        p.mutex.iconData["Reload"] = feather_tk_resource::Reload;
+        p.mutex.iconData["Reset"] = feather_tk_resource::Reset;
+        p.mutex.iconData["ReverseSort"] = feather_tk_resource::ReverseSort;
+        p.mutex.iconData["Search"] = feather_tk_resource::Search;
+        p.mutex.iconData["Settings"] = feather_tk_resource::Settings;
+        p.mutex.iconData["SubMenuArrow"] = feather_tk_resource::SubMenuArrow;
+        p.mutex.iconData["TimeEnd"] = feather_tk_resource::TimeEnd;
+        p.mutex.iconData["TimeStart"] = feather_tk_resource::TimeStart;
+        p.mutex.iconData["ViewFrame"] = feather_tk_resource::ViewFrame;
+        p.mutex.iconData["ViewZoomIn"] = feather_tk_resource::ViewZoomIn;
+        p.mutex.iconData["ViewZoomOut"] = feather_tk_resource::ViewZoomOut;
+        p.mutex.iconData["ViewZoomReset"] = feather_tk_resource::ViewZoomReset;
+        p.mutex.iconData["Volume"] = feather_tk_resource::Volume;
+        p.mutex.iconData["WindowFullScreen"] = feather_tk_resource::WindowFullScreen;
 
         p.mutex.cache.setMax(1000);
+        if (0 == threadCount)
+        {
+            threadCount = std::max(
+                static_cast<size_t>(1),
+                std::min(
+                    static_cast<size_t>(std::thread::hardware_concurrency()),
+                    threadCountMax));
+        }
         p.thread.running = true;
-        p.thread.thread = std::thread(
-            [this]
-            {
-                FEATHER_TK_P();
-                while (p.thread.running)
-                {
-                    std::list<std::shared_ptr<Private::Request> > requests;
-                    {
-                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                        if (p.thread.cv.wait_for(
-                            lock,
-                            std::chrono::milliseconds(p.requestTimeout),
-                            [this]
-                            {
-                                return !_p->mutex.requests.empty();
-                            }))
-                        {
-                            for (
-                                size_t i = 0;
-                                i < requestCount && !p.mutex.requests.empty();
-                                ++i)
-                            {
-                                requests.push_back(p.mutex.requests.front());
-                                p.mutex.requests.pop_front();
-                            }
-                        }
-                    }
-
-                    for (const auto& request : requests)
-                    {
-                        //std::cout << "icon request: " << request->name << " " << request->displayScale << std::endl;
-                        std::shared_ptr<Image> image;
-                        bool cached = false;
-                        {
-                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                            cached = p.mutex.cache.get(
-                                std::make_pair(request->name, request->displayScale),
-                                image);
-                        }
-                        if (!cached)
-                        {
-                            std::vector<uint8_t> resource;
-                            if (resource.empty())
-                            {
-                                const auto i = p.iconData.find(request->name);
-                                if (i != p.iconData.end())
-                                {
-                                    resource = i->second;
-                                }
-                            }
-                            if (!resource.empty())
-                            {
-                                if (auto context = p.context.lock())
-                                {
-                                    const std::string s(resource.begin(), resource.end());
-                                    if (auto doc = lunasvg::Document::loadFromData(s))
-                                    {
-                                        const int w = doc->width() * request->displayScale;
-                                        const int h = doc->height() * request->displayScale;
-                                        auto bitmap = doc->renderToBitmap(w, h, 0x00000000);
-                                        if (!bitmap.isNull())
-                                        {
-                                            image = Image::create(w, h, ImageType::RGBA_U8);
-                                            for (int y = 0; y < h; ++y)
-                                            {
-                                                uint8_t* imageP = image->getData() + y * w * 4;
-                                                const uint8_t* bitmapP = bitmap.data() + (h - 1 - y) * w * 4;
-                                                for (int x = 0; x < w; ++x, imageP += 4, bitmapP += 4)
-                                                {
-                                                    imageP[0] = bitmapP[2];
-                                                    imageP[1] = bitmapP[1];
-                                                    imageP[2] = bitmapP[0];
-                                                    imageP[3] = bitmapP[3];
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        request->promise.set_value(image);
-                        {
-                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                            p.mutex.cache.add(
-                                std::make_pair(request->name, request->displayScale),
-                                image);
-                        }
-                    }
-                }
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            p.thread.threads.push_back(std::thread(
+                [this]
                 {
-                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                    p.mutex.stopped = true;
-                }
-                p._cancelRequests();
-            });
+                    _p->run();
+                }));
+        }
     }
 
     IconSystem::IconSystem(const std::shared_ptr<Context>& context) :
@@ -291,26 +307,42 @@ namespace feather_tk
     IconSystem::~IconSystem()
     {
         FEATHER_TK_P();
-        p.thread.running = false;
-        if (p.thread.thread.joinable())
         {
-            p.thread.thread.join();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.thread.running = false;
+            p.mutex.stopped = true;
         }
+        p.thread.cv.notify_all();
+        for (auto& thread : p.thread.threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        p.cancelRequests();
     }
 
     std::shared_ptr<IconSystem> IconSystem::create(
-        const std::shared_ptr<Context>& context)
+        const std::shared_ptr<Context>& context,
+        size_t threadCount)
     {
         auto out = std::shared_ptr<IconSystem>(new IconSystem(context));
-        out->_init(context);
+        out->_init(context, threadCount);
         return out;
     }
 
+    size_t IconSystem::getThreadCount() const
+    {
+        return _p->thread.threads.size();
+    }
+
     std::vector<std::string> IconSystem::getNames() const
     {
         FEATHER_TK_P();
         std::vector<std::string> out;
-        for (const auto& i : p.iconData)
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        for (const auto& i : p.mutex.iconData)
         {
             out.push_back(i.first);
         }
@@ -320,76 +352,120 @@ namespace feather_tk
     void IconSystem::add(const std::string& name, const std::vector<uint8_t>& svg)
     {
         FEATHER_TK_P();
-        p.iconData[name] = svg;
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        p.mutex.iconData[name] = svg;
+        p.mutex.documents.erase(name);
+        for (const auto& key : p.mutex.cache.getKeys())
+        {
+            if (key.first == name)
+            {
+                p.mutex.cache.remove(key);
+            }
+        }
     }
 
     std::shared_ptr<Image> IconSystem::get(
         const std::string& name,
         float displayScale)
     {
-        return request(name, displayScale).future.get();
+        return request(name, displayScale, true).future.get();
     }
 
     IconRequest IconSystem::request(
         const std::string& name,
-        float displayScale)
+        float displayScale,
+        bool priority)
     {
         FEATHER_TK_P();
         IconRequest out;
-        out.id = p.id++;
         auto request = std::make_shared<Private::Request>();
-        request->id = out.id;
         request->name = name;
         request->displayScale = displayScale;
         out.future = request->promise.get_future();
         std::shared_ptr<Image> image;
         bool cached = false;
+        bool valid = false;
         {
             std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            out.id = p.id++;
+            request->id = out.id;
             cached = p.mutex.cache.get(
                 std::make_pair(name, displayScale),
                 image);
+            if (!cached && !p.mutex.stopped)
+            {
+                valid = true;
+                if (priority)
+                {
+                    p.mutex.priorityRequests.push_back(request);
+                }
+                else
+                {
+                    p.mutex.requests.push_back(request);
+                }
+            }
         }
         if (cached)
         {
             request->promise.set_value(image);
         }
+        else if (valid)
+        {
+            p.thread.cv.notify_one();
+        }
         else
         {
-            bool valid = false;
+            request->promise.set_value(nullptr);
+        }
+        return out;
+    }
+
+    void IconSystem::preload(
+        const std::vector<std::string>& names,
+        const std::vector<float>& displayScales)
+    {
+        FEATHER_TK_P();
+        bool valid = false;
+        {
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            if (!p.mutex.stopped)
             {
-                std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                if (!p.mutex.stopped)
+                for (const auto& name : names)
                 {
-                    valid = true;
-                    p.mutex.requests.push_back(request);
+                    for (const float displayScale : displayScales)
+                    {
+                        if (!p.mutex.cache.contains(std::make_pair(name, displayScale)))
+                        {
+                            auto request = std::make_shared<Private::Request>();
+                            request->id = p.id++;
+                            request->name = name;
+                            request->displayScale = displayScale;
+                            p.mutex.requests.push_back(request);
+                            valid = true;
+                        }
+                    }
                 }
             }
-            if (valid)
-            {
-                p.thread.cv.notify_one();
-            }
-            else
-            {
-                request->promise.set_value(nullptr);
-            }
         }
-        return out;
+        if (valid)
+        {
+            p.thread.cv.notify_all();
+        }
     }
 
     void IconSystem::cancelRequests(const std::vector<uint64_t>& ids)
     {
         FEATHER_TK_P();
-        std::list<std::shared_ptr<Private::Request> > requests;
+        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+        for (auto requests : { &p.mutex.priorityRequests, &p.mutex.requests })
         {
-            std::unique_lock<std::mutex> lock(p.mutex.mutex);
-            auto i = p.mutex.requests.begin();
-            while (i != p.mutex.requests.end())
+            auto i = requests->begin();
+            while (i != requests->end())
             {
                 const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
                 if (j != ids.end())
                 {
-                    i = p.mutex.requests.erase(i);
+                    i = requests->erase(i);
                 }
                 else
                 {
@@ -399,16 +475,125 @@ namespace feather_tk
         }
     }
 
-    void IconSystem::Private::_cancelRequests()
+    void IconSystem::Private::run()
+    {
+        while (thread.running)
+        {
+            std::shared_ptr<Request> request;
+            std::shared_ptr<Image> image;
+            bool cached = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                thread.cv.wait(
+                    lock,
+                    [this]
+                    {
+                        return
+                            !mutex.priorityRequests.empty() ||
+                            !mutex.requests.empty() ||
+                            !thread.running;
+                    });
+                auto& requests = !mutex.priorityRequests.empty() ?
+                    mutex.priorityRequests :
+                    mutex.requests;
+                if (!requests.empty())
+                {
+                    request = requests.front();
+                    requests.pop_front();
+                    cached = mutex.cache.get(
+                        std::make_pair(request->name, request->displayScale),
+                        image);
+                }
+            }
+            if (request)
+            {
+                if (!cached)
+                {
+                    image = render(request->name, request->displayScale);
+                    std::unique_lock<std::mutex> lock(mutex.mutex);
+                    mutex.cache.add(
+                        std::make_pair(request->name, request->displayScale),
+                        image);
+                }
+                request->promise.set_value(image);
+
+                // Wake the application so the widgets pick up the icon.
+                contextWake();
+            }
+        }
+    }
+
+    std::shared_ptr<Image> IconSystem::Private::render(
+        const std::string& name,
+        float displayScale)
     {
-        std::list<std::shared_ptr<Private::Request> > requests;
+        std::shared_ptr<Image> out;
+        if (auto document = getDocument(name))
+        {
+            // Documents are not re-entrant, so the same icon at different
+            // display scales is rendered serially.
+            std::unique_lock<std::mutex> lock(document->mutex);
+            const int w = document->doc->width() * displayScale;
+            const int h = document->doc->height() * displayScale;
+            auto bitmap = document->doc->renderToBitmap(w, h, 0x00000000);
+            if (!bitmap.isNull())
+            {
+                out = Image::create(w, h, ImageType::RGBA_U8);
+                convertBitmap(
+                    bitmap.data(),
+                    bitmap.stride(),
+                    w,
+                    h,
+                    out->getData());
+            }
+        }
+        return out;
+    }
+
+    std::shared_ptr<IconSystem::Private::Document> IconSystem::Private::getDocument(
+        const std::string& name)
+    {
+        std::shared_ptr<Document> out;
+        std::vector<uint8_t> data;
         {
             std::unique_lock<std::mutex> lock(mutex.mutex);
-            requests = std::move(mutex.requests);
+            const auto i = mutex.documents.find(name);
+            if (i != mutex.documents.end())
+            {
+                return i->second;
+            }
+            const auto j = mutex.iconData.find(name);
+            if (j != mutex.iconData.end())
+            {
+                data = j->second;
+            }
+        }
+        if (!data.empty())
+        {
+            const std::string s(data.begin(), data.end());
+            if (auto doc = lunasvg::Document::loadFromData(s))
+            {
+                out = std::make_shared<Document>();
+                out->doc = std::move(doc);
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                const auto i = mutex.documents.insert(std::make_pair(name, out));
+                out = i.first->second;
+            }
+        }
+        return out;
+    }
+
+    void IconSystem::Private::cancelRequests()
+    {
+        std::list<std::shared_ptr<Request> > requests;
+        {
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            requests = std::move(mutex.priorityRequests);
+            requests.splice(requests.end(), mutex.requests);
         }
         for (auto& request : requests)
         {
             request->promise.set_value(nullptr);
         }
     }
-}
+}
\ No newline at end of file
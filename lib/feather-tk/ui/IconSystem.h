@@ -15,28 +15,58 @@ namespace feather_tk
     //! \name Icons
     ///@{
 
+    class IconSystem;
+
+    //! Icon request.
     struct IconRequest
     {
         uint64_t id = 0;
         std::future<std::shared_ptr<Image> > future;
+
+        //! Get whether the request is pending.
+        bool isPending() const;
+
+        //! Make a priority request for the icon if the image is not set
+        //! and a request is not pending. Cached icons are set immediately.
+        //! Returns true if the request is pending, the icon can then be
+        //! received in the tick event with takeIcon().
+        bool request(
+            const std::shared_ptr<IconSystem>&,
+            const std::string& name,
+            float displayScale,
+            std::shared_ptr<Image>&);
     };
+
+    //! Get the icon from a request if it is ready. Returns true and
+    //! resets the request when the icon is ready.
+    bool takeIcon(IconRequest&, std::shared_ptr<Image>&);
         
     //! Icon system.
+    //!
+    //! Icons are rasterized by a pool of worker threads. The parsed SVG
+    //! documents and the rasterized images are cached.
     class IconSystem : public ISystem
     {
         FEATHER_TK_NON_COPYABLE(IconSystem);
 
     protected:
-        void _init(const std::shared_ptr<Context>&);
+        void _init(
+            const std::shared_ptr<Context>&,
+            size_t threadCount);
 
         IconSystem(const std::shared_ptr<Context>&);
 
     public:
         ~IconSystem();
 
-        //! Create a new system.
+        //! Create a new system. If the thread count is zero it is chosen
+        //! automatically.
         static std::shared_ptr<IconSystem> create(
-            const std::shared_ptr<Context>&);
+            const std::shared_ptr<Context>&,
+            size_t threadCount = 0);
+
+        //! Get the number of worker threads.
+        size_t getThreadCount() const;
 
         //! Get the icon names.
         std::vector<std::string> getNames() const;
@@ -44,15 +74,22 @@ namespace feather_tk
         //! Add an icon. The icon is stored as an SVG file.
         void add(const std::string& name, const std::vector<uint8_t>& svg);
 
-        //! Get an icon.
+        //! Get an icon. The request is given priority over async requests.
         std::shared_ptr<Image> get(
             const std::string& name,
             float displayScale);
 
-        //! Request an async icon.
+        //! Request an async icon. Priority requests are handled before
+        //! other requests, use them for icons that are currently visible.
         IconRequest request(
             const std::string& name,
-            float displayScale);
+            float displayScale,
+            bool priority = false);
+
+        //! Rasterize icons in the background to warm the cache.
+        void preload(
+            const std::vector<std::string>& names,
+            const std::vector<float>& displayScales);
 
         //! Cancel async requests.
         void cancelRequests(const std::vector<uint64_t>&);
@@ -28,7 +28,7 @@ namespace feather_tk
             int vMargin = 0;
             FontInfo fontInfo;
             FontMetrics fontMetrics;
-            Size2I textSize;
+            std::shared_ptr<TextLayout> textLayout;
         };
         SizeData size;
 
@@ -36,7 +36,6 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
     };
@@ -232,11 +231,11 @@ namespace feather_tk
                 p.size.fontInfo.size *= event.displayScale;
             }
             p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
-            p.size.textSize = event.fontSystem->getSize(p.text, p.size.fontInfo);
+            p.size.textLayout = event.fontSystem->getLayout(p.text, p.size.fontInfo);
             p.draw.reset();
         }
 
-        Size2I sizeHint(p.size.textSize);
+        Size2I sizeHint(p.size.textLayout ? p.size.textLayout->size : Size2I());
         sizeHint = margin(sizeHint, p.size.hMargin, p.size.vMargin);
         _setSizeHint(sizeHint);
     }
@@ -263,16 +262,15 @@ namespace feather_tk
             p.draw->g2 = margin(p.draw->g, -p.size.hMargin, -p.size.vMargin, -p.size.hMargin, -p.size.vMargin);
         }
 
-        if (!p.text.empty() && p.draw->glyphs.empty())
+        if (p.size.textLayout)
         {
-            p.draw->glyphs = event.fontSystem->getGlyphs(p.text, p.size.fontInfo);
+            event.render->drawText(
+                *p.size.textLayout,
+                p.size.fontMetrics,
+                p.draw->g2.min,
+                event.style->getColorRole(isEnabled() ?
+                    p.textRole :
+                    ColorRole::TextDisabled));
         }
-        event.render->drawText(
-            p.draw->glyphs,
-            p.size.fontMetrics,
-            p.draw->g2.min,
-            event.style->getColorRole(isEnabled() ?
-                p.textRole :
-                ColorRole::TextDisabled));
     }
 }
\ No newline at end of file
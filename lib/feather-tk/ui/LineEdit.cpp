@@ -10,7 +10,9 @@
 #include <feather-tk/ui/LayoutUtil.h>
 
 #include <feather-tk/core/RenderUtil.h>
+#include <feather-tk/core/Timer.h>
 
+#include <algorithm>
 #include <optional>
 
 namespace feather_tk
@@ -88,6 +90,62 @@ namespace feather_tk
         {
             _pair = std::make_pair(-1, -1);
         }
+
+        //! Get the advance of a glyph, including the hinting adjustment
+        //! from the previous glyph. This matches the font system layout.
+        int getAdvance(
+            const std::shared_ptr<Glyph>& prev,
+            const std::shared_ptr<Glyph>& glyph)
+        {
+            int out = 0;
+            if (glyph)
+            {
+                out = glyph->advance;
+                const int32_t rsbDeltaPrev = prev ? prev->rsbDelta : 0;
+                if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                {
+                    out -= 1;
+                }
+                else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                {
+                    out += 1;
+                }
+            }
+            return out;
+        }
+
+        //! Get the byte offsets of the UTF-8 characters.
+        std::vector<int> getOffsets(const std::string& value, int offset)
+        {
+            std::vector<int> out;
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                if ((static_cast<uint8_t>(value[i]) & 0xc0) != 0x80)
+                {
+                    out.push_back(offset + static_cast<int>(i));
+                }
+            }
+            return out;
+        }
+
+        //! Get the byte offset of the previous UTF-8 character.
+        int getPrevOffset(const std::string& value, int offset)
+        {
+            int out = offset - 1;
+            for (; out > 0 && (static_cast<uint8_t>(value[out]) & 0xc0) == 0x80; --out)
+                ;
+            return std::max(out, 0);
+        }
+
+        //! Get the byte offset of the next UTF-8 character.
+        int getNextOffset(const std::string& value, int offset)
+        {
+            const int size = static_cast<int>(value.size());
+            int out = offset + 1;
+            for (; out < size && (static_cast<uint8_t>(value[out]) & 0xc0) == 0x80; ++out)
+                ;
+            return std::min(out, size);
+        }
     }
 
     struct LineEdit::Private
@@ -101,7 +159,7 @@ namespace feather_tk
         ColorRole borderRole = ColorRole::Border;
         int cursorPos = 0;
         bool cursorVisible = false;
-        std::chrono::steady_clock::time_point cursorTimer;
+        std::shared_ptr<Timer> cursorTimer;
         Selection selection;
 
         struct SizeData
@@ -111,18 +169,33 @@ namespace feather_tk
             int border = 0;
             FontInfo fontInfo;
             FontMetrics fontMetrics;
-            Size2I textSize;
             Size2I formatSize;
         };
         SizeData size;
 
+        //! The glyphs and cursor positions are measured once and then
+        //! updated as the text is edited, so that moving the cursor or
+        //! dragging a selection does not measure the text again.
+        struct TextCache
+        {
+            bool valid = false;
+            std::vector<std::shared_ptr<Glyph> > glyphs;
+
+            //! The byte offset of each character, followed by the size of
+            //! the text.
+            std::vector<int> offsets;
+
+            //! The horizontal position of each character, followed by the
+            //! width of the text.
+            std::vector<int> advances;
+        };
+        TextCache textCache;
+
         struct DrawData
         {
             Box2I g2;
             Box2I g3;
-            TriMesh2F border;
-            std::vector<std::shared_ptr<Glyph> > glyphs;
-            std::vector<Box2I> glyphsBox;
+            CompactMesh2F border;
         };
         std::optional<DrawData> draw;
     };
@@ -137,6 +210,8 @@ namespace feather_tk
         setAcceptsKeyFocus(true);
         _setMouseHoverEnabled(true);
         _setMousePressEnabled(true);
+        p.cursorTimer = Timer::create(context);
+        p.cursorTimer->setRepeating(true);
         _textUpdate();
     }
 
@@ -168,6 +243,7 @@ namespace feather_tk
             return;
         p.text = value;
         p.cursorPos = p.text.size();
+        p.textCache.valid = false;
         _textUpdate();
     }
 
@@ -197,7 +273,9 @@ namespace feather_tk
         if (value == p.format)
             return;
         p.format = value;
-        _textUpdate();
+        p.size.displayScale.reset();
+        _setSizeUpdate();
+        _setDrawUpdate();
     }
 
     void LineEdit::setFocusCallback(const std::function<void(bool)>& value)
@@ -216,6 +294,7 @@ namespace feather_tk
         if (value == p.fontRole)
             return;
         p.fontRole = value;
+        p.size.displayScale.reset();
         _setSizeUpdate();
         _setDrawUpdate();
     }
@@ -275,31 +354,6 @@ namespace feather_tk
         }
     }
 
-    void LineEdit::tickEvent(
-        bool parentsVisible,
-        bool parentsEnabled,
-        const TickEvent& event)
-    {
-        IWidget::tickEvent(parentsVisible, parentsEnabled, event);
-        FEATHER_TK_P();
-        if (hasKeyFocus())
-        {
-            const auto now = std::chrono::steady_clock::now();
-            const std::chrono::duration<float> diff = now - p.cursorTimer;
-            if (diff.count() > .5F)
-            {
-                p.cursorVisible = !p.cursorVisible;
-                _setDrawUpdate();
-                p.cursorTimer = now;
-            }
-        }
-        else if (p.cursorVisible)
-        {
-            p.cursorVisible = false;
-            _setDrawUpdate();
-        }
-    }
-
     void LineEdit::sizeHintEvent(const SizeHintEvent& event)
     {
         IWidget::sizeHintEvent(event);
@@ -313,10 +367,14 @@ namespace feather_tk
             p.size.border = event.style->getSizeRole(SizeRole::Border, event.displayScale);
             p.size.fontInfo = event.style->getFontRole(p.fontRole, event.displayScale);
             p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
-            p.size.textSize = event.fontSystem->getSize(p.text, p.size.fontInfo);
             p.size.formatSize = event.fontSystem->getSize(p.format, p.size.fontInfo);
+            p.textCache.valid = false;
             p.draw.reset();
         }
+        if (!p.textCache.valid)
+        {
+            _textCacheUpdate(event.fontSystem);
+        }
 
         Size2I sizeHint(p.size.formatSize.w, p.size.fontMetrics.lineHeight);
         sizeHint = margin(
@@ -377,10 +435,8 @@ namespace feather_tk
         if (p.selection.isValid())
         {
             const auto selection = p.selection.getSorted();
-            const std::string text0 = p.text.substr(0, selection.first);
-            const int x0 = event.fontSystem->getSize(text0, p.size.fontInfo).w;
-            const std::string text1 = p.text.substr(0, selection.second);
-            const int x1 = event.fontSystem->getSize(text1, p.size.fontInfo).w;
+            const int x0 = _getCursorX(selection.first);
+            const int x1 = _getCursorX(selection.second);
             event.render->drawRect(
                 Box2I(p.draw->g3.x() + x0, p.draw->g3.y(), x1 - x0 + 1, p.draw->g3.h()),
                 event.style->getColorRole(ColorRole::Checked));
@@ -390,13 +446,8 @@ namespace feather_tk
         const V2I pos(
             p.draw->g3.x(),
             p.draw->g3.y() + p.draw->g3.h() / 2 - p.size.fontMetrics.lineHeight / 2);
-        if (!p.text.empty() && p.draw->glyphs.empty())
-        {
-            p.draw->glyphs = event.fontSystem->getGlyphs(p.text, p.size.fontInfo);
-            p.draw->glyphsBox = event.fontSystem->getBox(p.text, p.size.fontInfo);
-        }
         event.render->drawText(
-            p.draw->glyphs,
+            p.textCache.glyphs,
             p.size.fontMetrics,
             pos,
             event.style->getColorRole(enabled ?
@@ -406,8 +457,7 @@ namespace feather_tk
         // Draw the cursor.
         if (p.cursorVisible)
         {
-            const std::string text = p.text.substr(0, p.cursorPos);
-            const int x = event.fontSystem->getSize(text, p.size.fontInfo).w;
+            const int x = _getCursorX(p.cursorPos);
             event.render->drawRect(
                 Box2I(
                     p.draw->g3.x() + x,
@@ -429,7 +479,7 @@ namespace feather_tk
             {
                 p.cursorPos = cursorPos;
                 p.cursorVisible = true;
-                p.cursorTimer = std::chrono::steady_clock::now();
+                _cursorTimerStart();
                 _setDrawUpdate();
             }
             if (cursorPos != p.selection.get().second)
@@ -449,7 +499,7 @@ namespace feather_tk
         {
             p.cursorPos = cursorPos;
             p.cursorVisible = true;
-            p.cursorTimer = std::chrono::steady_clock::now();
+            _cursorTimerStart();
             _setDrawUpdate();
         }
         const SelectionPair selection(cursorPos, cursorPos);
@@ -469,11 +519,15 @@ namespace feather_tk
         {
             p.selection.clear();
             p.selection.select(0, p.text.size());
+            p.cursorVisible = true;
+            _cursorTimerStart();
             _setDrawUpdate();
         }
         else
         {
             p.selection.clear();
+            p.cursorTimer->stop();
+            p.cursorVisible = false;
             if (p.textCallback)
             {
                 p.textCallback(p.text);
@@ -534,7 +588,7 @@ namespace feather_tk
                             if (p.selection.isValid())
                             {
                                 const auto selection = p.selection.getSorted();
-                                p.text.replace(
+                                _textReplace(
                                     selection.first,
                                     selection.second - selection.first,
                                     text);
@@ -543,7 +597,7 @@ namespace feather_tk
                             }
                             else
                             {
-                                p.text.insert(p.cursorPos, text);
+                                _textReplace(p.cursorPos, 0, text);
                                 p.cursorPos += text.size();
                             }
                             if (p.textChangedCallback)
@@ -570,10 +624,10 @@ namespace feather_tk
                                     selection.first,
                                     selection.second - selection.first);
                                 clipboard->setText(text);
-                                p.text.replace(
+                                _textReplace(
                                     selection.first,
                                     selection.second - selection.first,
-                                    "");
+                                    std::string());
                                 p.selection.clear();
                                 p.cursorPos = selection.first;
                                 if (p.textChangedCallback)
@@ -590,18 +644,19 @@ namespace feather_tk
                 event.accept = true;
                 if (p.cursorPos > 0)
                 {
+                    const int cursorPos = getPrevOffset(p.text, p.cursorPos);
                     if (event.modifiers & static_cast<int>(KeyModifier::Shift))
                     {
-                        p.selection.select(p.cursorPos, p.cursorPos - 1);
+                        p.selection.select(p.cursorPos, cursorPos);
                     }
                     else
                     {
                         p.selection.clear();
                     }
 
-                    p.cursorPos--;
+                    p.cursorPos = cursorPos;
                     p.cursorVisible = true;
-                    p.cursorTimer = std::chrono::steady_clock::now();
+                    _cursorTimerStart();
 
                     _setDrawUpdate();
                 }
@@ -610,18 +665,19 @@ namespace feather_tk
                 event.accept = true;
                 if (p.cursorPos < p.text.size())
                 {
+                    const int cursorPos = getNextOffset(p.text, p.cursorPos);
                     if (event.modifiers & static_cast<int>(KeyModifier::Shift))
                     {
-                        p.selection.select(p.cursorPos, p.cursorPos + 1);
+                        p.selection.select(p.cursorPos, cursorPos);
                     }
                     else
                     {
                         p.selection.clear();
                     }
 
-                    p.cursorPos++;
+                    p.cursorPos = cursorPos;
                     p.cursorVisible = true;
-                    p.cursorTimer = std::chrono::steady_clock::now();
+                    _cursorTimerStart();
 
                     _setDrawUpdate();
                 }
@@ -641,7 +697,7 @@ namespace feather_tk
 
                     p.cursorPos = 0;
                     p.cursorVisible = true;
-                    p.cursorTimer = std::chrono::steady_clock::now();
+                    _cursorTimerStart();
 
                     _setDrawUpdate();
                 }
@@ -661,7 +717,7 @@ namespace feather_tk
 
                     p.cursorPos = p.text.size();
                     p.cursorVisible = true;
-                    p.cursorTimer = std::chrono::steady_clock::now();
+                    _cursorTimerStart();
 
                     _setDrawUpdate();
                 }
@@ -671,9 +727,10 @@ namespace feather_tk
                 if (p.selection.isValid())
                 {
                     const auto selection = p.selection.getSorted();
-                    p.text.erase(
+                    _textReplace(
                         selection.first,
-                        selection.second - selection.first);
+                        selection.second - selection.first,
+                        std::string());
                     p.selection.clear();
                     p.cursorPos = selection.first;
                     if (p.textChangedCallback)
@@ -684,9 +741,9 @@ namespace feather_tk
                 }
                 else if (p.cursorPos > 0)
                 {
-                    const auto i = p.text.begin() + p.cursorPos - 1;
-                    p.text.erase(i);
-                    p.cursorPos--;
+                    const int cursorPos = getPrevOffset(p.text, p.cursorPos);
+                    _textReplace(cursorPos, p.cursorPos - cursorPos, std::string());
+                    p.cursorPos = cursorPos;
                     if (p.textChangedCallback)
                     {
                         p.textChangedCallback(p.text);
@@ -699,9 +756,10 @@ namespace feather_tk
                 if (p.selection.isValid())
                 {
                     const auto selection = p.selection.getSorted();
-                    p.text.erase(
+                    _textReplace(
                         selection.first,
-                        selection.second - selection.first);
+                        selection.second - selection.first,
+                        std::string());
                     p.selection.clear();
                     p.cursorPos = selection.first;
                     if (p.textChangedCallback)
@@ -712,8 +770,10 @@ namespace feather_tk
                 }
                 else if (p.cursorPos < p.text.size())
                 {
-                    const auto i = p.text.begin() + p.cursorPos;
-                    p.text.erase(i);
+                    _textReplace(
+                        p.cursorPos,
+                        getNextOffset(p.text, p.cursorPos) - p.cursorPos,
+                        std::string());
                     if (p.textChangedCallback)
                     {
                         p.textChangedCallback(p.text);
@@ -765,7 +825,7 @@ namespace feather_tk
         if (p.selection.isValid())
         {
             const auto selection = p.selection.getSorted();
-            p.text.replace(
+            _textReplace(
                 selection.first,
                 selection.second - selection.first,
                 event.text);
@@ -774,7 +834,7 @@ namespace feather_tk
         }
         else
         {
-            p.text.insert(p.cursorPos, event.text);
+            _textReplace(p.cursorPos, 0, event.text);
             p.cursorPos += event.text.size();
         }
         if (p.textChangedCallback)
@@ -788,25 +848,157 @@ namespace feather_tk
     {
         FEATHER_TK_P();
         int out = 0;
-        if (p.draw.has_value())
+        if (p.draw.has_value() && p.textCache.valid)
+        {
+            // Find the first character whose right edge is past the
+            // position.
+            const auto& advances = p.textCache.advances;
+            const auto i = std::upper_bound(
+                advances.begin() + 1,
+                advances.end(),
+                value.x - p.draw->g3.x());
+            out = p.textCache.offsets[i - (advances.begin() + 1)];
+        }
+        return out;
+    }
+
+    int LineEdit::_getCursorX(int value) const
+    {
+        FEATHER_TK_P();
+        int out = 0;
+        if (p.textCache.valid)
         {
-            for (const auto& glyphBox : p.draw->glyphsBox)
+            // Find the character containing the byte offset.
+            const auto& offsets = p.textCache.offsets;
+            const auto i = std::upper_bound(offsets.begin(), offsets.end(), value);
+            if (i != offsets.begin())
             {
-                if (value.x < p.draw->g3.x() + glyphBox.x() + glyphBox.w())
-                {
-                    break;
-                }
-                ++out;
+                out = p.textCache.advances[i - offsets.begin() - 1];
             }
         }
         return out;
     }
 
-    void LineEdit::_textUpdate()
+    void LineEdit::_textReplace(int pos, int count, const std::string& value)
     {
         FEATHER_TK_P();
-        p.size.displayScale.reset();
+        p.text.replace(pos, count, value);
+
+        // The cache is measured again if it is not valid, or if the text
+        // could not be converted to glyphs.
+        auto context = getContext();
+        if (!p.textCache.valid ||
+            p.textCache.glyphs.size() + 1 != p.textCache.offsets.size() ||
+            !context)
+        {
+            p.textCache.valid = false;
+            return;
+        }
+
+        // Find the range of characters.
+        auto& cache = p.textCache;
+        const int i0 = std::lower_bound(cache.offsets.begin(), cache.offsets.end() - 1, pos) -
+            cache.offsets.begin();
+        const int i1 = std::lower_bound(cache.offsets.begin() + i0, cache.offsets.end() - 1, pos + count) -
+            cache.offsets.begin();
+
+        // Measure the new characters.
+        const std::vector<int> offsets = getOffsets(value, pos);
+        std::vector<std::shared_ptr<Glyph> > glyphs;
+        if (!value.empty())
+        {
+            glyphs = context->getSystem<FontSystem>()->getGlyphs(value, p.size.fontInfo);
+        }
+        if (cache.offsets[i0] != pos ||
+            cache.offsets[i1] != pos + count ||
+            glyphs.size() != offsets.size())
+        {
+            // The range does not fall on character boundaries, or the text
+            // could not be converted, measure it again.
+            cache.valid = false;
+            return;
+        }
+
+        // Replace the characters in the range.
+        cache.glyphs.erase(cache.glyphs.begin() + i0, cache.glyphs.begin() + i1);
+        cache.glyphs.insert(cache.glyphs.begin() + i0, glyphs.begin(), glyphs.end());
+        cache.offsets.erase(cache.offsets.begin() + i0, cache.offsets.begin() + i1);
+        cache.offsets.insert(cache.offsets.begin() + i0, offsets.begin(), offsets.end());
+        cache.advances.erase(cache.advances.begin() + i0 + 1, cache.advances.begin() + i1 + 1);
+        cache.advances.insert(cache.advances.begin() + i0 + 1, glyphs.size(), 0);
+
+        // Update the positions of the new characters and the character
+        // following them, then shift the remaining characters.
+        const int offsetDelta = static_cast<int>(value.size()) - count;
+        const int end = i0 + static_cast<int>(glyphs.size());
+        for (size_t i = end; i < cache.offsets.size(); ++i)
+        {
+            cache.offsets[i] += offsetDelta;
+        }
+        const int last = std::min(end + 1, static_cast<int>(cache.glyphs.size()));
+        const int prevAdvance = cache.advances[last];
+        for (int i = i0; i < last; ++i)
+        {
+            cache.advances[i + 1] = cache.advances[i] + getAdvance(
+                i > 0 ? cache.glyphs[i - 1] : nullptr,
+                cache.glyphs[i]);
+        }
+        const int advanceDelta = cache.advances[last] - prevAdvance;
+        for (size_t i = last + 1; i < cache.advances.size(); ++i)
+        {
+            cache.advances[i] += advanceDelta;
+        }
+    }
+
+    void LineEdit::_textCacheUpdate(const std::shared_ptr<FontSystem>& fontSystem)
+    {
+        FEATHER_TK_P();
+        auto& cache = p.textCache;
+        cache.glyphs.clear();
+        if (!p.text.empty())
+        {
+            cache.glyphs = fontSystem->getGlyphs(p.text, p.size.fontInfo);
+        }
+        cache.offsets = getOffsets(p.text, 0);
+        cache.advances.clear();
+        cache.advances.push_back(0);
+        if (cache.glyphs.size() == cache.offsets.size())
+        {
+            for (size_t i = 0; i < cache.glyphs.size(); ++i)
+            {
+                cache.advances.push_back(cache.advances.back() + getAdvance(
+                    i > 0 ? cache.glyphs[i - 1] : nullptr,
+                    cache.glyphs[i]));
+            }
+        }
+        else
+        {
+            // The text could not be converted, so the characters are all
+            // placed at the start. The glyphs are left empty, which makes
+            // _textReplace() measure the text again instead of updating it.
+            cache.glyphs.clear();
+            cache.advances.resize(cache.offsets.size() + 1, 0);
+        }
+        cache.offsets.push_back(static_cast<int>(p.text.size()));
+        cache.valid = true;
+    }
+
+    void LineEdit::_textUpdate()
+    {
         _setSizeUpdate();
         _setDrawUpdate();
     }
+
+    void LineEdit::_cursorTimerStart()
+    {
+        FEATHER_TK_P();
+        p.cursorTimer->start(
+            std::chrono::milliseconds(500),
+            [this]
+            {
+                FEATHER_TK_P();
+                p.cursorVisible = !p.cursorVisible;
+                _setDrawUpdate();
+            });
+    }
 }
\ No newline at end of file
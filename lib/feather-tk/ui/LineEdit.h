@@ -71,10 +71,6 @@ namespace feather_tk
         void setGeometry(const Box2I&) override;
         void setVisible(bool) override;
         void setEnabled(bool) override;
-        void tickEvent(
-            bool,
-            bool,
-            const TickEvent&) override;
         void clipEvent(const Box2I&, bool) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void drawEvent(const Box2I&, const DrawEvent&) override;
@@ -85,10 +81,18 @@ namespace feather_tk
         void keyReleaseEvent(KeyEvent&) override;
         void textEvent(TextEvent&) override;
 
-    private:
+    protected:
+        //! Get the byte offset of the character at a position.
         int _getCursorPos(const V2I&);
 
+        //! Get the horizontal position of a byte offset.
+        int _getCursorX(int) const;
+
+    private:
+        void _textReplace(int pos, int count, const std::string&);
+        void _textCacheUpdate(const std::shared_ptr<FontSystem>&);
         void _textUpdate();
+        void _cursorTimerStart();
 
         FEATHER_TK_PRIVATE();
     };
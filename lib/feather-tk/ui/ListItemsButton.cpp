@@ -23,7 +23,7 @@ namespace feather_tk
             int pad = 0;
             FontInfo fontInfo;
             FontMetrics fontMetrics;
-            Size2I textSize;
+            std::optional<Size2I> textSize;
         };
         SizeData size;
 
@@ -31,7 +31,7 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F border;
+            CompactMesh2F border;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
@@ -67,6 +67,18 @@ namespace feather_tk
         return out;
     }
 
+    void ListItemButton::setItem(const ListItem& value)
+    {
+        FEATHER_TK_P();
+        if (value.text != _text)
+        {
+            setText(value.text);
+            p.size.textSize.reset();
+            p.draw.reset();
+        }
+        setTooltip(value.tooltip);
+    }
+
     void ListItemButton::setCurrent(bool value)
     {
         FEATHER_TK_P();
@@ -92,22 +104,14 @@ namespace feather_tk
         IButton::sizeHintEvent(event);
         FEATHER_TK_P();
 
-        if (!p.size.displayScale.has_value() ||
-            (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+        _sizeUpdate(event.displayScale, event.style, event.fontSystem);
+        if (!p.size.textSize.has_value())
         {
-            p.size.displayScale = event.displayScale;
-            p.size.margin = event.style->getSizeRole(SizeRole::MarginInside, event.displayScale);
-            p.size.spacing = event.style->getSizeRole(SizeRole::SpacingSmall, event.displayScale);
-            p.size.border = event.style->getSizeRole(SizeRole::Border, event.displayScale);
-            p.size.pad = event.style->getSizeRole(SizeRole::LabelPad, event.displayScale);
-            p.size.fontInfo = event.style->getFontRole(FontRole::Label, event.displayScale);
-            p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
             p.size.textSize = event.fontSystem->getSize(_text, p.size.fontInfo);
-            p.draw.reset();
         }
 
         Size2I sizeHint(
-            p.size.textSize.w + p.size.pad * 2,
+            p.size.textSize->w + p.size.pad * 2,
             p.size.fontMetrics.lineHeight);
         sizeHint = margin(sizeHint, p.size.margin + p.size.border);
         _setSizeHint(sizeHint);
@@ -128,6 +132,10 @@ namespace feather_tk
         IButton::drawEvent(drawRect, event);
         FEATHER_TK_P();
 
+        // Buttons that are recycled by the list may be drawn before they
+        // receive a size hint event.
+        _sizeUpdate(event.displayScale, event.style, event.fontSystem);
+
         if (!p.draw.has_value())
         {
             p.draw = Private::DrawData();
@@ -178,4 +186,25 @@ namespace feather_tk
             V2I(p.draw->g2.x() + p.size.pad, p.draw->g2.y()),
             event.style->getColorRole(ColorRole::Text));
     }
+
+    void ListItemButton::_sizeUpdate(
+        float displayScale,
+        const std::shared_ptr<Style>& style,
+        const std::shared_ptr<FontSystem>& fontSystem)
+    {
+        FEATHER_TK_P();
+        if (!p.size.displayScale.has_value() ||
+            (p.size.displayScale.has_value() && p.size.displayScale.value() != displayScale))
+        {
+            p.size.displayScale = displayScale;
+            p.size.margin = style->getSizeRole(SizeRole::MarginInside, displayScale);
+            p.size.spacing = style->getSizeRole(SizeRole::SpacingSmall, displayScale);
+            p.size.border = style->getSizeRole(SizeRole::Border, displayScale);
+            p.size.pad = style->getSizeRole(SizeRole::LabelPad, displayScale);
+            p.size.fontInfo = style->getFontRole(FontRole::Label, displayScale);
+            p.size.fontMetrics = fontSystem->getMetrics(p.size.fontInfo);
+            p.size.textSize.reset();
+            p.draw.reset();
+        }
+    }
 }
\ No newline at end of file
@@ -4,11 +4,19 @@
 
 #include <feather-tk/ui/ListItemsWidgetPrivate.h>
 
-#include <feather-tk/ui/ButtonGroup.h>
-#include <feather-tk/ui/RowLayout.h>
+#include <feather-tk/core/StringSearch.h>
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
 
 namespace feather_tk
 {
+    namespace
+    {
+        const size_t measureMax = 8;
+    }
+
     ListItem::ListItem(
         const std::string& text,
         const std::string& tooltip) :
@@ -32,13 +40,39 @@ namespace feather_tk
     {
         ButtonGroupType type = ButtonGroupType::Click;
         std::vector<ListItem> items;
+        std::vector<bool> checked;
+        int radio = -1;
+        std::vector<int> rows;
         std::vector<std::shared_ptr<ListItemButton> > buttons;
-        std::shared_ptr<ButtonGroup> buttonGroup;
-        std::shared_ptr<VerticalLayout> layout;
+        std::vector<int> buttonItems;
         std::function<void(int, bool)> callback;
         std::shared_ptr<ObservableValue<int> > current;
         std::shared_ptr<ObservableValue<int> > scrollTo;
         std::string search;
+        StringSearch stringSearch;
+
+        struct SizeData
+        {
+            std::optional<float> displayScale;
+            int margin = 0;
+            int border = 0;
+            int pad = 0;
+            FontInfo fontInfo;
+            int rowHeight = 0;
+            std::optional<int> textWidth;
+        };
+        SizeData size;
+
+        int getRow(int index) const
+        {
+            int out = -1;
+            const auto i = std::lower_bound(rows.begin(), rows.end(), index);
+            if (i != rows.end() && *i == index)
+            {
+                out = i - rows.begin();
+            }
+            return out;
+        }
     };
 
     void ListItemsWidget::_init(
@@ -51,41 +85,7 @@ namespace feather_tk
 
         setAcceptsKeyFocus(true);
 
-        p.buttonGroup = ButtonGroup::create(context, type);
-
-        p.layout = VerticalLayout::create(context, shared_from_this());
-        p.layout->setSpacingRole(SizeRole::None);
-
-        _itemsUpdate();
-
-        switch (type)
-        {
-        case ButtonGroupType::Click:
-            p.buttonGroup->setClickedCallback(
-                [this](int index)
-                {
-                    setCurrent(index);
-                    takeKeyFocus();
-                    if (_p->callback)
-                    {
-                        _p->callback(index, true);
-                    }
-                });
-            break;
-        default:
-            p.buttonGroup->setCheckedCallback(
-                [this](int index, bool value)
-                {
-                    setCurrent(index);
-                    takeKeyFocus();
-                    if (_p->callback)
-                    {
-                        _p->callback(index, value);
-                    }
-                });
-            break;
-        }
-
+        p.type = type;
         p.current = ObservableValue<int>::create(-1);
         p.scrollTo = ObservableValue<int>::create(-1);
     }
@@ -118,12 +118,22 @@ namespace feather_tk
         if (value == p.items)
             return;
         p.items = value;
+        p.checked = std::vector<bool>(p.items.size(), false);
+        p.radio = -1;
+        std::vector<std::string> text;
+        text.reserve(p.items.size());
+        for (const auto& item : p.items)
+        {
+            text.push_back(item.text);
+        }
+        p.stringSearch.setItems(text);
         _itemsUpdate();
         const int index = !p.items.empty() ?
             clamp(p.current->get(), 0, static_cast<int>(p.items.size()) - 1) :
             -1;
         if (p.current->setIfChanged(index))
         {
+            _currentUpdate();
             p.scrollTo->setIfChanged(p.current->get());
         }
     }
@@ -142,16 +152,40 @@ namespace feather_tk
     {
         FEATHER_TK_P();
         bool out = false;
-        if (index >= 0 && index < p.buttons.size())
+        if (index >= 0 && index < p.checked.size())
         {
-            out = p.buttons[index]->isChecked();
+            out = p.checked[index];
         }
         return out;
     }
 
     void ListItemsWidget::setChecked(int index, bool value)
     {
-        _p->buttonGroup->setChecked(index, value);
+        FEATHER_TK_P();
+        switch (p.type)
+        {
+        case ButtonGroupType::Check:
+            if (index >= 0 && index < p.checked.size())
+            {
+                p.checked[index] = value;
+            }
+            break;
+        case ButtonGroupType::Radio:
+            for (size_t i = 0; i < p.checked.size(); ++i)
+            {
+                p.checked[i] = i == index;
+            }
+            p.radio = index;
+            break;
+        case ButtonGroupType::Toggle:
+            for (size_t i = 0; i < p.checked.size(); ++i)
+            {
+                p.checked[i] = i == index ? value : false;
+            }
+            break;
+        default: break;
+        }
+        _currentUpdate();
     }
 
     void ListItemsWidget::setCallback(const std::function<void(int, bool)>& value)
@@ -215,24 +249,76 @@ namespace feather_tk
     {
         FEATHER_TK_P();
         Box2I out;
-        if (index >= 0 && index < p.buttons.size())
+        const int row = p.getRow(index);
+        if (row != -1)
         {
-            out = p.buttons[index]->getGeometry();
-            out = move(out, -p.layout->getGeometry().min);
+            out = Box2I(
+                0,
+                row * p.size.rowHeight,
+                getGeometry().w(),
+                p.size.rowHeight);
         }
         return out;
     }
 
+    size_t ListItemsWidget::getButtonCount() const
+    {
+        return _p->buttons.size();
+    }
+
     void ListItemsWidget::setGeometry(const Box2I& value)
     {
         IWidget::setGeometry(value);
-        _p->layout->setGeometry(value);
+        _buttonsUpdate();
     }
 
     void ListItemsWidget::sizeHintEvent(const SizeHintEvent& event)
     {
         IWidget::sizeHintEvent(event);
-        _setSizeHint(_p->layout->getSizeHint());
+        FEATHER_TK_P();
+
+        if (!p.size.displayScale.has_value() ||
+            (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+        {
+            p.size.displayScale = event.displayScale;
+            p.size.margin = event.style->getSizeRole(SizeRole::MarginInside, event.displayScale);
+            p.size.border = event.style->getSizeRole(SizeRole::Border, event.displayScale);
+            p.size.pad = event.style->getSizeRole(SizeRole::LabelPad, event.displayScale);
+            p.size.fontInfo = event.style->getFontRole(FontRole::Label, event.displayScale);
+            const FontMetrics fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
+            p.size.rowHeight = fontMetrics.lineHeight + (p.size.margin + p.size.border) * 2;
+            p.size.textWidth.reset();
+        }
+
+        // Only measure the items with the longest text instead of every
+        // item. Measuring a few candidates handles proportional fonts where
+        // the item with the most characters is not the widest.
+        if (!p.size.textWidth.has_value())
+        {
+            std::vector<size_t> rows(p.rows.size());
+            std::iota(rows.begin(), rows.end(), 0);
+            const size_t count = std::min(rows.size(), measureMax);
+            std::partial_sort(
+                rows.begin(),
+                rows.begin() + count,
+                rows.end(),
+                [&p](size_t a, size_t b)
+                {
+                    return p.items[p.rows[a]].text.size() > p.items[p.rows[b]].text.size();
+                });
+            int textWidth = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                textWidth = std::max(
+                    textWidth,
+                    event.fontSystem->getSize(p.items[p.rows[rows[i]]].text, p.size.fontInfo).w);
+            }
+            p.size.textWidth = textWidth;
+        }
+
+        _setSizeHint(Size2I(
+            p.size.textWidth.value() + p.size.pad * 2 + (p.size.margin + p.size.border) * 2,
+            static_cast<int>(p.rows.size()) * p.size.rowHeight));
     }
 
     void ListItemsWidget::keyFocusEvent(bool value)
@@ -254,35 +340,47 @@ namespace feather_tk
             switch (event.key)
             {
             case Key::Enter:
-            {
                 event.accept = true;
                 takeKeyFocus();
-                const int current = p.current->get();
-                if (current >= 0 && current < p.buttons.size())
-                {
-                    p.buttons[current]->click();
-                }
+                _click(p.current->get());
                 break;
-            }
             case Key::Up:
-                event.accept = true;
-                takeKeyFocus();
-                setCurrent(p.current->get() - 1);
-                break;
             case Key::Down:
                 event.accept = true;
                 takeKeyFocus();
-                setCurrent(p.current->get() + 1);
+                if (!p.rows.empty())
+                {
+                    // Move to the previous or next item that is shown.
+                    const int current = p.current->get();
+                    const auto i = std::lower_bound(p.rows.begin(), p.rows.end(), current);
+                    int row = i - p.rows.begin();
+                    if (Key::Up == event.key)
+                    {
+                        row = row - 1;
+                    }
+                    else if (i != p.rows.end() && *i == current)
+                    {
+                        row = row + 1;
+                    }
+                    row = clamp(row, 0, static_cast<int>(p.rows.size()) - 1);
+                    setCurrent(p.rows[row]);
+                }
                 break;
             case Key::Home:
                 event.accept = true;
                 takeKeyFocus();
-                setCurrent(0);
+                if (!p.rows.empty())
+                {
+                    setCurrent(p.rows.front());
+                }
                 break;
             case Key::End:
                 event.accept = true;
                 takeKeyFocus();
-                setCurrent(static_cast<int>(p.items.size()) - 1);
+                if (!p.rows.empty())
+                {
+                    setCurrent(p.rows.back());
+                }
                 break;
             case Key::Escape:
                 event.accept = true;
@@ -303,34 +401,175 @@ namespace feather_tk
         event.accept = true;
     }
 
+    Box2I ListItemsWidget::_getVisible() const
+    {
+        Box2I out = getGeometry();
+        auto parent = getParent().lock();
+        while (parent)
+        {
+            out = intersect(out, parent->getChildrenClipRect());
+            parent = parent->getParent().lock();
+        }
+        return out;
+    }
+
+    void ListItemsWidget::_click(int index)
+    {
+        FEATHER_TK_P();
+        if (index < 0 || index >= p.items.size())
+            return;
+        bool value = true;
+        switch (p.type)
+        {
+        case ButtonGroupType::Check:
+            value = !p.checked[index];
+            p.checked[index] = value;
+            break;
+        case ButtonGroupType::Radio:
+            for (size_t i = 0; i < p.checked.size(); ++i)
+            {
+                p.checked[i] = i == index;
+            }
+            break;
+        case ButtonGroupType::Toggle:
+            value = !p.checked[index];
+            for (size_t i = 0; i < p.checked.size(); ++i)
+            {
+                p.checked[i] = i == index ? value : false;
+            }
+            break;
+        default: break;
+        }
+        setCurrent(index);
+        takeKeyFocus();
+        _currentUpdate();
+        const bool callback = ButtonGroupType::Radio != p.type || index != p.radio;
+        p.radio = ButtonGroupType::Radio == p.type ? index : p.radio;
+        if (p.callback && callback)
+        {
+            p.callback(index, value);
+        }
+    }
+
     void ListItemsWidget::_itemsUpdate()
+    {
+        FEATHER_TK_P();
+        p.rows.clear();
+        for (const auto& result : p.stringSearch.search(p.search))
+        {
+            p.rows.push_back(static_cast<int>(result.index));
+        }
+        for (auto& i : p.buttonItems)
+        {
+            i = -1;
+        }
+        p.size.textWidth.reset();
+        _buttonsUpdate();
+        _setSizeUpdate();
+        _setDrawUpdate();
+    }
+
+    void ListItemsWidget::_buttonsUpdate()
     {
         FEATHER_TK_P();
 
-        p.buttons.clear();
-        p.buttonGroup->clearButtons();
-        p.layout->clear();
+        // Find the rows that are visible.
+        const Box2I& g = getGeometry();
+        const Box2I visible = _getVisible();
+        int first = 0;
+        int last = -1;
+        if (p.size.rowHeight > 0 && !p.rows.empty() && visible.w() > 0 && visible.h() > 0)
+        {
+            const int rowsMax = static_cast<int>(p.rows.size()) - 1;
+            first = clamp((visible.min.y - g.min.y) / p.size.rowHeight, 0, rowsMax);
+            last = clamp((visible.max.y - g.min.y) / p.size.rowHeight, 0, rowsMax);
+        }
 
-        if (auto context = getContext())
+        // Keep the buttons that already show a visible row, and recycle
+        // the other buttons.
+        std::vector<int> rowButtons(std::max(0, last - first + 1), -1);
+        std::vector<size_t> unused;
+        for (size_t i = 0; i < p.buttons.size(); ++i)
+        {
+            const int row = p.getRow(p.buttonItems[i]);
+            if (row >= first && row <= last && -1 == rowButtons[row - first])
+            {
+                rowButtons[row - first] = i;
+            }
+            else
+            {
+                unused.push_back(i);
+            }
+        }
+        auto context = getContext();
+        const int current = p.current ? p.current->get() : -1;
+        const bool focus = hasKeyFocus();
+        for (int row = first; row <= last; ++row)
         {
-            for (const auto& item : p.items)
+            int& button = rowButtons[row - first];
+            if (-1 == button)
+            {
+                if (!unused.empty())
+                {
+                    button = unused.back();
+                    unused.pop_back();
+                }
+                else if (context)
+                {
+                    button = p.buttons.size();
+                    auto listItemButton = ListItemButton::create(
+                        context,
+                        std::string(),
+                        shared_from_this());
+                    const int index = button;
+                    listItemButton->setClickedCallback(
+                        [this, index]
+                        {
+                            _click(_p->buttonItems[index]);
+                        });
+                    p.buttons.push_back(listItemButton);
+                    p.buttonItems.push_back(-1);
+                }
+            }
+            if (button != -1)
             {
-                auto button = ListItemButton::create(context, item.text, p.layout);
-                button->setTooltip(item.tooltip);
-                p.buttons.push_back(button);
-                p.buttonGroup->addButton(button);
+                const int item = p.rows[row];
+                const auto& listItemButton = p.buttons[button];
+                if (item != p.buttonItems[button])
+                {
+                    p.buttonItems[button] = item;
+                    listItemButton->setItem(p.items[item]);
+                }
+                listItemButton->setChecked(p.checked[item]);
+                listItemButton->setCurrent(current == item && focus);
+                listItemButton->setGeometry(Box2I(
+                    g.min.x,
+                    g.min.y + row * p.size.rowHeight,
+                    g.w(),
+                    p.size.rowHeight));
+                listItemButton->setVisible(true);
             }
         }
+        for (size_t i : unused)
+        {
+            p.buttonItems[i] = -1;
+            p.buttons[i]->setVisible(false);
+        }
     }
 
     void ListItemsWidget::_currentUpdate()
     {
         FEATHER_TK_P();
-        const int current = p.current->get();
+        const int current = p.current ? p.current->get() : -1;
         const bool focus = hasKeyFocus();
         for (size_t i = 0; i < p.buttons.size(); ++i)
         {
-            p.buttons[i]->setCurrent(current == i && focus);
+            const int item = p.buttonItems[i];
+            if (item != -1)
+            {
+                p.buttons[i]->setChecked(p.checked[item]);
+                p.buttons[i]->setCurrent(current == item && focus);
+            }
         }
     }
 }
\ No newline at end of file
@@ -28,6 +28,12 @@ namespace feather_tk
     };
 
     //! List items widget.
+    //!
+    //! The list is virtualized so that it can display a large number of
+    //! items. Only the rows that are visible have buttons, and the buttons
+    //! are recycled from a small pool as the list is scrolled. The rows all
+    //! have the same height, and the text is only measured for the visible
+    //! rows and for the longest item.
     class ListItemsWidget : public IWidget
     {
     protected:
@@ -86,9 +92,13 @@ namespace feather_tk
         //! Clear the search.
         void clearSearch();
 
-        //! Get an item rectangle.
+        //! Get an item rectangle. A default rectangle is returned if the
+        //! item is not shown because of the search.
         Box2I getRect(int) const;
 
+        //! Get the number of buttons that have been created.
+        size_t getButtonCount() const;
+
         void setGeometry(const Box2I&) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void keyFocusEvent(bool) override;
@@ -96,7 +106,10 @@ namespace feather_tk
         void keyReleaseEvent(KeyEvent&) override;
 
     private:
+        Box2I _getVisible() const;
+        void _click(int);
         void _itemsUpdate();
+        void _buttonsUpdate();
         void _currentUpdate();
 
         FEATHER_TK_PRIVATE();
@@ -28,6 +28,10 @@ namespace feather_tk
             const std::string&,
             const std::shared_ptr<IWidget>& parent = nullptr);
 
+        //! Set the item that is displayed. This is used to recycle the
+        //! button for a different item when the list is scrolled.
+        void setItem(const ListItem&);
+
         void setCurrent(bool);
 
         void setGeometry(const Box2I&) override;
@@ -36,6 +40,11 @@ namespace feather_tk
         void drawEvent(const Box2I&, const DrawEvent&) override;
 
     private:
+        void _sizeUpdate(
+            float displayScale,
+            const std::shared_ptr<Style>&,
+            const std::shared_ptr<FontSystem>&);
+
         FEATHER_TK_PRIVATE();
     };
 }
@@ -5,6 +5,7 @@
 #include <feather-tk/ui/MenuPrivate.h>
 
 #include <feather-tk/ui/DrawUtil.h>
+#include <feather-tk/ui/IconSystem.h>
 
 #include <optional>
 
@@ -20,6 +21,7 @@ namespace feather_tk
         float iconScale = 1.F;
         std::string subMenuIcon;
         std::shared_ptr<Image> subMenuImage;
+        IconRequest subMenuRequest;
 
         std::shared_ptr<ValueObserver<std::string> > textObserver;
         std::shared_ptr<ValueObserver<std::string> > iconObserver;
@@ -47,7 +49,7 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F border;
+            CompactMesh2F border;
             std::vector<std::shared_ptr<Glyph> > textGlyphs;
             std::vector<std::shared_ptr<Glyph> > shortcutGlyphs;
         };
@@ -171,6 +173,7 @@ namespace feather_tk
             return;
         p.subMenuIcon = name;
         p.subMenuImage.reset();
+        p.subMenuRequest = IconRequest();
     }
 
     void MenuButton::setText(const std::string& value)
@@ -197,6 +200,24 @@ namespace feather_tk
         }
     }
 
+    void MenuButton::tickEvent(
+        bool parentsVisible,
+        bool parentsEnabled,
+        const TickEvent& event)
+    {
+        IButton::tickEvent(parentsVisible, parentsEnabled, event);
+        FEATHER_TK_P();
+        if (takeIcon(p.subMenuRequest, p.subMenuImage))
+        {
+            _setSizeUpdate();
+            _setDrawUpdate();
+        }
+        if (p.subMenuRequest.isPending())
+        {
+            _setTickEvents(true);
+        }
+    }
+
     void MenuButton::sizeHintEvent(const SizeHintEvent& event)
     {
         IButton::sizeHintEvent(event);
@@ -220,10 +241,14 @@ namespace feather_tk
         {
             p.iconScale = event.displayScale;
             p.subMenuImage.reset();
+            p.subMenuRequest = IconRequest();
         }
-        if (!p.subMenuIcon.empty() && !p.subMenuImage)
+
+        // Cached icons are ready immediately, otherwise the icon is
+        // received in the tick event.
+        if (p.subMenuRequest.request(event.iconSystem, p.subMenuIcon, p.iconScale, p.subMenuImage))
         {
-            p.subMenuImage = event.iconSystem->get(p.subMenuIcon, p.iconScale);
+            _setTickEvents(true);
         }
 
         Size2I sizeHint;
@@ -35,6 +35,10 @@ namespace feather_tk
         void setText(const std::string&) override;
 
         void setGeometry(const Box2I&) override;
+        void tickEvent(
+            bool parentsVisible,
+            bool parentsEnabled,
+            const TickEvent&) override;
         void sizeHintEvent(const SizeHintEvent&) override;
         void clipEvent(const Box2I&, bool) override;
         void drawEvent(
@@ -47,7 +47,7 @@ namespace feather_tk
         struct DrawData
         {
             Box2I g;
-            std::vector<TriMesh2F> meshes;
+            std::vector<CompactMesh2F> meshes;
         };
         std::optional<DrawData> draw;
     };
@@ -161,20 +161,20 @@ namespace feather_tk
             float a = 0.F;
             for (size_t i = 0; i < p.data.size(); ++i)
             {
-                TriMesh2F mesh;
+                CompactMesh2F mesh;
+                mesh.v.push_back(V2F(0.F, 0.F));
                 const float d = p.data[i].percentage;
                 const float inc = 2.F;
                 for (int i = a; i < a + d; i += inc)
                 {
-                    const size_t size = mesh.v.size();
-                    mesh.v.push_back(V2F(0.F, 0.F));
+                    const uint32_t size = mesh.v.size();
                     mesh.v.push_back(V2F(
                         cos(deg2rad(i / 100.F * 360.F - 90.F)) * r,
                         sin(deg2rad(i / 100.F * 360.F - 90.F)) * r));
                     mesh.v.push_back(V2F(
                         cos(deg2rad(std::min(i + inc, a + d) / 100.F * 360.F - 90.F)) * r,
                         sin(deg2rad(std::min(i + inc, a + d) / 100.F * 360.F - 90.F)) * r));
-                    mesh.triangles.push_back({ size + 1, size + 2, size + 3 });
+                    mesh.addTriangle(0, size, size + 1);
                 }
                 p.draw->meshes.push_back(mesh);
                 a += p.data[i].percentage;
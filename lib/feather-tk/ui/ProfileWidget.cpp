@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk/ui/ProfileWidget.h>
+
+#include <feather-tk/ui/LayoutUtil.h>
+
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ProfileSystem.h>
+#include <feather-tk/core/Timer.h>
+
+#include <optional>
+
+namespace feather_tk
+{
+    namespace
+    {
+        const std::chrono::milliseconds updateTime(250);
+    }
+
+    struct ProfileWidget::Private
+    {
+        std::shared_ptr<ProfileSystem> profileSystem;
+        size_t frameCount = 120;
+        float targetTime = 1000.F / 60.F;
+        std::vector<float> frameTimes;
+        std::vector<std::string> lines;
+        std::shared_ptr<Timer> timer;
+        std::shared_ptr<ValueObserver<bool> > enabledObserver;
+
+        struct SizeData
+        {
+            std::optional<float> displayScale;
+            int margin = 0;
+            int spacing = 0;
+            FontInfo fontInfo;
+            FontMetrics fontMetrics;
+            int graphHeight = 0;
+            int textWidth = 0;
+        };
+        SizeData size;
+
+        struct DrawData
+        {
+            Box2I g;
+            Box2I g2;
+            std::vector<std::vector<std::shared_ptr<Glyph> > > glyphs;
+        };
+        std::optional<DrawData> draw;
+    };
+
+    void ProfileWidget::_init(
+        const std::shared_ptr<Context>& context,
+        const std::shared_ptr<IWidget>& parent)
+    {
+        IWidget::_init(context, "feather_tk::ProfileWidget", parent);
+        FEATHER_TK_P();
+        setBackgroundRole(ColorRole::Base);
+
+        p.profileSystem = context->getSystem<ProfileSystem>();
+        p.timer = Timer::create(context);
+        p.timer->setRepeating(true);
+
+        p.enabledObserver = ValueObserver<bool>::create(
+            p.profileSystem->observeEnabled(),
+            [this](bool value)
+            {
+                FEATHER_TK_P();
+                if (value)
+                {
+                    p.timer->start(
+                        updateTime,
+                        [this]
+                        {
+                            _update();
+                        });
+                }
+                else
+                {
+                    p.timer->stop();
+                }
+                _update();
+            });
+    }
+
+    ProfileWidget::ProfileWidget() :
+        _p(new Private)
+    {}
+
+    ProfileWidget::~ProfileWidget()
+    {}
+
+    std::shared_ptr<ProfileWidget> ProfileWidget::create(
+        const std::shared_ptr<Context>& context,
+        const std::shared_ptr<IWidget>& parent)
+    {
+        auto out = std::shared_ptr<ProfileWidget>(new ProfileWidget);
+        out->_init(context, parent);
+        return out;
+    }
+
+    size_t ProfileWidget::getFrameCount() const
+    {
+        return _p->frameCount;
+    }
+
+    void ProfileWidget::setFrameCount(size_t value)
+    {
+        FEATHER_TK_P();
+        if (value == p.frameCount)
+            return;
+        p.frameCount = value;
+        _update();
+    }
+
+    float ProfileWidget::getTargetTime() const
+    {
+        return _p->targetTime;
+    }
+
+    void ProfileWidget::setTargetTime(float value)
+    {
+        FEATHER_TK_P();
+        if (value == p.targetTime)
+            return;
+        p.targetTime = value;
+        _setDrawUpdate();
+    }
+
+    void ProfileWidget::setGeometry(const Box2I& value)
+    {
+        const bool changed = value != getGeometry();
+        IWidget::setGeometry(value);
+        FEATHER_TK_P();
+        if (changed)
+        {
+            p.draw.reset();
+        }
+    }
+
+    void ProfileWidget::sizeHintEvent(const SizeHintEvent& event)
+    {
+        IWidget::sizeHintEvent(event);
+        FEATHER_TK_P();
+
+        if (!p.size.displayScale.has_value() ||
+            (p.size.displayScale.has_value() && p.size.displayScale.value() != event.displayScale))
+        {
+            p.size.displayScale = event.displayScale;
+            p.size.margin = event.style->getSizeRole(SizeRole::MarginSmall, event.displayScale);
+            p.size.spacing = event.style->getSizeRole(SizeRole::SpacingSmall, event.displayScale);
+            p.size.fontInfo = event.style->getFontRole(FontRole::Mono, event.displayScale);
+            p.size.fontMetrics = event.fontSystem->getMetrics(p.size.fontInfo);
+            p.size.graphHeight = p.size.fontMetrics.lineHeight * 4;
+            p.draw.reset();
+        }
+
+        p.size.textWidth = 0;
+        for (const auto& line : p.lines)
+        {
+            p.size.textWidth = std::max(
+                p.size.textWidth,
+                event.fontSystem->getSize(line, p.size.fontInfo).w);
+        }
+
+        Size2I sizeHint(
+            std::max(p.size.textWidth, p.size.fontMetrics.lineHeight * 12),
+            p.size.graphHeight +
+            p.size.spacing +
+            static_cast<int>(p.lines.size()) * p.size.fontMetrics.lineHeight);
+        sizeHint = margin(sizeHint, p.size.margin);
+        _setSizeHint(sizeHint);
+    }
+
+    void ProfileWidget::clipEvent(const Box2I& clipRect, bool clipped)
+    {
+        IWidget::clipEvent(clipRect, clipped);
+        FEATHER_TK_P();
+        if (clipped)
+        {
+            p.draw.reset();
+        }
+    }
+
+    void ProfileWidget::drawEvent(
+        const Box2I& drawRect,
+        const DrawEvent& event)
+    {
+        IWidget::drawEvent(drawRect, event);
+        FEATHER_TK_P();
+
+        if (!p.draw.has_value())
+        {
+            p.draw = Private::DrawData();
+            p.draw->g = getGeometry();
+            p.draw->g2 = margin(p.draw->g, -p.size.margin);
+        }
+        if (p.draw->glyphs.empty())
+        {
+            p.draw->glyphs.clear();
+            for (const auto& line : p.lines)
+            {
+                p.draw->glyphs.push_back(event.fontSystem->getGlyphs(line, p.size.fontInfo));
+            }
+        }
+
+        // Draw the graph. The frame times are scaled so that the target
+        // time is at the middle of the graph.
+        const Box2I& g2 = p.draw->g2;
+        const Box2I graph(g2.min.x, g2.min.y, g2.w(), p.size.graphHeight);
+        event.render->drawRect(graph, event.style->getColorRole(ColorRole::Window));
+        const float scale = p.targetTime > 0.F ?
+            (graph.h() / 2.F / p.targetTime) :
+            0.F;
+        if (p.frameCount > 0 && !p.frameTimes.empty())
+        {
+            std::vector<Box2F> bars;
+            std::vector<Box2F> slowBars;
+            const float w = graph.w() / static_cast<float>(p.frameCount);
+            const size_t offset = p.frameCount - p.frameTimes.size();
+            for (size_t i = 0; i < p.frameTimes.size(); ++i)
+            {
+                const float h = std::min(p.frameTimes[i] * scale, static_cast<float>(graph.h()));
+                const Box2F box(
+                    graph.min.x + (offset + i) * w,
+                    graph.max.y + 1 - h,
+                    std::max(w - 1.F, 1.F),
+                    h);
+                if (p.frameTimes[i] > p.targetTime)
+                {
+                    slowBars.push_back(box);
+                }
+                else
+                {
+                    bars.push_back(box);
+                }
+            }
+            event.render->drawRects(bars, event.style->getColorRole(ColorRole::Checked));
+            event.render->drawRects(slowBars, event.style->getColorRole(ColorRole::Red));
+        }
+        const int y = graph.max.y + 1 - graph.h() / 2;
+        event.render->drawRect(
+            Box2I(graph.min.x, y, graph.w(), 1),
+            event.style->getColorRole(ColorRole::Text));
+
+        // Draw the text.
+        V2I pos(g2.min.x, graph.max.y + 1 + p.size.spacing);
+        for (const auto& glyphs : p.draw->glyphs)
+        {
+            event.render->drawText(
+                glyphs,
+                p.size.fontMetrics,
+                pos,
+                event.style->getColorRole(ColorRole::Text));
+            pos.y += p.size.fontMetrics.lineHeight;
+        }
+    }
+
+    void ProfileWidget::_update()
+    {
+        FEATHER_TK_P();
+
+        p.frameTimes.clear();
+        std::vector<std::string> lines;
+        if (p.profileSystem->isEnabled())
+        {
+            auto frames = p.profileSystem->getFrames();
+            if (frames.size() > p.frameCount)
+            {
+                frames.erase(frames.begin(), frames.end() - p.frameCount);
+            }
+
+            // Average the events by name and depth, in the order they
+            // first appear.
+            struct Average
+            {
+                std::string name;
+                int depth = 0;
+                bool gpu = false;
+                int64_t total = 0;
+            };
+            std::vector<Average> averages;
+            int64_t total = 0;
+            int64_t max = 0;
+            for (const auto& frame : frames)
+            {
+                p.frameTimes.push_back(frame.duration / 1000.F);
+                total += frame.duration;
+                max = std::max(max, frame.duration);
+                for (const auto& event : frame.events)
+                {
+                    auto i = std::find_if(
+                        averages.begin(),
+                        averages.end(),
+                        [&event](const Average& value)
+                        {
+                            return
+                                value.name == event.name &&
+                                value.depth == event.depth &&
+                                value.gpu == event.gpu;
+                        });
+                    if (i == averages.end())
+                    {
+                        Average average;
+                        average.name = event.name;
+                        average.depth = event.depth;
+                        average.gpu = event.gpu;
+                        i = averages.insert(averages.end(), average);
+                    }
+                    i->total += event.duration;
+                }
+            }
+
+            const size_t size = std::max(frames.size(), static_cast<size_t>(1));
+            const float average = total / 1000.F / size;
+            lines.push_back(Format("Frame: {0}ms, max {1}ms").
+                arg(average, 2, 6).
+                arg(max / 1000.F, 2, 6));
+            for (const auto& i : averages)
+            {
+                lines.push_back(Format("{0}{1}{2}: {3}ms").
+                    arg(std::string(2 + i.depth * 2, ' ')).
+                    arg(std::string(i.gpu ? "GPU " : "")).
+                    arg(i.name).
+                    arg(i.total / 1000.F / size, 2, 6));
+            }
+        }
+        else
+        {
+            lines.push_back("Profiling disabled");
+        }
+
+        if (lines != p.lines)
+        {
+            // The numbers are padded to a fixed width, so the size only
+            // needs to be updated when the layout of the lines changes.
+            bool sizeUpdate = lines.size() != p.lines.size();
+            for (size_t i = 0; i < lines.size() && !sizeUpdate; ++i)
+            {
+                sizeUpdate = lines[i].size() != p.lines[i].size();
+            }
+            p.lines = lines;
+            if (p.draw.has_value())
+            {
+                p.draw->glyphs.clear();
+            }
+            if (sizeUpdate)
+            {
+                _setSizeUpdate();
+            }
+            _setDrawUpdate();
+        }
+    }
+}
\ No newline at end of file
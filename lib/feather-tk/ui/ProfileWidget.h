@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <feather-tk/ui/IWidget.h>
+
+namespace feather_tk
+{
+    //! \name Chart Widgets
+    ///@{
+
+    //! Profile widget.
+    //!
+    //! The profile widget shows a graph of the recent frame times from the
+    //! profile system, and the average time spent in each phase of the
+    //! frame. The widget is only updated while profiling is enabled.
+    class ProfileWidget : public IWidget
+    {
+    protected:
+        void _init(
+            const std::shared_ptr<Context>&,
+            const std::shared_ptr<IWidget>& parent);
+
+        ProfileWidget();
+
+    public:
+        virtual ~ProfileWidget();
+
+        //! Create a new widget.
+        static std::shared_ptr<ProfileWidget> create(
+            const std::shared_ptr<Context>&,
+            const std::shared_ptr<IWidget>& parent = nullptr);
+
+        //! Get the number of frames shown in the graph.
+        size_t getFrameCount() const;
+
+        //! Set the number of frames shown in the graph.
+        void setFrameCount(size_t);
+
+        //! Get the target frame time in milliseconds, which is shown as a
+        //! line in the graph.
+        float getTargetTime() const;
+
+        //! Set the target frame time in milliseconds.
+        void setTargetTime(float);
+
+        void setGeometry(const Box2I&) override;
+        void sizeHintEvent(const SizeHintEvent&) override;
+        void clipEvent(const Box2I&, bool) override;
+        void drawEvent(const Box2I&, const DrawEvent&) override;
+
+    private:
+        void _update();
+
+        FEATHER_TK_PRIVATE();
+    };
+
+    ///@}
+}
\ No newline at end of file
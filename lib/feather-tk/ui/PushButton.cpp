@@ -28,11 +28,18 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F mesh;
-            TriMesh2F border;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
+
+        struct MeshData
+        {
+            Size2I size;
+            int borderWidth = 0;
+            std::shared_ptr<RenderMesh> mesh;
+            std::shared_ptr<RenderMesh> border;
+        };
+        MeshData mesh;
     };
 
     void PushButton::_init(
@@ -169,36 +176,55 @@ namespace feather_tk
                 -(p.size.margin + p.size.border),
                 -(p.size.margin + p.size.pad + p.size.border),
                 -(p.size.margin + p.size.border));
-            p.draw->mesh = rect(p.draw->g);
-            p.draw->border = border(p.draw->g, p.size.border);
         }
 
+        // The meshes are retained by the renderer and built at the origin,
+        // so they are only uploaded again when the size, the border, or
+        // the renderer changes.
+        const Size2I& size = p.draw->g.size();
+        if (!p.mesh.mesh ||
+            p.mesh.mesh->getRender() != event.render ||
+            p.mesh.size != size ||
+            p.mesh.borderWidth != p.size.border)
+        {
+            const Box2I g(V2I(), size);
+            p.mesh.size = size;
+            p.mesh.borderWidth = p.size.border;
+            p.mesh.mesh = event.render->createMesh(rect(g));
+            p.mesh.border = event.render->createMesh(border(g, p.size.border));
+        }
+        const V2F pos = convert(p.draw->g.min);
+
         // Draw the background.
         const ColorRole colorRole = _checked ? _checkedRole : _buttonRole;
         if (colorRole != ColorRole::None)
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(colorRole));
+                p.mesh.mesh,
+                event.style->getColorRole(colorRole),
+                pos);
         }
 
         // Draw the focus and border.
         event.render->drawMesh(
-            p.draw->border,
-            event.style->getColorRole(hasKeyFocus() ? ColorRole::KeyFocus : ColorRole::Border));
+            p.mesh.border,
+            event.style->getColorRole(hasKeyFocus() ? ColorRole::KeyFocus : ColorRole::Border),
+            pos);
 
         // Draw the mouse states.
         if (_isMousePressed())
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(ColorRole::Pressed));
+                p.mesh.mesh,
+                event.style->getColorRole(ColorRole::Pressed),
+                pos);
         }
         else if (_isMouseInside())
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(ColorRole::Hover));
+                p.mesh.mesh,
+                event.style->getColorRole(ColorRole::Hover),
+                pos);
         }
 
         // Draw the icon and text.
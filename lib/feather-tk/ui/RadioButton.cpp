@@ -32,9 +32,9 @@ namespace feather_tk
             Box2I g2;
             Box2I g3;
             Box2I g4;
-            TriMesh2F border;
-            TriMesh2F button0;
-            TriMesh2F button1;
+            CompactMesh2F border;
+            CompactMesh2F button0;
+            CompactMesh2F button1;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
@@ -37,11 +37,18 @@ namespace feather_tk
         {
             Box2I g;
             Box2I g2;
-            TriMesh2F mesh;
-            TriMesh2F border;
             std::vector<std::shared_ptr<Glyph> > glyphs;
         };
         std::optional<DrawData> draw;
+
+        struct MeshData
+        {
+            Size2I size;
+            int borderWidth = 0;
+            std::shared_ptr<RenderMesh> mesh;
+            std::shared_ptr<RenderMesh> border;
+        };
+        MeshData mesh;
     };
 
     void ToolButton::_init(
@@ -267,39 +274,58 @@ namespace feather_tk
             {
                 p.draw->g2 = margin(p.draw->g2, -p.size.border);
             }
-            p.draw->mesh = rect(p.draw->g);
-            p.draw->border = border(p.draw->g, p.size.border);
         }
 
+        // The meshes are retained by the renderer and built at the origin,
+        // so they are only uploaded again when the size, the border, or
+        // the renderer changes.
+        const Size2I& size = p.draw->g.size();
+        if (!p.mesh.mesh ||
+            p.mesh.mesh->getRender() != event.render ||
+            p.mesh.size != size ||
+            p.mesh.borderWidth != p.size.border)
+        {
+            const Box2I g(V2I(), size);
+            p.mesh.size = size;
+            p.mesh.borderWidth = p.size.border;
+            p.mesh.mesh = event.render->createMesh(rect(g));
+            p.mesh.border = event.render->createMesh(border(g, p.size.border));
+        }
+        const V2F pos = convert(p.draw->g.min);
+
         // Draw the background.
         const ColorRole colorRole = _checked ? _checkedRole : _buttonRole;
         if (colorRole != ColorRole::None)
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(colorRole));
+                p.mesh.mesh,
+                event.style->getColorRole(colorRole),
+                pos);
         }
 
         // Draw the focus.
         if (hasKeyFocus())
         {
             event.render->drawMesh(
-                p.draw->border,
-                event.style->getColorRole(ColorRole::KeyFocus));
+                p.mesh.border,
+                event.style->getColorRole(ColorRole::KeyFocus),
+                pos);
         }
 
         // Draw the mouse states.
         if (_isMousePressed())
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(ColorRole::Pressed));
+                p.mesh.mesh,
+                event.style->getColorRole(ColorRole::Pressed),
+                pos);
         }
         else if (_isMouseInside())
         {
             event.render->drawMesh(
-                p.draw->mesh,
-                event.style->getColorRole(ColorRole::Hover));
+                p.mesh.mesh,
+                event.style->getColorRole(ColorRole::Hover),
+                pos);
         }
 
         // Draw the icon.
@@ -30,8 +30,8 @@ namespace feather_tk
         struct DrawData
         {
             Box2I g;
-            TriMesh2F shadow;
-            TriMesh2F border;
+            CompactMesh2F shadow;
+            CompactMesh2F border;
         };
         std::optional<DrawData> draw;
     };
@@ -77,7 +77,17 @@ namespace feather_tk
         //! automatically.
         void setDisplayScale(float);
 
-        //! Update the window.
+        //! Get whether the regions that are redrawn are displayed for
+        //! debugging.
+        bool getDrawRectsVisible() const;
+
+        //! Set whether the regions that are redrawn are displayed for
+        //! debugging.
+        void setDrawRectsVisible(bool);
+
+        //! Update the window. Only the regions of the window that contain
+        //! widgets needing a draw update are redrawn, unless the layout has
+        //! changed.
         virtual void update(
             const std::shared_ptr<FontSystem>&,
             const std::shared_ptr<IconSystem>&,
@@ -13,6 +13,7 @@
 #include <feather-tk/gl/Shader.h>
 #endif // FEATHER_TK_API_GLES_2
 
+#include <feather-tk/ui/DrawUtil.h>
 #include <feather-tk/ui/IClipboard.h>
 #include <feather-tk/ui/IconSystem.h>
 #include <feather-tk/ui/Style.h>
@@ -21,6 +22,7 @@
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/LogSystem.h>
 #include <feather-tk/core/FontSystem.h>
+#include <feather-tk/core/ProfileSystem.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -32,6 +34,80 @@ namespace feather_tk
 {
     namespace
     {
+        const size_t drawRectsMax = 16;
+
+        std::vector<Box2I> mergeDrawRects(const std::vector<Box2I>& rects)
+        {
+            std::vector<Box2I> out = rects;
+            bool merged = true;
+            while (merged)
+            {
+                merged = false;
+                for (size_t i = 0; i < out.size() && !merged; ++i)
+                {
+                    for (size_t j = i + 1; j < out.size() && !merged; ++j)
+                    {
+                        if (intersects(out[i], out[j]))
+                        {
+                            out[i] = expand(out[i], out[j]);
+                            out.erase(out.begin() + j);
+                            merged = true;
+                        }
+                    }
+                }
+            }
+            if (out.size() > drawRectsMax)
+            {
+                Box2I rect = out.front();
+                for (size_t i = 1; i < out.size(); ++i)
+                {
+                    rect = expand(rect, out[i]);
+                }
+                out = { rect };
+            }
+            return out;
+        }
+
+#if defined(FEATHER_TK_API_GL_4_1)
+        //! GPU timer query. The results are read back in later frames so
+        //! that the pipeline is not stalled.
+        struct GPUQuery
+        {
+            GLuint id = 0;
+            uint64_t frame = 0;
+            int64_t start = 0;
+            bool pending = false;
+        };
+
+        const size_t gpuQueryCount = 4;
+
+        void readGPUQueries(
+            std::vector<GPUQuery>& queries,
+            const std::shared_ptr<ProfileSystem>& profileSystem)
+        {
+            for (auto& query : queries)
+            {
+                if (query.pending)
+                {
+                    GLint available = 0;
+                    glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+                    if (available)
+                    {
+                        GLuint64 ns = 0;
+                        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &ns);
+                        ProfileEvent event;
+                        event.name = "Draw";
+                        event.start = query.start;
+                        event.duration = static_cast<int64_t>(ns / 1000);
+                        event.gpu = true;
+                        profileSystem->addEvent(query.frame, event);
+                        query.pending = false;
+                    }
+                }
+            }
+        }
+#endif // FEATHER_TK_API_GL_4_1
+
         class Clipboard : public IClipboard
         {
         protected:
@@ -203,6 +279,13 @@ namespace feather_tk
         V2F contentScale = V2F(1.F, 1.F);
         std::shared_ptr<ObservableValue<float> > displayScale;
         bool refresh = true;
+        bool sizeUpdateAll = true;
+        float sizeUpdateDisplayScale = 0.F;
+        std::weak_ptr<Style> style;
+        std::shared_ptr<ValueObserver<bool> > styleObserver;
+        bool fullDraw = true;
+        std::vector<Box2I> drawRects;
+        bool drawRectsVisible = false;
         int modifiers = 0;
         std::shared_ptr<gl::Window> window;
         std::function<void(void)> closeCallback;
@@ -212,6 +295,12 @@ namespace feather_tk
 #if defined(FEATHER_TK_API_GLES_2)
         std::shared_ptr<gl::Shader> shader;
 #endif // FEATHER_TK_API_GLES_2
+
+        std::shared_ptr<ProfileSystem> profileSystem;
+#if defined(FEATHER_TK_API_GL_4_1)
+        std::vector<GPUQuery> gpuQueries;
+        size_t gpuQueryIndex = 0;
+#endif // FEATHER_TK_API_GL_4_1
     };
 
     void Window::_init(
@@ -228,6 +317,7 @@ namespace feather_tk
         p.floatOnTop = ObservableValue<bool>::create(false);
         p.bufferType = ObservableValue<ImageType>::create(gl::offscreenColorDefault);
         p.displayScale = ObservableValue<float>::create(0.F);
+        p.profileSystem = context->getSystem<ProfileSystem>();
 
         p.window = gl::Window::create(
             context,
@@ -365,6 +455,12 @@ namespace feather_tk
         p.window->makeCurrent();
         p.render.reset();
         p.buffer.reset();
+#if defined(FEATHER_TK_API_GL_4_1)
+        for (const auto& query : p.gpuQueries)
+        {
+            glDeleteQueries(1, &query.id);
+        }
+#endif // FEATHER_TK_API_GL_4_1
         p.window->doneCurrent();
     }
 
@@ -472,30 +568,98 @@ namespace feather_tk
         }
     }
 
+    bool Window::getDrawRectsVisible() const
+    {
+        return _p->drawRectsVisible;
+    }
+
+    void Window::setDrawRectsVisible(bool value)
+    {
+        FEATHER_TK_P();
+        if (value == p.drawRectsVisible)
+            return;
+        p.drawRectsVisible = value;
+        p.refresh = true;
+    }
+
     void Window::update(
         const std::shared_ptr<FontSystem>& fontSystem,
         const std::shared_ptr<IconSystem>& iconSystem,
         const std::shared_ptr<Style>& style)
     {
         FEATHER_TK_P();
-        if (_hasSizeUpdate(shared_from_this()))
+        if (style != p.style.lock())
+        {
+            p.style = style;
+            p.styleObserver = ValueObserver<bool>::create(
+                style->observeChanged(),
+                [this](bool)
+                {
+                    _p->sizeUpdateAll = true;
+                    _setSizeUpdate();
+                    _setDrawUpdate();
+                });
+        }
+        const float displayScale = getDisplayScale();
+        if (displayScale != p.sizeUpdateDisplayScale)
+        {
+            p.sizeUpdateAll = true;
+            p.sizeUpdateDisplayScale = displayScale;
+        }
+        if (p.sizeUpdateAll || _hasSizeUpdate(shared_from_this()))
         {
-            SizeHintEvent sizeHintEvent(
-                fontSystem,
-                iconSystem,
-                getDisplayScale(),
-                style);
-            _sizeHintEventRecursive(shared_from_this(), sizeHintEvent);
-
-            setGeometry(Box2I(V2I(), p.bufferSize));
-
-            _clipEventRecursive(
-                shared_from_this(),
-                getGeometry(),
-                !isVisible(false));
+            // Widgets may cache values that depend on the display scale
+            // and style, so all of the widgets are updated when those
+            // change. Otherwise only the widgets that need a size update,
+            // and their parents, are updated.
+            const bool all = p.sizeUpdateAll;
+            {
+                ProfileTimer timer(p.profileSystem, "Size Hint");
+                SizeHintEvent sizeHintEvent(
+                    fontSystem,
+                    iconSystem,
+                    displayScale,
+                    style);
+                _sizeHintEventRecursive(
+                    shared_from_this(),
+                    sizeHintEvent,
+                    p.sizeUpdateAll);
+                p.sizeUpdateAll = false;
+            }
+
+            {
+                ProfileTimer timer(p.profileSystem, "Geometry");
+                setGeometry(Box2I(V2I(), p.bufferSize));
+            }
+
+            {
+                ProfileTimer timer(p.profileSystem, "Clip");
+                _clipEventRecursive(
+                    shared_from_this(),
+                    getGeometry(),
+                    !isVisible(false));
+            }
+
+            // Widgets that change geometry set a draw update, and their
+            // previous geometry is redrawn with them, so a full redraw is
+            // only needed when all of the widgets are updated.
+            if (all)
+            {
+                p.fullDraw = true;
+            }
         }
 
-        const bool drawUpdate = _hasDrawUpdate(shared_from_this());
+        // Find the regions that need to be redrawn, this also clears the
+        // draw update flags of the widgets that are clipped.
+        const Box2I rect(V2I(), p.bufferSize);
+        bool drawUpdate = false;
+        if (_hasDrawUpdate(shared_from_this()))
+        {
+            ProfileTimer timer(p.profileSystem, "Draw Rects");
+            p.drawRects.clear();
+            _getDrawRects(shared_from_this(), rect, p.drawRects);
+            drawUpdate = p.fullDraw || !p.drawRects.empty();
+        }
         if (p.refresh || drawUpdate)
         {
             p.window->makeCurrent();
@@ -505,25 +669,82 @@ namespace feather_tk
             if (gl::doCreate(p.buffer, p.bufferSize, bufferOptions))
             {
                 p.buffer = gl::OffscreenBuffer::create(p.bufferSize, bufferOptions);
+                p.fullDraw = true;
             }
 
             if (p.buffer && drawUpdate)
             {
-                gl::OffscreenBufferBinding bufferBinding(p.buffer);
-                p.render->begin(p.bufferSize);
-                p.render->setClipRectEnabled(true);
-                DrawEvent drawEvent(
-                    fontSystem,
-                    iconSystem,
-                    getDisplayScale(),
-                    style,
-                    p.render);
-                _drawEventRecursive(
-                    shared_from_this(),
-                    Box2I(V2I(), p.bufferSize),
-                    drawEvent);
-                p.render->setClipRectEnabled(false);
-                p.render->end();
+                // The offscreen buffer is kept between updates, so only the
+                // regions with widgets that need a draw update are redrawn.
+                if (p.fullDraw)
+                {
+                    p.drawRects = { rect };
+                }
+                else
+                {
+                    p.drawRects = mergeDrawRects(p.drawRects);
+                }
+                p.fullDraw = false;
+
+                if (!p.drawRects.empty())
+                {
+                    ProfileTimer timer(p.profileSystem, "Draw");
+#if defined(FEATHER_TK_API_GL_4_1)
+                    GPUQuery* gpuQuery = nullptr;
+                    if (p.profileSystem->isEnabled())
+                    {
+                        readGPUQueries(p.gpuQueries, p.profileSystem);
+                        if (p.gpuQueries.empty())
+                        {
+                            p.gpuQueries.resize(gpuQueryCount);
+                            for (auto& query : p.gpuQueries)
+                            {
+                                glGenQueries(1, &query.id);
+                            }
+                        }
+                        auto& query = p.gpuQueries[p.gpuQueryIndex];
+                        if (!query.pending)
+                        {
+                            // If all of the queries are still pending the
+                            // GPU timing for this frame is skipped.
+                            gpuQuery = &query;
+                            gpuQuery->frame = p.profileSystem->getFrameID();
+                            gpuQuery->start = p.profileSystem->getTime();
+                            gpuQuery->pending = true;
+                            glBeginQuery(GL_TIME_ELAPSED, gpuQuery->id);
+                            p.gpuQueryIndex = (p.gpuQueryIndex + 1) % gpuQueryCount;
+                        }
+                    }
+#endif // FEATHER_TK_API_GL_4_1
+                    gl::OffscreenBufferBinding bufferBinding(p.buffer);
+                    RenderOptions renderOptions;
+                    renderOptions.clear = false;
+                    p.render->begin(p.bufferSize, renderOptions);
+                    p.render->setClipRectEnabled(true);
+                    DrawEvent drawEvent(
+                        fontSystem,
+                        iconSystem,
+                        getDisplayScale(),
+                        style,
+                        p.render);
+                    for (const auto& drawRect : p.drawRects)
+                    {
+                        p.render->setClipRect(drawRect);
+                        p.render->clearViewport(renderOptions.clearColor);
+                        _drawEventRecursive(
+                            shared_from_this(),
+                            drawRect,
+                            drawEvent);
+                    }
+                    p.render->setClipRectEnabled(false);
+                    p.render->end();
+#if defined(FEATHER_TK_API_GL_4_1)
+                    if (gpuQuery)
+                    {
+                        glEndQuery(GL_TIME_ELAPSED);
+                    }
+#endif // FEATHER_TK_API_GL_4_1
+                }
             }
 
 #if defined(FEATHER_TK_API_GL_4_1)
@@ -630,7 +851,24 @@ namespace feather_tk
             }
 #endif // FEATHER_TK_API_GL_4_1
 
-            p.window->swap();
+            if (p.drawRectsVisible && !p.drawRects.empty())
+            {
+                RenderOptions renderOptions;
+                renderOptions.clear = false;
+                p.render->begin(p.bufferSize, renderOptions);
+                for (const auto& drawRect : p.drawRects)
+                {
+                    p.render->drawMesh(
+                        border(drawRect, 2),
+                        Color4F(1.F, 0.F, 0.F, .5F));
+                }
+                p.render->end();
+            }
+
+            {
+                ProfileTimer timer(p.profileSystem, "Swap");
+                p.window->swap();
+            }
             //! \todo Is this necessary?
             //p.window->doneCurrent();
 
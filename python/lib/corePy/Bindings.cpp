@@ -13,6 +13,7 @@
 #include <corePy/IRender.h>
 #include <corePy/ISystem.h>
 #include <corePy/Image.h>
+#include <corePy/ImageIO.h>
 #include <corePy/Memory.h>
 #include <corePy/Observable.h>
 #include <corePy/ObservableList.h>
@@ -46,6 +47,7 @@ namespace feather_tk
         iApp(m);
         iRender(m);
         image(m);
+        imageIO(m);
         memory(m);
         observable(m);
         observableList(m);
@@ -71,6 +71,11 @@ namespace feather_tk
                 "getGlyphs",
                 &FontSystem::getGlyphs,
                 py::arg("text"),
+                py::arg("fontInfo"))
+            .def(
+                "prefetchGlyphs",
+                &FontSystem::prefetchGlyphs,
+                py::arg("text"),
                 py::arg("fontInfo"));
     }
 }
\ No newline at end of file
@@ -21,6 +21,9 @@ namespace feather_tk
             .def("getExeName", &IApp::getExeName)
             .def("getExit", &IApp::getExit)
             .def("getContext", &IApp::getContext)
-            .def("run", &IApp::run);
+            .def(
+                "run",
+                &IApp::run,
+                py::call_guard<py::gil_scoped_release>());
     }
 }
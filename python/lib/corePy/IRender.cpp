@@ -5,6 +5,7 @@
 #include <corePy/IRender.h>
 
 #include <feather-tk/core/IRender.h>
+#include <feather-tk/core/SoftwareRender.h>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
@@ -68,5 +69,14 @@ namespace feather_tk
                 py::arg("fontMetrics"),
                 py::arg("position"),
                 py::arg("color") = Color4F(1.F, 1.F, 1.F, 1.F));
+
+        py::class_<SoftwareRender, IRender, std::shared_ptr<SoftwareRender> >(m, "SoftwareRender")
+            .def(
+                py::init(&SoftwareRender::create),
+                py::arg("context"),
+                py::arg("threadCount") = 0)
+            .def_property_readonly("threadCount", &SoftwareRender::getThreadCount)
+            .def_property_readonly("image", &SoftwareRender::getImage)
+            .def("flush", &SoftwareRender::flush);
     }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <corePy/Image.h>
 
 #include <feather-tk/core/Image.h>
+#include <feather-tk/core/Memory.h>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
@@ -14,6 +15,163 @@ namespace py = pybind11;
 
 namespace feather_tk
 {
+    namespace
+    {
+        //! Get the buffer format for an image type. YUV and packed 4-bit
+        //! types return an empty format, and are accessed as bytes.
+        std::string getBufferFormat(const ImageInfo& info, size_t& itemSize)
+        {
+            std::string out;
+            itemSize = 0;
+            switch (info.type)
+            {
+            case ImageType::L_U8:
+            case ImageType::LA_U8:
+            case ImageType::RGB_U8:
+            case ImageType::RGBA_U8:
+                out = "B";
+                itemSize = 1;
+                break;
+            case ImageType::L_U16:
+            case ImageType::LA_U16:
+            case ImageType::RGB_U16:
+            case ImageType::RGBA_U16:
+                out = "H";
+                itemSize = 2;
+                break;
+            case ImageType::L_U32:
+            case ImageType::LA_U32:
+            case ImageType::RGB_U10:
+            case ImageType::RGB_U32:
+            case ImageType::RGBA_U32:
+                out = "I";
+                itemSize = 4;
+                break;
+            case ImageType::L_F16:
+            case ImageType::LA_F16:
+            case ImageType::RGB_F16:
+            case ImageType::RGBA_F16:
+                out = "e";
+                itemSize = 2;
+                break;
+            case ImageType::L_F32:
+            case ImageType::LA_F32:
+            case ImageType::RGB_F32:
+            case ImageType::RGBA_F32:
+                out = "f";
+                itemSize = 4;
+                break;
+            default: break;
+            }
+            if (itemSize > 1 && info.layout.endian != getEndian())
+            {
+                out.insert(0, Endian::MSB == info.layout.endian ? ">" : "<");
+            }
+            return out;
+        }
+
+        //! Get a buffer for an image. The buffer has the shape (height,
+        //! width, channels), the row stride includes the layout alignment,
+        //! and mirrored layouts use negative strides so that the first row
+        //! is the top of the image.
+        py::buffer_info getBuffer(Image& image)
+        {
+            const ImageInfo& info = image.getInfo();
+            size_t itemSize = 0;
+            const std::string format = getBufferFormat(info, itemSize);
+            if (format.empty() || !info.isValid())
+            {
+                return py::buffer_info(
+                    image.getData(),
+                    1,
+                    py::format_descriptor<uint8_t>::format(),
+                    1,
+                    { static_cast<py::ssize_t>(image.getByteCount()) },
+                    { static_cast<py::ssize_t>(1) });
+            }
+            const size_t w = info.size.w;
+            const size_t h = info.size.h;
+            const size_t channels = ImageType::RGB_U10 == info.type ?
+                1 :
+                getChannelCount(info.type);
+            const size_t pixelBytes = channels * itemSize;
+            const size_t rowBytes = getAlignedByteCount(w * pixelBytes, info.layout.alignment);
+            uint8_t* data = image.getData();
+            py::ssize_t xStride = pixelBytes;
+            py::ssize_t yStride = rowBytes;
+            if (info.layout.mirror.x)
+            {
+                data += (w - 1) * pixelBytes;
+                xStride = -xStride;
+            }
+            if (info.layout.mirror.y)
+            {
+                data += (h - 1) * rowBytes;
+                yStride = -yStride;
+            }
+            return py::buffer_info(
+                data,
+                itemSize,
+                format,
+                3,
+                {
+                    static_cast<py::ssize_t>(h),
+                    static_cast<py::ssize_t>(w),
+                    static_cast<py::ssize_t>(channels)
+                },
+                {
+                    yStride,
+                    xStride,
+                    static_cast<py::ssize_t>(itemSize)
+                });
+        }
+
+        //! Keeps a Python buffer alive while an image uses its data.
+        struct ImageBuffer
+        {
+            std::shared_ptr<Image> image;
+            py::buffer_info buffer;
+
+            ~ImageBuffer()
+            {
+                if (Py_IsInitialized())
+                {
+                    py::gil_scoped_acquire acquire;
+                    buffer = py::buffer_info();
+                }
+            }
+        };
+
+        //! Create an image that uses the data of a Python buffer without
+        //! copying. The buffer must be writable, C contiguous, and large
+        //! enough for the image.
+        std::shared_ptr<Image> createImage(const ImageInfo& info, const py::buffer& data)
+        {
+            auto imageBuffer = std::make_shared<ImageBuffer>();
+            imageBuffer->buffer = data.request(true);
+            const py::buffer_info& buffer = imageBuffer->buffer;
+            py::ssize_t size = buffer.itemsize;
+            for (py::ssize_t i = buffer.ndim - 1; i >= 0; --i)
+            {
+                if (buffer.shape[i] > 1 && buffer.strides[i] != size)
+                {
+                    throw py::value_error("The buffer is not C contiguous");
+                }
+                size *= buffer.shape[i];
+            }
+            if (static_cast<size_t>(size) < info.getByteCount())
+            {
+                throw py::value_error("The buffer is too small for the image");
+            }
+            imageBuffer->image = Image::create(info, static_cast<uint8_t*>(buffer.ptr));
+
+            // The image shares ownership with the buffer, so the buffer is
+            // released when the last reference to the image is released,
+            // from either Python or C++.
+            return std::shared_ptr<Image>(imageBuffer, imageBuffer->image.get());
+        }
+    }
+
     void image(py::module_& m)
     {
         py::enum_<ImageType>(m, "ImageType")
@@ -98,8 +256,12 @@ namespace feather_tk
 
         py::class_<ImageTags>(m, "ImageTags");
 
-        py::class_<Image, std::shared_ptr<Image> >(m, "Image")
+        py::class_<Image, std::shared_ptr<Image> >(m, "Image", py::buffer_protocol())
             .def(py::init(py::overload_cast<const ImageInfo&>(&Image::create)))
+            .def(
+                py::init(&createImage),
+                py::arg("info"),
+                py::arg("data"))
             .def(py::init(py::overload_cast<const Size2I&, ImageType>(&Image::create)))
             .def(py::init(py::overload_cast<int, int, ImageType>(&Image::create)))
             .def_property_readonly("info", &Image::getInfo)
@@ -111,6 +273,10 @@ namespace feather_tk
             .def_property_readonly("valid", &Image::isValid)
             .def_property("tags", &Image::getTags, &Image::setTags)
             .def_property_readonly("byteCount", &Image::getByteCount)
-            .def("zero", &Image::zero);
+            .def("zero", &Image::zero)
+            .def_buffer([](Image& image)
+                {
+                    return getBuffer(image);
+                });
     }
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <corePy/ImageIO.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/ImageIO.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+
+namespace py = pybind11;
+
+namespace feather_tk
+{
+    void imageIO(py::module_& m)
+    {
+        py::class_<IImageReader, std::shared_ptr<IImageReader> >(m, "IImageReader")
+            .def_property_readonly("info", &IImageReader::getInfo)
+            .def(
+                "read",
+                py::overload_cast<>(&IImageReader::read),
+                py::call_guard<py::gil_scoped_release>());
+
+        py::class_<IImageWriter, std::shared_ptr<IImageWriter> >(m, "IImageWriter")
+            .def(
+                "write",
+                &IImageWriter::write,
+                py::arg("image"),
+                py::call_guard<py::gil_scoped_release>());
+
+        py::class_<ImageIO, ISystem, std::shared_ptr<ImageIO> >(m, "ImageIO")
+            .def_property_readonly("threadCount", &ImageIO::getThreadCount)
+            .def(
+                "read",
+                py::overload_cast<
+                    const std::filesystem::path&,
+                    const ImageIOOptions&>(&ImageIO::read),
+                py::arg("path"),
+                py::arg("options") = ImageIOOptions(),
+                py::call_guard<py::gil_scoped_release>())
+            .def(
+                "write",
+                &ImageIO::write,
+                py::arg("path"),
+                py::arg("info"),
+                py::arg("options") = ImageIOOptions(),
+                py::call_guard<py::gil_scoped_release>());
+    }
+}
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include <uiPy/IWindow.h>
 #include <uiPy/Icon.h>
 #include <uiPy/IconSystem.h>
+#include <uiPy/ImageWidget.h>
 #include <uiPy/IntEdit.h>
 #include <uiPy/IntEditSlider.h>
 #include <uiPy/IntModel.h>
@@ -116,6 +117,7 @@ namespace feather_tk
         groupBox(m);
         icon(m);
         iconSystem(m);
+        imageWidget(m);
         intEdit(m);
         intEditSlider(m);
         intModel(m);
@@ -18,7 +18,9 @@ namespace feather_tk
         py::class_<IconSystem, ISystem, std::shared_ptr<IconSystem> >(m, "IconSystem")
             .def(
                 py::init(&IconSystem::create),
-                py::arg("context"))
+                py::arg("context"),
+                py::arg("threadCount") = 0)
+            .def_property_readonly("threadCount", &IconSystem::getThreadCount)
             .def_property_readonly("names", &IconSystem::getNames)
             .def(
                 "add",
@@ -29,6 +31,11 @@ namespace feather_tk
                 "get",
                 &IconSystem::get,
                 py::arg("name"),
-                py::arg("displayScale"));
+                py::arg("displayScale"))
+            .def(
+                "preload",
+                &IconSystem::preload,
+                py::arg("names"),
+                py::arg("displayScales"));
     }
 }
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <uiPy/ImageWidget.h>
+
+#include <feather-tk/ui/ImageWidget.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+namespace feather_tk
+{
+    void imageWidget(py::module_& m)
+    {
+        py::class_<ImageWidget, IWidget, std::shared_ptr<ImageWidget> >(m, "ImageWidget")
+            .def(
+                py::init(&ImageWidget::create),
+                py::arg("context"),
+                py::arg("parent") = nullptr)
+            .def_property("image", &ImageWidget::getImage, &ImageWidget::setImage)
+            .def_property("marginRole", &ImageWidget::getMarginRole, &ImageWidget::setMarginRole);
+    }
+}
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+namespace feather_tk
+{
+    void imageWidget(pybind11::module_&);
+}
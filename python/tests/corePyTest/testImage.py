@@ -0,0 +1,74 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2024 Darby Johnston
+# All rights reserved.
+
+import feather_tk as ftk
+
+import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+class ImageTest(unittest.TestCase):
+
+    def test_buffer(self):
+        image = ftk.Image(4, 2, ftk.RGB_U8)
+        m = memoryview(image)
+        self.assertEqual(m.format, "B")
+        self.assertEqual(m.shape, (2, 4, 3))
+        self.assertEqual(m.strides, (12, 3, 1))
+        self.assertFalse(m.readonly)
+        image.zero()
+        m[1, 3, 2] = 7
+        self.assertEqual(m.tobytes()[-1], 7)
+
+        image = ftk.Image(2, 2, ftk.RGBA_F32)
+        m = memoryview(image)
+        self.assertEqual(m.format, "f")
+        self.assertEqual(m.shape, (2, 2, 4))
+        self.assertEqual(m.strides, (32, 16, 4))
+
+    def test_layout(self):
+        info = ftk.ImageInfo(3, 2, ftk.L_U8)
+        layout = ftk.ImageLayout()
+        layout.alignment = 4
+        info.layout = layout
+        m = memoryview(ftk.Image(info))
+        self.assertEqual(m.shape, (2, 3, 1))
+        self.assertEqual(m.strides, (4, 1, 1))
+
+        layout.mirror = ftk.ImageMirror(False, True)
+        info.layout = layout
+        m = memoryview(ftk.Image(info))
+        self.assertEqual(m.strides, (-4, 1, 1))
+
+        m = memoryview(ftk.Image(4, 4, ftk.YUV_420P_U8))
+        self.assertEqual(m.shape, (24,))
+
+    def test_external(self):
+        data = bytearray(2 * 2 * 4)
+        image = ftk.Image(ftk.ImageInfo(2, 2, ftk.RGBA_U8), data)
+        memoryview(image)[0, 1, 2] = 9
+        self.assertEqual(data[6], 9)
+        data[0] = 3
+        self.assertEqual(memoryview(image)[0, 0, 0], 3)
+
+        with self.assertRaises(ValueError):
+            ftk.Image(ftk.ImageInfo(4, 4, ftk.RGBA_U8), bytearray(4))
+        with self.assertRaises(BufferError):
+            ftk.Image(ftk.ImageInfo(1, 1, ftk.L_U8), bytes(1))
+
+    @unittest.skipIf(numpy is None, "NumPy is not available")
+    def test_numpy(self):
+        a = numpy.zeros((2, 3, 4), dtype=numpy.uint16)
+        image = ftk.Image(ftk.ImageInfo(3, 2, ftk.RGBA_U16), a)
+        b = numpy.asarray(image)
+        self.assertEqual(b.shape, (2, 3, 4))
+        self.assertEqual(b.dtype, numpy.uint16)
+        b[1, 2, 3] = 1000
+        self.assertEqual(a[1, 2, 3], 1000)
+
+        with self.assertRaises(ValueError):
+            ftk.Image(ftk.ImageInfo(3, 2, ftk.RGBA_U16), a[:, ::2])
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/DirSystemTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/DirSystem.h>
+#include <feather-tk/core/Format.h>
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        DirSystemTest::DirSystemTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::DirSystemTest")
+        {}
+
+        DirSystemTest::~DirSystemTest()
+        {}
+
+        std::shared_ptr<DirSystemTest> DirSystemTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<DirSystemTest>(new DirSystemTest(context));
+        }
+
+        void DirSystemTest::run()
+        {
+            {
+                DirEntry a;
+                DirEntry b;
+                b.path = "b";
+                FEATHER_TK_ASSERT(a == a);
+                FEATHER_TK_ASSERT(a != b);
+            }
+            if (auto context = _context.lock())
+            {
+                auto system = context->getSystem<DirSystem>();
+                const std::filesystem::path path =
+                    std::filesystem::temp_directory_path() / "DirSystemTest";
+                std::filesystem::remove_all(path);
+                std::filesystem::create_directory(path);
+                std::filesystem::create_directory(path / "dir");
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    std::ofstream(path / Format("file{0}.txt").arg(i).str()) << "test";
+                }
+
+                std::vector<DirEntry> entries;
+                bool complete = false;
+                system->scan(
+                    path,
+                    [&entries, &complete](const std::vector<DirEntry>& value, bool done)
+                    {
+                        entries.insert(entries.end(), value.begin(), value.end());
+                        complete = done;
+                    });
+                auto t0 = std::chrono::steady_clock::now();
+                while (!complete &&
+                    std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+                {
+                    context->tick();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                FEATHER_TK_ASSERT(complete);
+                FEATHER_TK_ASSERT(11 == entries.size());
+                size_t dirs = 0;
+                for (const auto& entry : entries)
+                {
+                    if (entry.isDir)
+                    {
+                        ++dirs;
+                    }
+                    else
+                    {
+                        FEATHER_TK_ASSERT(4 == entry.size);
+                    }
+                }
+                FEATHER_TK_ASSERT(1 == dirs);
+
+                std::vector<DirEntry> cache;
+                FEATHER_TK_ASSERT(system->getCache(path, cache));
+                FEATHER_TK_ASSERT(cache.size() == entries.size());
+
+                entries.clear();
+                complete = false;
+                system->scan(
+                    path,
+                    [&entries, &complete](const std::vector<DirEntry>& value, bool done)
+                    {
+                        entries = value;
+                        complete = done;
+                    });
+                FEATHER_TK_ASSERT(complete);
+                FEATHER_TK_ASSERT(11 == entries.size());
+
+                if (system->hasWatcher())
+                {
+                    bool changed = false;
+                    auto observer = ValueObserver<std::filesystem::path>::create(
+                        system->observeChanged(),
+                        [path, &changed](const std::filesystem::path& value)
+                        {
+                            changed |= std::filesystem::equivalent(value, path);
+                        },
+                        ObserverAction::Suppress);
+                    std::ofstream(path / "file10.txt") << "test";
+                    t0 = std::chrono::steady_clock::now();
+                    while (!changed &&
+                        std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+                    {
+                        context->tick();
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }
+                    FEATHER_TK_ASSERT(changed);
+                    FEATHER_TK_ASSERT(!system->getCache(path, cache));
+                }
+
+                system->invalidate(path);
+                FEATHER_TK_ASSERT(!system->getCache(path, cache));
+                const uint64_t id = system->scan(
+                    path,
+                    [](const std::vector<DirEntry>&, bool)
+                    {
+                        FEATHER_TK_ASSERT(false);
+                    });
+                system->cancel(id);
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    context->tick();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+
+                system->clearCache();
+                system->setCacheMax(10);
+                FEATHER_TK_ASSERT(10 == system->getCacheMax());
+                system->setCacheMax(100);
+
+                std::filesystem::remove_all(path);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class DirSystemTest : public test::ITest
+        {
+        protected:
+            DirSystemTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~DirSystemTest();
+
+            static std::shared_ptr<DirSystemTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+        };
+    }
+}
\ No newline at end of file
@@ -9,6 +9,15 @@
 #include <feather-tk/core/FontSystem.h>
 #include <feather-tk/core/Format.h>
 
+#include <chrono>
+#include <future>
+#include <thread>
+
+namespace feather_tk_resource
+{
+    extern std::vector<uint8_t> NotoSansRegular;
+}
+
 namespace feather_tk
 {
     namespace core_test
@@ -68,6 +77,115 @@ namespace feather_tk
                     arg(fontSystem->getGlyphCachePercentage()));
             }
             if (auto context = _context.lock())
+            {
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo info("NotoSans-Regular", 16);
+                const std::string s = "Hello world\nThe quick brown fox";
+                const size_t size = fontSystem->getLayoutCacheSize();
+                auto layout = fontSystem->getLayout(s, info);
+                FEATHER_TK_ASSERT(layout == fontSystem->getLayout(s, info));
+                FEATHER_TK_ASSERT(fontSystem->getLayoutCacheSize() == size + 1);
+                FEATHER_TK_ASSERT(s.size() == layout->glyphs.size());
+                FEATHER_TK_ASSERT(s.size() == layout->boxes.size());
+                FEATHER_TK_ASSERT(2 == layout->lines.size());
+                FEATHER_TK_ASSERT(layout->size == fontSystem->getSize(s, info));
+
+                // Layouts of long text are charged by size, and the largest
+                // ones are not cached.
+                const size_t byteCount = fontSystem->getLayoutCacheByteCount();
+                FEATHER_TK_ASSERT(byteCount > s.size());
+                const std::string s2(1000, 'x');
+                fontSystem->getLayout(s2, info);
+                FEATHER_TK_ASSERT(fontSystem->getLayoutCacheByteCount() > byteCount + s2.size());
+                const std::string s3(1000000, 'x');
+                fontSystem->getLayout(s3, info);
+                FEATHER_TK_ASSERT(fontSystem->getLayoutCacheSize() == size + 2);
+
+                auto wrapped = fontSystem->getLayout(s, info, 1);
+                FEATHER_TK_ASSERT(wrapped != layout);
+                FEATHER_TK_ASSERT(s.size() == wrapped->glyphs.size());
+                FEATHER_TK_ASSERT(s.size() == wrapped->boxes.size());
+                FEATHER_TK_ASSERT(wrapped->lines.size() > layout->lines.size());
+                const FontMetrics metrics = fontSystem->getMetrics(info);
+                FEATHER_TK_ASSERT(wrapped->size.h == wrapped->lines.size() * metrics.lineHeight);
+            }
+            if (auto context = _context.lock())
+            {
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo info("NotoSans-Regular", 20);
+                const std::string s = "abcdefghijklmnopqrstuvwxyz";
+                const size_t size = fontSystem->getGlyphCacheSize();
+                fontSystem->prefetchGlyphs(s, info);
+                const auto t0 = std::chrono::steady_clock::now();
+                while (fontSystem->getGlyphCacheSize() < size + s.size() &&
+                    std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                FEATHER_TK_ASSERT(fontSystem->getGlyphCacheSize() == size + s.size());
+                fontSystem->prefetchGlyphs(s, info);
+                FEATHER_TK_ASSERT(fontSystem->getGlyphCacheSize() == size + s.size());
+            }
+            if (auto context = _context.lock())
+            {
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo info("NotoSansMono-Regular", 12);
+                const std::string s = "The quick brown fox jumps over the lazy dog.";
+                const Size2I size = fontSystem->getSize(s, info);
+                std::vector<std::future<Size2I> > futures;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    futures.push_back(std::async(
+                        std::launch::async,
+                        [fontSystem, s, i]
+                        {
+                            return fontSystem->getSize(s, FontInfo("NotoSansMono-Regular", 12 + i % 2));
+                        }));
+                }
+                for (size_t i = 0; i < futures.size(); ++i)
+                {
+                    const Size2I threadSize = futures[i].get();
+                    if (0 == i % 2)
+                    {
+                        FEATHER_TK_ASSERT(size == threadSize);
+                    }
+                }
+            }
+            if (auto context = _context.lock())
+            {
+                // Transient threads reuse the faces in the pool.
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo info("NotoSans-Bold", 14);
+                fontSystem->getMetrics(info);
+                const size_t facePoolSize = fontSystem->getFacePoolSize();
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    std::thread thread(
+                        [fontSystem, info]
+                        {
+                            fontSystem->getMetrics(info);
+                        });
+                    thread.join();
+                }
+                FEATHER_TK_ASSERT(facePoolSize == fontSystem->getFacePoolSize());
+            }
+            if (auto context = _context.lock())
+            {
+                // Layouts requested before a font is added are replaced
+                // when it is added.
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo info("FontSystemTest", 14);
+                const std::string s = "The quick brown fox jumps over the lazy dog.";
+                FEATHER_TK_ASSERT(Size2I() == fontSystem->getSize(s, info));
+                const size_t layoutCacheSize = fontSystem->getLayoutCacheSize();
+                fontSystem->addFont(
+                    "FontSystemTest",
+                    feather_tk_resource::NotoSansRegular.data(),
+                    feather_tk_resource::NotoSansRegular.size());
+                FEATHER_TK_ASSERT(layoutCacheSize - 1 == fontSystem->getLayoutCacheSize());
+                FEATHER_TK_ASSERT(fontSystem->getSize(s, info).w > 0);
+            }
+            if (auto context = _context.lock())
             {
                 auto fontSystem = context->getSystem<FontSystem>();
                 try
@@ -9,6 +9,10 @@
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/ImageIO.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace feather_tk
 {
     namespace core_test
@@ -30,6 +34,7 @@ namespace feather_tk
         {
             _members();
             _functions();
+            _requests();
         }
         
         namespace
@@ -59,7 +64,10 @@ namespace feather_tk
                 auto io = context->getSystem<ImageIO>();
                 auto dummy = DummyPlugin::create();
                 io->addPlugin(dummy);
-                for (const auto& plugin : io->getPlugins())
+                const auto plugins = io->getPlugins();
+                FEATHER_TK_ASSERT(!plugins.empty());
+                FEATHER_TK_ASSERT(dummy == plugins.front());
+                for (const auto& plugin : plugins)
                 {
                     _print(Format("Plugin: {0}").arg(plugin->getName()));
                 }
@@ -77,6 +85,111 @@ namespace feather_tk
             FEATHER_TK_ASSERT(options3["Layer"] == "1");
             FEATHER_TK_ASSERT(options3["Compression"] == "RLE");
         }
+
+        void ImageIOTest::_requests()
+        {
+            if (auto context = _context.lock())
+            {
+                auto io = ImageIO::create(context, 4);
+                FEATHER_TK_ASSERT(4 == io->getThreadCount());
+
+                std::vector<std::filesystem::path> paths;
+                for (int i = 0; i < 10; ++i)
+                {
+                    const ImageInfo info(16 + i, 16, ImageType::RGB_U8);
+                    auto image = Image::create(info);
+                    image->zero();
+                    const std::filesystem::path path = Format(
+                        "ImageIOTest_{0}.png").arg(i).str();
+                    io->write(path, info)->write(image);
+                    paths.push_back(path);
+                }
+
+                std::atomic<int> rows(0);
+                std::vector<ImageRequest> requests;
+                for (size_t i = 0; i < paths.size(); ++i)
+                {
+                    requests.push_back(io->request(
+                        paths[i],
+                        ImageIOOptions(),
+                        [&rows](const std::shared_ptr<Image>&, int, int count)
+                        {
+                            rows += count;
+                        },
+                        0 == i % 2));
+                }
+                for (size_t i = 0; i < requests.size(); ++i)
+                {
+                    auto image = requests[i].future.get();
+                    FEATHER_TK_ASSERT(image);
+                    FEATHER_TK_ASSERT(Size2I(16 + static_cast<int>(i), 16) == image->getSize());
+                    FEATHER_TK_ASSERT(ImageType::RGB_U8 == image->getType());
+                }
+                FEATHER_TK_ASSERT(16 * 10 == rows);
+
+                auto request = io->request("ImageIOTest_Missing.png");
+                try
+                {
+                    request.future.get();
+                    FEATHER_TK_ASSERT(false);
+                }
+                catch (const std::exception& e)
+                {
+                    _print(Format("Error: {0}").arg(e.what()));
+                }
+
+                request = io->request("ImageIOTest.unknown");
+                FEATHER_TK_ASSERT(!request.future.get());
+
+                // Block the worker thread so the other requests stay
+                // queued, then cancel all of the requests.
+                io = ImageIO::create(context, 1);
+                std::atomic<bool> started(false);
+                std::atomic<bool> release(false);
+                auto blocked = io->request(
+                    paths[0],
+                    ImageIOOptions(),
+                    [&started, &release](const std::shared_ptr<Image>&, int, int)
+                    {
+                        started = true;
+                        while (!release)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                    });
+                while (!started)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                requests.clear();
+                for (size_t i = 1; i < paths.size(); ++i)
+                {
+                    requests.push_back(io->request(paths[i]));
+                }
+                std::vector<uint64_t> ids;
+                ids.push_back(blocked.id);
+                for (const auto& request : requests)
+                {
+                    ids.push_back(request.id);
+                }
+                io->cancelRequests(ids);
+                for (auto& request : requests)
+                {
+                    FEATHER_TK_ASSERT(!request.future.get());
+                }
+
+                // The request that was already running is not cancelled.
+                release = true;
+                auto image = blocked.future.get();
+                FEATHER_TK_ASSERT(image);
+                FEATHER_TK_ASSERT(Size2I(16, 16) == image->getSize());
+
+                // New requests are not affected by the cancelled ones.
+                request = io->request(paths[1]);
+                image = request.future.get();
+                FEATHER_TK_ASSERT(image);
+                FEATHER_TK_ASSERT(Size2I(17, 16) == image->getSize());
+            }
+        }
     }
 }
-
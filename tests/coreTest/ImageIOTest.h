@@ -26,6 +26,7 @@ namespace feather_tk
         private:
             void _members();
             void _functions();
+            void _requests();
         };
     }
 }
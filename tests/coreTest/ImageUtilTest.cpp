@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/ImageUtilTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ImageUtil.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        ImageUtilTest::ImageUtilTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::ImageUtilTest")
+        {}
+
+        ImageUtilTest::~ImageUtilTest()
+        {}
+
+        std::shared_ptr<ImageUtilTest> ImageUtilTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<ImageUtilTest>(new ImageUtilTest(context));
+        }
+        
+        void ImageUtilTest::run()
+        {
+            _convert();
+            _premultiply();
+            _mirror();
+            _resize();
+        }
+
+        namespace
+        {
+            //! Create an opaque gray image with 2x2 blocks of the same
+            //! value, so that it survives conversion to any type.
+            std::shared_ptr<Image> createGray(const ImageInfo& info)
+            {
+                auto out = Image::create(info);
+                uint8_t* p = out->getData();
+                for (int y = 0; y < info.size.h; ++y)
+                {
+                    for (int x = 0; x < info.size.w; ++x, p += 4)
+                    {
+                        const uint8_t v = ((x / 2) * 16 + (y / 2) * 7) % 256;
+                        p[0] = v;
+                        p[1] = v;
+                        p[2] = v;
+                        p[3] = 255;
+                    }
+                }
+                return out;
+            }
+
+            bool compare(
+                const std::shared_ptr<Image>& a,
+                const std::shared_ptr<Image>& b,
+                int tolerance)
+            {
+                bool out = a->getByteCount() == b->getByteCount();
+                for (size_t i = 0; out && i < a->getByteCount(); ++i)
+                {
+                    out = std::abs(a->getData()[i] - b->getData()[i]) <= tolerance;
+                }
+                return out;
+            }
+        }
+
+        void ImageUtilTest::_convert()
+        {
+            for (auto type : getImageTypeEnums())
+            {
+                if (ImageType::None == type)
+                    continue;
+                int tolerance = 1;
+                switch (type)
+                {
+                case ImageType::ARGB_4444_Premult: tolerance = 9; break;
+                case ImageType::YUV_420P_U8:
+                case ImageType::YUV_422P_U8:
+                case ImageType::YUV_444P_U8: tolerance = 3; break;
+                default: break;
+                }
+                for (auto videoLevels : getVideoLevelsEnums())
+                {
+                    ImageInfo info(16, 16, ImageType::RGBA_U8);
+                    info.videoLevels = videoLevels;
+                    auto image = createGray(info);
+                    auto tmp = convert(image, type);
+                    FEATHER_TK_ASSERT(type == tmp->getType());
+                    auto out = convert(tmp, ImageType::RGBA_U8);
+                    FEATHER_TK_ASSERT(VideoLevels::FullRange == out->getInfo().videoLevels);
+                    _print(Format("Convert: {0} {1}").arg(getLabel(type)).arg(getLabel(videoLevels)));
+                    FEATHER_TK_ASSERT(compare(image, out, tolerance));
+                }
+            }
+            {
+                auto image = Image::create(2, 1, ImageType::RGB_U8);
+                const uint8_t data[] = { 1, 2, 3, 4, 5, 6 };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = convert(image, ImageType::RGBA_U8);
+                const uint8_t result[] = { 1, 2, 3, 255, 4, 5, 6, 255 };
+                FEATHER_TK_ASSERT(0 == memcmp(out->getData(), result, sizeof(result)));
+                out = convert(out, ImageType::RGB_U8);
+                FEATHER_TK_ASSERT(0 == memcmp(out->getData(), data, sizeof(data)));
+            }
+            {
+                auto image = Image::create(2, 1, ImageType::LA_U8);
+                const uint8_t data[] = { 1, 2, 3, 4 };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = convert(image, ImageType::RGBA_U8);
+                const uint8_t result[] = { 1, 1, 1, 2, 3, 3, 3, 4 };
+                FEATHER_TK_ASSERT(0 == memcmp(out->getData(), result, sizeof(result)));
+            }
+            {
+                ImageInfo info(3, 3, ImageType::RGB_U8);
+                info.layout.alignment = 4;
+                auto image = Image::create(info);
+                image->zero();
+                for (int y = 0; y < 3; ++y)
+                {
+                    for (int x = 0; x < 9; ++x)
+                    {
+                        image->getData()[y * 12 + x] = y * 9 + x;
+                    }
+                }
+                auto out = convert(image, ImageType::RGBA_U8);
+                FEATHER_TK_ASSERT(4 == out->getInfo().layout.alignment);
+                FEATHER_TK_ASSERT(24 == out->getData()[2 * 12 + 8]);
+                FEATHER_TK_ASSERT(26 == out->getData()[2 * 12 + 10]);
+            }
+            {
+                ImageInfo info(1, 1, ImageType::RGBA_U16);
+                info.layout.endian = opposite(getEndian());
+                auto image = Image::create(info);
+                const uint8_t data[] = { 0x12, 0x34, 0, 0, 0xff, 0xff, 0xff, 0xff };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = convert(image, ImageType::RGBA_F32);
+                FEATHER_TK_ASSERT(getEndian() == out->getInfo().layout.endian);
+                float values[4];
+                memcpy(values, out->getData(), sizeof(values));
+                FEATHER_TK_ASSERT(std::fabs(values[0] - 0x1234 / 65535.F) < 1e-6F);
+                FEATHER_TK_ASSERT(0.F == values[1]);
+                FEATHER_TK_ASSERT(1.F == values[3]);
+            }
+            {
+                auto image = Image::create(4, 1, ImageType::L_F32);
+                const float data[] = { .5F, -2.F, 65504.F, .00001F };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = convert(convert(image, ImageType::L_F16), ImageType::L_F32);
+                float values[4];
+                memcpy(values, out->getData(), sizeof(values));
+                FEATHER_TK_ASSERT(.5F == values[0]);
+                FEATHER_TK_ASSERT(-2.F == values[1]);
+                FEATHER_TK_ASSERT(65504.F == values[2]);
+                FEATHER_TK_ASSERT(std::fabs(values[3] - .00001F) < .0000001F);
+            }
+            {
+                auto image = Image::create(2, 2, ImageType::RGBA_U8);
+                auto out = Image::create(1, 1, ImageType::RGBA_U8);
+                try
+                {
+                    convert(image, out);
+                    FEATHER_TK_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        void ImageUtilTest::_premultiply()
+        {
+            {
+                auto image = Image::create(1, 1, ImageType::RGBA_U8);
+                const uint8_t data[] = { 200, 100, 50, 128 };
+                memcpy(image->getData(), data, sizeof(data));
+                premultiply(image);
+                const uint8_t result[] = { 100, 50, 25, 128 };
+                FEATHER_TK_ASSERT(0 == memcmp(image->getData(), result, sizeof(result)));
+                unpremultiply(image);
+                for (size_t i = 0; i < sizeof(data); ++i)
+                {
+                    FEATHER_TK_ASSERT(std::abs(image->getData()[i] - data[i]) <= 2);
+                }
+            }
+            {
+                auto image = Image::create(1, 1, ImageType::RGBA_F32);
+                const float data[] = { 1.F, .5F, .25F, .5F };
+                memcpy(image->getData(), data, sizeof(data));
+                premultiply(image);
+                float values[4];
+                memcpy(values, image->getData(), sizeof(values));
+                FEATHER_TK_ASSERT(.5F == values[0]);
+                FEATHER_TK_ASSERT(.25F == values[1]);
+                FEATHER_TK_ASSERT(.125F == values[2]);
+                FEATHER_TK_ASSERT(.5F == values[3]);
+                unpremultiply(image);
+                memcpy(values, image->getData(), sizeof(values));
+                FEATHER_TK_ASSERT(0 == memcmp(values, data, sizeof(data)));
+            }
+            {
+                auto image = Image::create(1, 1, ImageType::RGB_U8);
+                const uint8_t data[] = { 200, 100, 50 };
+                memcpy(image->getData(), data, sizeof(data));
+                premultiply(image);
+                FEATHER_TK_ASSERT(0 == memcmp(image->getData(), data, sizeof(data)));
+            }
+        }
+
+        void ImageUtilTest::_mirror()
+        {
+            {
+                auto image = Image::create(3, 2, ImageType::L_U8);
+                const uint8_t data[] = { 0, 1, 2, 3, 4, 5 };
+                memcpy(image->getData(), data, sizeof(data));
+                mirror(image, ImageMirror(true, false));
+                const uint8_t resultX[] = { 2, 1, 0, 5, 4, 3 };
+                FEATHER_TK_ASSERT(0 == memcmp(image->getData(), resultX, sizeof(resultX)));
+                mirror(image, ImageMirror(false, true));
+                const uint8_t resultY[] = { 5, 4, 3, 2, 1, 0 };
+                FEATHER_TK_ASSERT(0 == memcmp(image->getData(), resultY, sizeof(resultY)));
+            }
+            {
+                auto image = Image::create(2, 1, ImageType::RGBA_U16);
+                const uint16_t data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+                memcpy(image->getData(), data, sizeof(data));
+                mirror(image, ImageMirror(true, false));
+                const uint16_t result[] = { 5, 6, 7, 8, 1, 2, 3, 4 };
+                FEATHER_TK_ASSERT(0 == memcmp(image->getData(), result, sizeof(result)));
+            }
+            {
+                auto image = Image::create(4, 4, ImageType::YUV_420P_U8);
+                for (size_t i = 0; i < image->getByteCount(); ++i)
+                {
+                    image->getData()[i] = i;
+                }
+                mirror(image, ImageMirror(true, true));
+                FEATHER_TK_ASSERT(15 == image->getData()[0]);
+                FEATHER_TK_ASSERT(19 == image->getData()[16]);
+                FEATHER_TK_ASSERT(23 == image->getData()[20]);
+                mirror(image, ImageMirror(true, true));
+                for (size_t i = 0; i < image->getByteCount(); ++i)
+                {
+                    FEATHER_TK_ASSERT(i == image->getData()[i]);
+                }
+            }
+        }
+
+        void ImageUtilTest::_resize()
+        {
+            {
+                auto image = Image::create(7, 5, ImageType::RGBA_U8);
+                uint8_t* p = image->getData();
+                for (int i = 0; i < 7 * 5; ++i, p += 4)
+                {
+                    p[0] = 10;
+                    p[1] = 20;
+                    p[2] = 30;
+                    p[3] = 255;
+                }
+                for (const auto& size : { Size2I(3, 2), Size2I(1, 1), Size2I(16, 9) })
+                {
+                    auto out = resize(image, size);
+                    FEATHER_TK_ASSERT(size == out->getSize());
+                    FEATHER_TK_ASSERT(ImageType::RGBA_U8 == out->getType());
+                    p = out->getData();
+                    for (int i = 0; i < size.w * size.h; ++i, p += 4)
+                    {
+                        FEATHER_TK_ASSERT(10 == p[0]);
+                        FEATHER_TK_ASSERT(20 == p[1]);
+                        FEATHER_TK_ASSERT(30 == p[2]);
+                        FEATHER_TK_ASSERT(255 == p[3]);
+                    }
+                }
+            }
+            {
+                auto image = Image::create(4, 1, ImageType::L_U8);
+                const uint8_t data[] = { 0, 255, 100, 200 };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = resize(image, Size2I(2, 1));
+                FEATHER_TK_ASSERT(128 == out->getData()[0]);
+                FEATHER_TK_ASSERT(150 == out->getData()[1]);
+            }
+            {
+                auto image = Image::create(2, 1, ImageType::RGBA_U8);
+                const uint8_t data[] = { 255, 0, 0, 255, 0, 255, 0, 0 };
+                memcpy(image->getData(), data, sizeof(data));
+                auto out = resize(image, Size2I(1, 1));
+                const uint8_t result[] = { 255, 0, 0, 128 };
+                FEATHER_TK_ASSERT(0 == memcmp(out->getData(), result, sizeof(result)));
+            }
+            {
+                auto image = Image::create(0, 0, ImageType::RGBA_U8);
+                auto out = resize(image, Size2I(1, 1));
+                FEATHER_TK_ASSERT(Size2I(1, 1) == out->getSize());
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class ImageUtilTest : public test::ITest
+        {
+        protected:
+            ImageUtilTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~ImageUtilTest();
+
+            static std::shared_ptr<ImageUtilTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+            
+        private:
+            void _convert();
+            void _premultiply();
+            void _mirror();
+            void _resize();
+        };
+    }
+}
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/LRUCache.h>
 
+#include <string>
+
 namespace feather_tk
 {
     namespace core_test
@@ -26,6 +28,12 @@ namespace feather_tk
         }
         
         void LRUCacheTest::run()
+        {
+            _members();
+            _evict();
+        }
+
+        void LRUCacheTest::_members()
         {
             LRUCache<int, bool> c;
             c.setMax(3);
@@ -69,6 +77,48 @@ namespace feather_tk
             c.setMax(2);
             FEATHER_TK_ASSERT(2 == c.getSize());
         }
-    }
-}
 
+        void LRUCacheTest::_evict()
+        {
+            LRUCache<std::string, int> c;
+            c.setMax(10);
+            std::vector<std::string> evicted;
+            c.setEvictCallback(
+                [&evicted](const std::string& key, int)
+                {
+                    evicted.push_back(key);
+                });
+            c.add("a", 0, 4);
+            c.add("b", 1, 4);
+            FEATHER_TK_ASSERT(8 == c.getSize());
+            int v = 0;
+            FEATHER_TK_ASSERT(c.get("a", v));
+            FEATHER_TK_ASSERT(0 == v);
+            FEATHER_TK_ASSERT(!c.get("c", v));
+            FEATHER_TK_ASSERT(1 == c.getHits());
+            FEATHER_TK_ASSERT(1 == c.getMisses());
+
+            c.add("c", 2, 4);
+            FEATHER_TK_ASSERT(1 == c.getEvictions());
+            FEATHER_TK_ASSERT(1 == evicted.size());
+            FEATHER_TK_ASSERT("b" == evicted[0]);
+            FEATHER_TK_ASSERT(8 == c.getSize());
+            FEATHER_TK_ASSERT("a" == c.getKeys()[0]);
+            FEATHER_TK_ASSERT("c" == c.getKeys()[1]);
+
+            c.add("a", 3, 2);
+            FEATHER_TK_ASSERT(6 == c.getSize());
+            FEATHER_TK_ASSERT("a" == c.getKeys()[1]);
+            FEATHER_TK_ASSERT(c.touch("c"));
+            FEATHER_TK_ASSERT("c" == c.getKeys()[1]);
+            c.remove("c");
+            FEATHER_TK_ASSERT(2 == c.getSize());
+            FEATHER_TK_ASSERT(1 == c.getEvictions());
+
+            c.resetStats();
+            FEATHER_TK_ASSERT(0 == c.getHits());
+            FEATHER_TK_ASSERT(0 == c.getMisses());
+            FEATHER_TK_ASSERT(0 == c.getEvictions());
+        }
+    }
+}
\ No newline at end of file
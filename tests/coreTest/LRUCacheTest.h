@@ -22,6 +22,10 @@ namespace feather_tk
                 const std::shared_ptr<Context>&);
 
             void run() override;
+
+        private:
+            void _members();
+            void _evict();
         };
     }
 }
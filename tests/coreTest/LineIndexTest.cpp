@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/LineIndexTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/FileIO.h>
+#include <feather-tk/core/LineIndex.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        LineIndexTest::LineIndexTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::LineIndexTest")
+        {}
+
+        LineIndexTest::~LineIndexTest()
+        {}
+
+        std::shared_ptr<LineIndexTest> LineIndexTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<LineIndexTest>(new LineIndexTest(context));
+        }
+        
+        void LineIndexTest::run()
+        {
+            _string();
+            _file();
+        }
+
+        void LineIndexTest::_string()
+        {
+            {
+                auto index = LineIndex::create(std::string());
+                FEATHER_TK_ASSERT(0 == index->getSize());
+                FEATHER_TK_ASSERT(0 == index->getLineCount());
+                FEATHER_TK_ASSERT(index->getLine(0).empty());
+            }
+            {
+                auto index = LineIndex::create("\n");
+                FEATHER_TK_ASSERT(1 == index->getLineCount());
+                FEATHER_TK_ASSERT(index->getLine(0).empty());
+            }
+            {
+                auto index = LineIndex::create("a\nbcd\r\n\nef");
+                FEATHER_TK_ASSERT(4 == index->getLineCount());
+                FEATHER_TK_ASSERT("a" == index->getLine(0));
+                FEATHER_TK_ASSERT("bcd" == index->getLine(1));
+                FEATHER_TK_ASSERT("" == index->getLine(2));
+                FEATHER_TK_ASSERT("ef" == index->getLine(3));
+                FEATHER_TK_ASSERT("b" == index->getLine(1, 1));
+                FEATHER_TK_ASSERT(1 == index->getMaxLine());
+            }
+            {
+                auto index = LineIndex::create("a\nb\n");
+                FEATHER_TK_ASSERT(2 == index->getLineCount());
+                FEATHER_TK_ASSERT("b" == index->getLine(1));
+            }
+            {
+                // Compare the parallel and serial results.
+                std::string text;
+                for (size_t i = 0; i < 200000; ++i)
+                {
+                    text += std::string(i % 50, 'x');
+                    text += '\n';
+                }
+                auto a = LineIndex::create(text, 1);
+                auto b = LineIndex::create(text, 8);
+                FEATHER_TK_ASSERT(200000 == a->getLineCount());
+                FEATHER_TK_ASSERT(a->getLineCount() == b->getLineCount());
+                FEATHER_TK_ASSERT(49 == b->getMaxLineLength());
+                for (size_t i = 0; i < b->getLineCount(); i += 997)
+                {
+                    FEATHER_TK_ASSERT(a->getLine(i) == b->getLine(i));
+                    FEATHER_TK_ASSERT(i % 50 == b->getLine(i).size());
+                }
+            }
+        }
+
+        void LineIndexTest::_file()
+        {
+            const std::filesystem::path path("LineIndexTest.txt");
+            writeLines(path, { "Line 0", "", "Line 2", std::string(10000, 'x') });
+            for (auto fileRead : { FileRead::MemoryMapped, FileRead::Normal })
+            {
+                auto index = LineIndex::create(FileIO::create(path, FileMode::Read, fileRead));
+                FEATHER_TK_ASSERT(4 == index->getLineCount());
+                FEATHER_TK_ASSERT("Line 0" == index->getLine(0));
+                FEATHER_TK_ASSERT("" == index->getLine(1));
+                FEATHER_TK_ASSERT("Line 2" == index->getLine(2));
+                FEATHER_TK_ASSERT(10000 == index->getLineLength(3));
+                FEATHER_TK_ASSERT(3 == index->getMaxLine());
+                FEATHER_TK_ASSERT(std::string(100, 'x') == index->getLine(3, 100));
+            }
+        }
+    }
+}
\ No newline at end of file
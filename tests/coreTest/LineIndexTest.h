@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class LineIndexTest : public test::ITest
+        {
+        protected:
+            LineIndexTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~LineIndexTest();
+
+            static std::shared_ptr<LineIndexTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+
+        private:
+            void _string();
+            void _file();
+        };
+    }
+}
+
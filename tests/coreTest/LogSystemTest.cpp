@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/LogSystemTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/FileIO.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/LogSystem.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        namespace
+        {
+            class TestSink : public ILogSink
+            {
+            public:
+                static std::shared_ptr<TestSink> create()
+                {
+                    return std::shared_ptr<TestSink>(new TestSink);
+                }
+
+                void write(const std::vector<LogItem>& value) override
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    items.insert(items.end(), value.begin(), value.end());
+                }
+
+                std::mutex mutex;
+                std::vector<LogItem> items;
+            };
+
+            class ErrorSink : public ILogSink
+            {
+            public:
+                static std::shared_ptr<ErrorSink> create()
+                {
+                    return std::shared_ptr<ErrorSink>(new ErrorSink);
+                }
+
+                void write(const std::vector<LogItem>&) override
+                {
+                    ++count;
+                    throw std::runtime_error("Cannot write");
+                }
+
+                std::atomic<size_t> count = { 0 };
+            };
+        }
+
+        LogSystemTest::LogSystemTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::LogSystemTest")
+        {}
+
+        LogSystemTest::~LogSystemTest()
+        {}
+
+        std::shared_ptr<LogSystemTest> LogSystemTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<LogSystemTest>(new LogSystemTest(context));
+        }
+        
+        void LogSystemTest::run()
+        {
+            _items();
+            _level();
+            _file();
+            _error();
+        }
+
+        void LogSystemTest::_items()
+        {
+            auto context = Context::create();
+            auto logSystem = context->getSystem<LogSystem>();
+            logSystem->tick();
+            std::vector<LogItem> observed;
+            auto observer = ListObserver<LogItem>::create(
+                logSystem->observeLogItems(),
+                [&observed](const std::vector<LogItem>& value)
+                {
+                    observed.insert(observed.end(), value.begin(), value.end());
+                });
+            observed.clear();
+            auto sink = TestSink::create();
+            logSystem->addSink(sink);
+
+            const std::string longMessage(1000, 'x');
+            logSystem->print("A", "Message");
+            logSystem->print("B", "Warning", LogType::Warning);
+            logSystem->print("A", longMessage, LogType::Error);
+            logSystem->tick();
+            FEATHER_TK_ASSERT(3 == observed.size());
+            FEATHER_TK_ASSERT("A" == observed[0].prefix);
+            FEATHER_TK_ASSERT("Message" == observed[0].message);
+            FEATHER_TK_ASSERT(LogType::Message == observed[0].type);
+            FEATHER_TK_ASSERT("B" == observed[1].prefix);
+            FEATHER_TK_ASSERT(LogType::Warning == observed[1].type);
+            FEATHER_TK_ASSERT(longMessage == observed[2].message);
+            FEATHER_TK_ASSERT(observed[2].time >= observed[0].time);
+            {
+                std::unique_lock<std::mutex> lock(sink->mutex);
+                FEATHER_TK_ASSERT(observed == sink->items);
+            }
+
+            // Messages printed from other threads.
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                threads.push_back(std::thread(
+                    [logSystem, i]
+                    {
+                        for (size_t j = 0; j < 100; ++j)
+                        {
+                            logSystem->print(
+                                Format("Thread {0}").arg(i),
+                                Format("{0}").arg(j));
+                        }
+                    }));
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            logSystem->flush();
+            {
+                std::unique_lock<std::mutex> lock(sink->mutex);
+                FEATHER_TK_ASSERT(403 == sink->items.size());
+                std::vector<int> counts(4, 0);
+                for (size_t i = 3; i < sink->items.size(); ++i)
+                {
+                    const auto& item = sink->items[i];
+                    const int thread = item.prefix.back() - '0';
+                    FEATHER_TK_ASSERT(std::to_string(counts[thread]) == item.message);
+                    ++counts[thread];
+                }
+            }
+
+            logSystem->removeSink(sink);
+            logSystem->print("A", "Message");
+            logSystem->flush();
+            {
+                std::unique_lock<std::mutex> lock(sink->mutex);
+                FEATHER_TK_ASSERT(403 == sink->items.size());
+            }
+        }
+
+        void LogSystemTest::_level()
+        {
+            auto context = Context::create();
+            auto logSystem = context->getSystem<LogSystem>();
+            logSystem->flush();
+            auto sink = TestSink::create();
+            logSystem->addSink(sink);
+
+            FEATHER_TK_ASSERT(LogType::Message == logSystem->getLevel());
+            FEATHER_TK_ASSERT(logSystem->isLogged(LogType::Message));
+            logSystem->setLevel(LogType::Warning);
+            FEATHER_TK_ASSERT(LogType::Warning == logSystem->getLevel());
+            FEATHER_TK_ASSERT(!logSystem->isLogged(LogType::Message));
+            FEATHER_TK_ASSERT(logSystem->isLogged(LogType::Error));
+            logSystem->print("A", "Message");
+            logSystem->print("A", "Warning", LogType::Warning);
+            logSystem->print("A", "Error", LogType::Error);
+            logSystem->flush();
+            std::unique_lock<std::mutex> lock(sink->mutex);
+            FEATHER_TK_ASSERT(2 == sink->items.size());
+            FEATHER_TK_ASSERT("Warning" == sink->items[0].message);
+            FEATHER_TK_ASSERT("Error" == sink->items[1].message);
+        }
+
+        void LogSystemTest::_file()
+        {
+            const std::filesystem::path path("LogSystemTest.log");
+            for (const auto& i : {
+                "LogSystemTest.log",
+                "LogSystemTest.log.1",
+                "LogSystemTest.log.2",
+                "LogSystemTest.log.3" })
+            {
+                std::error_code ec;
+                std::filesystem::remove(i, ec);
+            }
+            {
+                auto context = Context::create();
+                auto logSystem = context->getSystem<LogSystem>();
+                logSystem->addSink(FileLogSink::create(path, 1000, 2));
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    logSystem->print("feather_tk::core_test::LogSystemTest", Format("Message {0}").arg(i));
+                }
+                logSystem->flush();
+            }
+            FEATHER_TK_ASSERT(std::filesystem::exists(path));
+            FEATHER_TK_ASSERT(std::filesystem::file_size(path) <= 1000);
+            FEATHER_TK_ASSERT(std::filesystem::exists("LogSystemTest.log.1"));
+            FEATHER_TK_ASSERT(std::filesystem::exists("LogSystemTest.log.2"));
+            FEATHER_TK_ASSERT(!std::filesystem::exists("LogSystemTest.log.3"));
+            const auto lines = readLines(path);
+            FEATHER_TK_ASSERT(!lines.empty());
+            FEATHER_TK_ASSERT(lines.back().find("Message 99") != std::string::npos);
+        }
+
+        void LogSystemTest::_error()
+        {
+            auto context = Context::create();
+            auto logSystem = context->getSystem<LogSystem>();
+            logSystem->flush();
+            logSystem->tick();
+            std::vector<LogItem> observed;
+            auto observer = ListObserver<LogItem>::create(
+                logSystem->observeLogItems(),
+                [&observed](const std::vector<LogItem>& value)
+                {
+                    observed.insert(observed.end(), value.begin(), value.end());
+                });
+            observed.clear();
+            auto errorSink = ErrorSink::create();
+            errorSink->count = 0;
+            logSystem->addSink(errorSink);
+            auto sink = TestSink::create();
+            logSystem->addSink(sink);
+
+            // The sink that throws is removed and the error is logged.
+            logSystem->print("A", "Message");
+            logSystem->flush();
+            logSystem->print("A", "Message 2");
+            logSystem->flush();
+            logSystem->tick();
+            FEATHER_TK_ASSERT(1 == errorSink->count);
+            {
+                std::unique_lock<std::mutex> lock(sink->mutex);
+                FEATHER_TK_ASSERT(2 == sink->items.size());
+            }
+            bool error = false;
+            for (const auto& item : observed)
+            {
+                if (LogType::Error == item.type &&
+                    item.message.find("Cannot write") != std::string::npos)
+                {
+                    error = true;
+                }
+            }
+            FEATHER_TK_ASSERT(error);
+        }
+    }
+}
\ No newline at end of file
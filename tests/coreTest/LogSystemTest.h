@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class LogSystemTest : public test::ITest
+        {
+        protected:
+            LogSystemTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~LogSystemTest();
+
+            static std::shared_ptr<LogSystemTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+
+        private:
+            void _items();
+            void _level();
+            void _file();
+            void _error();
+        };
+    }
+}
+
@@ -58,6 +58,24 @@ namespace feather_tk
                 FEATHER_TK_ASSERT(3 == v.n);
                 FEATHER_TK_ASSERT(4 == v.c);
             }
+            {
+                CompactMesh2F m;
+                FEATHER_TK_ASSERT(!m.is32Bit());
+                FEATHER_TK_ASSERT(0 == m.getTriangleCount());
+                m.addTriangle(0, 1, 2);
+                FEATHER_TK_ASSERT(!m.is32Bit());
+                FEATHER_TK_ASSERT(3 == m.getIndexCount());
+                FEATHER_TK_ASSERT(1 == m.getTriangleCount());
+                m.addTriangle(2, 3, 65536);
+                FEATHER_TK_ASSERT(m.is32Bit());
+                FEATHER_TK_ASSERT(m.indices16.empty());
+                FEATHER_TK_ASSERT(6 == m.getIndexCount());
+                FEATHER_TK_ASSERT(2 == m.getTriangleCount());
+                FEATHER_TK_ASSERT(2 == m.getIndex(2));
+                FEATHER_TK_ASSERT(65536 == m.getIndex(5));
+                FEATHER_TK_ASSERT(m == m);
+                FEATHER_TK_ASSERT(m != CompactMesh2F());
+            }
         }
         
         void MeshTest::_functions()
@@ -68,6 +86,28 @@ namespace feather_tk
                 V2F(1.F, 1.F));
             const TriMesh2F m = mesh(Box2I(0, 1, 2, 3));
             const TriMesh2F m1 = mesh(Box2F(0.F, 1.F, 2.F, 3.F));
+            {
+                const TriMesh2F m2 = mesh(Box2I(0, 0, 100, 100));
+                const CompactMesh2F c = compactMesh(m2);
+                FEATHER_TK_ASSERT(4 == c.v.size());
+                FEATHER_TK_ASSERT(4 == c.t.size());
+                FEATHER_TK_ASSERT(c.c.empty());
+                FEATHER_TK_ASSERT(!c.is32Bit());
+                FEATHER_TK_ASSERT(m2.triangles.size() == c.getTriangleCount());
+                const TriMesh2F m3 = triMesh(c);
+                FEATHER_TK_ASSERT(m3.triangles.size() == m2.triangles.size());
+                for (size_t i = 0; i < m2.triangles.size(); ++i)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        const Vertex2& a = m2.triangles[i].v[j];
+                        const Vertex2& b = m3.triangles[i].v[j];
+                        FEATHER_TK_ASSERT(m2.v[a.v - 1] == m3.v[b.v - 1]);
+                        FEATHER_TK_ASSERT(m2.t[a.t - 1] == m3.t[b.t - 1]);
+                    }
+                }
+                FEATHER_TK_ASSERT(compactMesh(m3) == c);
+            }
         }
     }
 }
@@ -30,7 +30,10 @@ namespace feather_tk
         {
             _value();
             _list();
+            _listChanges();
             _map();
+            _mapChanges();
+            _append();
         }
         
         void ObservableTest::_value()
@@ -154,6 +157,219 @@ namespace feather_tk
             }
             FEATHER_TK_ASSERT(!omap->getObserversCount());
         }
+
+        void ObservableTest::_listChanges()
+        {
+            {
+                ListChange a;
+                ListChange b(ObservableChangeType::Insert, 1, 2);
+                FEATHER_TK_ASSERT(a == a);
+                FEATHER_TK_ASSERT(a != b);
+            }
+            auto olist = ObservableList<int>::create({ 0, 1, 2 });
+            std::vector<int> list;
+            std::vector<ListChange> changes;
+            size_t callbacks = 0;
+            auto observer = ListChangeObserver<int>::create(
+                olist,
+                [&list, &changes, &callbacks](
+                    const std::vector<int>& value,
+                    const std::vector<ListChange>& value2)
+                {
+                    list = value;
+                    changes = value2;
+                    ++callbacks;
+                });
+            FEATHER_TK_ASSERT(olist->getObserversCount());
+            FEATHER_TK_ASSERT(1 == callbacks);
+            FEATHER_TK_ASSERT(olist->get() == list);
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Reset) }) == changes);
+
+            olist->pushBack(3);
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Insert, 3, 1) }) == changes);
+            olist->insertItem(0, -1);
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Insert, 0, 1) }) == changes);
+            FEATHER_TK_ASSERT(std::vector<int>({ -1, 0, 1, 2, 3 }) == list);
+            olist->setItem(1, 10);
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Update, 1, 1) }) == changes);
+            callbacks = 0;
+            olist->setItemOnlyIfChanged(1, 10);
+            FEATHER_TK_ASSERT(0 == callbacks);
+            olist->removeItem(0);
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Remove, 0, 1) }) == changes);
+            FEATHER_TK_ASSERT(std::vector<int>({ 10, 1, 2, 3 }) == list);
+
+            // Only the changed range is reported.
+            olist->setIfChanged({ 10, 1, 5, 6, 7, 3 });
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Update, 2, 1),
+                ListChange(ObservableChangeType::Insert, 3, 2) }) == changes);
+            olist->setIfChanged({ 10, 3 });
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Remove, 1, 4) }) == changes);
+            olist->setAlways({ 10, 3 });
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Reset) }) == changes);
+
+            // Batches are coalesced into a single callback.
+            callbacks = 0;
+            olist->beginBatch();
+            olist->beginBatch();
+            for (int i = 0; i < 100; ++i)
+            {
+                olist->pushBack(i);
+            }
+            olist->endBatch();
+            FEATHER_TK_ASSERT(0 == callbacks);
+            olist->setItem(3, 0);
+            olist->setItem(4, 0);
+            olist->endBatch();
+            FEATHER_TK_ASSERT(1 == callbacks);
+            FEATHER_TK_ASSERT(102 == list.size());
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Insert, 2, 100),
+                ListChange(ObservableChangeType::Update, 3, 2) }) == changes);
+
+            olist->beginBatch();
+            for (int i = 0; i < 10; ++i)
+            {
+                olist->removeItem(0);
+            }
+            olist->endBatch();
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Remove, 0, 10) }) == changes);
+
+            // Many scattered changes are reported as a reset.
+            olist->setAlways({ 0, 1, 2, 3 });
+            olist->beginBatch();
+            olist->setItem(0, 1);
+            olist->setItem(2, 1);
+            olist->insertItem(0, 1);
+            olist->removeItem(4);
+            olist->setItem(3, 1);
+            olist->endBatch();
+            FEATHER_TK_ASSERT(std::vector<ListChange>({ ListChange(ObservableChangeType::Reset) }) == changes);
+
+            olist->clear();
+            FEATHER_TK_ASSERT(list.empty());
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Remove, 0, 4) }) == changes);
+
+            observer.reset();
+            FEATHER_TK_ASSERT(!olist->getObserversCount());
+        }
+
+        void ObservableTest::_mapChanges()
+        {
+            {
+                MapChange<int> a;
+                MapChange<int> b;
+                b.key = 1;
+                FEATHER_TK_ASSERT(a == a);
+                FEATHER_TK_ASSERT(a != b);
+            }
+            auto omap = ObservableMap<int, int>::create({ { 0, 0 }, { 1, 1 } });
+            std::map<int, int> map;
+            std::vector<MapChange<int> > changes;
+            size_t callbacks = 0;
+            auto observer = MapChangeObserver<int, int>::create(
+                omap,
+                [&map, &changes, &callbacks](
+                    const std::map<int, int>& value,
+                    const std::vector<MapChange<int> >& value2)
+                {
+                    map = value;
+                    changes = value2;
+                    ++callbacks;
+                });
+            FEATHER_TK_ASSERT(omap->getObserversCount());
+            FEATHER_TK_ASSERT(omap->get() == map);
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({ MapChange<int>() }) == changes);
+
+            omap->setItem(2, 2);
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({ { ObservableChangeType::Insert, 2 } }) == changes);
+            omap->setItem(2, 3);
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({ { ObservableChangeType::Update, 2 } }) == changes);
+            callbacks = 0;
+            omap->setItemOnlyIfChanged(2, 3);
+            omap->removeItem(3);
+            FEATHER_TK_ASSERT(0 == callbacks);
+            omap->removeItem(2);
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({ { ObservableChangeType::Remove, 2 } }) == changes);
+            FEATHER_TK_ASSERT(2 == map.size());
+
+            FEATHER_TK_ASSERT(omap->setIfChanged({ { 1, 2 }, { 3, 3 } }));
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({
+                { ObservableChangeType::Remove, 0 },
+                { ObservableChangeType::Update, 1 },
+                { ObservableChangeType::Insert, 3 } }) == changes);
+            FEATHER_TK_ASSERT(!omap->setIfChanged({ { 1, 2 }, { 3, 3 } }));
+
+            callbacks = 0;
+            omap->beginBatch();
+            omap->setItem(4, 4);
+            omap->removeItem(4);
+            omap->removeItem(3);
+            omap->setItem(3, 4);
+            omap->setItem(5, 5);
+            omap->endBatch();
+            FEATHER_TK_ASSERT(1 == callbacks);
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({
+                { ObservableChangeType::Update, 3 },
+                { ObservableChangeType::Insert, 5 } }) == changes);
+
+            omap->clear();
+            FEATHER_TK_ASSERT(map.empty());
+            FEATHER_TK_ASSERT(std::vector<MapChange<int> >({ MapChange<int>() }) == changes);
+
+            observer.reset();
+            FEATHER_TK_ASSERT(!omap->getObserversCount());
+        }
+
+        void ObservableTest::_append()
+        {
+            const size_t count = 1000;
+            auto olist = ObservableList<int>::create(std::vector<int>(count, 0));
+            std::vector<std::vector<ListChange> > changes;
+            size_t updated = 0;
+            auto observer = ListChangeObserver<int>::create(
+                olist,
+                [&changes, &updated](const std::vector<int>&, const std::vector<ListChange>& value)
+                {
+                    changes.push_back(value);
+                    for (const auto& change : value)
+                    {
+                        updated += ObservableChangeType::Reset == change.type ? 0 : change.count;
+                    }
+                });
+            FEATHER_TK_ASSERT(1 == changes.size());
+            FEATHER_TK_ASSERT(0 == updated);
+
+            // Each append should only notify the observers of the new item.
+            changes.clear();
+            const size_t appends = 100;
+            for (size_t i = 0; i < appends; ++i)
+            {
+                olist->pushBack(i);
+            }
+            FEATHER_TK_ASSERT(appends == updated);
+            FEATHER_TK_ASSERT(appends == changes.size());
+            for (size_t i = 0; i < changes.size(); ++i)
+            {
+                FEATHER_TK_ASSERT(std::vector<ListChange>({
+                    ListChange(ObservableChangeType::Insert, count + i, 1) }) == changes[i]);
+            }
+
+            // Setting a list with one new item should only insert that item.
+            changes.clear();
+            updated = 0;
+            std::vector<int> list = olist->get();
+            list.push_back(0);
+            FEATHER_TK_ASSERT(olist->setIfChanged(list));
+            FEATHER_TK_ASSERT(1 == updated);
+            FEATHER_TK_ASSERT(1 == changes.size());
+            FEATHER_TK_ASSERT(std::vector<ListChange>({
+                ListChange(ObservableChangeType::Insert, count + appends, 1) }) == changes[0]);
+        }
     }
 }
 
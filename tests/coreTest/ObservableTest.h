@@ -26,7 +26,10 @@ namespace feather_tk
         private:
             void _value();
             void _list();
+            void _listChanges();
             void _map();
+            void _mapChanges();
+            void _append();
         };
     }
 }
@@ -10,6 +10,8 @@
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/ImageIO.h>
 
+#include <cstring>
+
 namespace feather_tk
 {
     namespace core_test
@@ -102,6 +104,50 @@ namespace feather_tk
                         }
                     }
                 }
+                for (const bool interlace : { false, true })
+                {
+                    const ImageInfo info(37, 150, ImageType::RGBA_U8);
+                    auto image = Image::create(info);
+                    for (size_t i = 0; i < image->getByteCount(); ++i)
+                    {
+                        image->getData()[i] = i * 7;
+                    }
+                    const std::filesystem::path path = Format(
+                        "PNGTest_Interlace_{0}.png").
+                        arg(interlace).str();
+                    ImageIOOptions options;
+                    options["Interlace"] = interlace ? "1" : "0";
+                    auto write = io->write(path, info, options);
+                    write->write(image);
+                    write.reset();
+
+                    auto read = io->read(path);
+                    auto image2 = Image::create(read->getInfo());
+                    int callbacks = 0;
+                    int rows = 0;
+                    FEATHER_TK_ASSERT(read->read(
+                        image2,
+                        [&callbacks, &rows](const std::shared_ptr<Image>&, int, int count)
+                        {
+                            ++callbacks;
+                            rows += count;
+                        }));
+                    _print(Format("Interlace {0}: {1} callbacks").arg(interlace).arg(callbacks));
+                    FEATHER_TK_ASSERT(interlace ? 7 == callbacks : 3 == callbacks);
+                    FEATHER_TK_ASSERT(interlace ? 7 * 150 == rows : 150 == rows);
+                    // The writer flips the image vertically.
+                    const size_t rowByteCount = info.size.w * 4;
+                    for (int y = 0; y < info.size.h; ++y)
+                    {
+                        FEATHER_TK_ASSERT(0 == memcmp(
+                            image->getData() + y * rowByteCount,
+                            image2->getData() + (info.size.h - 1 - y) * rowByteCount,
+                            rowByteCount));
+                    }
+
+                    read = io->read(path);
+                    FEATHER_TK_ASSERT(!read->read(Image::create(1, 1, ImageType::RGBA_U8)));
+                }
             }
         }
     }
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/ProfileSystemTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/FileIO.h>
+#include <feather-tk/core/ProfileSystem.h>
+
+#include <nlohmann/json.hpp>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        ProfileSystemTest::ProfileSystemTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::ProfileSystemTest")
+        {}
+
+        ProfileSystemTest::~ProfileSystemTest()
+        {}
+
+        std::shared_ptr<ProfileSystemTest> ProfileSystemTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<ProfileSystemTest>(new ProfileSystemTest(context));
+        }
+        
+        void ProfileSystemTest::run()
+        {
+            _events();
+            _frames();
+            _trace();
+        }
+
+        void ProfileSystemTest::_events()
+        {
+            if (auto context = _context.lock())
+            {
+                auto system = context->getSystem<ProfileSystem>();
+                FEATHER_TK_ASSERT(system);
+                FEATHER_TK_ASSERT(!system->isEnabled());
+                system->clear();
+
+                system->beginFrame();
+                {
+                    ProfileTimer timer(system, "Disabled");
+                }
+                system->endFrame();
+                FEATHER_TK_ASSERT(system->getFrames().empty());
+
+                system->setEnabled(true);
+                const uint64_t id = system->getFrameID();
+                system->beginFrame();
+                {
+                    ProfileTimer timer(system, "A");
+                    {
+                        ProfileTimer timer2(system, "B");
+                    }
+                    {
+                        ProfileTimer timer2(system, "B");
+                    }
+                }
+                {
+                    ProfileTimer timer(system, "A");
+                }
+                system->endFrame();
+                ProfileEvent gpu;
+                gpu.name = "A";
+                gpu.duration = 10;
+                gpu.gpu = true;
+                FEATHER_TK_ASSERT(system->addEvent(id, gpu));
+                FEATHER_TK_ASSERT(!system->addEvent(id + 1, gpu));
+
+                const auto frame = system->getLastFrame();
+                FEATHER_TK_ASSERT(id == frame.id);
+                FEATHER_TK_ASSERT(5 == frame.events.size());
+                FEATHER_TK_ASSERT("A" == frame.events[0].name);
+                FEATHER_TK_ASSERT(0 == frame.events[0].depth);
+                FEATHER_TK_ASSERT("B" == frame.events[1].name);
+                FEATHER_TK_ASSERT(1 == frame.events[1].depth);
+                FEATHER_TK_ASSERT(frame.events[1].start >= frame.events[0].start);
+                FEATHER_TK_ASSERT(
+                    frame.events[1].start + frame.events[1].duration <=
+                    frame.events[0].start + frame.events[0].duration);
+                FEATHER_TK_ASSERT(
+                    frame.getDuration("A") ==
+                    frame.events[0].duration + frame.events[3].duration);
+                FEATHER_TK_ASSERT(0 == frame.getDuration("B"));
+                FEATHER_TK_ASSERT(10 == frame.getDuration("A", true));
+                FEATHER_TK_ASSERT(frame.duration >= frame.getDuration("A"));
+
+                // Unbalanced events are closed at the end of the frame.
+                system->beginFrame();
+                system->beginEvent("C");
+                system->endFrame();
+                FEATHER_TK_ASSERT(1 == system->getLastFrame().events.size());
+                system->endEvent();
+
+                system->setEnabled(false);
+                system->clear();
+            }
+        }
+
+        void ProfileSystemTest::_frames()
+        {
+            if (auto context = _context.lock())
+            {
+                auto system = context->getSystem<ProfileSystem>();
+                system->setEnabled(true);
+                system->setFrameCount(10);
+                FEATHER_TK_ASSERT(10 == system->getFrameCount());
+                for (size_t i = 0; i < 25; ++i)
+                {
+                    system->beginFrame();
+                    system->endFrame();
+                }
+                auto frames = system->getFrames();
+                FEATHER_TK_ASSERT(10 == frames.size());
+                for (size_t i = 1; i < frames.size(); ++i)
+                {
+                    FEATHER_TK_ASSERT(frames[i].id == frames[i - 1].id + 1);
+                }
+                FEATHER_TK_ASSERT(frames.back().id == system->getLastFrame().id);
+
+                system->setFrameCount(4);
+                const auto frames2 = system->getFrames();
+                FEATHER_TK_ASSERT(4 == frames2.size());
+                FEATHER_TK_ASSERT(frames.back().id == frames2.back().id);
+                system->beginFrame();
+                system->endFrame();
+                FEATHER_TK_ASSERT(frames2.back().id + 1 == system->getLastFrame().id);
+                FEATHER_TK_ASSERT(4 == system->getFrames().size());
+
+                system->setFrameCount(300);
+                system->setEnabled(false);
+                system->clear();
+                FEATHER_TK_ASSERT(system->getFrames().empty());
+            }
+        }
+
+        void ProfileSystemTest::_trace()
+        {
+            if (auto context = _context.lock())
+            {
+                auto system = context->getSystem<ProfileSystem>();
+                system->setEnabled(true);
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    system->beginFrame();
+                    ProfileTimer timer(system, "Draw");
+                    system->endFrame();
+                }
+                system->setEnabled(false);
+
+                const std::filesystem::path path("ProfileSystemTest.json");
+                system->writeChromeTrace(path);
+                auto io = FileIO::create(path, FileMode::Read);
+                std::string s(io->getSize(), 0);
+                io->read(s.data(), s.size());
+                const nlohmann::json json = nlohmann::json::parse(s);
+                const auto& events = json.at("traceEvents");
+                FEATHER_TK_ASSERT(4 == events.size());
+                FEATHER_TK_ASSERT("Frame" == events[0].at("name").get<std::string>());
+                FEATHER_TK_ASSERT("Draw" == events[1].at("name").get<std::string>());
+                FEATHER_TK_ASSERT("X" == events[1].at("ph").get<std::string>());
+                system->clear();
+            }
+        }
+    }
+}
\ No newline at end of file
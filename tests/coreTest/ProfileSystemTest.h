@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class ProfileSystemTest : public test::ITest
+        {
+        protected:
+            ProfileSystemTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~ProfileSystemTest();
+
+            static std::shared_ptr<ProfileSystemTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+
+        private:
+            void _events();
+            void _frames();
+            void _trace();
+        };
+    }
+}
+
@@ -53,6 +53,9 @@ namespace feather_tk
                 FEATHER_TK_ASSERT(a == b);
                 b.cache = false;
                 FEATHER_TK_ASSERT(a != b);
+                b = ImageOptions();
+                b.stream = true;
+                FEATHER_TK_ASSERT(a != b);
             }
         }
     }
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/SoftwareRenderTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/SoftwareRender.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        SoftwareRenderTest::SoftwareRenderTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::SoftwareRenderTest")
+        {}
+
+        SoftwareRenderTest::~SoftwareRenderTest()
+        {}
+
+        std::shared_ptr<SoftwareRenderTest> SoftwareRenderTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<SoftwareRenderTest>(new SoftwareRenderTest(context));
+        }
+        
+        void SoftwareRenderTest::run()
+        {
+            _prims();
+            _clip();
+            _text();
+            _images();
+        }
+
+        namespace
+        {
+            const uint8_t* getPixel(const std::shared_ptr<Image>& image, int x, int y)
+            {
+                return image->getData() + (y * image->getWidth() + x) * 4;
+            }
+
+            bool isColor(const uint8_t* p, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+            {
+                return
+                    std::abs(p[0] - r) <= 1 &&
+                    std::abs(p[1] - g) <= 1 &&
+                    std::abs(p[2] - b) <= 1 &&
+                    std::abs(p[3] - a) <= 1;
+            }
+        }
+
+        void SoftwareRenderTest::_prims()
+        {
+            if (auto context = _context.lock())
+            {
+                auto render = SoftwareRender::create(context, 4);
+                FEATHER_TK_ASSERT(4 == render->getThreadCount());
+                const Size2I size(300, 200);
+                RenderOptions options;
+                options.clearColor = Color4F(0.F, 0.F, 0.F, 1.F);
+                render->begin(size, options);
+                FEATHER_TK_ASSERT(size == render->getRenderSize());
+                FEATHER_TK_ASSERT(options == render->getRenderOptions());
+                FEATHER_TK_ASSERT(Box2I(0, 0, size.w, size.h) == render->getViewport());
+                render->drawRect(Box2F(10.F, 10.F, 100.F, 100.F), Color4F(1.F, 0.F, 0.F));
+                render->drawRect(Box2F(50.F, 50.F, 100.F, 100.F), Color4F(0.F, 0.F, 1.F, .5F));
+                render->drawLine(V2F(200.F, 10.F), V2F(200.F, 190.F), Color4F(0.F, 1.F, 0.F));
+                TriMesh2F mesh;
+                mesh.v.push_back(V2F(220.F, 10.F));
+                mesh.v.push_back(V2F(290.F, 10.F));
+                mesh.v.push_back(V2F(290.F, 80.F));
+                mesh.c.push_back(V4F(1.F, 0.F, 0.F, 1.F));
+                mesh.c.push_back(V4F(0.F, 1.F, 0.F, 1.F));
+                mesh.c.push_back(V4F(0.F, 0.F, 1.F, 1.F));
+                Triangle2 triangle;
+                triangle.v[0] = Vertex2(1, 0, 1);
+                triangle.v[1] = Vertex2(2, 0, 2);
+                triangle.v[2] = Vertex2(3, 0, 3);
+                mesh.triangles.push_back(triangle);
+                render->drawColorMesh(mesh);
+                render->drawMesh(mesh, Color4F(1.F, 1.F, 1.F), V2F(0.F, 100.F));
+                const std::shared_ptr<IRender> base = render;
+                auto retained = base->createMesh(mesh);
+                FEATHER_TK_ASSERT(retained->getRender() == base);
+                base->drawMesh(retained, Color4F(1.F, 1.F, 1.F), V2F(-60.F, 100.F));
+                render->end();
+
+                auto image = render->getImage();
+                FEATHER_TK_ASSERT(image);
+                FEATHER_TK_ASSERT(size == image->getSize());
+                FEATHER_TK_ASSERT(ImageType::RGBA_U8 == image->getType());
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 0, 0), 0, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 10, 10), 255, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 49, 49), 255, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 110, 110), 0, 0, 128, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 60, 60), 128, 0, 128, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 150, 150), 0, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 199, 100), 0, 255, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 280, 110), 255, 255, 255, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 228, 112), 255, 255, 255, 255));
+                const uint8_t* p = getPixel(image, 288, 12);
+                FEATHER_TK_ASSERT(p[1] > p[0] && p[1] > p[2]);
+
+                // Adjacent triangles must not blend the shared edge twice.
+                render->begin(size, options);
+                render->drawRects(
+                    { Box2F(0.F, 0.F, 10.F, 10.F), Box2F(10.F, 0.F, 10.F, 10.F) },
+                    Color4F(1.F, 1.F, 1.F, .5F));
+                render->end();
+                for (int y = 0; y < 10; ++y)
+                {
+                    for (int x = 0; x < 20; ++x)
+                    {
+                        FEATHER_TK_ASSERT(isColor(getPixel(image, x, y), 128, 128, 128, 255));
+                    }
+                }
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 20, 0), 0, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 0, 10), 0, 0, 0, 255));
+            }
+        }
+
+        void SoftwareRenderTest::_clip()
+        {
+            if (auto context = _context.lock())
+            {
+                auto render = SoftwareRender::create(context);
+                const Size2I size(100, 100);
+                render->begin(size);
+                render->setClipRectEnabled(true);
+                render->setClipRect(Box2I(10, 10, 20, 20));
+                FEATHER_TK_ASSERT(render->getClipRectEnabled());
+                FEATHER_TK_ASSERT(Box2I(10, 10, 20, 20) == render->getClipRect());
+                render->drawRect(Box2F(0.F, 0.F, 100.F, 100.F), Color4F(1.F, 1.F, 1.F));
+                render->clearViewport(Color4F(0.F, 1.F, 0.F));
+                render->setClipRectEnabled(false);
+                render->setTransform(ortho(0.F, 50.F, 50.F, 0.F, -1.F, 1.F));
+                render->drawRect(Box2F(40.F, 40.F, 10.F, 10.F), Color4F(1.F, 0.F, 0.F));
+                render->end();
+
+                auto image = render->getImage();
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 9, 9), 0, 0, 0, 0));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 10, 10), 0, 255, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 29, 29), 0, 255, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 30, 30), 0, 0, 0, 0));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 79, 79), 0, 0, 0, 0));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 80, 80), 255, 0, 0, 255));
+                FEATHER_TK_ASSERT(isColor(getPixel(image, 99, 99), 255, 0, 0, 255));
+            }
+        }
+
+        void SoftwareRenderTest::_text()
+        {
+            if (auto context = _context.lock())
+            {
+                auto fontSystem = context->getSystem<FontSystem>();
+                const FontInfo fontInfo("NotoSans-Regular", 32);
+                const std::string text = "Hello world";
+                const FontMetrics fontMetrics = fontSystem->getMetrics(fontInfo);
+                const Size2I textSize = fontSystem->getSize(text, fontInfo);
+
+                auto render = SoftwareRender::create(context);
+                render->begin(Size2I(textSize.w + 20, textSize.h + 20));
+                render->drawText(
+                    fontSystem->getGlyphs(text, fontInfo),
+                    fontMetrics,
+                    V2F(10.F, 10.F),
+                    Color4F(1.F, 1.F, 1.F));
+                render->end();
+
+                auto image = render->getImage();
+                size_t count = 0;
+                for (int y = 0; y < image->getHeight(); ++y)
+                {
+                    for (int x = 0; x < image->getWidth(); ++x)
+                    {
+                        if (getPixel(image, x, y)[3] > 0)
+                        {
+                            FEATHER_TK_ASSERT(x >= 10 && x < 10 + textSize.w);
+                            FEATHER_TK_ASSERT(y >= 10 && y < 10 + textSize.h);
+                            ++count;
+                        }
+                    }
+                }
+                _print(Format("Text pixels: {0}").arg(count));
+                FEATHER_TK_ASSERT(count > 0);
+            }
+        }
+
+        void SoftwareRenderTest::_images()
+        {
+            if (auto context = _context.lock())
+            {
+                auto render = SoftwareRender::create(context);
+                for (auto type : getImageTypeEnums())
+                {
+                    if (ImageType::None == type)
+                        continue;
+                    auto image = Image::create(8, 8, type);
+                    image->zero();
+                    if (ImageType::RGBA_U8 == type)
+                    {
+                        for (size_t i = 0; i < image->getByteCount(); ++i)
+                        {
+                            image->getData()[i] = 255;
+                        }
+                    }
+                    render->begin(Size2I(16, 16));
+                    ImageOptions options;
+                    options.alphaBlend = AlphaBlend::None;
+                    render->drawImage(image, Box2F(0.F, 0.F, 16.F, 16.F), Color4F(1.F, 1.F, 1.F), options);
+                    render->end();
+                    const uint8_t* p = getPixel(render->getImage(), 8, 8);
+                    _print(Format("{0}: {1} {2} {3} {4}").
+                        arg(type).arg(int(p[0])).arg(int(p[1])).arg(int(p[2])).arg(int(p[3])));
+                    switch (type)
+                    {
+                    case ImageType::RGBA_U8:
+                        FEATHER_TK_ASSERT(isColor(p, 255, 255, 255, 255));
+                        break;
+                    case ImageType::YUV_420P_U8:
+                    case ImageType::YUV_422P_U8:
+                    case ImageType::YUV_444P_U8:
+                    case ImageType::YUV_420P_U16:
+                    case ImageType::YUV_422P_U16:
+                    case ImageType::YUV_444P_U16:
+                        // Zero chroma is a saturated green.
+                        FEATHER_TK_ASSERT(p[1] > p[0] && p[1] > p[2]);
+                        FEATHER_TK_ASSERT(255 == p[3]);
+                        break;
+                    case ImageType::LA_U8:
+                    case ImageType::LA_U16:
+                    case ImageType::LA_U32:
+                    case ImageType::LA_F16:
+                    case ImageType::LA_F32:
+                    case ImageType::RGBA_U16:
+                    case ImageType::RGBA_U32:
+                    case ImageType::RGBA_F16:
+                    case ImageType::RGBA_F32:
+                    case ImageType::ARGB_4444_Premult:
+                        FEATHER_TK_ASSERT(isColor(p, 0, 0, 0, 0));
+                        break;
+                    default:
+                        FEATHER_TK_ASSERT(isColor(p, 0, 0, 0, 255));
+                        break;
+                    }
+                }
+                {
+                    // Half float conversion and image mirroring.
+                    ImageInfo info(1, 2, ImageType::L_F16);
+                    info.layout.mirror.y = true;
+                    auto image = Image::create(info);
+                    uint16_t* data = reinterpret_cast<uint16_t*>(image->getData());
+                    data[0] = 0x3c00;
+                    data[1] = 0x3800;
+                    render->begin(Size2I(1, 2));
+                    ImageOptions options;
+                    options.imageFilters.magnify = ImageFilter::Nearest;
+                    render->drawImage(image, Box2F(0.F, 0.F, 1.F, 2.F), Color4F(1.F, 1.F, 1.F), options);
+                    render->end();
+                    FEATHER_TK_ASSERT(isColor(getPixel(render->getImage(), 0, 0), 255, 255, 255, 255));
+                    FEATHER_TK_ASSERT(isColor(getPixel(render->getImage(), 0, 1), 128, 128, 128, 255));
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
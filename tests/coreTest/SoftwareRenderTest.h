@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class SoftwareRenderTest : public test::ITest
+        {
+        protected:
+            SoftwareRenderTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~SoftwareRenderTest();
+
+            static std::shared_ptr<SoftwareRenderTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+
+        private:
+            void _prims();
+            void _clip();
+            void _text();
+            void _images();
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <coreTest/StringSearchTest.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/StringSearch.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        StringSearchTest::StringSearchTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::core_test::StringSearchTest")
+        {}
+
+        StringSearchTest::~StringSearchTest()
+        {}
+
+        std::shared_ptr<StringSearchTest> StringSearchTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<StringSearchTest>(new StringSearchTest(context));
+        }
+        
+        void StringSearchTest::run()
+        {
+            _enums();
+            _fold();
+            _substring();
+            _fuzzy();
+        }
+
+        void StringSearchTest::_enums()
+        {
+            FEATHER_TK_TEST_ENUM(StringSearchMode);
+        }
+
+        void StringSearchTest::_fold()
+        {
+            FEATHER_TK_ASSERT("abc xyz 123" == foldCase("ABC xyz 123"));
+            FEATHER_TK_ASSERT("\xc3\xa9t\xc3\xa9" == foldCase("\xc3\x89T\xc3\x89"));
+            FEATHER_TK_ASSERT("\xce\xb1\xcf\x83" == foldCase("\xce\x91\xce\xa3"));
+            FEATHER_TK_ASSERT("\xd0\xb4\xd0\xb0" == foldCase("\xd0\x94\xd0\x90"));
+            const std::string invalid = "A\xc3";
+            FEATHER_TK_ASSERT("a\xc3" == foldCase(invalid));
+        }
+
+        void StringSearchTest::_substring()
+        {
+            StringSearch search;
+            search.setItems({ "Apple", "banana", "Cherry", "\xc3\x89" "clair", "pineapple" });
+            FEATHER_TK_ASSERT(5 == search.getItemCount());
+            FEATHER_TK_ASSERT("Cherry" == search.getItem(2));
+            FEATHER_TK_ASSERT(5 == search.getResults().size());
+
+            auto results = search.search("AP");
+            FEATHER_TK_ASSERT("AP" == search.getSearch());
+            FEATHER_TK_ASSERT(StringSearchMode::Substring == search.getMode());
+            FEATHER_TK_ASSERT(2 == results.size());
+            FEATHER_TK_ASSERT(0 == results[0].index);
+            FEATHER_TK_ASSERT(4 == results[1].index);
+            FEATHER_TK_ASSERT(search.isMatch(0));
+            FEATHER_TK_ASSERT(!search.isMatch(1));
+            FEATHER_TK_ASSERT(!search.isMatch(100));
+
+            results = search.search("app");
+            FEATHER_TK_ASSERT(2 == results.size());
+            results = search.search("appl");
+            FEATHER_TK_ASSERT(2 == results.size());
+            results = search.search("eappl");
+            FEATHER_TK_ASSERT(1 == results.size());
+            FEATHER_TK_ASSERT(4 == results[0].index);
+            FEATHER_TK_ASSERT(!search.isMatch(0));
+            const auto ranges = search.getMatchRanges(4);
+            FEATHER_TK_ASSERT(1 == ranges.size());
+            FEATHER_TK_ASSERT(3 == ranges[0].first);
+            FEATHER_TK_ASSERT(5 == ranges[0].second);
+            FEATHER_TK_ASSERT(search.getMatchRanges(0).empty());
+
+            results = search.search("an");
+            FEATHER_TK_ASSERT(1 == results.size());
+            FEATHER_TK_ASSERT(1 == results[0].index);
+
+            results = search.search("\xc3\xa9" "c");
+            FEATHER_TK_ASSERT(1 == results.size());
+            FEATHER_TK_ASSERT(3 == results[0].index);
+
+            search.search("e");
+            search.addItems({ "Grape", "Kiwi" });
+            FEATHER_TK_ASSERT(search.isMatch(5));
+            FEATHER_TK_ASSERT(!search.isMatch(6));
+            FEATHER_TK_ASSERT(5 == search.getResults().back().index);
+
+            search.search(std::string());
+            FEATHER_TK_ASSERT(7 == search.getResults().size());
+            search.clear();
+            FEATHER_TK_ASSERT(0 == search.getItemCount());
+            FEATHER_TK_ASSERT(search.getResults().empty());
+        }
+
+        void StringSearchTest::_fuzzy()
+        {
+            StringSearch search;
+            search.setItems({
+                "ListItemsWidget.cpp",
+                "LineEdit.cpp",
+                "ColorWidget.cpp",
+                "LayoutUtil.cpp",
+                "README.md" });
+            auto results = search.search("lw", StringSearchMode::Fuzzy);
+            FEATHER_TK_ASSERT(StringSearchMode::Fuzzy == search.getMode());
+            FEATHER_TK_ASSERT(2 == results.size());
+            FEATHER_TK_ASSERT(0 == results[0].index);
+            FEATHER_TK_ASSERT(2 == results[1].index);
+            FEATHER_TK_ASSERT(results[0].score >= results[1].score);
+
+            results = search.search("le", StringSearchMode::Fuzzy);
+            FEATHER_TK_ASSERT(1 == results[0].index);
+            const auto ranges = search.getMatchRanges(1);
+            FEATHER_TK_ASSERT(2 == ranges.size());
+            FEATHER_TK_ASSERT(std::make_pair(size_t(0), size_t(1)) == ranges[0]);
+            FEATHER_TK_ASSERT(std::make_pair(size_t(3), size_t(1)) == ranges[1]);
+
+            results = search.search("lec", StringSearchMode::Fuzzy);
+            FEATHER_TK_ASSERT(3 == results.size());
+            FEATHER_TK_ASSERT(1 == results[0].index);
+            FEATHER_TK_ASSERT(0 == results[1].index);
+            FEATHER_TK_ASSERT(2 == results[2].index);
+
+            results = search.search("xyz", StringSearchMode::Fuzzy);
+            FEATHER_TK_ASSERT(results.empty());
+            FEATHER_TK_ASSERT(search.getMatchRanges(0).empty());
+
+            results = search.search("rd", StringSearchMode::Fuzzy);
+            FEATHER_TK_ASSERT(2 == results.size());
+            FEATHER_TK_ASSERT(4 == results[0].index);
+            FEATHER_TK_ASSERT(2 == results[1].index);
+            results = search.search("rd", StringSearchMode::Substring);
+            FEATHER_TK_ASSERT(results.empty());
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace core_test
+    {
+        class StringSearchTest : public test::ITest
+        {
+        protected:
+            StringSearchTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~StringSearchTest();
+
+            static std::shared_ptr<StringSearchTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _fold();
+            void _substring();
+            void _fuzzy();
+        };
+    }
+}
+
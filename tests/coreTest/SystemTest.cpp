@@ -9,6 +9,8 @@
 #include <feather-tk/core/ISystem.h>
 #include <feather-tk/core/LogSystem.h>
 
+#include <atomic>
+
 namespace feather_tk
 {
     namespace core_test
@@ -50,10 +52,23 @@ namespace feather_tk
                     return std::shared_ptr<System2>(new System2(context));
                 }
 
+                size_t getTickCount() const
+                {
+                    return _tickCount;
+                }
+
+                void tick() override
+                {
+                    ++_tickCount;
+                }
+
                 std::chrono::milliseconds getTickTime() const override
                 {
                     return std::chrono::milliseconds(100);
                 }
+
+            private:
+                size_t _tickCount = 0;
             };
         }
         
@@ -101,6 +116,32 @@ namespace feather_tk
                     "This is an error!",
                     LogType::Error);
             }
+            if (auto context = _context.lock())
+            {
+                // Waking the context calls the callback and ticks the
+                // systems regardless of their tick times.
+                std::atomic<size_t> wakeCount(0);
+                context->setWakeCallback(
+                    [&wakeCount]
+                    {
+                        ++wakeCount;
+                    });
+                auto system = context->getSystem<System2>();
+                context->tick();
+                const size_t tickCount = system->getTickCount();
+                context->wake();
+                FEATHER_TK_ASSERT(wakeCount > 0);
+                context->tick();
+                FEATHER_TK_ASSERT(system->getTickCount() > tickCount);
+
+                const size_t wakeCount2 = wakeCount;
+                auto wake = context->getWakeFunc();
+                wake();
+                FEATHER_TK_ASSERT(wakeCount > wakeCount2);
+                context->tick();
+                FEATHER_TK_ASSERT(system->getTickCount() > tickCount + 1);
+                context->setWakeCallback(nullptr);
+            }
         }
     }
 }
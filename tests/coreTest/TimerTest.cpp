@@ -29,6 +29,9 @@ namespace feather_tk
             timer->start(timeout, [] {});
             FEATHER_TK_ASSERT(timer->isActive());
             FEATHER_TK_ASSERT(timeout == timer->getTimeout());
+            FEATHER_TK_ASSERT(timer->getTimeRemaining() <= timeout);
+            auto timerSystem = context->getSystem<TimerSystem>();
+            FEATHER_TK_ASSERT(timerSystem->getTimeRemaining() <= timeout);
             timer->stop();
             FEATHER_TK_ASSERT(!timer->isActive());
 
@@ -61,6 +64,7 @@ namespace feather_tk
                 sleep(std::chrono::milliseconds(5), t0, t1);
                 t0 = t1;
             }
+            FEATHER_TK_ASSERT(std::chrono::microseconds::zero() == timer->getTimeRemaining());
         }
 
         TimerTest::~TimerTest()
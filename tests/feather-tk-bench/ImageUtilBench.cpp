@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/ImageUtilBench.h>
+
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ImageUtil.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        ImageUtilBench::ImageUtilBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::ImageUtilBench")
+        {}
+
+        ImageUtilBench::~ImageUtilBench()
+        {}
+
+        std::shared_ptr<ImageUtilBench> ImageUtilBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<ImageUtilBench>(new ImageUtilBench(context));
+        }
+
+        void ImageUtilBench::run()
+        {
+            const Size2I size(512, 512);
+            for (auto inType : getImageTypeEnums())
+            {
+                if (ImageType::None == inType)
+                    continue;
+                auto image = Image::create(size, inType);
+                for (size_t i = 0; i < image->getByteCount(); ++i)
+                {
+                    image->getData()[i] = i * 31;
+                }
+                for (auto outType : getImageTypeEnums())
+                {
+                    if (ImageType::None == outType)
+                        continue;
+                    auto out = Image::create(size, outType);
+                    const auto t0 = std::chrono::steady_clock::now();
+                    convert(image, out);
+                    const auto t1 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<double> diff = t1 - t0;
+                    _print(Format("Convert {0} to {1}: {2} megapixels per second").
+                        arg(getLabel(inType)).
+                        arg(getLabel(outType)).
+                        arg(size.w * size.h / 1000000.0 / std::max(diff.count(), 1e-9), 0));
+                }
+            }
+            {
+                auto image = Image::create(3840, 2160, ImageType::RGBA_U8);
+                const auto t0 = std::chrono::steady_clock::now();
+                auto out = resize(image, Size2I(256, 144));
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<double> diff = t1 - t0;
+                _print(Format("Resize {0} to {1}: {2} seconds").
+                    arg(image->getSize()).
+                    arg(out->getSize()).
+                    arg(diff.count(), 4));
+            }
+        }
+    }
+}
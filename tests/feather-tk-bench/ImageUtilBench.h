@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        class ImageUtilBench : public test::ITest
+        {
+        protected:
+            ImageUtilBench(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~ImageUtilBench();
+
+            static std::shared_ptr<ImageUtilBench> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+        };
+    }
+}
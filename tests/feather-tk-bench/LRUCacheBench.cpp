@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/LRUCacheBench.h>
+
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/LRUCache.h>
+
+#include <chrono>
+#include <map>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        LRUCacheBench::LRUCacheBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::LRUCacheBench")
+        {}
+
+        LRUCacheBench::~LRUCacheBench()
+        {}
+
+        std::shared_ptr<LRUCacheBench> LRUCacheBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<LRUCacheBench>(new LRUCacheBench(context));
+        }
+
+        namespace
+        {
+            //! The previous LRU cache implementation, which searched the
+            //! whole cache to find the size and the least recently used
+            //! items. It is kept for comparison.
+            class PreviousLRUCache
+            {
+            public:
+                size_t getSize() const
+                {
+                    size_t out = 0;
+                    for (const auto& i : _map)
+                    {
+                        out += i.second.second;
+                    }
+                    return out;
+                }
+
+                void setMax(size_t value)
+                {
+                    _max = value;
+                    _maxUpdate();
+                }
+
+                bool get(int key, int& value)
+                {
+                    auto i = _map.find(key);
+                    if (i != _map.end())
+                    {
+                        value = i->second.first;
+                        auto j = _counts.find(key);
+                        if (j != _counts.end())
+                        {
+                            ++_counter;
+                            j->second = _counter;
+                        }
+                    }
+                    return i != _map.end();
+                }
+
+                void add(int key, int value, size_t size = 1)
+                {
+                    _map[key] = std::make_pair(value, size);
+                    ++_counter;
+                    _counts[key] = _counter;
+                    _maxUpdate();
+                }
+
+            private:
+                void _maxUpdate()
+                {
+                    if (getSize() > _max)
+                    {
+                        std::map<int64_t, int> sorted;
+                        for (const auto& i : _counts)
+                        {
+                            sorted[i.second] = i.first;
+                        }
+                        while (getSize() > _max)
+                        {
+                            auto begin = sorted.begin();
+                            _map.erase(begin->second);
+                            _counts.erase(begin->second);
+                            sorted.erase(begin);
+                        }
+                    }
+                }
+
+                size_t _max = 10000;
+                std::map<int, std::pair<int, size_t> > _map;
+                std::map<int, int64_t> _counts;
+                int64_t _counter = 0;
+            };
+
+            template<typename T>
+            std::pair<float, size_t> benchmark(T& c, int count)
+            {
+                size_t hits = 0;
+                const auto t0 = std::chrono::steady_clock::now();
+                for (int i = 0; i < count; ++i)
+                {
+                    c.add(i, i);
+                    int v = 0;
+                    if (c.get(i / 2, v))
+                    {
+                        ++hits;
+                    }
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> diff = t1 - t0;
+                return std::make_pair(diff.count(), hits);
+            }
+        }
+
+        void LRUCacheBench::run()
+        {
+            // Compare the previous and current implementations by adding
+            // and getting the same items.
+            const int count = 20000;
+            const size_t max = 2000;
+            PreviousLRUCache previous;
+            previous.setMax(max);
+            const auto previousResult = benchmark(previous, count);
+            _print(Format("Previous implementation, add and get {0} items with a maximum of {1}: {2} seconds, {3} hits").
+                arg(count).
+                arg(max).
+                arg(previousResult.first).
+                arg(previousResult.second));
+
+            LRUCache<int, int> c;
+            c.setMax(max);
+            const auto result = benchmark(c, count);
+            _print(Format("Current implementation, add and get {0} items with a maximum of {1}: {2} seconds, {3} hits, {4} misses, {5} evictions").
+                arg(count).
+                arg(max).
+                arg(result.first).
+                arg(c.getHits()).
+                arg(c.getMisses()).
+                arg(c.getEvictions()));
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/LineIndexBench.h>
+
+#include <feather-tk/core/FileIO.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/LineIndex.h>
+
+#include <chrono>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        LineIndexBench::LineIndexBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::LineIndexBench")
+        {}
+
+        LineIndexBench::~LineIndexBench()
+        {}
+
+        std::shared_ptr<LineIndexBench> LineIndexBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<LineIndexBench>(new LineIndexBench(context));
+        }
+
+        void LineIndexBench::run()
+        {
+            const std::filesystem::path path("LineIndexBench.txt");
+            {
+                auto io = FileIO::create(path, FileMode::Write);
+                std::string block;
+                for (size_t i = 0; i < 100000; ++i)
+                {
+                    block += Format("{0}: The quick brown fox jumps over the lazy dog\n").arg(i);
+                }
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    io->write(block);
+                }
+            }
+            for (size_t threadCount : { 1, 0 })
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                auto index = LineIndex::create(FileIO::create(path, FileMode::Read), threadCount);
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> diff = t1 - t0;
+                _print(Format("Index {0}MB with {1} threads: {2} seconds, {3} lines").
+                    arg(index->getSize() / (1024 * 1024)).
+                    arg(threadCount).
+                    arg(diff.count()).
+                    arg(index->getLineCount()));
+            }
+            std::filesystem::remove(path);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/LogSystemBench.h>
+
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/LogSystem.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        namespace
+        {
+            class CountSink : public ILogSink
+            {
+            public:
+                static std::shared_ptr<CountSink> create()
+                {
+                    return std::shared_ptr<CountSink>(new CountSink);
+                }
+
+                void write(const std::vector<LogItem>& value) override
+                {
+                    for (const auto& item : value)
+                    {
+                        if (LogType::Message == item.type)
+                        {
+                            ++count;
+                        }
+                    }
+                }
+
+                std::atomic<size_t> count = { 0 };
+            };
+        }
+
+        LogSystemBench::LogSystemBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::LogSystemBench")
+        {}
+
+        LogSystemBench::~LogSystemBench()
+        {}
+
+        std::shared_ptr<LogSystemBench> LogSystemBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<LogSystemBench>(new LogSystemBench(context));
+        }
+
+        void LogSystemBench::run()
+        {
+            auto context = Context::create();
+            auto logSystem = context->getSystem<LogSystem>();
+            logSystem->flush();
+            auto sink = CountSink::create();
+            logSystem->addSink(sink);
+            const size_t count = 100000;
+            for (size_t threadCount : { 1, 2, 4, 8 })
+            {
+                sink->count = 0;
+                const auto t0 = std::chrono::steady_clock::now();
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [logSystem, count, threadCount]
+                        {
+                            const std::string prefix = "feather_tk::bench::LogSystemBench";
+                            const std::string message = "This is a log message";
+                            for (size_t j = 0; j < count / threadCount; ++j)
+                            {
+                                logSystem->print(prefix, message);
+                            }
+                        }));
+                }
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                logSystem->flush();
+                const auto t2 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> diff = t1 - t0;
+                const std::chrono::duration<float> diff2 = t2 - t0;
+                _print(Format("Print {0} messages from {1} threads: {2} seconds, {3} messages/second, {4} seconds with sinks, {5} logged").
+                    arg(count).
+                    arg(threadCount).
+                    arg(diff.count()).
+                    arg(static_cast<size_t>(count / diff.count())).
+                    arg(diff2.count()).
+                    arg(sink->count.load()));
+            }
+        }
+    }
+}
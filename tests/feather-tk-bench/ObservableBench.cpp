@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/ObservableBench.h>
+
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ObservableList.h>
+
+#include <chrono>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        ObservableBench::ObservableBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::ObservableBench")
+        {}
+
+        ObservableBench::~ObservableBench()
+        {}
+
+        std::shared_ptr<ObservableBench> ObservableBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<ObservableBench>(new ObservableBench(context));
+        }
+
+        void ObservableBench::run()
+        {
+            const size_t count = 50000;
+            auto olist = ObservableList<int>::create(std::vector<int>(count, 0));
+            size_t updated = 0;
+            auto observer = ListChangeObserver<int>::create(
+                olist,
+                [&updated](const std::vector<int>&, const std::vector<ListChange>& changes)
+                {
+                    for (const auto& change : changes)
+                    {
+                        updated += ObservableChangeType::Reset == change.type ? 0 : change.count;
+                    }
+                });
+            const size_t appends = 10000;
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < appends; ++i)
+            {
+                olist->pushBack(i);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            std::chrono::duration<float> diff = t1 - t0;
+            _print(Format("Append {0} items to a {1} item list: {2} seconds, {3} items updated").
+                arg(appends).
+                arg(count).
+                arg(diff.count()).
+                arg(updated));
+
+            std::vector<int> list = olist->get();
+            list.push_back(0);
+            t0 = std::chrono::steady_clock::now();
+            olist->setIfChanged(list);
+            t1 = std::chrono::steady_clock::now();
+            diff = t1 - t0;
+            _print(Format("Set a {0} item list with one new item: {1} seconds").
+                arg(list.size()).
+                arg(diff.count()));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <feather-tk-bench/StringSearchBench.h>
+
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/Random.h>
+#include <feather-tk/core/StringSearch.h>
+
+#include <chrono>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        StringSearchBench::StringSearchBench(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::bench::StringSearchBench")
+        {}
+
+        StringSearchBench::~StringSearchBench()
+        {}
+
+        std::shared_ptr<StringSearchBench> StringSearchBench::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<StringSearchBench>(new StringSearchBench(context));
+        }
+
+        void StringSearchBench::run()
+        {
+            Random random;
+            random.setSeed(1);
+            const std::vector<std::string> words =
+            {
+                "image", "render", "final", "comp", "shot", "plate", "v001",
+                "v002", "lighting", "matte", "beauty", "depth", "Normal", "exr"
+            };
+            std::vector<std::string> items;
+            for (size_t i = 0; i < 200000; ++i)
+            {
+                const std::string frame = std::to_string(i);
+                items.push_back(
+                    random.getItem(words) + "_" +
+                    random.getItem(words) + "_" +
+                    random.getItem(words) + "." +
+                    std::string(6 - frame.size(), '0') + frame + ".exr");
+            }
+
+            StringSearch search;
+            auto t0 = std::chrono::steady_clock::now();
+            search.setItems(items);
+            auto t1 = std::chrono::steady_clock::now();
+            std::chrono::duration<float> diff = t1 - t0;
+            _print(Format("Add {0} items: {1} seconds").arg(items.size()).arg(diff.count()));
+
+            for (auto mode : getStringSearchModeEnums())
+            {
+                std::string text;
+                for (const char c : std::string("renderv00"))
+                {
+                    text.push_back(c);
+                    t0 = std::chrono::steady_clock::now();
+                    const size_t count = search.search(text, mode).size();
+                    t1 = std::chrono::steady_clock::now();
+                    diff = t1 - t0;
+                    _print(Format("{0} \"{1}\": {2} results, {3} seconds").
+                        arg(mode).
+                        arg(text).
+                        arg(count).
+                        arg(diff.count()));
+                }
+                search.search(std::string(), mode);
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include "feather-tk-bench.h"
+
+#include <feather-tk-bench/ImageUtilBench.h>
+#include <feather-tk-bench/LRUCacheBench.h>
+#include <feather-tk-bench/LineIndexBench.h>
+#include <feather-tk-bench/LogSystemBench.h>
+#include <feather-tk-bench/ObservableBench.h>
+#include <feather-tk-bench/StringSearchBench.h>
+
+#include <testLib/ITest.h>
+
+#include <feather-tk/core/CmdLine.h>
+#include <feather-tk/core/Context.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/String.h>
+
+#include <iostream>
+
+namespace feather_tk
+{
+    namespace bench
+    {
+        struct App::Private
+        {
+            std::shared_ptr<CmdLineValueArg<std::string> > benchName;
+            std::vector<std::shared_ptr<test::ITest> > benches;
+        };
+        
+        void App::_init(
+            const std::shared_ptr<Context>& context,
+            std::vector<std::string>& argv)
+        {
+            FEATHER_TK_P();
+            p.benchName = CmdLineValueArg<std::string>::create(
+                "Benchmark",
+                "Name of the benchmark to run.",
+                true);
+            IApp::_init(
+                context,
+                argv,
+                "feather-tk-bench",
+                "Benchmark application",
+                { p.benchName });
+
+            p.benches.push_back(ImageUtilBench::create(context));
+            p.benches.push_back(LRUCacheBench::create(context));
+            p.benches.push_back(LineIndexBench::create(context));
+            p.benches.push_back(LogSystemBench::create(context));
+            p.benches.push_back(ObservableBench::create(context));
+            p.benches.push_back(StringSearchBench::create(context));
+        }
+
+        App::App() :
+            _p(new Private)
+        {}
+
+        App::~App()
+        {}
+
+        std::shared_ptr<App> App::create(
+            const std::shared_ptr<Context>& context,
+            std::vector<std::string>& argv)
+        {
+            auto out = std::shared_ptr<App>(new App);
+            out->_init(context, argv);
+            return out;
+        }
+        
+        void App::run()
+        {
+            FEATHER_TK_P();
+            for (const auto& bench : p.benches)
+            {
+                if (!p.benchName->hasValue() ||
+                    contains(bench->getName(), p.benchName->getValue()))
+                {
+                    _context->tick();
+                    _print(Format("Running benchmark: {0}").arg(bench->getName()));
+                    bench->run();
+                }
+            }
+        }
+    }
+}
+
+FEATHER_TK_MAIN()
+{
+    int r = 0;
+    try
+    {
+        auto context = feather_tk::Context::create();
+        auto args = feather_tk::convert(argc, argv);
+        auto app = feather_tk::bench::App::create(context, args);
+        r = app->getExit();
+        if (0 == r)
+        {
+            app->run();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "ERROR: " << e.what() << std::endl;
+    }
+    return r;
+}
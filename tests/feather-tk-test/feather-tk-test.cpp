@@ -42,6 +42,7 @@
 #include <uiTest/MenuBarTest.h>
 #include <uiTest/MessageDialogTest.h>
 #include <uiTest/PieChartTest.h>
+#include <uiTest/ProfileWidgetTest.h>
 #include <uiTest/ProgressDialogTest.h>
 #include <uiTest/RecentFilesModelTest.h>
 #include <uiTest/RowLayoutTest.h>
@@ -59,6 +60,7 @@
 #include <glTest/MeshTest.h>
 #include <glTest/OffscreenBufferTest.h>
 #include <glTest/TextureAtlasTest.h>
+#include <glTest/TextureStreamTest.h>
 #include <glTest/TextureTest.h>
 #include <glTest/RenderTest.h>
 #include <glTest/ShaderTest.h>
@@ -72,6 +74,7 @@
 #include <coreTest/CmdLineTest.h>
 #include <coreTest/ColorTest.h>
 #include <coreTest/CommandTest.h>
+#include <coreTest/DirSystemTest.h>
 #include <coreTest/ErrorTest.h>
 #include <coreTest/FileIOTest.h>
 #include <coreTest/FileTest.h>
@@ -79,6 +82,9 @@
 #include <coreTest/FormatTest.h>
 #include <coreTest/ImageIOTest.h>
 #include <coreTest/ImageTest.h>
+#include <coreTest/ImageUtilTest.h>
+#include <coreTest/LineIndexTest.h>
+#include <coreTest/LogSystemTest.h>
 #include <coreTest/LRUCacheTest.h>
 #include <coreTest/MathTest.h>
 #include <coreTest/MatrixTest.h>
@@ -88,11 +94,14 @@
 #include <coreTest/OSTest.h>
 #include <coreTest/ObservableTest.h>
 #include <coreTest/PNGTest.h>
+#include <coreTest/ProfileSystemTest.h>
 #include <coreTest/RandomTest.h>
 #include <coreTest/RangeTest.h>
 #include <coreTest/RenderOptionsTest.h>
 #include <coreTest/RenderUtilTest.h>
+#include <coreTest/SoftwareRenderTest.h>
 #include <coreTest/SizeTest.h>
+#include <coreTest/StringSearchTest.h>
 #include <coreTest/StringTest.h>
 #include <coreTest/SystemTest.h>
 #include <coreTest/TimeTest.h>
@@ -156,6 +165,7 @@ namespace feather_tk
             p.tests.push_back(core_test::CmdLineTest::create(context));
             p.tests.push_back(core_test::ColorTest::create(context));
             p.tests.push_back(core_test::CommandTest::create(context));
+            p.tests.push_back(core_test::DirSystemTest::create(context));
             p.tests.push_back(core_test::ErrorTest::create(context));
             p.tests.push_back(core_test::FileIOTest::create(context));
             p.tests.push_back(core_test::FileTest::create(context));
@@ -163,6 +173,9 @@ namespace feather_tk
             p.tests.push_back(core_test::FormatTest::create(context));
             p.tests.push_back(core_test::ImageIOTest::create(context));
             p.tests.push_back(core_test::ImageTest::create(context));
+            p.tests.push_back(core_test::ImageUtilTest::create(context));
+            p.tests.push_back(core_test::LineIndexTest::create(context));
+            p.tests.push_back(core_test::LogSystemTest::create(context));
             p.tests.push_back(core_test::LRUCacheTest::create(context));
             p.tests.push_back(core_test::MathTest::create(context));
             p.tests.push_back(core_test::MatrixTest::create(context));
@@ -172,11 +185,14 @@ namespace feather_tk
             p.tests.push_back(core_test::OSTest::create(context));
             p.tests.push_back(core_test::ObservableTest::create(context));
             p.tests.push_back(core_test::PNGTest::create(context));
+            p.tests.push_back(core_test::ProfileSystemTest::create(context));
             p.tests.push_back(core_test::RandomTest::create(context));
             p.tests.push_back(core_test::RangeTest::create(context));
             p.tests.push_back(core_test::RenderOptionsTest::create(context));
             p.tests.push_back(core_test::RenderUtilTest::create(context));
+            p.tests.push_back(core_test::SoftwareRenderTest::create(context));
             p.tests.push_back(core_test::SizeTest::create(context));
+            p.tests.push_back(core_test::StringSearchTest::create(context));
             p.tests.push_back(core_test::StringTest::create(context));
             p.tests.push_back(core_test::SystemTest::create(context));
             p.tests.push_back(core_test::TimeTest::create(context));
@@ -188,6 +204,7 @@ namespace feather_tk
             p.tests.push_back(gl_test::MeshTest::create(context));
             p.tests.push_back(gl_test::OffscreenBufferTest::create(context));
             p.tests.push_back(gl_test::TextureAtlasTest::create(context));
+            p.tests.push_back(gl_test::TextureStreamTest::create(context));
             p.tests.push_back(gl_test::TextureTest::create(context));
             p.tests.push_back(gl_test::RenderTest::create(context));
             p.tests.push_back(gl_test::ShaderTest::create(context));
@@ -230,6 +247,7 @@ namespace feather_tk
             p.tests.push_back(ui_test::MenuBarTest::create(context));
             p.tests.push_back(ui_test::MessageDialogTest::create(context));
             p.tests.push_back(ui_test::PieChartTest::create(context));
+            p.tests.push_back(ui_test::ProfileWidgetTest::create(context));
             p.tests.push_back(ui_test::ProgressDialogTest::create(context));
             p.tests.push_back(ui_test::RecentFilesModelTest::create(context));
             p.tests.push_back(ui_test::RowLayoutTest::create(context));
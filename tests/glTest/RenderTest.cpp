@@ -86,6 +86,67 @@ namespace feather_tk
                 render->end();
             }
             if (auto context = _context.lock())
+            {
+                auto window = createWindow(context);
+                const Size2I size(100, 100);
+                auto buffer = createBuffer(size);
+                OffscreenBufferBinding bufferBinding(buffer);
+
+                auto render = Render::create(context);
+                render->begin(size);
+                FEATHER_TK_ASSERT(0 == render->getStats().drawCount);
+                FEATHER_TK_ASSERT(0 == render->getStats().batchCount);
+                FEATHER_TK_ASSERT(0 == render->getStats().triCount);
+
+                // Primitives are batched together until the batch is flushed.
+                render->drawRect(Box2F(0.F, 0.F, 10.F, 10.F), Color4F(1.F, 0.F, 0.F));
+                render->drawRect(Box2F(10.F, 0.F, 10.F, 10.F), Color4F(0.F, 1.F, 0.F));
+                render->drawLine(V2F(0.F, 0.F), V2F(100.F, 100.F), Color4F(0.F, 0.F, 1.F));
+                FEATHER_TK_ASSERT(0 == render->getStats().drawCount);
+                render->flush();
+                FEATHER_TK_ASSERT(1 == render->getStats().drawCount);
+                FEATHER_TK_ASSERT(1 == render->getStats().batchCount);
+                FEATHER_TK_ASSERT(6 == render->getStats().triCount);
+                render->flush();
+                FEATHER_TK_ASSERT(1 == render->getStats().drawCount);
+
+                // Changing the clip rectangle flushes the batch.
+                render->drawRect(Box2F(0.F, 0.F, 10.F, 10.F), Color4F(1.F, 0.F, 0.F));
+                render->setClipRectEnabled(true);
+                render->setClipRect(Box2I(0, 0, 50, 50));
+                FEATHER_TK_ASSERT(2 == render->getStats().batchCount);
+                render->drawRect(Box2F(0.F, 0.F, 10.F, 10.F), Color4F(1.F, 0.F, 0.F));
+                render->setClipRect(Box2I(0, 0, 25, 25));
+                render->setClipRectEnabled(false);
+                FEATHER_TK_ASSERT(3 == render->getStats().drawCount);
+                FEATHER_TK_ASSERT(3 == render->getStats().batchCount);
+
+                // Retained meshes are drawn with their own draw call.
+                TriMesh2F mesh;
+                mesh.v.push_back(V2F(0.F, 0.F));
+                mesh.v.push_back(V2F(10.F, 0.F));
+                mesh.v.push_back(V2F(10.F, 10.F));
+                Triangle2 triangle;
+                triangle.v[0].v = 1;
+                triangle.v[1].v = 2;
+                triangle.v[2].v = 3;
+                mesh.triangles.push_back(triangle);
+                auto retained = render->createMesh(mesh);
+                render->drawMesh(retained);
+                FEATHER_TK_ASSERT(4 == render->getStats().drawCount);
+                FEATHER_TK_ASSERT(3 == render->getStats().batchCount);
+                FEATHER_TK_ASSERT(1 == render->getStats().retainedDrawCount);
+                render->end();
+
+                // The statistics are reset for each frame.
+                render->begin(size);
+                FEATHER_TK_ASSERT(0 == render->getStats().drawCount);
+                FEATHER_TK_ASSERT(0 == render->getStats().batchCount);
+                FEATHER_TK_ASSERT(0 == render->getStats().triCount);
+                FEATHER_TK_ASSERT(0 == render->getStats().retainedDrawCount);
+                render->end();
+            }
+            if (auto context = _context.lock())
             {
                 auto window = createWindow(context);
                 Size2I size(1920, 1080);
@@ -118,6 +179,50 @@ namespace feather_tk
                     triangle.v[2].v = 1;
                     mesh.triangles.push_back(triangle);
                     render->drawMesh(mesh);
+
+                    auto retained = render->createMesh(mesh);
+                    render->drawMesh(retained, Color4F(1.F, 1.F, 1.F, .5F));
+                    render->drawMesh(retained, Color4F(1.F, 1.F, 1.F, .5F), V2F(10.F, 10.F));
+                    retained.reset();
+                    retained = render->createMesh(mesh);
+                    render->drawMesh(retained);
+                }
+
+                {
+                    // Dense grid with more indices than a shared mesh
+                    // page holds.
+                    TriMesh2F mesh;
+                    const int gridSize = 200;
+                    for (int y = 0; y < gridSize; ++y)
+                    {
+                        for (int x = 0; x < gridSize; ++x)
+                        {
+                            mesh.v.push_back(V2F(x, y));
+                        }
+                    }
+                    for (int y = 0; y < gridSize - 1; ++y)
+                    {
+                        for (int x = 0; x < gridSize - 1; ++x)
+                        {
+                            const size_t i = y * gridSize + x + 1;
+                            Triangle2 triangle;
+                            triangle.v[0].v = i;
+                            triangle.v[1].v = i + 1;
+                            triangle.v[2].v = i + gridSize + 1;
+                            mesh.triangles.push_back(triangle);
+                            triangle.v[0].v = i + gridSize + 1;
+                            triangle.v[1].v = i + gridSize;
+                            triangle.v[2].v = i;
+                            mesh.triangles.push_back(triangle);
+                        }
+                    }
+                    FEATHER_TK_ASSERT(mesh.triangles.size() * 3 > 65536 * 3);
+                    auto retained = render->createMesh(mesh);
+                    render->drawMesh(retained);
+                    auto retained2 = render->createMesh(mesh);
+                    render->drawMesh(retained2, Color4F(1.F, 1.F, 1.F, .5F));
+                    retained.reset();
+                    retained2.reset();
                 }
                 
                 {
@@ -154,6 +259,25 @@ namespace feather_tk
                 auto fontMetrics = fontSystem->getMetrics(fontInfo);
                 auto glyphs = fontSystem->getGlyphs(text, fontInfo);
                 render->drawText(glyphs, fontMetrics, V2F(100.F, 100.F));
+                render->drawText(glyphs, fontMetrics, V2F(100.F, 200.F), Color4F(1.F, 0.F, 0.F));
+                auto textLayout = fontSystem->getLayout(text, fontInfo, 20);
+                render->drawText(
+                    *textLayout,
+                    fontMetrics,
+                    V2I(100, 300));
+                render->flush();
+
+                std::vector<Box2F> rects;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    rects.push_back(Box2F(i, i, 10.F, 10.F));
+                    render->drawRect(rects.back(), Color4F(i / 1000.F, 0.F, 0.F));
+                }
+                render->drawRects(rects, Color4F(0.F, 0.F, 1.F));
+                render->setClipRectEnabled(true);
+                render->setClipRect(Box2I(0, 0, 100, 100));
+                render->drawRects(rects, Color4F(0.F, 1.F, 0.F));
+                render->setClipRectEnabled(false);
                 
                 std::vector<ImageOptions> imageOptionsList;
                 for (auto i : getInputVideoLevelsEnums())
@@ -173,6 +297,11 @@ namespace feather_tk
                     imageOptions.cache = false;
                     imageOptionsList.push_back(imageOptions);
                 }
+                {
+                    ImageOptions imageOptions;
+                    imageOptions.stream = true;
+                    imageOptionsList.push_back(imageOptions);
+                }
                 {
                     ImageOptions imageOptions;
                     imageOptions.imageFilters.minify = ImageFilter::Nearest;
@@ -136,6 +136,16 @@ namespace feather_tk
                 shader->setUniform("af", std::vector<float>({ 1.F, 1.F, 1.F, 1.F }));
                 shader->setUniform("av3", std::vector<V3F>(4, V3F(1.F, 1.F, 1.F)));
                 shader->setUniform("av4", std::vector<V4F>(4, V4F(1.F, 1.F, 1.F, 1.F)));
+                FEATHER_TK_ASSERT(-1 == shader->getUniformLocation("doesNotExist"));
+                const int location = shader->getUniformLocation("m4");
+                if (location != -1)
+                {
+                    const size_t skipped = shader->getSkippedUniformCount();
+                    shader->setUniform(location, M44F());
+                    FEATHER_TK_ASSERT(shader->getSkippedUniformCount() == skipped + 1);
+                    shader->setUniform(location, translate(V3F(1.F, 0.F, 0.F)));
+                    FEATHER_TK_ASSERT(shader->getSkippedUniformCount() == skipped + 1);
+                }
             }
             if (auto context = _context.lock())
             {
@@ -74,9 +74,77 @@ namespace feather_tk
                     TextureAtlasItem item;
                     FEATHER_TK_ASSERT(atlas->addItem(image, item));
                     FEATHER_TK_ASSERT(atlas->getItem(item.id, item));
+                    FEATHER_TK_ASSERT(Size2I(512, 512) == item.size);
                     _print(format(item));
                     _print(Format("Percentage: {0}").arg(atlas->getPercentageUsed()));
                 }
+                FEATHER_TK_ASSERT(1 == atlas->getPageCount());
+                FEATHER_TK_ASSERT(10 == atlas->getItemCount());
+                FEATHER_TK_ASSERT(0 == atlas->getEvictionCount());
+
+                auto image = Image::create(2048, 2048, ImageType::L_U8);
+                TextureAtlasItem item;
+                FEATHER_TK_ASSERT(!atlas->addItem(image, item));
+            }
+            if (auto context = _context.lock())
+            {
+                auto window = createWindow(context);
+
+                auto atlas = TextureAtlas::create(
+                    256,
+                    ImageType::L_U8,
+                    ImageFilter::Linear,
+                    1,
+                    2);
+                FEATHER_TK_ASSERT(2 == atlas->getPageCountMax());
+                FEATHER_TK_ASSERT(0 == atlas->getPageCount());
+
+                // Fill the first page.
+                std::vector<TextureAtlasItem> items;
+                auto image = Image::create(126, 126, ImageType::L_U8);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    TextureAtlasItem item;
+                    FEATHER_TK_ASSERT(atlas->addItem(image, item));
+                    FEATHER_TK_ASSERT(0 == item.page);
+                    items.push_back(item);
+                }
+                FEATHER_TK_ASSERT(1 == atlas->getPageCount());
+                FEATHER_TK_ASSERT(1.F == atlas->getPercentageUsed());
+
+                // Adding another item creates a new page.
+                TextureAtlasItem item;
+                FEATHER_TK_ASSERT(atlas->addItem(image, item));
+                FEATHER_TK_ASSERT(1 == item.page);
+                FEATHER_TK_ASSERT(2 == atlas->getPageCount());
+                FEATHER_TK_ASSERT(atlas->getTexture(0) != atlas->getTexture(1));
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    FEATHER_TK_ASSERT(atlas->addItem(image, item));
+                    FEATHER_TK_ASSERT(1 == item.page);
+                }
+
+                // Use the first page, then add an item to evict the
+                // least recently used second page.
+                std::vector<int> evicted;
+                atlas->setEvictCallback(
+                    [&evicted](int page)
+                    {
+                        evicted.push_back(page);
+                    });
+                FEATHER_TK_ASSERT(atlas->getItem(items[0].id, item));
+                FEATHER_TK_ASSERT(atlas->addItem(image, item));
+                FEATHER_TK_ASSERT(1 == item.page);
+                FEATHER_TK_ASSERT(1 == evicted.size());
+                FEATHER_TK_ASSERT(1 == evicted[0]);
+                FEATHER_TK_ASSERT(2 == atlas->getPageCount());
+                FEATHER_TK_ASSERT(4 == atlas->getEvictionCount());
+                FEATHER_TK_ASSERT(5 == atlas->getItemCount());
+                FEATHER_TK_ASSERT(9 == atlas->getAddCount());
+                for (const auto& i : items)
+                {
+                    FEATHER_TK_ASSERT(atlas->getItem(i.id, item));
+                }
             }
         }
     }
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <glTest/TextureStreamTest.h>
+
+#include <feather-tk/gl/Render.h>
+#include <feather-tk/gl/TextureStream.h>
+#include <feather-tk/gl/Window.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Format.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace feather_tk::gl;
+
+namespace feather_tk
+{
+    namespace gl_test
+    {
+        TextureStreamTest::TextureStreamTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::gl_test::TextureStreamTest")
+        {}
+
+        TextureStreamTest::~TextureStreamTest()
+        {}
+
+        std::shared_ptr<TextureStreamTest> TextureStreamTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<TextureStreamTest>(new TextureStreamTest(context));
+        }
+
+        void TextureStreamTest::run()
+        {
+            if (auto context = _context.lock())
+            {
+                auto window = Window::create(
+                    context,
+                    "TextureStreamTest",
+                    Size2I(100, 100),
+                    static_cast<int>(WindowOptions::MakeCurrent));
+
+                for (auto imageType : {
+                    ImageType::RGBA_U8,
+                    ImageType::YUV_420P_U8,
+                    ImageType::YUV_422P_U16,
+                    ImageType::YUV_420P_U16 })
+                {
+                    try
+                    {
+                        const ImageInfo info(1920, 1080, imageType);
+                        _print(Format("Texture stream: {0}").arg(info.type));
+                        auto stream = TextureStream::create(info);
+                        FEATHER_TK_ASSERT(info == stream->getInfo());
+                        FEATHER_TK_ASSERT(stream->getBufferCount() > 0);
+                        const size_t textureCount = stream->getTextures().size();
+                        FEATHER_TK_ASSERT(
+                            (ImageType::RGBA_U8 == imageType && 1 == textureCount) ||
+                            (ImageType::RGBA_U8 != imageType && 3 == textureCount));
+                        FEATHER_TK_ASSERT(stream->isCompatible(info));
+                        FEATHER_TK_ASSERT(!stream->isCompatible(ImageInfo(1280, 720, imageType)));
+
+                        // Copy more images than there are buffers.
+                        for (size_t i = 0; i < stream->getBufferCount() * 2; ++i)
+                        {
+                            auto image = Image::create(info);
+                            image->zero();
+                            FEATHER_TK_ASSERT(stream->copy(image));
+                            FEATHER_TK_ASSERT(!stream->copy(image));
+                        }
+                        FEATHER_TK_ASSERT(!stream->copy(Image::create(1280, 720, imageType)));
+
+                        // Write the buffer from another thread.
+                        if (uint8_t* data = stream->map())
+                        {
+                            FEATHER_TK_ASSERT(data == stream->map());
+                            const size_t byteCount = info.getByteCount();
+                            std::thread thread(
+                                [data, byteCount]
+                                {
+                                    memset(data, 255, byteCount);
+                                });
+                            thread.join();
+                            stream->upload();
+                        }
+                        else
+                        {
+                            FEATHER_TK_ASSERT(false);
+                        }
+
+                        auto render = Render::create(context);
+                        render->begin(Size2I(100, 100));
+                        render->drawImage(stream, Box2F(0.F, 0.F, 100.F, 100.F));
+                        render->end();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _error(e.what());
+                    }
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace gl_test
+    {
+        class TextureStreamTest : public test::ITest
+        {
+        protected:
+            TextureStreamTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~TextureStreamTest();
+
+            static std::shared_ptr<TextureStreamTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+        };
+    }
+}
+
@@ -178,11 +178,14 @@ namespace feather_tk
             const bool parentsEnabled = enabled && widget->isEnabled(false);
             for (const auto& child : widget->getChildren())
             {
-                _tickRecursive(
-                    child,
-                    parentsVisible,
-                    parentsEnabled,
-                    event);
+                if (child->hasTickEvents())
+                {
+                    _tickRecursive(
+                        child,
+                        parentsVisible,
+                        parentsEnabled,
+                        event);
+                }
             }
             widget->tickEvent(visible, enabled, event);
         }
@@ -12,6 +12,8 @@
 #include <feather-tk/core/Assert.h>
 #include <feather-tk/core/Format.h>
 
+#include <algorithm>
+
 namespace feather_tk
 {
     namespace ui_test
@@ -46,6 +48,46 @@ namespace feather_tk
                     out->_init(context, "Widget", parent);
                     return out;
                 }
+
+                size_t getSizeHintCount() const
+                {
+                    return _sizeHintCount;
+                }
+
+                size_t getTickCount() const
+                {
+                    return _tickCount;
+                }
+
+                void update()
+                {
+                    _setSizeUpdate();
+                    _setDrawUpdate();
+                }
+
+                void setTickEvents(bool value)
+                {
+                    _setTickEvents(value);
+                }
+
+                void tickEvent(
+                    bool parentsVisible,
+                    bool parentsEnabled,
+                    const TickEvent& event) override
+                {
+                    IWidget::tickEvent(parentsVisible, parentsEnabled, event);
+                    ++_tickCount;
+                }
+
+                void sizeHintEvent(const SizeHintEvent& event) override
+                {
+                    IWidget::sizeHintEvent(event);
+                    ++_sizeHintCount;
+                }
+
+            private:
+                size_t _sizeHintCount = 0;
+                size_t _tickCount = 0;
             };
         }
 
@@ -110,6 +152,108 @@ namespace feather_tk
                 FEATHER_TK_ASSERT(0 == layout->getChildIndex(widget2));
                 FEATHER_TK_ASSERT(1 == layout->getChildIndex(widget0));
                 FEATHER_TK_ASSERT(2 == layout->getChildIndex(widget1));
+
+                app->tick();
+                FEATHER_TK_ASSERT(0 == window->getChildUpdates());
+                FEATHER_TK_ASSERT(0 == layout->getChildUpdates());
+                const size_t sizeHintCount0 = widget0->getSizeHintCount();
+                const size_t sizeHintCount1 = widget1->getSizeHintCount();
+                widget0->update();
+                FEATHER_TK_ASSERT(widget0->getUpdates() & static_cast<int>(Update::Size));
+                FEATHER_TK_ASSERT(layout->getChildUpdates() & static_cast<int>(Update::Size));
+                FEATHER_TK_ASSERT(window->getChildUpdates() & static_cast<int>(Update::Size));
+                FEATHER_TK_ASSERT(window->getChildUpdates() & static_cast<int>(Update::Draw));
+                app->tick();
+                FEATHER_TK_ASSERT(0 == window->getChildUpdates());
+                FEATHER_TK_ASSERT(0 == layout->getChildUpdates());
+                FEATHER_TK_ASSERT(sizeHintCount0 + 1 == widget0->getSizeHintCount());
+                FEATHER_TK_ASSERT(sizeHintCount1 == widget1->getSizeHintCount());
+
+                window->setDisplayScale(2.F);
+                app->tick();
+                FEATHER_TK_ASSERT(sizeHintCount0 + 1 < widget0->getSizeHintCount());
+                FEATHER_TK_ASSERT(sizeHintCount1 < widget1->getSizeHintCount());
+
+                auto widget3 = Widget::create(context, nullptr);
+                auto widget4 = Widget::create(context, widget3);
+                widget4->update();
+                widget3->setParent(layout);
+                FEATHER_TK_ASSERT(layout->getChildUpdates() & static_cast<int>(Update::Size));
+                app->tick();
+                FEATHER_TK_ASSERT(widget4->getSizeHintCount() > 0);
+
+                // Only widgets with tick events are ticked.
+                auto widget5 = Widget::create(context, layout);
+                auto widget6 = Widget::create(context, widget5);
+                app->tick();
+                FEATHER_TK_ASSERT(0 == widget5->getTickCount());
+                FEATHER_TK_ASSERT(0 == widget6->getTickCount());
+                widget6->setTickEvents(true);
+                FEATHER_TK_ASSERT(widget5->hasTickEvents());
+                app->tick();
+                FEATHER_TK_ASSERT(widget5->getTickCount() > 0);
+                FEATHER_TK_ASSERT(widget6->getTickCount() > 0);
+                FEATHER_TK_ASSERT(0 == widget0->getTickCount());
+                widget6->setTickEvents(false);
+                FEATHER_TK_ASSERT(!widget5->hasTickEvents());
+                const size_t tickCount5 = widget5->getTickCount();
+                const size_t tickCount6 = widget6->getTickCount();
+                app->tick();
+                FEATHER_TK_ASSERT(tickCount5 == widget5->getTickCount());
+                FEATHER_TK_ASSERT(tickCount6 == widget6->getTickCount());
+
+                // The visibility and enabled state are propagated to the
+                // children without tick events.
+                FEATHER_TK_ASSERT(widget6->isVisible(true));
+                FEATHER_TK_ASSERT(widget6->isEnabled(true));
+                widget5->hide();
+                FEATHER_TK_ASSERT(!widget6->isVisible(true));
+                FEATHER_TK_ASSERT(widget6->isVisible(false));
+                widget5->setEnabled(false);
+                FEATHER_TK_ASSERT(!widget6->isEnabled(true));
+                FEATHER_TK_ASSERT(widget6->isEnabled(false));
+                app->tick();
+                FEATHER_TK_ASSERT(tickCount6 == widget6->getTickCount());
+                widget5->show();
+                widget5->setEnabled(true);
+                FEATHER_TK_ASSERT(widget6->isVisible(true));
+                FEATHER_TK_ASSERT(widget6->isEnabled(true));
+                layout->hide();
+                FEATHER_TK_ASSERT(!widget6->isVisible(true));
+                layout->show();
+                FEATHER_TK_ASSERT(widget6->isVisible(true));
+                app->tick();
+
+                // Moving a widget redraws both the previous and the new
+                // geometry.
+                widget5->setVStretch(Stretch::Expanding);
+                auto widget7 = Widget::create(context, widget5);
+                app->tick();
+                const Box2I& g5 = widget5->getGeometry();
+                const Box2I g7a(g5.min.x, g5.min.y, 2, 2);
+                const Box2I g7b(g5.min.x + 4, g5.min.y, 2, 2);
+                widget7->setGeometry(g7a);
+                app->tick();
+                widget7->setGeometry(g7b);
+                app->tick();
+                auto isRedrawn = [window](const Box2I& value)
+                {
+                    const auto& drawRects = window->getDrawRects();
+                    return std::find_if(
+                        drawRects.begin(),
+                        drawRects.end(),
+                        [value](const Box2I& rect)
+                        {
+                            return intersect(rect, value) == value;
+                        }) != drawRects.end();
+                };
+                FEATHER_TK_ASSERT(isRedrawn(g7a));
+                FEATHER_TK_ASSERT(isRedrawn(g7b));
+
+                // Hiding a widget redraws its previous geometry.
+                widget7->hide();
+                app->tick();
+                FEATHER_TK_ASSERT(isRedrawn(g7b));
             }
         }
     }
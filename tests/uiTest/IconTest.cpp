@@ -8,12 +8,15 @@
 #include <uiTest/Window.h>
 
 #include <feather-tk/ui/Icon.h>
+#include <feather-tk/ui/IconSystem.h>
 #include <feather-tk/ui/RowLayout.h>
 
 #include <feather-tk/core/Assert.h>
 #include <feather-tk/core/Format.h>
 #include <feather-tk/core/Time.h>
 
+#include <thread>
+
 namespace feather_tk
 {
     namespace ui_test
@@ -76,6 +79,51 @@ namespace feather_tk
                 app->tick(1000);
                 app->setDisplayScale(1.F);
                 app->tick(1000);
+
+                // The icons are received in tick events.
+                widget->setIcon("Settings");
+                const auto t0 = std::chrono::steady_clock::now();
+                while (widget->getSizeHint() == Size2I() &&
+                    std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+                {
+                    app->tick();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                FEATHER_TK_ASSERT(widget->getSizeHint() != Size2I());
+            }
+            if (auto context = _context.lock())
+            {
+                auto iconSystem = IconSystem::create(context, 2);
+                FEATHER_TK_ASSERT(2 == iconSystem->getThreadCount());
+                const auto names = iconSystem->getNames();
+                FEATHER_TK_ASSERT(!names.empty());
+                iconSystem->preload(names, { 1.F, 2.F });
+                auto image = iconSystem->get(names.front(), 2.F);
+                FEATHER_TK_ASSERT(image);
+                FEATHER_TK_ASSERT(image == iconSystem->get(names.front(), 2.F));
+                auto request = iconSystem->request(names.back(), 1.F);
+                FEATHER_TK_ASSERT(request.future.get());
+                request = iconSystem->request(names.back(), 2.F, true);
+                std::shared_ptr<Image> image2;
+                const auto t0 = std::chrono::steady_clock::now();
+                while (!takeIcon(request, image2) &&
+                    std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                FEATHER_TK_ASSERT(image2);
+                FEATHER_TK_ASSERT(!request.isPending());
+                FEATHER_TK_ASSERT(!iconSystem->get("Invalid", 1.F));
+
+                // Requests are not made without a name or with an image.
+                FEATHER_TK_ASSERT(!request.request(iconSystem, std::string(), 2.F, image2));
+                FEATHER_TK_ASSERT(!request.request(iconSystem, names.back(), 2.F, image2));
+                FEATHER_TK_ASSERT(!request.isPending());
+
+                // The preloaded icons are taken immediately.
+                std::shared_ptr<Image> image3;
+                FEATHER_TK_ASSERT(!request.request(iconSystem, names.front(), 2.F, image3));
+                FEATHER_TK_ASSERT(image == image3);
             }
         }
     }
@@ -30,6 +30,36 @@ namespace feather_tk
         {
             return std::shared_ptr<LineEditTest>(new LineEditTest(context));
         }
+
+        namespace
+        {
+            class TestLineEdit : public LineEdit
+            {
+            protected:
+                TestLineEdit()
+                {}
+
+            public:
+                static std::shared_ptr<TestLineEdit> create(
+                    const std::shared_ptr<Context>& context,
+                    const std::shared_ptr<IWidget>& parent)
+                {
+                    auto out = std::shared_ptr<TestLineEdit>(new TestLineEdit);
+                    out->_init(context, parent);
+                    return out;
+                }
+
+                int getCursorPos(const V2I& value)
+                {
+                    return _getCursorPos(value);
+                }
+
+                int getCursorX(int value) const
+                {
+                    return _getCursorX(value);
+                }
+            };
+        }
                 
         void LineEditTest::run()
         {
@@ -116,9 +146,20 @@ namespace feather_tk
                 window->setText("t");
                 FEATHER_TK_ASSERT("t" == textChanged);
 
+                window->setText("\xc3\xa9");
+                FEATHER_TK_ASSERT("t\xc3\xa9" == textChanged);
+                window->setKey(Key::Home);
+                window->setText("\xe2\x82\xac");
+                FEATHER_TK_ASSERT("\xe2\x82\xact\xc3\xa9" == textChanged);
+                window->setKey(Key::A, static_cast<int>(KeyModifier::Control));
+                window->setKey(Key::Delete);
+                FEATHER_TK_ASSERT(textChanged.empty());
+
                 window->setKey(Key::Escape, static_cast<int>(KeyModifier::Control));
                 FEATHER_TK_ASSERT(!edit->hasKeyFocus());
 
+                _cache(context, app, window, layout);
+
                 Box2I g = edit->getGeometry();
                 const V2I c = center(g);
                 window->setCursorPos(c);
@@ -143,6 +184,102 @@ namespace feather_tk
                 FEATHER_TK_ASSERT(!edit->hasKeyFocus());
             }
         }
+        void LineEditTest::_cache(
+            const std::shared_ptr<Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<Window>& window,
+            const std::shared_ptr<IWidget>& layout)
+        {
+            // Compare the cursor positions and hit testing of an edited
+            // line edit against one that measures all of the text.
+            auto edit = TestLineEdit::create(context, layout);
+            auto ref = TestLineEdit::create(context, layout);
+            auto compare = [app, edit, ref]
+            {
+                ref->setText(edit->getText());
+                app->tick();
+                const std::string& text = edit->getText();
+                FEATHER_TK_ASSERT(ref->getCursorX(static_cast<int>(text.size())) > 0);
+                for (int i = 0; i <= static_cast<int>(text.size()); ++i)
+                {
+                    FEATHER_TK_ASSERT(edit->getCursorX(i) == ref->getCursorX(i));
+                }
+                const Box2I& g = edit->getGeometry();
+                const Box2I& refG = ref->getGeometry();
+                FEATHER_TK_ASSERT(g.size() == refG.size());
+                for (int x = 0; x < g.w(); ++x)
+                {
+                    FEATHER_TK_ASSERT(
+                        edit->getCursorPos(V2I(g.min.x + x, g.min.y)) ==
+                        ref->getCursorPos(V2I(refG.min.x + x, refG.min.y)));
+                }
+            };
+            app->tick();
+            edit->takeKeyFocus();
+            app->tick();
+
+            // Insert multi-byte characters.
+            window->setText("a");
+            window->setText("\xc3\xa9");
+            window->setText("W");
+            app->tick();
+            compare();
+            window->setKey(Key::Home);
+            window->setText("\xe2\x82\xac");
+            window->setKey(Key::Right);
+            window->setText("\xc3\xa9");
+            app->tick();
+            FEATHER_TK_ASSERT("\xe2\x82\xac" "a\xc3\xa9\xc3\xa9W" == edit->getText());
+            compare();
+
+            // Delete multi-byte characters.
+            window->setKey(Key::Delete);
+            app->tick();
+            FEATHER_TK_ASSERT("\xe2\x82\xac" "a\xc3\xa9W" == edit->getText());
+            compare();
+            window->setKey(Key::Backspace);
+            app->tick();
+            FEATHER_TK_ASSERT("\xe2\x82\xac" "aW" == edit->getText());
+            compare();
+
+            // Select and replace multi-byte characters.
+            window->setKey(Key::Right, static_cast<int>(KeyModifier::Shift));
+            window->setText("xy");
+            app->tick();
+            FEATHER_TK_ASSERT("\xe2\x82\xac" "axy" == edit->getText());
+            compare();
+
+            // Click on the third character and insert text before it.
+            const Box2I& g = edit->getGeometry();
+            const Box2I& refG = ref->getGeometry();
+            int x = 0;
+            for (; x < refG.w() && ref->getCursorPos(V2I(refG.min.x + x, refG.min.y)) != 4; ++x)
+                ;
+            FEATHER_TK_ASSERT(x < refG.w());
+            window->setCursorPos(V2I(g.min.x + x, g.min.y + g.h() / 2));
+            window->setButton(0, true);
+            window->setButton(0, false);
+            window->setText("\xc3\xa9");
+            app->tick();
+            FEATHER_TK_ASSERT("\xe2\x82\xac" "a\xc3\xa9xy" == edit->getText());
+            compare();
+
+            // Text that cannot be converted is measured again when it is
+            // edited.
+            edit->setText("\xff");
+            app->tick();
+            edit->takeKeyFocus();
+            app->tick();
+            window->setKey(Key::End);
+            window->setText("\xc3\xa9");
+            app->tick();
+            FEATHER_TK_ASSERT("\xff\xc3\xa9" == edit->getText());
+            window->setKey(Key::Backspace);
+            app->tick();
+            FEATHER_TK_ASSERT("\xff" == edit->getText());
+
+            edit->setParent(nullptr);
+            ref->setParent(nullptr);
+        }
     }
 }
-
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <uiTest/App.h>
+#include <uiTest/Window.h>
+
 #include <testLib/ITest.h>
 
 namespace feather_tk
@@ -22,6 +25,13 @@ namespace feather_tk
                 const std::shared_ptr<Context>&);
 
             void run() override;
+
+        private:
+            void _cache(
+                const std::shared_ptr<Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<Window>&,
+                const std::shared_ptr<IWidget>&);
         };
     }
 }
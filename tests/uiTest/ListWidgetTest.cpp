@@ -7,7 +7,9 @@
 #include <uiTest/App.h>
 #include <uiTest/Window.h>
 
+#include <feather-tk/ui/ListItemsWidget.h>
 #include <feather-tk/ui/ListWidget.h>
+#include <feather-tk/ui/ScrollWidget.h>
 
 #include <feather-tk/core/Assert.h>
 #include <feather-tk/core/Format.h>
@@ -48,6 +50,7 @@ namespace feather_tk
                 _test(context, app, window, ButtonGroupType::Check);
                 _test(context, app, window, ButtonGroupType::Radio);
                 _test(context, app, window, ButtonGroupType::Toggle);
+                _virtual(context, app, window);
             }
         }
 
@@ -98,6 +101,52 @@ namespace feather_tk
             window->setKey(Key::Home);
             window->setKey(Key::Escape);
         }
-    }
-}
 
+        void ListWidgetTest::_virtual(
+            const std::shared_ptr<Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<Window>& window)
+        {
+            auto scrollWidget = ScrollWidget::create(context, ScrollType::Both, window);
+            auto widget = ListItemsWidget::create(context, ButtonGroupType::Check);
+            scrollWidget->setWidget(widget);
+            std::vector<std::string> items;
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                items.push_back(Format("Item {0}").arg(i));
+            }
+            widget->setItems(items);
+            app->tick();
+            const size_t buttonCount = widget->getButtonCount();
+            FEATHER_TK_ASSERT(buttonCount > 0);
+            FEATHER_TK_ASSERT(buttonCount < 1000);
+            const Box2I rect = widget->getRect(5000);
+            FEATHER_TK_ASSERT(rect.min.y == 5000 * widget->getRect(0).h());
+
+            widget->setCurrent(5000);
+            scrollWidget->scrollTo(rect);
+            app->tick();
+            FEATHER_TK_ASSERT(widget->getButtonCount() <= buttonCount + 1);
+            widget->setChecked(5000, true);
+            FEATHER_TK_ASSERT(widget->getChecked(5000));
+
+            widget->setSearch("Item 999");
+            app->tick();
+            FEATHER_TK_ASSERT(0 == widget->getRect(999).min.y);
+            FEATHER_TK_ASSERT(widget->getRect(999).h() == widget->getRect(9990).min.y);
+            FEATHER_TK_ASSERT(widget->getChecked(5000));
+            widget->takeKeyFocus();
+            window->setKey(Key::Home);
+            FEATHER_TK_ASSERT(999 == widget->getCurrent());
+            window->setKey(Key::Down);
+            FEATHER_TK_ASSERT(9990 == widget->getCurrent());
+            window->setKey(Key::End);
+            FEATHER_TK_ASSERT(9999 == widget->getCurrent());
+            window->setKey(Key::Escape);
+            widget->clearSearch();
+            app->tick();
+
+            scrollWidget->setParent(nullptr);
+        }
+    }
+}
\ No newline at end of file
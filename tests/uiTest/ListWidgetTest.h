@@ -34,6 +34,10 @@ namespace feather_tk
                 const std::shared_ptr<App>&,
                 const std::shared_ptr<Window>&,
                 ButtonGroupType);
+            void _virtual(
+                const std::shared_ptr<Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<Window>&);
         };
     }
 }
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#include <uiTest/ProfileWidgetTest.h>
+
+#include <uiTest/App.h>
+#include <uiTest/Window.h>
+
+#include <feather-tk/ui/Label.h>
+#include <feather-tk/ui/ProfileWidget.h>
+#include <feather-tk/ui/RowLayout.h>
+
+#include <feather-tk/core/Assert.h>
+#include <feather-tk/core/Format.h>
+#include <feather-tk/core/ProfileSystem.h>
+
+#include <algorithm>
+
+namespace feather_tk
+{
+    namespace ui_test
+    {
+        ProfileWidgetTest::ProfileWidgetTest(const std::shared_ptr<Context>& context) :
+            ITest(context, "feather_tk::ui_test::ProfileWidgetTest")
+        {}
+
+        ProfileWidgetTest::~ProfileWidgetTest()
+        {}
+
+        std::shared_ptr<ProfileWidgetTest> ProfileWidgetTest::create(
+            const std::shared_ptr<Context>& context)
+        {
+            return std::shared_ptr<ProfileWidgetTest>(new ProfileWidgetTest(context));
+        }
+                
+        void ProfileWidgetTest::run()
+        {
+            if (auto context = _context.lock())
+            {
+                std::vector<std::string> argv;
+                argv.push_back("ProfileWidgetTest");
+                auto app = App::create(
+                    context,
+                    argv,
+                    "ProfileWidgetTest",
+                    "Profile widget test.");
+                auto window = Window::create(context, app, "ProfileWidgetTest");
+                auto layout = HorizontalLayout::create(context, window);
+                layout->setMarginRole(SizeRole::MarginLarge);
+                app->addWindow(window);
+                window->show();
+                app->tick();
+
+                auto widget = ProfileWidget::create(context, layout);
+                widget->setFrameCount(60);
+                widget->setFrameCount(60);
+                FEATHER_TK_ASSERT(60 == widget->getFrameCount());
+                widget->setTargetTime(10.F);
+                widget->setTargetTime(10.F);
+                FEATHER_TK_ASSERT(10.F == widget->getTargetTime());
+                app->tick();
+
+                auto profileSystem = context->getSystem<ProfileSystem>();
+                profileSystem->setEnabled(true);
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    profileSystem->beginFrame();
+                    {
+                        ProfileTimer timer(profileSystem, "Tick");
+                        app->tick();
+                    }
+                    profileSystem->endFrame();
+                }
+
+                // Siblings with the same name should have separate events.
+                auto label0 = Label::create(context, "Label", layout);
+                auto label1 = Label::create(context, "Label", layout);
+                app->tick();
+                profileSystem->setWidgetDepth(3);
+                profileSystem->beginFrame();
+                label0->setText("Label 0");
+                label1->setText("Label 1");
+                app->tick();
+                profileSystem->endFrame();
+                const std::string path = Format("{0}/{1}[0]").
+                    arg(window->getObjectName()).
+                    arg(layout->getObjectName());
+                std::vector<std::string> names;
+                for (const auto& event : profileSystem->getLastFrame().events)
+                {
+                    names.push_back(event.name);
+                }
+                FEATHER_TK_ASSERT(std::find(names.begin(), names.end(), path) != names.end());
+                const std::string name0 = Format("{0}/{1}[1]").
+                    arg(path).
+                    arg(label0->getObjectName());
+                const std::string name1 = Format("{0}/{1}[2]").
+                    arg(path).
+                    arg(label1->getObjectName());
+                FEATHER_TK_ASSERT(std::find(names.begin(), names.end(), name0) != names.end());
+                FEATHER_TK_ASSERT(std::find(names.begin(), names.end(), name1) != names.end());
+
+                profileSystem->setEnabled(false);
+                profileSystem->clear();
+                app->tick();
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2024-2025 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <testLib/ITest.h>
+
+namespace feather_tk
+{
+    namespace ui_test
+    {
+        class ProfileWidgetTest : public test::ITest
+        {
+        protected:
+            ProfileWidgetTest(const std::shared_ptr<Context>&);
+
+        public:
+            virtual ~ProfileWidgetTest();
+
+            static std::shared_ptr<ProfileWidgetTest> create(
+                const std::shared_ptr<Context>&);
+
+            void run() override;
+        };
+    }
+}
+
@@ -259,8 +259,10 @@ namespace feather_tk
             std::weak_ptr<App> app;
             Size2I bufferSize = Size2I(0, 0);
             float displayScale = 1.F;
+            bool sizeUpdateAll = true;
             bool refresh = true;
             int modifiers = 0;
+            std::vector<Box2I> drawRects;
             std::shared_ptr<Render> render;
         };
 
@@ -309,6 +311,7 @@ namespace feather_tk
             if (value == p.displayScale)
                 return;
             p.displayScale = value;
+            p.sizeUpdateAll = true;
             _setSizeUpdate();
             _setDrawUpdate();
         }
@@ -384,6 +387,11 @@ namespace feather_tk
             if (auto app = p.app.lock()) { app->tick(); }
         }
 
+        const std::vector<Box2I>& Window::getDrawRects() const
+        {
+            return _p->drawRects;
+        }
+
         void Window::update(
             const std::shared_ptr<FontSystem>& fontSystem,
             const std::shared_ptr<IconSystem>& iconSystem,
@@ -391,14 +399,18 @@ namespace feather_tk
         {
             FEATHER_TK_P();
 
-            if (_hasSizeUpdate(shared_from_this()))
+            if (p.sizeUpdateAll || _hasSizeUpdate(shared_from_this()))
             {
                 SizeHintEvent sizeHintEvent(
                     fontSystem,
                     iconSystem,
                     p.displayScale,
                     style);
-                _sizeHintEventRecursive(shared_from_this(), sizeHintEvent);
+                _sizeHintEventRecursive(
+                    shared_from_this(),
+                    sizeHintEvent,
+                    p.sizeUpdateAll);
+                p.sizeUpdateAll = false;
 
                 setGeometry(Box2I(V2I(), p.bufferSize));
 
@@ -411,6 +423,14 @@ namespace feather_tk
             const bool drawUpdate = _hasDrawUpdate(shared_from_this());
             if (p.refresh || drawUpdate)
             {
+                // The whole window is drawn, the draw regions are only
+                // used to clear the draw update flags and for testing.
+                p.drawRects.clear();
+                _getDrawRects(
+                    shared_from_this(),
+                    Box2I(V2I(), p.bufferSize),
+                    p.drawRects);
+
                 p.render->begin(p.bufferSize);
                 p.render->setClipRectEnabled(true);
                 DrawEvent drawEvent(
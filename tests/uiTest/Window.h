@@ -43,6 +43,9 @@ namespace feather_tk
             void setText(const std::string&);
             void setDrop(const std::vector<std::string>&);
 
+            //! Get the regions that needed to be redrawn in the last update.
+            const std::vector<Box2I>& getDrawRects() const;
+
             void update(
                 const std::shared_ptr<FontSystem>&,
                 const std::shared_ptr<IconSystem>&,